@@ -33,6 +33,8 @@
 #include <QAction>
 #include <QActionGroup>
 #include <QMenu>
+#include <QFileInfo>
+#include <QTextDocument>
 
 #ifdef QT_DEBUG
 #include <QDebug>
@@ -47,11 +49,23 @@
 namespace ArgoNavis { namespace GUI {
 
 
+// maximum number of loaded source documents retained for redisplay
+const int MAX_CACHED_DOCUMENTS = 8;
+
+// files at least this size are memory-mapped instead of read into a buffer
+const qint64 MAP_FILE_THRESHOLD = 1024 * 1024;
+
+
 SourceView::SourceView(QWidget *parent)
     : QPlainTextEdit( parent )
     , m_SideBarArea( new SideBarArea( this ) )
-    , m_SyntaxHighlighter( new SyntaxHighlighter( this->document() ) )
+    , m_SyntaxHighlighter( Q_NULLPTR )
+    , m_blankDocument( new QTextDocument( this ) )
+    , m_selectedMetricType( QVariant::Invalid )
 {
+    m_blankDocument->setDocumentLayout( new QPlainTextDocumentLayout( m_blankDocument ) );
+    setDocument( m_blankDocument );
+
     connect(this, SIGNAL(blockCountChanged(int)), this, SLOT(updateSideBarAreaWidth(int)));
     connect(this, SIGNAL(updateRequest(QRect,int)), this, SLOT(updateSideBarArea(QRect,int)));
 
@@ -70,15 +84,16 @@ SourceView::SourceView(QWidget *parent)
     // connect signals to the metric cache manager
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
     connect( this, &SourceView::addMetricView, &m_metricsCache, &SourceViewMetricsCache::handleAddMetricView );
-    connect( this, &SourceView::addMetricViewData, &m_metricsCache, &SourceViewMetricsCache::handleAddMetricViewData );
+    connect( this, &SourceView::addSourceLineMetricData, &m_metricsCache, &SourceViewMetricsCache::handleAddSourceLineMetricData );
 #else
     connect( this, SIGNAL(addMetricView(QString,QString,QString,QString,QStringList)),
              &m_metricsCache, SLOT(handleAddMetricView(QString,QString,QString,QString,QStringList)) );
-    connect( this, SIGNAL(addMetricViewData(QString,QString,QString,QString,QVariantList,QStringList)),
-             &m_metricsCache, SLOT(handleAddMetricViewData(QString,QString,QString,QString,QVariantList,QStringList)) );
+    connect( this, SIGNAL(addSourceLineMetricData(QString,QString,QString,QString,QVector<QString>,QVector<int>,QVector<QVariantList>)),
+             &m_metricsCache, SLOT(handleAddSourceLineMetricData(QString,QString,QString,QString,QVector<QString>,QVector<int>,QVector<QVariantList>)) );
 #endif
 
-    connect( &m_metricsCache, SIGNAL(signalSelectedMetricChanged(QString,QString)), this, SLOT(update()) );
+    connect( &m_metricsCache, SIGNAL(signalSelectedMetricChanged(QString,QString)), this, SLOT(refreshLineMetrics()) );
+    connect( &m_metricsCache, SIGNAL(signalMetricsChanged()), this, SLOT(refreshLineMetrics()) );
 
     m_metricsCache.moveToThread( &m_thread );
     m_thread.start();
@@ -118,18 +133,59 @@ void SourceView::reset()
 {
     handleClearSourceView();
 
+    clearDocumentCache();
+
     m_metricsCache.clear();
+
+    refreshLineMetrics();
 }
 
 void SourceView::handleClearSourceView()
 {
-    clear();
+    // display the blank document - the cached source documents are kept intact
+    setDocument( m_blankDocument );
+
+    m_SyntaxHighlighter = Q_NULLPTR;
+
+    setExtraSelections( QList< QTextEdit::ExtraSelection >() );
 
     m_Annotations.clear();
 }
 
 void SourceView::handleDisplaySourceFileLineNumber(const QString &filename, int lineNumber)
 {
+    QTextDocument* sourceDocument = loadDocument( resolvePath( filename ) );
+
+    if ( sourceDocument ) {
+        m_SyntaxHighlighter = m_documentCache.first().highlighter;
+        if ( document() != sourceDocument ) {
+            setDocument( sourceDocument );
+        }
+        setCurrentLineNumber( lineNumber );
+        highlightVisibleBlocks();
+    }
+    else {
+        handleClearSourceView();
+    }
+
+    m_currentFilename = filename;
+
+    refreshLineMetrics();
+}
+
+/**
+ * @brief SourceView::resolvePath
+ * @param filename - the source filename recorded in the experiment database
+ * @return - the filename after applying the first matching path substitution
+ *
+ * Resolved filenames are remembered until the path substitutions change.
+ */
+QString SourceView::resolvePath(const QString &filename)
+{
+    QHash< QString, QString >::const_iterator cached = m_resolvedPaths.constFind( filename );
+    if ( cached != m_resolvedPaths.constEnd() )
+        return cached.value();
+
     QString filenameToLoad( filename );
 
     QMap< QString, QString >::iterator iter( m_pathSubstitutions.begin() );
@@ -141,22 +197,105 @@ void SourceView::handleDisplaySourceFileLineNumber(const QString &filename, int
         iter++;
     }
 
-    QFile file( filenameToLoad );
-    if ( file.open( QIODevice::ReadOnly | QIODevice::Text ) ) {
-        QTextDocument* sourceDocument = new QTextDocument( file.readAll(), this );
-        sourceDocument->setDocumentLayout( new QPlainTextDocumentLayout( sourceDocument ) );
-        setDocument( sourceDocument );
-        setCurrentLineNumber( lineNumber );
+    m_resolvedPaths.insert( filename, filenameToLoad );
+
+    return filenameToLoad;
+}
+
+/**
+ * @brief SourceView::loadDocument
+ * @param filePath - the source file to load
+ * @return - the highlighted source document or NULL if the file could not be read
+ *
+ * Return the cached document for the file if it hasn't been modified since loaded; otherwise load the file into a new document.
+ * The returned document is moved to the front of the cache and the least recently used documents beyond MAX_CACHED_DOCUMENTS
+ * are discarded.  Large files are memory-mapped rather than read into an intermediate buffer.
+ */
+QTextDocument* SourceView::loadDocument(const QString &filePath)
+{
+    const QFileInfo fileInfo( filePath );
+    const QDateTime lastModified = fileInfo.lastModified();
+    const qint64 size = fileInfo.size();
+
+    for ( int i=0; i<m_documentCache.size(); ++i ) {
+        const CachedDocument& entry = m_documentCache.at( i );
+        if ( entry.filePath == filePath ) {
+            if ( entry.lastModified == lastModified && entry.size == size ) {
+                m_documentCache.move( i, 0 );
+                return entry.document;
+            }
+            // the file has changed since it was loaded
+            if ( entry.document == document() )
+                handleClearSourceView();
+            delete entry.document;
+            m_documentCache.removeAt( i );
+            break;
+        }
+    }
+
+    QFile file( filePath );
+    if ( ! file.open( QIODevice::ReadOnly ) )
+        return Q_NULLPTR;
+
+    QString text;
+
+    const uchar* data = ( size >= MAP_FILE_THRESHOLD ) ? file.map( 0, size ) : Q_NULLPTR;
+    if ( data ) {
+        text = QString::fromUtf8( reinterpret_cast< const char* >( data ), size );
+        file.unmap( const_cast< uchar* >( data ) );
     }
     else {
-        handleClearSourceView();
+        const QByteArray contents = file.readAll();
+        text = QString::fromUtf8( contents.constData(), contents.size() );
     }
 
-    m_currentFilename = filename;
+    file.close();
+
+    // equivalent of opening the file in text mode
+    if ( text.contains( QLatin1Char('\r') ) )
+        text.remove( QLatin1Char('\r') );
+
+    CachedDocument entry;
+    entry.filePath = filePath;
+    entry.lastModified = lastModified;
+    entry.size = size;
+    entry.document = new QTextDocument( text, this );
+    entry.document->setDocumentLayout( new QPlainTextDocumentLayout( entry.document ) );
+    entry.highlighter = new SyntaxHighlighter( entry.document );
+    entry.highlighter->setDocument( entry.document, SyntaxHighlighter::languageForFile( filePath ) );
+
+    m_documentCache.prepend( entry );
+
+    while ( m_documentCache.size() > MAX_CACHED_DOCUMENTS ) {
+        QTextDocument* evicted = m_documentCache.takeLast().document;
+        if ( evicted == document() )
+            handleClearSourceView();
+        delete evicted;
+    }
+
+    return entry.document;
+}
+
+/**
+ * @brief SourceView::clearDocumentCache
+ *
+ * Discard all cached source documents.  The blank document must be displayed.
+ */
+void SourceView::clearDocumentCache()
+{
+    Q_ASSERT( document() == m_blankDocument );
+
+    foreach ( const CachedDocument& entry, m_documentCache ) {
+        delete entry.document;
+    }
+
+    m_documentCache.clear();
 }
 
 void SourceView::handleAddPathSubstitution(int index, const QString &oldPath, const QString &newPath)
 {
+    m_resolvedPaths.clear();
+
     // check if modifying existing entry and remove it
     if ( index < m_pathSubstitutions.size() ) {
         int count( 0 );
@@ -167,6 +306,7 @@ void SourceView::handleAddPathSubstitution(int index, const QString &oldPath, co
                 iter.remove();
                 break;
             }
+            ++count;
         }
     }
 
@@ -194,6 +334,8 @@ void SourceView::updateSideBarAreaWidth(int newBlockCount)
 
 void SourceView::updateSideBarArea(const QRect &rect, int dy)
 {
+    highlightVisibleBlocks();
+
     if(dy) {
         m_SideBarArea->scroll(0, dy);
     } else {
@@ -205,6 +347,22 @@ void SourceView::updateSideBarArea(const QRect &rect, int dy)
     }
 }
 
+/**
+ * @brief SourceView::highlightVisibleBlocks
+ *
+ * Request syntax highlighting of the blocks visible in the viewport.  Blocks already highlighted are skipped, so this is cheap
+ * to call on every viewport update.
+ */
+void SourceView::highlightVisibleBlocks()
+{
+    if ( Q_NULLPTR == m_SyntaxHighlighter )
+        return;
+
+    const int lineHeight = qMax( 1, fontMetrics().height() );
+
+    m_SyntaxHighlighter->highlightVisibleBlocks( firstVisibleBlock(), viewport()->height() / lineHeight + 1 );
+}
+
 void SourceView::resizeEvent(QResizeEvent *e)
 {
     QPlainTextEdit::resizeEvent(e);
@@ -232,12 +390,7 @@ void SourceView::sideBarAreaPaintEvent(QPaintEvent *event)
     painter.setFont( m_font );
     const int height = fontMetrics().height();
 
-    QVector< double > metrics = m_metricsCache.getMetricsCache( m_currentMetricView, m_currentFilename );
-
-    QString selectedMetricName;
-    QVariant::Type selectedMetricType;
-
-    m_metricsCache.getSelectedMetricDetails( m_currentMetricView, selectedMetricName, selectedMetricType );
+    const QVector< double >& metrics = m_lineMetrics.values;
 
     while (block.isValid() && top <= event->rect().bottom()) {
         if (block.isVisible() && bottom >= event->rect().top()) {
@@ -248,7 +401,7 @@ void SourceView::sideBarAreaPaintEvent(QPaintEvent *event)
 
             if ( lineHasMetrics ) {
                 QString value;
-                if ( QVariant::Double == selectedMetricType ) {
+                if ( QVariant::Double == m_selectedMetricType ) {
                     value = QString::number( metrics[lineNumber], 'f', 2 );
                 }
                 else {
@@ -260,29 +413,6 @@ void SourceView::sideBarAreaPaintEvent(QPaintEvent *event)
                 painter.drawText( 0, top, m_metricValueWidth, height, Qt::AlignRight|Qt::AlignVCenter, value );
             }
 
-#ifdef HAS_SOURCE_CODE_LINE_HIGHLIGHTS
-            QTextBlockFormat format;
-            QColor backgroundColor = QColor("#ffffff");
-            if ( lineHasMetrics ) {
-                double percentage = metrics[lineNumber] / metrics[0];
-                if ( percentage > 0.9 )
-                    backgroundColor = QColor("#ff3c33");
-                else if ( percentage > 0.75 )
-                    backgroundColor = QColor("#ff6969");
-                else if ( percentage > 0.5 )
-                    backgroundColor = QColor("#ffb347");
-                else if ( percentage > 0.25 )
-                    backgroundColor = QColor("#fee270");
-                else if ( percentage > 0.1 )
-                    backgroundColor = QColor("#faffcd");
-                else if ( percentage > 0.0 )
-                    backgroundColor = QColor("#afdbaf");
-            }
-            format.setBackground( backgroundColor);
-            QTextCursor cursor( block );
-            cursor.mergeBlockFormat( format );
-#endif
-
             painter.setPen( lineNumber == currentLineNumber ? Qt::white : Qt::darkGray );
             painter.setFont( m_font );
             painter.drawText(0, top, m_SideBarArea->width(), fontMetrics().height(), Qt::AlignRight, number);
@@ -385,9 +515,85 @@ void SourceView::handleMetricViewChanged(const QString& metricViewName)
 {
     m_currentMetricView = metricViewName;
 
+    refreshLineMetrics();
+}
+
+/**
+ * @brief SourceView::refreshLineMetrics
+ *
+ * Fetches the line metrics of the selected metric for the current metric view and file from the metric cache and repaints the view.
+ * The line metrics share the cached array so painting the side bar area reads them directly.
+ */
+void SourceView::refreshLineMetrics()
+{
+    m_lineMetrics = m_metricsCache.getLineMetrics( m_currentMetricView, m_currentFilename );
+
+    QString selectedMetricName;
+
+    m_metricsCache.getSelectedMetricDetails( m_currentMetricView, selectedMetricName, m_selectedMetricType );
+
+#ifdef HAS_SOURCE_CODE_LINE_HIGHLIGHTS
+    updateHeatOverlay();
+#endif
+
+    m_SideBarArea->update();
     update();
 }
 
+#ifdef HAS_SOURCE_CODE_LINE_HIGHLIGHTS
+/**
+ * @brief SourceView::heatColor
+ * @param percentage - the line metric value relative to the maximum line metric value of the file
+ * @return - the background color for the line
+ */
+QColor SourceView::heatColor(double percentage)
+{
+    if ( percentage > 0.9 )
+        return QColor("#ff3c33");
+    else if ( percentage > 0.75 )
+        return QColor("#ff6969");
+    else if ( percentage > 0.5 )
+        return QColor("#ffb347");
+    else if ( percentage > 0.25 )
+        return QColor("#fee270");
+    else if ( percentage > 0.1 )
+        return QColor("#faffcd");
+
+    return QColor("#afdbaf");
+}
+
+/**
+ * @brief SourceView::updateHeatOverlay
+ *
+ * Computes the background color of each line having metrics once per file and metric and applies them as extra selections.
+ * Extra selections are drawn over the document by the view, so the document itself is never modified and scrolling doesn't
+ * recompute the colors.
+ */
+void SourceView::updateHeatOverlay()
+{
+    QList< QTextEdit::ExtraSelection > selections;
+
+    const QVector< double >& metrics = m_lineMetrics.values;
+    const int lineCount = qMin( metrics.size() - 1, document()->blockCount() );
+
+    if ( m_lineMetrics.maximum > 0.0 ) {
+        for ( int lineNumber = 1; lineNumber <= lineCount; ++lineNumber ) {
+            if ( metrics[lineNumber] <= 0.0 )
+                continue;
+
+            QTextEdit::ExtraSelection selection;
+            selection.format.setBackground( heatColor( metrics[lineNumber] / m_lineMetrics.maximum ) );
+            selection.format.setProperty( QTextFormat::FullWidthSelection, true );
+            selection.cursor = QTextCursor( document()->findBlockByNumber( lineNumber-1 ) );
+
+            selections << selection;
+        }
+    }
+
+    setExtraSelections( selections );
+}
+#endif
+
 
 } // GUI
 } // ArgoNavis
@@ -31,12 +31,16 @@
 #include <QColor>
 #include <QThread>
 #include <QMap>
+#include <QHash>
+#include <QList>
+#include <QDateTime>
 
 #include "SourceViewMetricsCache.h"
 
 #include "common/openss-gui-config.h"
 
 class QPaintEvent;
+class QTextDocument;
 class QResizeEvent;
 class QEvent;
 class QAction;
@@ -71,7 +75,7 @@ signals:
 
     void addMetricView(const QString& clusteringCriteriaName, const QString& modeName, const QString& metricName, const QString& viewName, const QStringList& metrics);
     void addAssociatedMetricView(const QString& clusteringCriteriaName, const QString& modeName, const QString& metricName, const QString& viewName, const QString& attachedMetricViewName, const QStringList& metrics);
-    void addMetricViewData(const QString& clusteringCriteriaName, const QString& modeName, const QString& metricName, const QString& viewName, const QVariantList& data, const QStringList& columnHeaders = QStringList());
+    void addSourceLineMetricData(const QString& clusteringCriteriaName, const QString& modeName, const QString& metricName, const QString& viewName, const QVector<QString>& filenames, const QVector<int>& lineNumbers, const QVector<QVariantList>& data);
 
 public slots:
 
@@ -96,11 +100,20 @@ private:
     void sideBarAreaPaintEvent(QPaintEvent *event);
     int sideBarAreaWidth();
     void refreshStatements();
+    void highlightVisibleBlocks();
+    QString resolvePath(const QString& filename);
+    QTextDocument* loadDocument(const QString& filePath);
+    void clearDocumentCache();
+#ifdef HAS_SOURCE_CODE_LINE_HIGHLIGHTS
+    void updateHeatOverlay();
+    static QColor heatColor(double percentage);
+#endif
 
 private slots:
 
     void updateSideBarAreaWidth(int newBlockCount);
     void updateSideBarArea(const QRect &, int);
+    void refreshLineMetrics();
 
 private:
 
@@ -119,8 +132,25 @@ private:
     QFont m_metricsFont;
 
     QMap<QString, QString> m_pathSubstitutions;
+    QHash<QString, QString> m_resolvedPaths;
+
+    // loaded and highlighted source documents - most recently used first
+    struct CachedDocument {
+        QString filePath;
+        QDateTime lastModified;
+        qint64 size;
+        QTextDocument* document;
+        SyntaxHighlighter* highlighter;
+    };
+    QList<CachedDocument> m_documentCache;
+
+    QTextDocument* m_blankDocument;
 
     SourceViewMetricsCache m_metricsCache;
+
+    // line metrics of the selected metric for the current file - refreshed when the metric cache changes
+    SourceViewMetricsCache::LineMetrics m_lineMetrics;
+    QVariant::Type m_selectedMetricType;
     QThread m_thread;
 
     friend class SideBarArea;
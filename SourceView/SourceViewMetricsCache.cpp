@@ -23,7 +23,6 @@
 
 #include "SourceViewMetricsCache.h"
 
-#include "ModifyPathSubstitutionsDialog.h"
 #include "widgets/PerformanceDataMetricView.h"
 
 #include <QVariant>
@@ -61,28 +60,39 @@ SourceViewMetricsCache::~SourceViewMetricsCache()
 }
 
 /**
- * @brief SourceViewMetricsCache::getMetricsCache
+ * @brief SourceViewMetricsCache::getLineMetrics
  * @param metricViewName - the metric view name
  * @param currentFileName - the name of the file current displayed in the source-code view
- * @return the map for the specified metric view
+ * @return - the line metrics of the selected metric for the specified metric view and file
  *
- * Get a copy of the metric cache for the specified metric view.
+ * Get the line metrics of the selected metric for the specified metric view and file.  The returned values share the cached
+ * array, so the caller can keep the result and read it without copying or locking.  Calling this function re-arms the
+ * signalMetricsChanged notification.
  */
-QVector<double> SourceViewMetricsCache::getMetricsCache(const QString &metricViewName, const QString &currentFileName)
+SourceViewMetricsCache::LineMetrics SourceViewMetricsCache::getLineMetrics(const QString &metricViewName, const QString &currentFileName)
 {
     QMutexLocker guard( &m_mutex );
 
-    if ( m_watchedMetricNames.contains( metricViewName ) && m_metrics.contains( metricViewName ) && m_metrics[ metricViewName ].contains( currentFileName ) ) {
+    m_metricsChangedPending.fetchAndStoreOrdered( 0 );
 
-        const QMap< QString, QVector<double> >& metrics = m_metrics[ metricViewName ][ currentFileName ];
+    QMap< QString, QHash< quint32, QMap< QString, LineMetrics > > >::const_iterator viewIter = m_metrics.constFind( metricViewName );
+    QHash< QString, quint32 >::const_iterator fileIter = m_fileIds.constFind( currentFileName );
 
-        const QString selectedMetricName = m_watchedMetricNames[ metricViewName ];
+    if ( m_watchedMetricNames.contains( metricViewName ) && viewIter != m_metrics.constEnd() && fileIter != m_fileIds.constEnd() ) {
 
-        if ( metrics.contains( selectedMetricName ) )
-            return metrics[ selectedMetricName ];
+        QHash< quint32, QMap< QString, LineMetrics > >::const_iterator metricsIter = viewIter.value().constFind( fileIter.value() );
+
+        if ( metricsIter != viewIter.value().constEnd() ) {
+            const QString selectedMetricName = m_watchedMetricNames[ metricViewName ];
+
+            QMap< QString, LineMetrics >::const_iterator iter = metricsIter.value().constFind( selectedMetricName );
+
+            if ( iter != metricsIter.value().constEnd() )
+                return iter.value();
+        }
     }
 
-    return QVector<double>();
+    return LineMetrics();
 }
 
 /**
@@ -178,6 +188,9 @@ void SourceViewMetricsCache::handleAddMetricView(const QString &clusteringCriter
         // initialize the map of indexes for each metric name
         m_watchedMetricViews.insert( metricViewName, metricIndexes );
 
+        // discard previously accumulated values so regenerating the metric view doesn't count them twice
+        m_metrics.remove( metricViewName );
+
         // determine default selected metrc name
         QString defaultSelectedMetric;
 
@@ -202,24 +215,27 @@ void SourceViewMetricsCache::handleAddMetricView(const QString &clusteringCriter
 
         // default selected metric is either the time metric or the first PAPI event item
         m_watchedMetricNames.insert( metricViewName, defaultSelectedMetric );
+
+        notifyMetricsChanged();
     }
 }
 
 /**
- * @brief SourceViewMetricsCache::handleAddMetricViewData
+ * @brief SourceViewMetricsCache::handleAddSourceLineMetricData
  * @param clusteringCriteriaName - the name of the clustering criteria
  * @param modeName - the mode name
  * @param metricName - the name of the metric requested in the metric view
  * @param viewName - the name of the view requested in the metric view
- * @param data - the data to add to the model
- * @param columnHeaders - if present provides the names of the columns for each index in the data
+ * @param filenames - the source filename of the defining location of each entry
+ * @param lineNumbers - the line number of the defining location of each entry
+ * @param data - the data added to the metric view for each entry
  *
- * Extracts the data for one entry of the specified metric view and stores in the corresponding cache map .
+ * Accumulates the metric values of the entries of the specified metric view into the line metrics of their defining locations.
+ * Several entries may resolve to the same line (for instance several statements on one line), so values are added rather than replaced.
  */
-void SourceViewMetricsCache::handleAddMetricViewData(const QString &clusteringCriteriaName, const QString& modeName, const QString &metricName, const QString &viewName, const QVariantList &data, const QStringList &columnHeaders)
+void SourceViewMetricsCache::handleAddSourceLineMetricData(const QString &clusteringCriteriaName, const QString &modeName, const QString &metricName, const QString &viewName, const QVector<QString> &filenames, const QVector<int> &lineNumbers, const QVector<QVariantList> &data)
 {
     Q_UNUSED( clusteringCriteriaName );
-    Q_UNUSED( columnHeaders );
 
     const QString metricViewName = PerformanceDataMetricView::getMetricViewName( modeName, metricName, viewName );
 
@@ -229,54 +245,68 @@ void SourceViewMetricsCache::handleAddMetricViewData(const QString &clusteringCr
     if ( ! m_watchedMetricViews.contains( metricViewName ) || ! m_watchedMetricNames.contains( metricViewName ) )
         return;
 
-    QMap< QString, QMap< QString, QVector< double > > >& metricViewData = m_metrics[ metricViewName ];
+    QHash< quint32, QMap< QString, LineMetrics > >& viewMetrics = m_metrics[ metricViewName ];
 
     // get the list of metric name / index pairs
     const QMap< QString, int >& metricIndexes = m_watchedMetricViews[ metricViewName ];
 
-    if ( ! metricIndexes.contains( s_functionTitle ) )
-         return;
+    const int count = qMin( filenames.size(), qMin( lineNumbers.size(), data.size() ) );
 
-    const QString definingLocation = data.at( metricIndexes[ s_functionTitle ] ).toString();
+    for ( int i=0; i<count; ++i ) {
+        const QString& filename = filenames[i];
+        const int lineNumber = lineNumbers[i];
 
-    int lineNumber;
-    QString filename;
+        if ( filename.isEmpty() || lineNumber < 1 )
+            continue;   // skip invalid filename or line number
 
-    ModifyPathSubstitutionsDialog::extractFilenameAndLine( definingLocation, filename, lineNumber );
+        QHash< QString, quint32 >::const_iterator fileIter = m_fileIds.constFind( filename );
+        if ( fileIter == m_fileIds.constEnd() )
+            fileIter = m_fileIds.insert( filename, m_fileIds.size() );
 
-    if ( filename.isEmpty() || lineNumber < 1 )
-        return;   // skip invalid filename or line number
+        QMap< QString, LineMetrics >& metricFileData = viewMetrics[ fileIter.value() ];
 
-    QMap< QString, QVector< double > >& metricFileData = metricViewData[ filename ];
+        const QVariantList& values = data[i];
 
-    for ( QMap< QString, int >::const_iterator iter = metricIndexes.begin(); iter != metricIndexes.end(); iter++ ) {
-        const QString metricName = iter.key();
+        for ( QMap< QString, int >::const_iterator iter = metricIndexes.begin(); iter != metricIndexes.end(); iter++ ) {
+            const QString metricName = iter.key();
 
-        if ( metricName == s_functionTitle )
-            continue;  // skip the function name metric
+            if ( metricName == s_functionTitle )
+                continue;  // skip the function name metric
 
-        const int metricIndex = iter.value();
+            const int metricIndex = iter.value();
 
-        const double value = data.at( metricIndex ).toDouble();
+            if ( metricIndex < 0 || metricIndex >= values.size() )
+                continue;
 
-        QVector< double >& metrics = metricFileData[ metricName ];
+            LineMetrics& metrics = metricFileData[ metricName ];
 
-        if ( metrics.size() == 0 ) {
-            // initialize max value to first value
-            metrics.push_back( value );
-        }
-        else {
-            // update max value as appropriate
-            if ( value > metrics[0] ) {
-                metrics[0] = value;
-            }
-        }
+            if ( metrics.values.size() < lineNumber+1 )
+                metrics.values.resize( lineNumber+1 );
+
+            double& value = metrics.values[ lineNumber ];
 
-        if ( metrics.size() < lineNumber+1 )
-            metrics.resize( lineNumber+1 );
+            value += values.at( metricIndex ).toDouble();
 
-        metrics[ lineNumber ] = value;
+            if ( value > metrics.maximum )
+                metrics.maximum = value;
+        }
     }
+
+    guard.unlock();
+
+    notifyMetricsChanged();
+}
+
+/**
+ * @brief SourceViewMetricsCache::notifyMetricsChanged
+ *
+ * Emits signalMetricsChanged unless a previous notification has not yet been followed by a call to getLineMetrics.  This coalesces
+ * the notifications for the metric views updated in a row into a single refresh of the source-code view.
+ */
+void SourceViewMetricsCache::notifyMetricsChanged()
+{
+    if ( m_metricsChangedPending.testAndSetOrdered( 0, 1 ) )
+        emit signalMetricsChanged();
 }
 
 /**
@@ -290,6 +320,7 @@ void SourceViewMetricsCache::clear()
     QMutexLocker guard( &m_mutex );
 
     m_watchedMetricViews.clear();
+    m_fileIds.clear();
     m_metrics.clear();
     m_watchedMetricNames.clear();
     m_watchableMetricNames.clear();
@@ -30,7 +30,9 @@
 #include <QPair>
 #include <QVector>
 #include <QVariantList>
+#include <QHash>
 #include <QMutex>
+#include <QAtomicInt>
 #include <set>
 
 namespace ArgoNavis { namespace GUI {
@@ -45,7 +47,14 @@ public:
     explicit SourceViewMetricsCache(QObject *parent = 0);
     virtual ~SourceViewMetricsCache();
 
-    QVector< double > getMetricsCache(const QString& metricViewName, const QString& currentFileName);
+    // the line-indexed metric values for one file - values[0] is unused
+    struct LineMetrics {
+        LineMetrics() : maximum( 0.0 ) { }
+        QVector< double > values;
+        double maximum;
+    };
+
+    LineMetrics getLineMetrics(const QString& metricViewName, const QString& currentFileName);
 
     QStringList getMetricChoices(const QString &metricViewName) const;
 
@@ -56,21 +65,27 @@ public:
 signals:
 
     void signalSelectedMetricChanged(const QString& metricViewName, const QString& selectedMetricName);
+    void signalMetricsChanged();
 
 public slots:
 
     void handleSelectedMetricChanged();
     void handleAddMetricView(const QString &clusteringCriteriaName, const QString& modeName, const QString &metricName, const QString &viewName, const QStringList &metrics);
-    void handleAddMetricViewData(const QString &clusteringCriteriaName, const QString& modeName, const QString &metricName, const QString &viewName, const QVariantList &data, const QStringList &columnHeaders);
+    void handleAddSourceLineMetricData(const QString &clusteringCriteriaName, const QString& modeName, const QString &metricName, const QString &viewName, const QVector<QString> &filenames, const QVector<int> &lineNumbers, const QVector<QVariantList> &data);
 
 private:
 
-    // maps metric view name to pair of integers representing the indexes of
-    // the columns containing the defining location and the metric value.
+    void notifyMetricsChanged();
+
+    // maps metric view name to another map of metric name to the index of
+    // the column containing the metric value.
     QMap< QString, QMap< QString, int > > m_watchedMetricViews;
 
-    // maps the metric view name to another map of filename to another map of the metric name to the metric value
-    QMap< QString, QMap< QString, QMap< QString, QVector<double> > > > m_metrics;
+    // interned source filenames
+    QHash< QString, quint32 > m_fileIds;
+
+    // maps the metric view name to another map of file id to another map of the metric name to the line metrics
+    QMap< QString, QHash< quint32, QMap< QString, LineMetrics > > > m_metrics;
 
     // maps the metric view name to the name of the metric in the 'm_watchedMetricViews' that is selected
     QMap< QString, QString > m_watchedMetricNames;
@@ -78,6 +93,9 @@ private:
     // maps the metric view name to the set of metrics that can be selected for the metric view
     QMap< QString, std::set< QString > > m_watchableMetricNames;
 
+    // set while a metrics changed notification is pending delivery
+    QAtomicInt m_metricsChangedPending;
+
     // mutex for cache
     mutable QMutex m_mutex;
 
@@ -25,119 +25,634 @@
 #include "SyntaxHighlighter.h"
 
 #include <QTextDocument>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QByteArray>
 
 namespace ArgoNavis { namespace GUI {
 
-SyntaxHighlighter::SyntaxHighlighter(QTextDocument *parent) :
-    QSyntaxHighlighter(parent)
+
+namespace {
+
+// maximum time spent highlighting blocks per idle time slice
+const int IDLE_SLICE_MSEC = 8;
+
+// number of blocks above and below the viewport highlighted with the visible blocks
+const int VIEWPORT_MARGIN_BLOCKS = 50;
+
+const char* const C_KEYWORDS[] = {
+    "asm", "break", "case", "catch", "class", "const_cast", "continue", "default", "delete",
+    "do", "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "friend",
+    "for", "goto", "if", "inline", "namespace", "new", "operator", "private", "protected",
+    "public", "reinterpret_cast", "return", "sizeof", "static_cast", "struct", "switch",
+    "template", "this", "throw", "true", "try", "typedef", "typeid", "type_info",
+    "typename", "union", "using", "virtual", "while", "and", "and_eq", "bad_cast",
+    "bad_typeid", "bitand", "bitor", "compl", "not", "not_eq", "or", "or_eq", "xor",
+    "xor_eq", "nullptr", "constexpr", "decltype", "noexcept", "static_assert", "override", "final"
+};
+
+const char* const C_DATA_TYPES[] = {
+    "auto", "bool", "char", "const", "double", "float", "int", "long", "mutable",
+    "register", "short", "signed", "static", "unsigned", "void", "volatile", "uchar",
+    "uint", "int8_t", "int16_t", "int32_t", "int64_t", "uint8_t", "uint16_t", "uint32_t",
+    "uint64_t", "wchar_t", "size_t"
+};
+
+const char* const FORTRAN_KEYWORDS[] = {
+    "program", "end", "subroutine", "function", "module", "use", "only", "implicit", "none",
+    "call", "do", "enddo", "if", "then", "else", "elseif", "endif", "select", "case", "where",
+    "contains", "return", "stop", "allocate", "deallocate", "interface", "intent", "in", "out",
+    "inout", "parameter", "go", "goto", "continue", "cycle", "exit", "while", "print", "write",
+    "read", "open", "close", "format", "common", "data", "save", "include", "public", "private",
+    "pure", "elemental", "recursive", "result", "block", "associate", "target", "pointer",
+    "allocatable", "dimension", "optional", "equivalence", "external", "intrinsic", "entry",
+    "sequence", "forall", "endfunction", "endsubroutine", "endmodule", "endprogram"
+};
+
+const char* const FORTRAN_DATA_TYPES[] = {
+    "integer", "real", "double", "precision", "doubleprecision", "complex", "logical",
+    "character", "type", "class", "kind", "len"
+};
+
+#define ARRAY_SIZE(a) ( sizeof(a) / sizeof((a)[0]) )
+
+
+/**
+ * @brief The KeywordTable class
+ *
+ * Perfect hash table of the keywords and data type names of a language.  The hash seed is chosen when the table is built so that
+ * no two words share a slot, so a lookup costs one hash computation and at most one string compare.
+ */
+class KeywordTable
+{
+public:
+
+    KeywordTable(const char* const keywords[], int keywordCount,
+                 const char* const dataTypes[], int dataTypeCount,
+                 bool caseInsensitive)
+        : m_seed( 0 )
+        , m_mask( 0 )
+        , m_maxLength( 0 )
+        , m_caseInsensitive( caseInsensitive )
+    {
+        QVector< Entry > entries;
+
+        for ( int i=0; i<keywordCount; ++i )
+            entries << Entry( keywords[i], true );
+        for ( int i=0; i<dataTypeCount; ++i )
+            entries << Entry( dataTypes[i], false );
+
+        // a table eight times larger than the word count finds a collision free seed after a few attempts
+        quint32 size = 1;
+        while ( size < quint32( entries.size() * 8 ) )
+            size <<= 1;
+        m_mask = size - 1;
+
+        for ( m_seed = 1; ; ++m_seed ) {
+            m_table = QVector< Entry >( size );
+            bool collision( false );
+            foreach ( const Entry& entry, entries ) {
+                const quint32 slot = hash( entry.word.constData(), entry.word.size() ) & m_mask;
+                if ( ! m_table[ slot ].word.isEmpty() ) {
+                    collision = true;
+                    break;
+                }
+                m_table[ slot ] = entry;
+                m_maxLength = qMax( m_maxLength, entry.word.size() );
+            }
+            if ( ! collision )
+                break;
+        }
+    }
+
+    // returns 1 for keywords, 0 for data types or -1 if not found
+    int lookup(const QChar* word, int length) const
+    {
+        if ( length > m_maxLength )
+            return -1;
+
+        char buffer[ 64 ];
+        for ( int i=0; i<length; ++i ) {
+            const ushort c = word[i].unicode();
+            if ( c > 0x7f )
+                return -1;
+            buffer[i] = ( m_caseInsensitive && c >= 'A' && c <= 'Z' ) ? char( c - 'A' + 'a' ) : char( c );
+        }
+
+        const Entry& entry = m_table[ hash( buffer, length ) & m_mask ];
+
+        if ( entry.word.size() != length || qstrncmp( entry.word.constData(), buffer, length ) != 0 )
+            return -1;
+
+        return entry.keyword ? 1 : 0;
+    }
+
+private:
+
+    struct Entry {
+        Entry() : keyword( false ) { }
+        Entry(const char* w, bool k) : word( w ), keyword( k ) { }
+        QByteArray word;
+        bool keyword;
+    };
+
+    // FNV-1a hash mixed with the table seed
+    quint32 hash(const char* word, int length) const
+    {
+        quint32 h = 2166136261u ^ ( m_seed * 0x9e3779b9u );
+        for ( int i=0; i<length; ++i ) {
+            h ^= quint8( word[i] );
+            h *= 16777619u;
+        }
+        return h ^ ( h >> 15 );
+    }
+
+    QVector< Entry > m_table;
+    quint32 m_seed;
+    quint32 m_mask;
+    int m_maxLength;
+    bool m_caseInsensitive;
+
+};
+
+const KeywordTable& cKeywordTable()
+{
+    static const KeywordTable table( C_KEYWORDS, ARRAY_SIZE(C_KEYWORDS), C_DATA_TYPES, ARRAY_SIZE(C_DATA_TYPES), false );
+    return table;
+}
+
+const KeywordTable& fortranKeywordTable()
+{
+    static const KeywordTable table( FORTRAN_KEYWORDS, ARRAY_SIZE(FORTRAN_KEYWORDS), FORTRAN_DATA_TYPES, ARRAY_SIZE(FORTRAN_DATA_TYPES), true );
+    return table;
+}
+
+inline bool isIdentifierStart(const QChar& c)
+{
+    return c.isLetter() || c == QLatin1Char('_');
+}
+
+inline bool isIdentifierPart(const QChar& c)
+{
+    return c.isLetterOrNumber() || c == QLatin1Char('_');
+}
+
+// whether the identifier is an MPI routine or constant (MPI_xxx)
+inline bool isMPIName(const QChar* word, int length, bool caseInsensitive)
+{
+    if ( length <= 4 || word[3] != QLatin1Char('_') )
+        return false;
+    if ( caseInsensitive )
+        return word[0].toUpper() == QLatin1Char('M') && word[1].toUpper() == QLatin1Char('P') && word[2].toUpper() == QLatin1Char('I');
+    return word[0] == QLatin1Char('M') && word[1] == QLatin1Char('P') && word[2] == QLatin1Char('I');
+}
+
+} // anonymous namespace
+
+
+/**
+ * @brief SyntaxHighlighter::SyntaxHighlighter
+ * @param parent - the parent object
+ *
+ * Constructs a SyntaxHighlighter instance not yet attached to a document.
+ */
+SyntaxHighlighter::SyntaxHighlighter(QObject *parent)
+    : QObject( parent )
+    , m_language( Language_C )
+    , m_nextIdleBlock( 0 )
+    , m_highlighting( false )
 {
     init();
+
+    m_idleTimer.setInterval( 0 );
+
+    connect( &m_idleTimer, SIGNAL(timeout()), this, SLOT(handleIdleTimeout()) );
 }
 
+/**
+ * @brief SyntaxHighlighter::init
+ *
+ * Initialize the text formats of each highlighting category.
+ */
 void SyntaxHighlighter::init()
 {
-    QStringList keywords;
-    keywords << "asm" << "break" << "case" << "catch" << "class" << "const_cast" << "continue" << "default" << "delete"
-             << "do" << "dynamic_cast" << "else" << "enum" << "explicit" << "export" << "extern" << "false" << "friend"
-             << "for" << "goto" << "if" << "inline" << "namespace" << "new" << "operator" << "private" << "protected"
-             << "public" << "reinterpret_cast" << "return" << "sizeof" << "static_cast" << "struct" << "switch"
-             << "template" << "this" << "throw" << "true" << "try" << "typedef" << "typeid" << "type_info"
-             << "typename" << "union" << "using" << "virtual" << "while" << "and" << "and_eq" << "bad_cast"
-             << "bad_typeid" << "bitand" << "bitor" << "compl" << "not" << "not_eq" << "or" << "or_eq" << "xor"
-             << "xor_eq";
+    m_formats[ Category_Keyword ].setForeground( Qt::darkYellow );
+    m_formats[ Category_DataType ].setForeground( Qt::darkMagenta );
+    m_formats[ Category_MPI ].setForeground( Qt::red );
+    m_formats[ Category_Preprocessor ].setForeground( Qt::darkBlue );
+    m_formats[ Category_Quote ].setForeground( Qt::darkGreen );
+    m_formats[ Category_Comment ].setForeground( Qt::darkGreen );
 
-    QString keywordPattern;
-    keywordPattern.append("\\b(");
-    keywordPattern.append(keywords.join("|"));
-    keywordPattern.append(")\\b");
-    m_Keywords.setPattern(keywordPattern);
+    // build the keyword tables now rather than when the first block is highlighted
+    cKeywordTable();
+    fortranKeywordTable();
+}
 
-    QStringList dataTypes;
-    dataTypes << "auto" << "bool" << "char" << "const" << "double" << "float" << "int" << "long" << "mutable"
-              << "register" << "short" << "signed" << "static" << "unsigned" << "void" << "volatile" << "uchar"
-              << "uint" << "int8_t" << "int16_t" << "int32_t" << "int64_t" << "uint8_t" << "uint16_t" << "uint32_t"
-              << "uint64_t" << "wchar_t";
+/**
+ * @brief SyntaxHighlighter::setDocument
+ * @param document - the document to highlight (may be NULL)
+ * @param language - the source language of the document
+ *
+ * Attach the highlighter to the document.  No blocks are highlighted until requested by SyntaxHighlighter::highlightVisibleBlocks;
+ * the remaining blocks are highlighted in idle time afterwards.  The document must not be modified while attached.
+ */
+void SyntaxHighlighter::setDocument(QTextDocument *document, Language language)
+{
+    m_idleTimer.stop();
 
-    QString dataTypePattern;
-    dataTypePattern.append("\\b(");
-    dataTypePattern.append(dataTypes.join("|"));
-    dataTypePattern.append(")\\b");
-    m_DataTypes.setPattern(dataTypePattern);
+    m_document = document;
+    m_language = language;
 
+    m_blockStates.clear();
+    m_highlighted.clear();
+    m_nextIdleBlock = 0;
+
+    if ( document ) {
+        m_highlighted.resize( document->blockCount() );
+    }
 }
 
+/**
+ * @brief SyntaxHighlighter::languageForFile
+ * @param filename - the source filename
+ * @return - the source language determined from the filename suffix
+ */
+SyntaxHighlighter::Language SyntaxHighlighter::languageForFile(const QString &filename)
+{
+    const QString suffix = QFileInfo( filename ).suffix().toLower();
+
+    if ( suffix == QStringLiteral("f") || suffix == QStringLiteral("for") || suffix == QStringLiteral("f77") || suffix == QStringLiteral("ftn") )
+        return Language_FortranFixedForm;
 
-void SyntaxHighlighter::highlightBlock(const QString &text)
+    if ( suffix == QStringLiteral("f90") || suffix == QStringLiteral("f95") || suffix == QStringLiteral("f03") || suffix == QStringLiteral("f08") )
+        return Language_FortranFreeForm;
+
+    return Language_C;
+}
+
+/**
+ * @brief SyntaxHighlighter::highlightVisibleBlocks
+ * @param firstVisibleBlock - the first block visible in the viewport
+ * @param visibleBlockCount - the number of blocks visible in the viewport
+ *
+ * Highlight the visible blocks, plus a margin above and below for scrolling, and start highlighting the remaining blocks in idle time.
+ */
+void SyntaxHighlighter::highlightVisibleBlocks(const QTextBlock &firstVisibleBlock, int visibleBlockCount)
 {
-    int index = text.indexOf(m_Keywords);
-    while (index >= 0) {
-        int length = m_Keywords.matchedLength();
-        setFormat(index, length, Qt::darkYellow);
-        index = text.indexOf(m_Keywords, index + length);
+    // applying formats triggers viewport updates which request highlighting again
+    if ( m_highlighting || m_document.isNull() || ! firstVisibleBlock.isValid() || firstVisibleBlock.document() != m_document )
+        return;
+
+    m_highlighting = true;
+
+    const int firstBlockNumber = qMax( 0, firstVisibleBlock.blockNumber() - VIEWPORT_MARGIN_BLOCKS );
+    const int lastBlockNumber = firstVisibleBlock.blockNumber() + visibleBlockCount + VIEWPORT_MARGIN_BLOCKS;
+
+    QTextBlock block = m_document->findBlockByNumber( firstBlockNumber );
+
+    while ( block.isValid() && block.blockNumber() <= lastBlockNumber ) {
+        highlightBlock( block );
+        block = block.next();
     }
 
-    index = text.indexOf(m_DataTypes);
-    while (index >= 0) {
-        int length = m_DataTypes.matchedLength();
-        setFormat(index, length, Qt::darkMagenta);
-        index = text.indexOf(m_DataTypes, index + length);
+    m_highlighting = false;
+
+    if ( m_nextIdleBlock < m_highlighted.size() && ! m_idleTimer.isActive() ) {
+        m_idleTimer.start();
     }
+}
 
-    static QRegExp mpiMethod("\\bMPI_\\w+\\b");
-    index = text.indexOf(mpiMethod);
-    while (index >= 0) {
-        int length = mpiMethod.matchedLength();
-        setFormat(index, length, Qt::red);
-        index = text.indexOf(mpiMethod, index + length);
+/**
+ * @brief SyntaxHighlighter::handleIdleTimeout
+ *
+ * Highlight the next blocks not yet highlighted for at most IDLE_SLICE_MSEC before returning to the event loop.
+ */
+void SyntaxHighlighter::handleIdleTimeout()
+{
+    if ( m_document.isNull() ) {
+        m_idleTimer.stop();
+        return;
     }
 
-    static QRegExp preprocessor("#\\s*\\w+\\b");
-    index = text.indexOf(preprocessor);
-    while (index >= 0) {
-        int length = preprocessor.matchedLength();
-        setFormat(index, length, Qt::darkBlue);
-        index = text.indexOf(preprocessor, index + length);
+    if ( m_highlighting )
+        return;
+
+    m_highlighting = true;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QTextBlock block = m_document->findBlockByNumber( m_nextIdleBlock );
+
+    while ( block.isValid() && timer.elapsed() < IDLE_SLICE_MSEC ) {
+        highlightBlock( block );
+        block = block.next();
+        ++m_nextIdleBlock;
+    }
+
+    m_highlighting = false;
+
+    if ( ! block.isValid() ) {
+        m_idleTimer.stop();
+    }
+}
+
+/**
+ * @brief SyntaxHighlighter::highlightBlock
+ * @param block - the block to highlight
+ *
+ * Lex the block and apply the formats to the block layout, if not highlighted already.
+ */
+void SyntaxHighlighter::highlightBlock(const QTextBlock &block)
+{
+    const int blockNumber = block.blockNumber();
+
+    if ( blockNumber >= m_highlighted.size() || m_highlighted.testBit( blockNumber ) )
+        return;
+
+    ensureBlockStates( blockNumber );
+
+    const int previousState = ( blockNumber > 0 ) ? m_blockStates[ blockNumber - 1 ] : State_NormalState;
+
+    FormatRanges formats;
+
+    const int state = lexBlock( block.text(), previousState, &formats );
+
+    if ( blockNumber == m_blockStates.size() )
+        m_blockStates << state;
+
+    m_highlighted.setBit( blockNumber );
+
+    if ( formats.isEmpty() )
+        return;
+
+    QTextLayout* layout = block.layout();
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 6, 0))
+    layout->setFormats( formats );
+#else
+    layout->setAdditionalFormats( formats.toList() );
+#endif
+    m_document->markContentsDirty( block.position(), block.length() );
+}
+
+/**
+ * @brief SyntaxHighlighter::ensureBlockStates
+ * @param blockNumber - the block number
+ *
+ * Make sure the lexer end states of all blocks preceding the block are known.  Blocks not yet lexed are lexed without producing
+ * formats, which is cheap compared to highlighting them.
+ */
+void SyntaxHighlighter::ensureBlockStates(int blockNumber)
+{
+    if ( m_blockStates.size() >= blockNumber )
+        return;
+
+    QTextBlock block = m_document->findBlockByNumber( m_blockStates.size() );
+
+    while ( block.isValid() && m_blockStates.size() < blockNumber ) {
+        const int previousState = m_blockStates.isEmpty() ? State_NormalState : m_blockStates.last();
+        m_blockStates << lexBlock( block.text(), previousState, Q_NULLPTR );
+        block = block.next();
+    }
+}
+
+/**
+ * @brief SyntaxHighlighter::lexBlock
+ * @param text - the text of the block
+ * @param state - the lexer state at the end of the previous block
+ * @param formats - the formats produced for the block (NULL if only the state is needed)
+ * @return - the lexer state at the end of the block
+ */
+int SyntaxHighlighter::lexBlock(const QString &text, int state, FormatRanges *formats) const
+{
+    if ( Language_C == m_language )
+        return lexC( text, state, formats );
+
+    return lexFortran( text, formats );
+}
+
+/**
+ * @brief SyntaxHighlighter::lexC
+ * @param text - the text of the block
+ * @param state - the lexer state at the end of the previous block
+ * @param formats - the formats produced for the block (NULL if only the state is needed)
+ * @return - the lexer state at the end of the block
+ *
+ * Single-pass lexer for C/C++ source.
+ */
+int SyntaxHighlighter::lexC(const QString &text, int state, FormatRanges *formats) const
+{
+    const QChar* data = text.constData();
+    const int length = text.length();
+
+    int i = 0;
+
+    if ( State_InsideComment == state ) {
+        const int end = text.indexOf( QStringLiteral("*/") );
+        if ( end < 0 ) {
+            addFormat( formats, 0, length, Category_Comment );
+            return State_InsideComment;
+        }
+        i = end + 2;
+        addFormat( formats, 0, i, Category_Comment );
     }
 
-    static QRegExp quote("(\".*\")|('.')|(<\\s*[\\w\\.]+\\s*>)");
-    index = text.indexOf(quote);
-    while (index >= 0) {
-        int length = quote.matchedLength();
-        setFormat(index, length, Qt::darkGreen);
-        index = text.indexOf(quote, index + length);
+    // in state-only mode only comment delimiters, quotes and line comments matter
+    const bool wantFormats = ( formats != Q_NULLPTR );
+
+    bool includeDirective( false );
+
+    // preprocessor directive
+    int j = i;
+    while ( j < length && data[j].isSpace() )
+        ++j;
+    if ( j < length && data[j] == QLatin1Char('#') ) {
+        int k = j + 1;
+        while ( k < length && data[k].isSpace() )
+            ++k;
+        const int wordStart = k;
+        while ( k < length && isIdentifierPart( data[k] ) )
+            ++k;
+        const QString directive = QString::fromRawData( data + wordStart, k - wordStart );
+        includeDirective = ( directive == QStringLiteral("include") || directive == QStringLiteral("import") );
+        addFormat( formats, j, k - j, Category_Preprocessor );
+        i = k;
     }
 
-    static QRegExp oneLineComment("(//.*$)");
-    index = text.indexOf(oneLineComment);
-    while (index >= 0) {
-        int length = oneLineComment.matchedLength();
-        setFormat(index, length, Qt::darkGreen);
-        index = text.indexOf(oneLineComment, index + length);
+    const KeywordTable& table = cKeywordTable();
+
+    while ( i < length ) {
+        const QChar c = data[i];
+        const QChar next = ( i + 1 < length ) ? data[i+1] : QChar();
+
+        if ( c == QLatin1Char('/') && next == QLatin1Char('/') ) {
+            addFormat( formats, i, length - i, Category_Comment );
+            break;
+        }
+
+        if ( c == QLatin1Char('/') && next == QLatin1Char('*') ) {
+            const int end = text.indexOf( QStringLiteral("*/"), i + 2 );
+            if ( end < 0 ) {
+                addFormat( formats, i, length - i, Category_Comment );
+                return State_InsideComment;
+            }
+            addFormat( formats, i, end + 2 - i, Category_Comment );
+            i = end + 2;
+            continue;
+        }
+
+        if ( c == QLatin1Char('"') || c == QLatin1Char('\'') ) {
+            int end = i + 1;
+            while ( end < length && data[end] != c ) {
+                if ( data[end] == QLatin1Char('\\') )
+                    ++end;
+                ++end;
+            }
+            end = qMin( end + 1, length );
+            addFormat( formats, i, end - i, Category_Quote );
+            i = end;
+            continue;
+        }
+
+        if ( includeDirective && c == QLatin1Char('<') ) {
+            const int end = text.indexOf( QLatin1Char('>'), i + 1 );
+            if ( end > 0 ) {
+                addFormat( formats, i, end + 1 - i, Category_Quote );
+                i = end + 1;
+                continue;
+            }
+        }
+
+        if ( isIdentifierStart( c ) ) {
+            int end = i + 1;
+            while ( end < length && isIdentifierPart( data[end] ) )
+                ++end;
+            if ( wantFormats ) {
+                const int category = table.lookup( data + i, end - i );
+                if ( category >= 0 )
+                    addFormat( formats, i, end - i, category ? Category_Keyword : Category_DataType );
+                else if ( isMPIName( data + i, end - i, false ) )
+                    addFormat( formats, i, end - i, Category_MPI );
+            }
+            i = end;
+            continue;
+        }
+
+        if ( c.isDigit() ) {
+            // skip the whole numeric literal so suffixes aren't taken for identifiers
+            ++i;
+            while ( i < length && ( isIdentifierPart( data[i] ) || data[i] == QLatin1Char('.') ) )
+                ++i;
+            continue;
+        }
+
+        ++i;
     }
 
-    /* Multi-line comments */
-    static QRegExp startExpression("/\\*");
-    static QRegExp endExpression("\\*/");
+    return State_NormalState;
+}
+
+/**
+ * @brief SyntaxHighlighter::lexFortran
+ * @param text - the text of the block
+ * @param formats - the formats produced for the block (NULL if only the state is needed)
+ * @return - the lexer state at the end of the block
+ *
+ * Single-pass lexer for fixed and free form Fortran source.  Fortran has no multi-line comments, so no state is carried between blocks.
+ */
+int SyntaxHighlighter::lexFortran(const QString &text, FormatRanges *formats) const
+{
+    if ( Q_NULLPTR == formats )
+        return State_NormalState;
 
-    setCurrentBlockState(0);
+    const QChar* data = text.constData();
+    const int length = text.length();
 
-    int startIndex = 0;
-    if(previousBlockState() != 1) {
-        startIndex = text.indexOf(startExpression);
+    if ( 0 == length )
+        return State_NormalState;
+
+    // fixed form comment line
+    if ( Language_FortranFixedForm == m_language ) {
+        const QChar c = data[0];
+        if ( c == QLatin1Char('c') || c == QLatin1Char('C') || c == QLatin1Char('*') || c == QLatin1Char('!') ) {
+            addFormat( formats, 0, length, Category_Comment );
+            return State_NormalState;
+        }
     }
 
-    while(startIndex >= 0) {
-       int endIndex = text.indexOf(endExpression, startIndex);
-       int commentLength;
-       if(endIndex == -1) {
-           setCurrentBlockState(1);
-           commentLength = text.length() - startIndex;
-       } else {
-           commentLength = endIndex - startIndex + endExpression.matchedLength();
-       }
-       setFormat(startIndex, commentLength, Qt::darkGreen);
-       startIndex = text.indexOf(startExpression, startIndex + commentLength);
+    int i = 0;
+
+    // preprocessor directive (.F and .F90 sources)
+    if ( data[0] == QLatin1Char('#') ) {
+        int k = 1;
+        while ( k < length && isIdentifierPart( data[k] ) )
+            ++k;
+        addFormat( formats, 0, k, Category_Preprocessor );
+        i = k;
     }
+
+    const KeywordTable& table = fortranKeywordTable();
+
+    while ( i < length ) {
+        const QChar c = data[i];
+
+        if ( c == QLatin1Char('!') ) {
+            addFormat( formats, i, length - i, Category_Comment );
+            break;
+        }
+
+        if ( c == QLatin1Char('"') || c == QLatin1Char('\'') ) {
+            int end = text.indexOf( c, i + 1 );
+            end = ( end < 0 ) ? length : end + 1;
+            addFormat( formats, i, end - i, Category_Quote );
+            i = end;
+            continue;
+        }
+
+        if ( isIdentifierStart( c ) ) {
+            int end = i + 1;
+            while ( end < length && isIdentifierPart( data[end] ) )
+                ++end;
+            const int category = table.lookup( data + i, end - i );
+            if ( category >= 0 )
+                addFormat( formats, i, end - i, category ? Category_Keyword : Category_DataType );
+            else if ( isMPIName( data + i, end - i, true ) )
+                addFormat( formats, i, end - i, Category_MPI );
+            i = end;
+            continue;
+        }
+
+        if ( c.isDigit() ) {
+            ++i;
+            while ( i < length && ( isIdentifierPart( data[i] ) || data[i] == QLatin1Char('.') ) )
+                ++i;
+            continue;
+        }
+
+        ++i;
+    }
+
+    return State_NormalState;
+}
+
+/**
+ * @brief SyntaxHighlighter::addFormat
+ * @param formats - the formats of the block (NULL if only the state is needed)
+ * @param start - the start of the range
+ * @param length - the length of the range
+ * @param category - the highlighting category of the range
+ */
+void SyntaxHighlighter::addFormat(FormatRanges *formats, int start, int length, Category category) const
+{
+    if ( Q_NULLPTR == formats || length <= 0 )
+        return;
+
+    QTextLayout::FormatRange range;
+    range.start = start;
+    range.length = length;
+    range.format = m_formats[ category ];
+
+    formats->append( range );
 }
 
 
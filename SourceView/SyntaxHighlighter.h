@@ -24,7 +24,14 @@
 #ifndef PLUGINS_SOURCEVIEW_SYNTAXHIGHLIGHTER_H
 #define PLUGINS_SOURCEVIEW_SYNTAXHIGHLIGHTER_H
 
-#include <QSyntaxHighlighter>
+#include <QObject>
+#include <QPointer>
+#include <QTextCharFormat>
+#include <QTextLayout>
+#include <QTextBlock>
+#include <QBitArray>
+#include <QVector>
+#include <QTimer>
 
 #include "common/openss-gui-config.h"
 
@@ -32,31 +39,80 @@ class QTextDocument;
 
 namespace ArgoNavis { namespace GUI {
 
-class SyntaxHighlighter : public QSyntaxHighlighter
+/*!
+ * \brief The SyntaxHighlighter class
+ *
+ * Highlights C/C++ and Fortran source documents displayed by the SourceView using a single-pass lexer.  Unlike QSyntaxHighlighter,
+ * which highlights the entire document as soon as it is set, only the blocks near the viewport are highlighted on request and the
+ * remaining blocks are highlighted in short slices while the event loop is idle.
+ */
+
+class SyntaxHighlighter : public QObject
 {
     Q_OBJECT
 
 public:
 
-    explicit SyntaxHighlighter(QTextDocument *parent);
+    enum Language {
+        Language_C,
+        Language_FortranFixedForm,
+        Language_FortranFreeForm
+    };
+
+    explicit SyntaxHighlighter(QObject *parent = 0);
 
     void init();
 
-    void highlightBlock(const QString &text) Q_DECL_OVERRIDE;
+    void setDocument(QTextDocument* document, Language language = Language_C);
 
-private:
+    static Language languageForFile(const QString& filename);
+
+    void highlightVisibleBlocks(const QTextBlock& firstVisibleBlock, int visibleBlockCount);
+
+private slots:
 
-    QRegExp m_Keywords;
-    QRegExp m_DataTypes;
+    void handleIdleTimeout();
+
+private:
 
     enum States {
-        State_NormalState = -1,
-        State_InsideComment,
-        State_InsideDoubleQuote,
-        State_InsideSingleQuote,
-        State_InsideAngleBracketQuote
+        State_NormalState = 0,
+        State_InsideComment
     };
 
+    enum Category {
+        Category_Keyword,
+        Category_DataType,
+        Category_MPI,
+        Category_Preprocessor,
+        Category_Quote,
+        Category_Comment,
+        Category_None
+    };
+
+    typedef QVector< QTextLayout::FormatRange > FormatRanges;
+
+    void highlightBlock(const QTextBlock& block);
+    void ensureBlockStates(int blockNumber);
+
+    int lexBlock(const QString &text, int state, FormatRanges* formats) const;
+    int lexC(const QString &text, int state, FormatRanges* formats) const;
+    int lexFortran(const QString &text, FormatRanges* formats) const;
+
+    void addFormat(FormatRanges* formats, int start, int length, Category category) const;
+
+    QPointer< QTextDocument > m_document;
+    Language m_language;
+
+    QTextCharFormat m_formats[ Category_None ];
+
+    QVector< int > m_blockStates;       // lexer state at the end of each block [ 0, m_blockStates.size() )
+    QBitArray m_highlighted;            // blocks that have been highlighted
+    int m_nextIdleBlock;                // next block to be highlighted in idle time
+    bool m_highlighting;                // guards against re-entry from viewport updates
+
+    QTimer m_idleTimer;
+
 };
 
 } // GUI
@@ -0,0 +1,275 @@
+/*!
+   \file OSSDecimatedSeries.cpp
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "OSSDecimatedSeries.h"
+
+#include <algorithm>
+#include <vector>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+// at most this many points per pixel are passed to the graph without decimation
+const int MAX_POINTS_PER_PIXEL = 4;
+
+
+/**
+ * @brief OSSDecimatedSeries::OSSDecimatedSeries
+ *
+ * Constructs an empty OSSDecimatedSeries instance.
+ */
+OSSDecimatedSeries::OSSDecimatedSeries()
+    : m_sorted( true )
+    , m_modified( false )
+    , m_pixelWidth( 0 )
+{
+
+}
+
+/**
+ * @brief OSSDecimatedSeries::setData
+ * @param keys - the keys (times) of the points
+ * @param values - the values of the points
+ *
+ * Replaces the raw points.  The points need not be in key order.
+ */
+void OSSDecimatedSeries::setData(const QVector<double> &keys, const QVector<double> &values)
+{
+    m_keys = keys;
+    m_values = values;
+
+    m_sorted = std::is_sorted( m_keys.constBegin(), m_keys.constEnd() );
+    m_modified = true;
+}
+
+/**
+ * @brief OSSDecimatedSeries::addData
+ * @param key - the key (time) of the point
+ * @param value - the value of the point
+ *
+ * Appends the point to the raw points.  Points normally arrive in key order; otherwise the raw points are sorted at the next graph update.
+ */
+void OSSDecimatedSeries::addData(double key, double value)
+{
+    if ( ! m_keys.isEmpty() && key < m_keys.last() )
+        m_sorted = false;
+
+    m_keys.append( key );
+    m_values.append( value );
+
+    m_modified = true;
+}
+
+/**
+ * @brief OSSDecimatedSeries::clear
+ *
+ * Removes all raw points.
+ */
+void OSSDecimatedSeries::clear()
+{
+    m_keys.clear();
+    m_values.clear();
+
+    m_sorted = true;
+    m_modified = true;
+}
+
+/**
+ * @brief OSSDecimatedSeries::size
+ * @return - the number of raw points
+ */
+int OSSDecimatedSeries::size() const
+{
+    return m_keys.size();
+}
+
+/**
+ * @brief OSSDecimatedSeries::keys
+ * @return - the keys of the raw points
+ */
+const QVector< double >& OSSDecimatedSeries::keys() const
+{
+    return m_keys;
+}
+
+/**
+ * @brief OSSDecimatedSeries::values
+ * @return - the values of the raw points
+ */
+const QVector< double >& OSSDecimatedSeries::values() const
+{
+    return m_values;
+}
+
+/**
+ * @brief OSSDecimatedSeries::updateGraph
+ * @param graph - the graph drawing the series
+ * @param keyRange - the visible key range
+ * @param pixelWidth - the width of the visible key range in pixels
+ * @return - whether the data of the graph was replaced
+ *
+ * Replaces the data of the graph with the decimated raw points if the key range, the pixel width or the raw points changed since the last update.
+ */
+bool OSSDecimatedSeries::updateGraph(QCPGraph *graph, const QCPRange &keyRange, int pixelWidth)
+{
+    if ( Q_NULLPTR == graph )
+        return false;
+
+    if ( ! m_modified && pixelWidth == m_pixelWidth && keyRange.lower == m_keyRange.lower && keyRange.upper == m_keyRange.upper )
+        return false;
+
+    if ( ! m_sorted )
+        sort();
+
+    QVector< double > keys;
+    QVector< double > values;
+
+    decimate( keyRange, pixelWidth, keys, values );
+
+#if defined(HAS_QCUSTOMPLOT_V2)
+    graph->setData( keys, values, true );
+#else
+    graph->setData( keys, values );
+#endif
+
+    m_keyRange = keyRange;
+    m_pixelWidth = pixelWidth;
+    m_modified = false;
+
+    return true;
+}
+
+/**
+ * @brief OSSDecimatedSeries::sort
+ *
+ * Orders the raw points by key.
+ */
+void OSSDecimatedSeries::sort()
+{
+    std::vector< int > order( m_keys.size() );
+    for ( std::size_t i=0; i<order.size(); ++i )
+        order[ i ] = i;
+
+    const QVector< double >& keys( m_keys );
+
+    std::stable_sort( order.begin(), order.end(), [&keys](int lhs, int rhs) {
+        return keys[ lhs ] < keys[ rhs ];
+    } );
+
+    QVector< double > sortedKeys( order.size() );
+    QVector< double > sortedValues( order.size() );
+
+    for ( std::size_t i=0; i<order.size(); ++i ) {
+        sortedKeys[ i ] = m_keys[ order[ i ] ];
+        sortedValues[ i ] = m_values[ order[ i ] ];
+    }
+
+    m_keys.swap( sortedKeys );
+    m_values.swap( sortedValues );
+
+    m_sorted = true;
+}
+
+/**
+ * @brief OSSDecimatedSeries::decimate
+ * @param keyRange - the visible key range
+ * @param pixelWidth - the width of the visible key range in pixels
+ * @param keys - the keys of the decimated points
+ * @param values - the values of the decimated points
+ *
+ * Reduces the raw points within the visible key range to the first, minimum, maximum and last point of each pixel column, in key order.
+ * The nearest raw point on either side of the visible range is kept so the line enters and leaves the axis rect at the same slope.
+ * If there are only a few points per pixel, the raw points are passed through unchanged.
+ */
+void OSSDecimatedSeries::decimate(const QCPRange &keyRange, int pixelWidth, QVector<double> &keys, QVector<double> &values) const
+{
+    const int count = m_keys.size();
+
+    const double* rawKeys = m_keys.constData();
+    const double* rawValues = m_values.constData();
+
+    int first = std::lower_bound( rawKeys, rawKeys + count, keyRange.lower ) - rawKeys;
+    int last = std::upper_bound( rawKeys, rawKeys + count, keyRange.upper ) - rawKeys;
+
+    if ( first > 0 )
+        --first;
+    if ( last < count )
+        ++last;
+
+    if ( pixelWidth <= 0 || keyRange.size() <= 0.0 || last - first <= MAX_POINTS_PER_PIXEL * pixelWidth ) {
+        keys = m_keys.mid( first, last - first );
+        values = m_values.mid( first, last - first );
+        return;
+    }
+
+    keys.reserve( MAX_POINTS_PER_PIXEL * pixelWidth + 2 );
+    values.reserve( MAX_POINTS_PER_PIXEL * pixelWidth + 2 );
+
+    const double pixelsPerKey = pixelWidth / keyRange.size();
+
+    int i = first;
+
+    while ( i < last ) {
+        // the points adjacent to the visible range are passed through
+        if ( rawKeys[ i ] < keyRange.lower || rawKeys[ i ] > keyRange.upper ) {
+            keys.append( rawKeys[ i ] );
+            values.append( rawValues[ i ] );
+            ++i;
+            continue;
+        }
+
+        const int column = qMin( pixelWidth - 1, static_cast< int >( ( rawKeys[ i ] - keyRange.lower ) * pixelsPerKey ) );
+
+        int minIndex( i );
+        int maxIndex( i );
+        int j( i + 1 );
+
+        for ( ; j < last && rawKeys[ j ] <= keyRange.upper; ++j ) {
+            if ( qMin( pixelWidth - 1, static_cast< int >( ( rawKeys[ j ] - keyRange.lower ) * pixelsPerKey ) ) != column )
+                break;
+            if ( rawValues[ j ] < rawValues[ minIndex ] )
+                minIndex = j;
+            if ( rawValues[ j ] > rawValues[ maxIndex ] )
+                maxIndex = j;
+        }
+
+        // the first, minimum, maximum and last points of the column in key order
+        const int indices[] = { i, qMin( minIndex, maxIndex ), qMax( minIndex, maxIndex ), j - 1 };
+
+        int previous( -1 );
+        for ( int n=0; n<4; ++n ) {
+            if ( indices[ n ] != previous ) {
+                keys.append( rawKeys[ indices[ n ] ] );
+                values.append( rawValues[ indices[ n ] ] );
+                previous = indices[ n ];
+            }
+        }
+
+        i = j;
+    }
+}
+
+
+} // GUI
+} // ArgoNavis
@@ -0,0 +1,82 @@
+/*!
+   \file OSSDecimatedSeries.h
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OSSDECIMATEDSERIES_H
+#define OSSDECIMATEDSERIES_H
+
+#include "qcustomplot.h"
+
+#include "common/openss-gui-config.h"
+
+#include <QVector>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/*!
+ * \brief The OSSDecimatedSeries class
+ *
+ * The raw points of a line graph kept in contiguous key and value arrays.  Rather than handing every raw point to the QCPGraph, the
+ * graph is given the first, minimum, maximum and last point of each horizontal pixel of the visible key range, which draws the same
+ * line as the raw points.  The decimated data is recomputed only when the key range, the pixel width or the raw points change.
+ */
+
+class OSSDecimatedSeries
+{
+public:
+
+    OSSDecimatedSeries();
+
+    void setData(const QVector< double >& keys, const QVector< double >& values);
+    void addData(double key, double value);
+    void clear();
+
+    int size() const;
+    const QVector< double >& keys() const;
+    const QVector< double >& values() const;
+
+    bool updateGraph(QCPGraph* graph, const QCPRange& keyRange, int pixelWidth);
+
+private:
+
+    void sort();
+    void decimate(const QCPRange& keyRange, int pixelWidth, QVector< double >& keys, QVector< double >& values) const;
+
+    // the raw points
+    QVector< double > m_keys;
+    QVector< double > m_values;
+    bool m_sorted;
+
+    // the state of the last decimation
+    bool m_modified;
+    QCPRange m_keyRange;
+    int m_pixelWidth;
+
+};
+
+
+} // GUI
+} // ArgoNavis
+
+#endif // OSSDECIMATEDSERIES_H
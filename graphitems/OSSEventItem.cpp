@@ -106,6 +106,24 @@ void OSSEventItem::draw(QCPPainter *painter)
     }
 }
 
+/**
+ * @brief OSSEventItem::selectTest
+ * @param pos - the position in pixels
+ * @param onlySelectable - whether only a selectable item may be hit
+ * @param details - the details of the hit
+ * @return - always -1 as the item is found by the interval index of the timeline view
+ *
+ * Reimplements the QCPItemRect::selectTest method so QCustomPlot does not test each item on every mouse event.
+ */
+double OSSEventItem::selectTest(const QPointF &pos, bool onlySelectable, QVariant *details) const
+{
+    Q_UNUSED( pos )
+    Q_UNUSED( onlySelectable )
+    Q_UNUSED( details )
+
+    return -1.0;
+}
+
 
 } // GUI
 } // ArgoNavis
@@ -45,6 +45,8 @@ public:
 
     void setBrush(const QColor& color);
 
+    virtual double selectTest(const QPointF &pos, bool onlySelectable, QVariant *details = 0) const Q_DECL_OVERRIDE;
+
 protected:
 
     virtual void draw(QCPPainter *painter) Q_DECL_OVERRIDE;
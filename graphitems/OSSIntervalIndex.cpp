@@ -0,0 +1,281 @@
+/*!
+   \file OSSIntervalIndex.cpp
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "OSSIntervalIndex.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/**
+ * @brief OSSIntervalIndex::OSSIntervalIndex
+ *
+ * Constructs an empty OSSIntervalIndex instance.
+ */
+OSSIntervalIndex::OSSIntervalIndex()
+{
+
+}
+
+/**
+ * @brief OSSIntervalIndex::insert
+ * @param lane - the lane of the interval
+ * @param begin - the begin time of the interval
+ * @param end - the end time of the interval
+ * @param payload - the caller defined payload of the interval
+ *
+ * Adds the interval to the pending intervals of the lane.  The interval is found by the queries after the next call to finalize().
+ */
+void OSSIntervalIndex::insert(int lane, double begin, double end, quint32 payload)
+{
+    Lane& intervals = m_pending[ lane ];
+
+    intervals.begins.append( begin );
+    intervals.ends.append( end );
+    intervals.payloads.append( payload );
+}
+
+/**
+ * @brief OSSIntervalIndex::finalize
+ *
+ * Appends the pending intervals to their lanes.  Intervals normally arrive in time order, so the running maximum of the end times is
+ * extended; otherwise the lane is sorted.  The interval tree of each lane having pending intervals is rebuilt.
+ */
+void OSSIntervalIndex::finalize()
+{
+    for ( QMap< int, Lane >::const_iterator iter = m_pending.constBegin(); iter != m_pending.constEnd(); ++iter ) {
+        const Lane& pending = iter.value();
+        Lane& intervals = m_lanes[ iter.key() ];
+
+        for ( int i=0; i<pending.begins.size(); ++i ) {
+            if ( ! intervals.begins.isEmpty() && pending.begins[ i ] < intervals.begins.last() )
+                intervals.sorted = false;
+
+            if ( intervals.sorted )
+                intervals.maxEnds.append( intervals.maxEnds.isEmpty() ? pending.ends[ i ] : qMax( intervals.maxEnds.last(), pending.ends[ i ] ) );
+
+            intervals.begins.append( pending.begins[ i ] );
+            intervals.ends.append( pending.ends[ i ] );
+            intervals.payloads.append( pending.payloads[ i ] );
+        }
+
+        if ( ! intervals.sorted )
+            sortLane( intervals );
+
+        buildTree( intervals );
+    }
+
+    m_pending.clear();
+}
+
+/**
+ * @brief OSSIntervalIndex::clear
+ *
+ * Removes all intervals.
+ */
+void OSSIntervalIndex::clear()
+{
+    m_lanes.clear();
+    m_pending.clear();
+}
+
+/**
+ * @brief OSSIntervalIndex::isEmpty
+ * @return - whether the index has no finalized intervals
+ */
+bool OSSIntervalIndex::isEmpty() const
+{
+    return m_lanes.isEmpty();
+}
+
+/**
+ * @brief OSSIntervalIndex::lanes
+ * @return - the lanes having finalized intervals in ascending order
+ */
+QList< int > OSSIntervalIndex::lanes() const
+{
+    return m_lanes.keys();
+}
+
+/**
+ * @brief OSSIntervalIndex::lane
+ * @param lane - the lane
+ * @return - the finalized intervals of the lane sorted by begin time
+ */
+const OSSIntervalIndex::Lane& OSSIntervalIndex::lane(int lane) const
+{
+    static const Lane s_emptyLane;
+
+    QMap< int, Lane >::const_iterator iter = m_lanes.constFind( lane );
+
+    if ( iter == m_lanes.constEnd() )
+        return s_emptyLane;
+
+    return iter.value();
+}
+
+/**
+ * @brief OSSIntervalIndex::findRange
+ * @param lane - the lane
+ * @param lower - the lower bound of the time range
+ * @param upper - the upper bound of the time range
+ * @param first - set to the index of the first interval which may intersect the time range
+ * @param last - set to one past the index of the last interval which may intersect the time range
+ *
+ * Finds the range of intervals [first, last) of the lane which contains all the intervals intersecting the time range.  As intervals of
+ * the lane may overlap, an interval in the range may still end before the lower bound of the time range.
+ */
+void OSSIntervalIndex::findRange(int lane, double lower, double upper, int &first, int &last) const
+{
+    const Lane& intervals = this->lane( lane );
+
+    const int count = intervals.begins.size();
+
+    const double* maxEnds = intervals.maxEnds.constData();
+    const double* begins = intervals.begins.constData();
+
+    first = std::lower_bound( maxEnds, maxEnds + count, lower ) - maxEnds;
+    last = std::upper_bound( begins, begins + count, upper ) - begins;
+}
+
+/**
+ * @brief OSSIntervalIndex::find
+ * @param lane - the lane
+ * @param lower - the lower bound of the time range
+ * @param upper - the upper bound of the time range
+ * @return - the index in the lane of the interval intersecting the time range with the latest begin time or -1 if none
+ *
+ * Finds the innermost interval at a position.  The range is normally the time at the position widened by a pixel tolerance.
+ */
+int OSSIntervalIndex::find(int lane, double lower, double upper) const
+{
+    const Lane& intervals = this->lane( lane );
+
+    const int last = std::upper_bound( intervals.begins.constBegin(), intervals.begins.constEnd(), upper ) - intervals.begins.constBegin();
+
+    if ( 0 == last )
+        return -1;
+
+    return findLast( intervals, 1, 0, intervals.leafCount, last, lower );
+}
+
+/**
+ * @brief OSSIntervalIndex::findLast
+ * @param lane - the lane
+ * @param node - the interval tree node
+ * @param nodeBegin - the index of the first interval of the node's subtree
+ * @param nodeEnd - one past the index of the last interval of the node's subtree
+ * @param last - one past the index of the last interval to consider
+ * @param lower - the lower bound of the time range
+ * @return - the index of the last interval before 'last' in the node's subtree which ends at or after 'lower' or -1 if none
+ *
+ * Subtrees whose maximum end time is less than 'lower' are skipped, and the right subtree is searched before the left one.  Only the
+ * subtrees along the path to 'last' are partially covered, so the search visits a logarithmic number of nodes.
+ */
+int OSSIntervalIndex::findLast(const Lane &lane, int node, int nodeBegin, int nodeEnd, int last, double lower) const
+{
+    if ( nodeBegin >= last || lane.subtreeMaxEnds[ node ] < lower )
+        return -1;
+
+    if ( nodeEnd - nodeBegin == 1 )
+        return nodeBegin;
+
+    const int middle = nodeBegin + ( nodeEnd - nodeBegin ) / 2;
+
+    const int index = findLast( lane, 2 * node + 1, middle, nodeEnd, last, lower );
+
+    return ( index >= 0 ) ? index : findLast( lane, 2 * node, nodeBegin, middle, last, lower );
+}
+
+/**
+ * @brief OSSIntervalIndex::sortLane
+ * @param lane - the lane to sort
+ *
+ * Orders the intervals of the lane by begin time and computes the running maximum of the end times.
+ */
+void OSSIntervalIndex::sortLane(Lane &lane)
+{
+    std::vector< int > order( lane.begins.size() );
+    for ( std::size_t i=0; i<order.size(); ++i )
+        order[ i ] = i;
+
+    const QVector< double >& begins( lane.begins );
+
+    std::stable_sort( order.begin(), order.end(), [&begins](int lhs, int rhs) {
+        return begins[ lhs ] < begins[ rhs ];
+    } );
+
+    QVector< double > sortedBegins( order.size() );
+    QVector< double > sortedEnds( order.size() );
+    QVector< double > maxEnds( order.size() );
+    QVector< quint32 > sortedPayloads( order.size() );
+
+    for ( std::size_t i=0; i<order.size(); ++i ) {
+        sortedBegins[ i ] = lane.begins[ order[ i ] ];
+        sortedEnds[ i ] = lane.ends[ order[ i ] ];
+        sortedPayloads[ i ] = lane.payloads[ order[ i ] ];
+        maxEnds[ i ] = ( 0 == i ) ? sortedEnds[ i ] : qMax( maxEnds[ i-1 ], sortedEnds[ i ] );
+    }
+
+    lane.begins.swap( sortedBegins );
+    lane.ends.swap( sortedEnds );
+    lane.maxEnds.swap( maxEnds );
+    lane.payloads.swap( sortedPayloads );
+
+    lane.sorted = true;
+}
+
+/**
+ * @brief OSSIntervalIndex::buildTree
+ * @param lane - the sorted lane
+ *
+ * Builds the interval tree of the lane.  The tree is stored implicitly in an array: the leaves are the intervals in begin time order
+ * (padded to a power of two) and each inner node holds the maximum end time of its subtree.
+ */
+void OSSIntervalIndex::buildTree(Lane &lane)
+{
+    const int count = lane.ends.size();
+
+    int leafCount( 1 );
+    while ( leafCount < count )
+        leafCount *= 2;
+
+    QVector< double > subtreeMaxEnds( 2 * leafCount, -std::numeric_limits< double >::infinity() );
+
+    for ( int i=0; i<count; ++i )
+        subtreeMaxEnds[ leafCount + i ] = lane.ends[ i ];
+
+    for ( int node=leafCount-1; node>0; --node )
+        subtreeMaxEnds[ node ] = qMax( subtreeMaxEnds[ 2 * node ], subtreeMaxEnds[ 2 * node + 1 ] );
+
+    lane.subtreeMaxEnds.swap( subtreeMaxEnds );
+    lane.leafCount = leafCount;
+}
+
+
+} // GUI
+} // ArgoNavis
@@ -0,0 +1,96 @@
+/*!
+   \file OSSIntervalIndex.h
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OSSINTERVALINDEX_H
+#define OSSINTERVALINDEX_H
+
+#include <QVector>
+#include <QMap>
+
+#include "common/openss-gui-config.h"
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/*!
+ * \brief The OSSIntervalIndex class
+ *
+ * An index of time intervals organized in lanes (for example the ranks of a trace timeline).  The intervals of each lane are kept in
+ * arrays sorted by begin time together with the running maximum of the end times, which is non-decreasing.  The first interval which
+ * may end inside a time range and the last interval beginning inside it are both found by binary search, so range queries take
+ * logarithmic time plus the number of intervals reported.  An implicit interval tree over the sorted intervals holds the maximum end
+ * time of each subtree, so a point lookup takes logarithmic time however many long intervals overlap the point.  Each interval carries
+ * a caller defined payload.
+ *
+ * Intervals may be inserted in any order.  Inserted intervals are held pending until finalize() is called, which sorts the lanes they
+ * were added to and rebuilds their interval trees, so the queries only read the index and never modify it.  Call finalize() once a batch
+ * of intervals has been loaded rather than after every insertion.  The index is not synchronized and is only used from the GUI thread.
+ */
+
+class OSSIntervalIndex
+{
+public:
+
+    // the intervals of one lane
+    struct Lane {
+        Lane() : sorted( true ), leafCount( 0 ) { }
+        QVector< double > begins;
+        QVector< double > ends;
+        QVector< double > maxEnds;      // maxEnds[i] is the maximum of ends[0..i]
+        QVector< quint32 > payloads;
+        bool sorted;
+        QVector< double > subtreeMaxEnds;   // the maximum end time of each subtree of the interval tree (node 1 is the root)
+        int leafCount;                      // the number of leaves of the interval tree (a power of two) or zero if not built
+    };
+
+    OSSIntervalIndex();
+
+    void insert(int lane, double begin, double end, quint32 payload);
+    void finalize();
+    void clear();
+
+    bool isEmpty() const;
+    QList< int > lanes() const;
+
+    const Lane& lane(int lane) const;
+
+    void findRange(int lane, double lower, double upper, int& first, int& last) const;
+    int find(int lane, double lower, double upper) const;
+
+private:
+
+    void sortLane(Lane& lane);
+    void buildTree(Lane& lane);
+    int findLast(const Lane& lane, int node, int nodeBegin, int nodeEnd, int last, double lower) const;
+
+    QMap< int, Lane > m_lanes;
+    QMap< int, Lane > m_pending;    // the intervals inserted since the last finalize()
+
+};
+
+
+} // GUI
+} // ArgoNavis
+
+#endif // OSSINTERVALINDEX_H
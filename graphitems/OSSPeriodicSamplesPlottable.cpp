@@ -0,0 +1,414 @@
+/*!
+   \file OSSPeriodicSamplesPlottable.cpp
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "OSSPeriodicSamplesPlottable.h"
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+// the color of the bars up to the maximum value of each pixel
+const QColor MAX_VALUE_COLOR = QColor( 140, 140, 140, 80 );
+
+// the color of the bars up to the mean value of each pixel
+const QColor MEAN_VALUE_COLOR = QColor( 140, 140, 140, 160 );
+
+
+/**
+ * @brief OSSPeriodicSamplesPlottable::OSSPeriodicSamplesPlottable
+ * @param keyAxis - the time axis
+ * @param valueAxis - the counter value axis
+ *
+ * Constructs an OSSPeriodicSamplesPlottable instance.
+ */
+OSSPeriodicSamplesPlottable::OSSPeriodicSamplesPlottable(QCPAxis *keyAxis, QCPAxis *valueAxis)
+    : QCPAbstractPlottable( keyAxis, valueAxis )
+    , m_sorted( true )
+    , m_maxValue( 0.0 )
+    , m_modified( false )
+    , m_pixelWidth( 0 )
+{
+    setName( QStringLiteral("Periodic Samples") );
+
+    // the individual samples are found by the timeline view, not by the QCustomPlot selection mechanism
+#if defined(HAS_QCUSTOMPLOT_V2)
+    setSelectable( QCP::stNone );
+#else
+    setSelectable( false );
+#endif
+
+    setAntialiasedFill( false );
+}
+
+/**
+ * @brief OSSPeriodicSamplesPlottable::~OSSPeriodicSamplesPlottable
+ *
+ * Destroys the OSSPeriodicSamplesPlottable instance.
+ */
+OSSPeriodicSamplesPlottable::~OSSPeriodicSamplesPlottable()
+{
+
+}
+
+/**
+ * @brief OSSPeriodicSamplesPlottable::addSamples
+ * @param timeBegins - the begin times of the sample periods
+ * @param timeEnds - the end times of the sample periods
+ * @param values - the counter values of the sample periods
+ *
+ * Appends the sample periods.  Samples normally arrive in time order; otherwise the samples are sorted at the next update.
+ */
+void OSSPeriodicSamplesPlottable::addSamples(const QVector<double> &timeBegins, const QVector<double> &timeEnds, const QVector<double> &values)
+{
+    if ( timeBegins.isEmpty() || timeBegins.size() != timeEnds.size() || timeBegins.size() != values.size() )
+        return;
+
+    if ( ! m_timeBegins.isEmpty() && timeBegins.first() < m_timeBegins.last() )
+        m_sorted = false;
+    if ( ! std::is_sorted( timeBegins.constBegin(), timeBegins.constEnd() ) )
+        m_sorted = false;
+
+    m_timeBegins += timeBegins;
+    m_timeEnds += timeEnds;
+    m_values += values;
+
+    m_maxValue = qMax( m_maxValue, *std::max_element( values.constBegin(), values.constEnd() ) );
+
+    m_modified = true;
+}
+
+/**
+ * @brief OSSPeriodicSamplesPlottable::findSample
+ * @param lower - the lower bound of the time range
+ * @param upper - the upper bound of the time range
+ * @return - the index of the first sample period intersecting the time range (or -1 if there is none)
+ *
+ * The sample periods of a counter do not overlap, so both the begin and end times are ordered and the sample is found by a binary search.
+ */
+int OSSPeriodicSamplesPlottable::findSample(double lower, double upper) const
+{
+    if ( ! m_sorted )
+        const_cast< OSSPeriodicSamplesPlottable* >( this )->sort();
+
+    const int i = std::lower_bound( m_timeEnds.constBegin(), m_timeEnds.constEnd(), lower ) - m_timeEnds.constBegin();
+
+    return ( i < m_timeBegins.size() && m_timeBegins[ i ] <= upper ) ? i : -1;
+}
+
+/**
+ * @brief OSSPeriodicSamplesPlottable::sampleCount
+ * @return - the number of sample periods
+ */
+int OSSPeriodicSamplesPlottable::sampleCount() const
+{
+    return m_values.size();
+}
+
+/**
+ * @brief OSSPeriodicSamplesPlottable::timeBegin
+ * @param i - the index of the sample period
+ * @return - the begin time of the sample period
+ */
+double OSSPeriodicSamplesPlottable::timeBegin(int i) const
+{
+    return m_timeBegins.value( i );
+}
+
+/**
+ * @brief OSSPeriodicSamplesPlottable::timeEnd
+ * @param i - the index of the sample period
+ * @return - the end time of the sample period
+ */
+double OSSPeriodicSamplesPlottable::timeEnd(int i) const
+{
+    return m_timeEnds.value( i );
+}
+
+/**
+ * @brief OSSPeriodicSamplesPlottable::value
+ * @param i - the index of the sample period
+ * @return - the counter value of the sample period
+ */
+double OSSPeriodicSamplesPlottable::value(int i) const
+{
+    return m_values.value( i );
+}
+
+/**
+ * @brief OSSPeriodicSamplesPlottable::clearData
+ *
+ * Removes all sample periods.
+ */
+void OSSPeriodicSamplesPlottable::clearData()
+{
+    m_timeBegins.clear();
+    m_timeEnds.clear();
+    m_values.clear();
+
+    m_sorted = true;
+    m_maxValue = 0.0;
+    m_modified = true;
+}
+
+/**
+ * @brief OSSPeriodicSamplesPlottable::sort
+ *
+ * Orders the sample periods by begin time.
+ */
+void OSSPeriodicSamplesPlottable::sort()
+{
+    std::vector< int > order( m_timeBegins.size() );
+    for ( std::size_t i=0; i<order.size(); ++i )
+        order[ i ] = i;
+
+    const QVector< double >& timeBegins( m_timeBegins );
+
+    std::stable_sort( order.begin(), order.end(), [&timeBegins](int lhs, int rhs) {
+        return timeBegins[ lhs ] < timeBegins[ rhs ];
+    } );
+
+    QVector< double > sortedBegins( order.size() );
+    QVector< double > sortedEnds( order.size() );
+    QVector< double > sortedValues( order.size() );
+
+    for ( std::size_t i=0; i<order.size(); ++i ) {
+        sortedBegins[ i ] = m_timeBegins[ order[ i ] ];
+        sortedEnds[ i ] = m_timeEnds[ order[ i ] ];
+        sortedValues[ i ] = m_values[ order[ i ] ];
+    }
+
+    m_timeBegins.swap( sortedBegins );
+    m_timeEnds.swap( sortedEnds );
+    m_values.swap( sortedValues );
+
+    m_sorted = true;
+}
+
+/**
+ * @brief OSSPeriodicSamplesPlottable::updateColumns
+ * @param keyRange - the visible time range
+ * @param pixelWidth - the width of the visible time range in pixels
+ *
+ * Computes the maximum and time-weighted mean value of the sample periods overlapping each pixel column of the visible time range.
+ * Only the sample periods intersecting the visible time range are visited and the column arrays are reused between updates.
+ */
+void OSSPeriodicSamplesPlottable::updateColumns(const QCPRange &keyRange, int pixelWidth)
+{
+    if ( ! m_sorted )
+        sort();
+
+    if ( m_columnMax.size() != pixelWidth ) {
+        m_columnMax.resize( pixelWidth );
+        m_columnMean.resize( pixelWidth );
+        m_columnWeight.resize( pixelWidth );
+    }
+
+    m_columnMax.fill( -1.0 );
+    m_columnMean.fill( 0.0 );
+    m_columnWeight.fill( 0.0 );
+
+    m_keyRange = keyRange;
+    m_pixelWidth = pixelWidth;
+    m_modified = false;
+
+    if ( pixelWidth <= 0 || keyRange.size() <= 0.0 )
+        return;
+
+    const int count = m_timeBegins.size();
+
+    const double* begins = m_timeBegins.constData();
+    const double* ends = m_timeEnds.constData();
+    const double* values = m_values.constData();
+
+    double* columnMax = m_columnMax.data();
+    double* columnSum = m_columnMean.data();
+    double* columnWeight = m_columnWeight.data();
+
+    const double pixelsPerKey = pixelWidth / keyRange.size();
+    const double keysPerPixel = keyRange.size() / pixelWidth;
+
+    const int first = std::lower_bound( ends, ends + count, keyRange.lower ) - ends;
+    const int last = std::upper_bound( begins, begins + count, keyRange.upper ) - begins;
+
+    for ( int i=first; i<last; ++i ) {
+        const int firstColumn = qBound( 0, static_cast< int >( std::floor( ( begins[ i ] - keyRange.lower ) * pixelsPerKey ) ), pixelWidth - 1 );
+        const int lastColumn = qBound( 0, static_cast< int >( std::floor( ( ends[ i ] - keyRange.lower ) * pixelsPerKey ) ), pixelWidth - 1 );
+
+        for ( int column=firstColumn; column<=lastColumn; ++column ) {
+            const double columnLower = keyRange.lower + column * keysPerPixel;
+            const double overlap = qMin( ends[ i ], columnLower + keysPerPixel ) - qMax( begins[ i ], columnLower );
+
+            // a period ending on the lower edge of a column does not reach into it
+            if ( overlap <= 0.0 && ends[ i ] > begins[ i ] )
+                continue;
+
+            columnMax[ column ] = qMax( columnMax[ column ], values[ i ] );
+
+            if ( overlap > 0.0 ) {
+                columnSum[ column ] += values[ i ] * overlap;
+                columnWeight[ column ] += overlap;
+            }
+        }
+    }
+
+    for ( int column=0; column<pixelWidth; ++column ) {
+        if ( columnWeight[ column ] > 0.0 )
+            columnSum[ column ] /= columnWeight[ column ];
+        else
+            columnSum[ column ] = qMax( 0.0, columnMax[ column ] );
+    }
+}
+
+/**
+ * @brief OSSPeriodicSamplesPlottable::draw
+ * @param painter - the painter used for drawing
+ *
+ * Draws a maximum and a mean value bar for each pixel column of the visible time range having samples.  Adjacent columns with the same
+ * values are drawn as a single rectangle.
+ */
+void OSSPeriodicSamplesPlottable::draw(QCPPainter *painter)
+{
+    QCPAxis* keyAxis = mKeyAxis.data();
+    QCPAxis* valueAxis = mValueAxis.data();
+
+    if ( ! keyAxis || ! valueAxis || m_values.isEmpty() )
+        return;
+
+    const QCPRange keyRange = keyAxis->range();
+    const int pixelWidth = keyAxis->axisRect()->width();
+
+    if ( m_modified || pixelWidth != m_pixelWidth || keyRange.lower != m_keyRange.lower || keyRange.upper != m_keyRange.upper )
+        updateColumns( keyRange, pixelWidth );
+
+    if ( pixelWidth <= 0 || keyRange.size() <= 0.0 )
+        return;
+
+    const double keysPerPixel = keyRange.size() / pixelWidth;
+    const double zero = valueAxis->coordToPixel( 0.0 );
+
+    int column = 0;
+
+    while ( column < pixelWidth ) {
+        const double maxValue = m_columnMax[ column ];
+        const double meanValue = m_columnMean[ column ];
+
+        int next = column + 1;
+        while ( next < pixelWidth && m_columnMax[ next ] == maxValue && m_columnMean[ next ] == meanValue )
+            ++next;
+
+        if ( maxValue > 0.0 ) {
+            double x1 = keyAxis->coordToPixel( keyRange.lower + column * keysPerPixel );
+            double x2 = keyAxis->coordToPixel( keyRange.lower + next * keysPerPixel );
+            if ( x1 > x2 )
+                std::swap( x1, x2 );
+
+            const double width = qMax( 1.0, x2 - x1 );
+
+            painter->fillRect( QRectF( QPointF( x1, valueAxis->coordToPixel( maxValue ) ), QPointF( x1 + width, zero ) ).normalized(), MAX_VALUE_COLOR );
+            painter->fillRect( QRectF( QPointF( x1, valueAxis->coordToPixel( meanValue ) ), QPointF( x1 + width, zero ) ).normalized(), MEAN_VALUE_COLOR );
+        }
+
+        column = next;
+    }
+}
+
+/**
+ * @brief OSSPeriodicSamplesPlottable::drawLegendIcon
+ * @param painter - the painter used for drawing
+ * @param rect - the rectangle of the legend icon
+ */
+void OSSPeriodicSamplesPlottable::drawLegendIcon(QCPPainter *painter, const QRectF &rect) const
+{
+    painter->fillRect( rect, MEAN_VALUE_COLOR );
+}
+
+/**
+ * @brief OSSPeriodicSamplesPlottable::selectTest
+ * @param pos - the position in pixels
+ * @param onlySelectable - whether only a selectable plottable may be hit
+ * @param details - the details of the hit
+ * @return - always -1 as the plottable is not selectable
+ */
+double OSSPeriodicSamplesPlottable::selectTest(const QPointF &pos, bool onlySelectable, QVariant *details) const
+{
+    Q_UNUSED( pos )
+    Q_UNUSED( onlySelectable )
+    Q_UNUSED( details )
+
+    return -1.0;
+}
+
+/**
+ * @brief OSSPeriodicSamplesPlottable::getKeyRange
+ * @param foundRange - set to whether there are any samples
+ * @param inSignDomain - the sign domain (ignored as times are never negative)
+ * @return - the time range spanned by the samples
+ */
+#if defined(HAS_QCUSTOMPLOT_V2)
+QCPRange OSSPeriodicSamplesPlottable::getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain) const
+#else
+QCPRange OSSPeriodicSamplesPlottable::getKeyRange(bool &foundRange, SignDomain inSignDomain) const
+#endif
+{
+    Q_UNUSED( inSignDomain )
+
+    foundRange = ! m_values.isEmpty();
+
+    if ( ! foundRange )
+        return QCPRange();
+
+    return QCPRange( *std::min_element( m_timeBegins.constBegin(), m_timeBegins.constEnd() ),
+                     *std::max_element( m_timeEnds.constBegin(), m_timeEnds.constEnd() ) );
+}
+
+/**
+ * @brief OSSPeriodicSamplesPlottable::getValueRange
+ * @param foundRange - set to whether there are any samples
+ * @param inSignDomain - the sign domain (ignored as counter values are never negative)
+ * @param inKeyRange - the time range (ignored)
+ * @return - the range from zero to the largest counter value
+ */
+#if defined(HAS_QCUSTOMPLOT_V2)
+QCPRange OSSPeriodicSamplesPlottable::getValueRange(bool &foundRange, QCP::SignDomain inSignDomain, const QCPRange &inKeyRange) const
+#else
+QCPRange OSSPeriodicSamplesPlottable::getValueRange(bool &foundRange, SignDomain inSignDomain) const
+#endif
+{
+    Q_UNUSED( inSignDomain )
+#if defined(HAS_QCUSTOMPLOT_V2)
+    Q_UNUSED( inKeyRange )
+#endif
+
+    foundRange = ! m_values.isEmpty();
+
+    return ( foundRange ) ? QCPRange( 0.0, m_maxValue ) : QCPRange();
+}
+
+
+} // GUI
+} // ArgoNavis
@@ -0,0 +1,116 @@
+/*!
+   \file OSSPeriodicSamplesPlottable.h
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef OSSPERIODICSAMPLESPLOTTABLE_H
+#define OSSPERIODICSAMPLESPLOTTABLE_H
+
+#include "qcustomplot.h"
+
+#include "common/openss-gui-config.h"
+
+#include <QVector>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/*!
+ * \brief The OSSPeriodicSamplesPlottable class
+ *
+ * A plottable drawing the periodic samples of one counter of a cluster.  The sample periods are kept in contiguous begin, end and
+ * value arrays ordered by time.  Rather than a rectangle per sample, each horizontal pixel of the visible time range is drawn as a
+ * bar up to the maximum value of the samples overlapping the pixel, with a darker bar up to their time-weighted mean value.  The
+ * per-pixel values are recomputed only when the time range, the pixel width or the samples change.
+ */
+
+class OSSPeriodicSamplesPlottable : public QCPAbstractPlottable
+{
+    Q_OBJECT
+
+public:
+
+    explicit OSSPeriodicSamplesPlottable(QCPAxis* keyAxis, QCPAxis* valueAxis);
+    virtual ~OSSPeriodicSamplesPlottable();
+
+    void addSamples(const QVector< double >& timeBegins, const QVector< double >& timeEnds, const QVector< double >& values);
+
+    int findSample(double lower, double upper) const;
+
+    int sampleCount() const;
+    double timeBegin(int i) const;
+    double timeEnd(int i) const;
+    double value(int i) const;
+
+#if defined(HAS_QCUSTOMPLOT_V2)
+    void clearData();
+#else
+    virtual void clearData() Q_DECL_OVERRIDE;
+#endif
+
+    virtual double selectTest(const QPointF &pos, bool onlySelectable, QVariant *details = 0) const Q_DECL_OVERRIDE;
+
+#if defined(HAS_QCUSTOMPLOT_V2)
+    virtual QCPRange getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain = QCP::sdBoth) const Q_DECL_OVERRIDE;
+    virtual QCPRange getValueRange(bool &foundRange, QCP::SignDomain inSignDomain = QCP::sdBoth, const QCPRange &inKeyRange = QCPRange()) const Q_DECL_OVERRIDE;
+#endif
+
+protected:
+
+    virtual void draw(QCPPainter *painter) Q_DECL_OVERRIDE;
+    virtual void drawLegendIcon(QCPPainter *painter, const QRectF &rect) const Q_DECL_OVERRIDE;
+
+#if !defined(HAS_QCUSTOMPLOT_V2)
+    virtual QCPRange getKeyRange(bool &foundRange, SignDomain inSignDomain = sdBoth) const Q_DECL_OVERRIDE;
+    virtual QCPRange getValueRange(bool &foundRange, SignDomain inSignDomain = sdBoth) const Q_DECL_OVERRIDE;
+#endif
+
+private:
+
+    void sort();
+    void updateColumns(const QCPRange& keyRange, int pixelWidth);
+
+    // the sample periods ordered by begin time
+    QVector< double > m_timeBegins;
+    QVector< double > m_timeEnds;
+    QVector< double > m_values;
+    bool m_sorted;
+    double m_maxValue;
+
+    // the maximum and mean value of each pixel column of the last update (a negative maximum marks an empty column)
+    QVector< double > m_columnMax;
+    QVector< double > m_columnMean;
+    QVector< double > m_columnWeight;
+
+    // the state of the last update
+    bool m_modified;
+    QCPRange m_keyRange;
+    int m_pixelWidth;
+
+};
+
+
+} // GUI
+} // ArgoNavis
+
+#endif // OSSPERIODICSAMPLESPLOTTABLE_H
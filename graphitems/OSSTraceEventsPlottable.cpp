@@ -0,0 +1,360 @@
+/*!
+   \file OSSTraceEventsPlottable.cpp
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "OSSTraceEventsPlottable.h"
+
+#include "OSSTraceItem.h"
+
+#include <algorithm>
+#include <limits>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+// the color of the spans covered by events narrower than a pixel
+const QColor COVERAGE_COLOR = QColor( 0x60, 0x60, 0x60 );
+
+// events narrower than this (in pixels) are drawn as plain rectangles
+const double MIN_ROUNDED_EVENT_WIDTH = 12.0;
+
+// the space between a label and the edges of the event (in pixels)
+const double LABEL_PADDING = 4.0;
+
+
+/**
+ * @brief OSSTraceEventsPlottable::OSSTraceEventsPlottable
+ * @param keyAxis - the time axis
+ * @param valueAxis - the rank (or thread) axis
+ *
+ * Constructs an OSSTraceEventsPlottable instance.
+ */
+OSSTraceEventsPlottable::OSSTraceEventsPlottable(QCPAxis *keyAxis, QCPAxis *valueAxis)
+    : QCPAbstractPlottable( keyAxis, valueAxis )
+    , m_keyLower( std::numeric_limits<double>::max() )
+    , m_keyUpper( std::numeric_limits<double>::lowest() )
+{
+    setName( QStringLiteral("Trace Events") );
+
+    // the individual events are found by the timeline view, not by the QCustomPlot selection mechanism
+#if defined(HAS_QCUSTOMPLOT_V2)
+    setSelectable( QCP::stNone );
+#else
+    setSelectable( false );
+#endif
+
+    setAntialiasedFill( false );
+
+    m_labelFont.setPointSize( 10 );
+    m_labelFont.setBold( true );
+}
+
+/**
+ * @brief OSSTraceEventsPlottable::~OSSTraceEventsPlottable
+ *
+ * Destroys the OSSTraceEventsPlottable instance.
+ */
+OSSTraceEventsPlottable::~OSSTraceEventsPlottable()
+{
+
+}
+
+/**
+ * @brief OSSTraceEventsPlottable::addEvent
+ * @param functionName - the name of the traced function
+ * @param timeBegin - the start time of the trace event
+ * @param timeEnd - the end time of the trace event
+ * @param rank - the rank or thread id in which the trace event occurred
+ *
+ * Appends the trace event to the lane of the rank.
+ */
+void OSSTraceEventsPlottable::addEvent(const QString &functionName, double timeBegin, double timeEnd, int rank)
+{
+    m_index.insert( rank, timeBegin, timeEnd, functionId( functionName ) );
+
+    m_keyLower = qMin( m_keyLower, timeBegin );
+    m_keyUpper = qMax( m_keyUpper, timeEnd );
+}
+
+/**
+ * @brief OSSTraceEventsPlottable::finalize
+ *
+ * Indexes the trace events added since the last call, so they are drawn and found by the timeline view.
+ */
+void OSSTraceEventsPlottable::finalize()
+{
+    m_index.finalize();
+}
+
+/**
+ * @brief OSSTraceEventsPlottable::index
+ * @return - the interval index of the trace events with the function id as payload
+ */
+const OSSIntervalIndex &OSSTraceEventsPlottable::index() const
+{
+    return m_index;
+}
+
+/**
+ * @brief OSSTraceEventsPlottable::functionName
+ * @param functionId - the id of the function in the function table
+ * @return - the name of the traced function
+ */
+QString OSSTraceEventsPlottable::functionName(quint32 functionId) const
+{
+    return m_functionNames.value( functionId );
+}
+
+/**
+ * @brief OSSTraceEventsPlottable::clearData
+ *
+ * Removes all trace events.
+ */
+void OSSTraceEventsPlottable::clearData()
+{
+    m_index.clear();
+
+    m_keyLower = std::numeric_limits<double>::max();
+    m_keyUpper = std::numeric_limits<double>::lowest();
+}
+
+/**
+ * @brief OSSTraceEventsPlottable::functionId
+ * @param functionName - the name of the traced function
+ * @return - the id of the function in the function table
+ *
+ * Interns the function in the function table; the color and the label of the function are resolved only once.
+ */
+quint32 OSSTraceEventsPlottable::functionId(const QString &functionName)
+{
+    QHash< QString, quint32 >::const_iterator iter = m_functionIds.constFind( functionName );
+
+    if ( iter != m_functionIds.constEnd() )
+        return iter.value();
+
+    const quint32 id = m_functionColors.size();
+
+    QStaticText label( functionName );
+    label.setPerformanceHint( QStaticText::AggressiveCaching );
+    label.prepare( QTransform(), m_labelFont );
+
+    m_functionIds.insert( functionName, id );
+    m_functionNames.append( functionName );
+    m_functionColors.append( OSSTraceItem::functionColor( functionName ) );
+    m_functionLabels.append( label );
+
+    return id;
+}
+
+/**
+ * @brief OSSTraceEventsPlottable::draw
+ * @param painter - the painter used for drawing
+ *
+ * Draws the events of the lanes within the visible rank range.  The events added since the last replot are indexed first, so events
+ * still loading appear with each replot.
+ */
+void OSSTraceEventsPlottable::draw(QCPPainter *painter)
+{
+    QCPAxis* valueAxis = mValueAxis.data();
+
+    if ( ! mKeyAxis || ! valueAxis )
+        return;
+
+    m_index.finalize();
+
+    const QCPRange valueRange = valueAxis->range();
+
+    painter->setFont( m_labelFont );
+
+    foreach ( const int rank, m_index.lanes() ) {
+        if ( rank + OSSTraceItem::s_halfHeight < valueRange.lower || rank - OSSTraceItem::s_halfHeight > valueRange.upper )
+            continue;
+
+        drawLane( painter, rank );
+    }
+}
+
+/**
+ * @brief OSSTraceEventsPlottable::drawLane
+ * @param painter - the painter used for drawing
+ * @param rank - the rank (or thread) of the lane to draw
+ *
+ * Draws the events of the lane intersecting the visible time range.  The range of events is found by the interval index; consecutive
+ * events narrower than a pixel are accumulated into a coverage span which is drawn as a single rectangle.
+ */
+void OSSTraceEventsPlottable::drawLane(QCPPainter *painter, int rank)
+{
+    QCPAxis* keyAxis = mKeyAxis.data();
+    QCPAxis* valueAxis = mValueAxis.data();
+
+    const QCPRange keyRange = keyAxis->range();
+
+    const double top = valueAxis->coordToPixel( rank + OSSTraceItem::s_halfHeight );
+    const double bottom = valueAxis->coordToPixel( rank - OSSTraceItem::s_halfHeight );
+    const double y = qMin( top, bottom );
+    const double height = qAbs( bottom - top );
+
+    const OSSIntervalIndex::Lane& lane = m_index.lane( rank );
+
+    const double* begins = lane.begins.constData();
+    const double* ends = lane.ends.constData();
+    const quint32* functionIds = lane.payloads.constData();
+
+    int first, last;
+    m_index.findRange( rank, keyRange.lower, keyRange.upper, first, last );
+
+    bool haveSpan( false );
+    double spanLeft( 0.0 );
+    double spanRight( 0.0 );
+
+    for ( int i=first; i<last; ++i ) {
+        if ( ends[ i ] < keyRange.lower )
+            continue;
+
+        double x1 = keyAxis->coordToPixel( begins[ i ] );
+        double x2 = keyAxis->coordToPixel( ends[ i ] );
+        if ( x1 > x2 )
+            std::swap( x1, x2 );
+
+        const double width = x2 - x1;
+
+        if ( width < 1.0 ) {
+            if ( haveSpan && x1 <= spanRight + 1.0 ) {
+                spanRight = qMax( spanRight, x2 );
+            }
+            else {
+                if ( haveSpan )
+                    painter->fillRect( QRectF( spanLeft, y, qMax( 1.0, spanRight - spanLeft ), height ), COVERAGE_COLOR );
+                spanLeft = x1;
+                spanRight = x2;
+                haveSpan = true;
+            }
+            continue;
+        }
+
+        if ( haveSpan ) {
+            painter->fillRect( QRectF( spanLeft, y, qMax( 1.0, spanRight - spanLeft ), height ), COVERAGE_COLOR );
+            haveSpan = false;
+        }
+
+        const QRectF rect( x1, y, width, height );
+        const QColor& color = m_functionColors[ functionIds[ i ] ];
+
+        if ( width < MIN_ROUNDED_EVENT_WIDTH ) {
+            painter->fillRect( rect, color );
+        }
+        else {
+            painter->setPen( QPen( color.darker( 150 ), 0 ) );
+            painter->setBrush( color );
+            painter->drawRoundedRect( rect, 5.0, 5.0 );
+        }
+
+        const QStaticText& label = m_functionLabels[ functionIds[ i ] ];
+        const QSizeF labelSize = label.size();
+
+        if ( width >= labelSize.width() + LABEL_PADDING && height >= labelSize.height() ) {
+            painter->setPen( Qt::white );
+            painter->drawStaticText( QPointF( rect.center().x() - labelSize.width() / 2.0, rect.center().y() - labelSize.height() / 2.0 ), label );
+        }
+    }
+
+    if ( haveSpan )
+        painter->fillRect( QRectF( spanLeft, y, qMax( 1.0, spanRight - spanLeft ), height ), COVERAGE_COLOR );
+}
+
+/**
+ * @brief OSSTraceEventsPlottable::drawLegendIcon
+ * @param painter - the painter used for drawing
+ * @param rect - the rectangle of the legend icon
+ */
+void OSSTraceEventsPlottable::drawLegendIcon(QCPPainter *painter, const QRectF &rect) const
+{
+    painter->fillRect( rect, OSSTraceItem::functionColor( QString() ) );
+}
+
+/**
+ * @brief OSSTraceEventsPlottable::selectTest
+ * @param pos - the position in pixels
+ * @param onlySelectable - whether only a selectable plottable may be hit
+ * @param details - the details of the hit
+ * @return - always -1 as the plottable is not selectable
+ */
+double OSSTraceEventsPlottable::selectTest(const QPointF &pos, bool onlySelectable, QVariant *details) const
+{
+    Q_UNUSED( pos )
+    Q_UNUSED( onlySelectable )
+    Q_UNUSED( details )
+
+    return -1.0;
+}
+
+/**
+ * @brief OSSTraceEventsPlottable::getKeyRange
+ * @param foundRange - set to whether there are any events
+ * @param inSignDomain - the sign domain (ignored as times are never negative)
+ * @return - the time range spanned by the events
+ */
+#if defined(HAS_QCUSTOMPLOT_V2)
+QCPRange OSSTraceEventsPlottable::getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain) const
+#else
+QCPRange OSSTraceEventsPlottable::getKeyRange(bool &foundRange, SignDomain inSignDomain) const
+#endif
+{
+    Q_UNUSED( inSignDomain )
+
+    foundRange = ! m_index.isEmpty();
+
+    return ( foundRange ) ? QCPRange( m_keyLower, m_keyUpper ) : QCPRange();
+}
+
+/**
+ * @brief OSSTraceEventsPlottable::getValueRange
+ * @param foundRange - set to whether there are any events
+ * @param inSignDomain - the sign domain (ignored as ranks are never negative)
+ * @param inKeyRange - the time range (ignored)
+ * @return - the rank range spanned by the lanes
+ */
+#if defined(HAS_QCUSTOMPLOT_V2)
+QCPRange OSSTraceEventsPlottable::getValueRange(bool &foundRange, QCP::SignDomain inSignDomain, const QCPRange &inKeyRange) const
+#else
+QCPRange OSSTraceEventsPlottable::getValueRange(bool &foundRange, SignDomain inSignDomain) const
+#endif
+{
+    Q_UNUSED( inSignDomain )
+#if defined(HAS_QCUSTOMPLOT_V2)
+    Q_UNUSED( inKeyRange )
+#endif
+
+    foundRange = ! m_index.isEmpty();
+
+    if ( ! foundRange )
+        return QCPRange();
+
+    const QList< int > ranks = m_index.lanes();
+
+    return QCPRange( ranks.first() - OSSTraceItem::s_halfHeight, ranks.last() + OSSTraceItem::s_halfHeight );
+}
+
+
+} // GUI
+} // ArgoNavis
@@ -0,0 +1,113 @@
+/*!
+   \file OSSTraceEventsPlottable.h
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OSSTRACEEVENTSPLOTTABLE_H
+#define OSSTRACEEVENTSPLOTTABLE_H
+
+#include "qcustomplot.h"
+
+#include "common/openss-gui-config.h"
+
+#include "OSSIntervalIndex.h"
+
+#include <QVector>
+#include <QHash>
+#include <QStaticText>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/*!
+ * \brief The OSSTraceEventsPlottable class
+ *
+ * A plottable drawing all trace events (MPI or I/O calls) of a trace timeline.  The events of each rank (or thread) are kept in a lane
+ * of an interval index with the function id as payload, so only the events intersecting the visible time range are visited when
+ * drawing and the event at a position is found by the timeline view in logarithmic time.  Consecutive events narrower than a pixel are merged into a single coverage span.  Each traced function is interned once in
+ * a function table holding its color and its label, which is drawn (as a cached QStaticText) only when the event is wide enough.
+ */
+
+class OSSTraceEventsPlottable : public QCPAbstractPlottable
+{
+    Q_OBJECT
+
+public:
+
+    explicit OSSTraceEventsPlottable(QCPAxis* keyAxis, QCPAxis* valueAxis);
+    virtual ~OSSTraceEventsPlottable();
+
+    void addEvent(const QString& functionName, double timeBegin, double timeEnd, int rank);
+    void finalize();
+
+    const OSSIntervalIndex& index() const;
+    QString functionName(quint32 functionId) const;
+
+#if defined(HAS_QCUSTOMPLOT_V2)
+    void clearData();
+#else
+    virtual void clearData() Q_DECL_OVERRIDE;
+#endif
+
+    virtual double selectTest(const QPointF &pos, bool onlySelectable, QVariant *details = 0) const Q_DECL_OVERRIDE;
+
+#if defined(HAS_QCUSTOMPLOT_V2)
+    virtual QCPRange getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain = QCP::sdBoth) const Q_DECL_OVERRIDE;
+    virtual QCPRange getValueRange(bool &foundRange, QCP::SignDomain inSignDomain = QCP::sdBoth, const QCPRange &inKeyRange = QCPRange()) const Q_DECL_OVERRIDE;
+#endif
+
+protected:
+
+    virtual void draw(QCPPainter *painter) Q_DECL_OVERRIDE;
+    virtual void drawLegendIcon(QCPPainter *painter, const QRectF &rect) const Q_DECL_OVERRIDE;
+
+#if !defined(HAS_QCUSTOMPLOT_V2)
+    virtual QCPRange getKeyRange(bool &foundRange, SignDomain inSignDomain = sdBoth) const Q_DECL_OVERRIDE;
+    virtual QCPRange getValueRange(bool &foundRange, SignDomain inSignDomain = sdBoth) const Q_DECL_OVERRIDE;
+#endif
+
+private:
+
+    quint32 functionId(const QString& functionName);
+    void drawLane(QCPPainter* painter, int rank);
+
+    // the trace events of each rank (or thread) with the function id as payload
+    OSSIntervalIndex m_index;
+
+    // the function table
+    QHash< QString, quint32 > m_functionIds;
+    QVector< QString > m_functionNames;
+    QVector< QColor > m_functionColors;
+    QVector< QStaticText > m_functionLabels;
+
+    QFont m_labelFont;
+
+    double m_keyLower;
+    double m_keyUpper;
+
+};
+
+
+} // GUI
+} // ArgoNavis
+
+#endif // OSSTRACEEVENTSPLOTTABLE_H
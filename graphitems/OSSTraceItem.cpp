@@ -89,19 +89,29 @@ void OSSTraceItem::setData(const QString& functionName, double timeBegin, double
  * @param functionName - the name of the function
  */
 void OSSTraceItem::setBrush(const QString &functionName)
+{
+    OSSEventItem::setBrush( functionColor( functionName ) );
+}
+
+/**
+ * @brief OSSTraceItem::functionColor
+ * @param functionName - the name of the function
+ * @return - the fill color of trace events of the function
+ */
+QColor OSSTraceItem::functionColor(const QString &functionName)
 {
     if ( functionName.contains( QStringLiteral("MPI_Init") ) )
-        OSSEventItem::setBrush( QColor( 0x95, 0xd0, 0xaa ) );
+        return QColor( 0x95, 0xd0, 0xaa );
     else if ( functionName.contains( QStringLiteral("MPI_Finalize") ) )
-        OSSEventItem::setBrush( QColor( 0xa3, 0x21, 0x3e ) );
+        return QColor( 0xa3, 0x21, 0x3e );
     else if ( functionName.contains( QStringLiteral("MPI_Barrier") ) )
-        OSSEventItem::setBrush( QColor( 0xca, 0x2b, 0x2b ) );
+        return QColor( 0xca, 0x2b, 0x2b );
     else if ( functionName.contains( QStringLiteral("MPI_Send") ) )
-        OSSEventItem::setBrush( QColor( 0xcc, 0x7d, 0xaf ) );
+        return QColor( 0xcc, 0x7d, 0xaf );
     else if ( functionName.contains( QStringLiteral("MPI_Recv") ) )
-        OSSEventItem::setBrush( QColor( 0xcc, 0x7d, 0xaf ) );
+        return QColor( 0xcc, 0x7d, 0xaf );
     else
-        OSSEventItem::setBrush( QColor( 0x43, 0x8e, 0xc8 ) );
+        return QColor( 0x43, 0x8e, 0xc8 );
 }
 
 /**
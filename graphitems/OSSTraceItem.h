@@ -41,6 +41,8 @@ public:
     void setData(const QString& functionName, double timeBegin, double timeEnd, int rank);
     void setBrush(const QString& functionName);
 
+    static QColor functionColor(const QString& functionName);
+
     static double s_halfHeight;
 
 protected:
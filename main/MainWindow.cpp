@@ -110,7 +110,7 @@ MainWindow::MainWindow(QWidget *parent)
         connect( dataMgr, &PerformanceDataManager::addCluster, this, &MainWindow::handleAdjustPlotViewScrollArea );
         connect( dataMgr, &PerformanceDataManager::removeCluster, this, &MainWindow::handleRemoveCluster );
         connect( dataMgr, &PerformanceDataManager::addMetricView, ui->widget_SourceCodeViewer, &SourceView::addMetricView );
-        connect( dataMgr, &PerformanceDataManager::addMetricViewData, ui->widget_SourceCodeViewer, &SourceView::addMetricViewData );
+        connect( dataMgr, &PerformanceDataManager::addSourceLineMetricData, ui->widget_SourceCodeViewer, &SourceView::addSourceLineMetricData );
         connect( ui->widget_MetricTableView, &PerformanceDataMetricView::signalMetricViewChanged, ui->widget_SourceCodeViewer, &SourceView::handleMetricViewChanged );
         connect( dataMgr, &PerformanceDataManager::signalSetDefaultMetricView, ui->widget_MetricViewManager, &MetricViewManager::handleSwitchView );
         connect( dataMgr, &PerformanceDataManager::signalSetDefaultMetricView, this, &MainWindow::handleSetDefaultMetricView );
@@ -147,8 +147,8 @@ MainWindow::MainWindow(QWidget *parent)
         connect( dataMgr, SIGNAL(removeCluster(QString,QString)), this, SLOT(handleRemoveCluster(QString,QString)) );
         connect( dataMgr, SIGNAL(addMetricView(QString,QString,QString,QString,QStringList)),
                  ui->widget_SourceCodeViewer, SIGNAL(addMetricView(QString,QString,QString,QString,QStringList)) );
-        connect( dataMgr, SIGNAL(addMetricViewData(QString,QString,QString,QString,QVariantList,QStringList)),
-                 ui->widget_SourceCodeViewer, SIGNAL(addMetricViewData(QString,QString,QString,QString,QVariantList,QStringList)) );
+        connect( dataMgr, SIGNAL(addSourceLineMetricData(QString,QString,QString,QString,QVector<QString>,QVector<int>,QVector<QVariantList>)),
+                 ui->widget_SourceCodeViewer, SIGNAL(addSourceLineMetricData(QString,QString,QString,QString,QVector<QString>,QVector<int>,QVector<QVariantList>)) );
         connect( ui->widget_MetricTableView, SIGNAL(signalMetricViewChanged(QString)),
                  ui->widget_SourceCodeViewer, SLOT(handleMetricViewChanged(QString)) );
         connect( dataMgr, SIGNAL(signalSetDefaultMetricView(MetricViewTypes,bool,bool,bool,bool,bool)),
@@ -286,8 +286,15 @@ void MainWindow::loadExperimentDatabase(const QString& filepath)
     m_lastFilePath = fileInfo.absolutePath();
 
 #if defined(HAS_OSSCUDA2XML)
+#if defined(HAS_OSSCUDA2NDJSON)
+    dataMgr->ndjsonDump( filepath );
+#else
     dataMgr->xmlDump( filepath );
 #endif
+#endif
+#if defined(HAS_OSSSNAPSHOT)
+    dataMgr->snapshotDump( filepath );
+#endif
 }
 
 /**
@@ -25,6 +25,7 @@
 
 #if defined(HAS_DESTROY_SINGLETONS)
 #include "managers/PerformanceDataManager.h"
+#include "managers/BoundedSignalChannel.h"
 #endif
 
 #include <QApplication>
@@ -135,6 +136,7 @@ int main(int argc, char *argv[])
 
 #if defined(HAS_DESTROY_SINGLETONS)
     GUI::PerformanceDataManager::destroy();
+    GUI::BoundedSignalChannel::destroy();
 #endif
 
     return status;
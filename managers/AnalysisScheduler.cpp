@@ -0,0 +1,379 @@
+/*!
+   \file AnalysisScheduler.cpp
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+#include "AnalysisScheduler.h"
+
+#include "BoundedSignalChannel.h"
+
+#include "common/openss-gui-config.h"
+
+#include <QMutexLocker>
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <QCoreApplication>
+#include <QThreadStorage>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+// the token of the task running in each thread (if any)
+static QThreadStorage< CancellationToken > s_currentToken;
+
+
+/**
+ * @brief CancellationToken::CancellationToken
+ *
+ * Constructs a token which has not been canceled.
+ */
+CancellationToken::CancellationToken()
+    : m_canceled( new QAtomicInt( 0 ) )
+{
+
+}
+
+/**
+ * @brief CancellationToken::cancel
+ *
+ * Cancel the token and all copies of it.
+ */
+void CancellationToken::cancel()
+{
+    m_canceled->fetchAndStoreOrdered( 1 );
+}
+
+/**
+ * @brief CancellationToken::isCanceled
+ * @return - whether the token has been canceled
+ */
+bool CancellationToken::isCanceled() const
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+    return m_canceled->load() != 0;
+#else
+    return *m_canceled != 0;
+#endif
+}
+
+/**
+ * @brief CancellationToken::operator ==
+ * @param other - the other token
+ * @return - whether both tokens are copies of the same token
+ */
+bool CancellationToken::operator==(const CancellationToken &other) const
+{
+    return m_canceled == other.m_canceled;
+}
+
+/**
+ * @brief CancellationToken::operator !=
+ * @param other - the other token
+ * @return - whether the tokens are not copies of the same token
+ */
+bool CancellationToken::operator!=(const CancellationToken &other) const
+{
+    return m_canceled != other.m_canceled;
+}
+
+/**
+ * @brief AnalysisScheduler::TokenScope::TokenScope
+ * @param token - the token of the calling thread within the scope
+ */
+AnalysisScheduler::TokenScope::TokenScope(const CancellationToken &token)
+    : m_hadToken( s_currentToken.hasLocalData() )
+{
+    if ( m_hadToken )
+        m_previous = s_currentToken.localData();
+
+    s_currentToken.setLocalData( token );
+}
+
+/**
+ * @brief AnalysisScheduler::TokenScope::~TokenScope
+ *
+ * Restores the token of the calling thread at the construction of the scope.  A task stealing a subtask it waits for (see QFuture::result)
+ * runs the subtask in its own thread, so scopes can be nested.
+ */
+AnalysisScheduler::TokenScope::~TokenScope()
+{
+    if ( m_hadToken )
+        s_currentToken.setLocalData( m_previous );
+    else
+        s_currentToken.setLocalData( CancellationToken() );
+}
+
+/**
+ * @brief AnalysisScheduler::AnalysisScheduler
+ *
+ * Constructs an AnalysisScheduler instance.  The visible view lane uses as many threads as there are processor cores.  Metric views are
+ * prefetched one at a time and batch work is performed one task at a time.
+ */
+AnalysisScheduler::AnalysisScheduler()
+{
+    m_prefetchPool.setMaxThreadCount( 1 );
+    m_exportPool.setMaxThreadCount( 1 );
+}
+
+/**
+ * @brief AnalysisScheduler::~AnalysisScheduler
+ *
+ * Destroys the AnalysisScheduler instance.  All tasks are canceled and the thread pools wait for the running tasks to stop.
+ */
+AnalysisScheduler::~AnalysisScheduler()
+{
+    cancelAll();
+
+    waitForDone();
+}
+
+/**
+ * @brief AnalysisScheduler::supersede
+ * @param group - the group of the key
+ * @param key - the key of the task
+ * @return - the token of the new task for the key
+ *
+ * Register a new token for the key.  The token of the task previously registered for the key (if any) is canceled.
+ */
+CancellationToken AnalysisScheduler::supersede(const QString &group, const QString &key)
+{
+    QWriteLocker publishGuard( &m_publishLock );
+    QMutexLocker guard( &m_mutex );
+
+    // if the group is not currently in map an entry will automatically be created
+    QMap< QString, CancellationToken >& tokens = m_tokens[ group ];
+
+    if ( tokens.contains( key ) ) {
+        tokens[ key ].cancel();
+
+        BoundedSignalChannel::wakeProducers();
+    }
+
+    const CancellationToken token;
+
+    tokens.insert( key, token );
+
+    return token;
+}
+
+/**
+ * @brief AnalysisScheduler::release
+ * @param group - the group of the key
+ * @param key - the key of the task
+ * @param token - the token of the finished task
+ *
+ * Unregister the token of a finished task.  Nothing is done if another token has since been registered for the key.
+ */
+void AnalysisScheduler::release(const QString &group, const QString &key, const CancellationToken &token)
+{
+    QMutexLocker guard( &m_mutex );
+
+    if ( ! m_tokens.contains( group ) )
+        return;
+
+    QMap< QString, CancellationToken >& tokens = m_tokens[ group ];
+
+    if ( tokens.contains( key ) && tokens[ key ] == token )
+        tokens.remove( key );
+
+    if ( tokens.isEmpty() )
+        m_tokens.remove( group );
+}
+
+/**
+ * @brief AnalysisScheduler::cancel
+ * @param group - the group of the key
+ * @param key - the key of the task
+ *
+ * Cancel the task registered for the key (if any).
+ */
+void AnalysisScheduler::cancel(const QString &group, const QString &key)
+{
+    QWriteLocker publishGuard( &m_publishLock );
+    QMutexLocker guard( &m_mutex );
+
+    if ( m_tokens.contains( group ) && m_tokens[ group ].contains( key ) ) {
+        m_tokens[ group ].take( key ).cancel();
+
+        BoundedSignalChannel::wakeProducers();
+    }
+}
+
+/**
+ * @brief AnalysisScheduler::cancelGroup
+ * @param group - the group of tasks
+ *
+ * Cancel all tasks registered for the group.
+ */
+void AnalysisScheduler::cancelGroup(const QString &group)
+{
+    QWriteLocker publishGuard( &m_publishLock );
+    QMutexLocker guard( &m_mutex );
+
+    QMap< QString, CancellationToken > tokens = m_tokens.take( group );
+
+    for ( QMap< QString, CancellationToken >::iterator iter = tokens.begin(); iter != tokens.end(); iter++ ) {
+        iter.value().cancel();
+    }
+
+    BoundedSignalChannel::wakeProducers();
+}
+
+/**
+ * @brief AnalysisScheduler::cancelAll
+ *
+ * Cancel all registered tasks.
+ */
+void AnalysisScheduler::cancelAll()
+{
+    QWriteLocker publishGuard( &m_publishLock );
+    QMutexLocker guard( &m_mutex );
+
+    for ( QMap< QString, QMap< QString, CancellationToken > >::iterator iter = m_tokens.begin(); iter != m_tokens.end(); iter++ ) {
+        QMap< QString, CancellationToken >& tokens( iter.value() );
+        for ( QMap< QString, CancellationToken >::iterator titer = tokens.begin(); titer != tokens.end(); titer++ ) {
+            titer.value().cancel();
+        }
+    }
+
+    m_tokens.clear();
+
+    BoundedSignalChannel::wakeProducers();
+}
+
+/**
+ * @brief AnalysisScheduler::waitForDone
+ *
+ * Waits for the running tasks of all lanes to finish.  Tasks which were canceled stop early.
+ */
+void AnalysisScheduler::waitForDone()
+{
+    m_visibleViewPool.waitForDone();
+    m_prefetchPool.waitForDone();
+    m_exportPool.waitForDone();
+}
+
+/**
+ * @brief AnalysisScheduler::currentToken
+ * @return - the token of the task running in the calling thread
+ *
+ * A thread not running a task is given a token which is never canceled.
+ */
+CancellationToken AnalysisScheduler::currentToken()
+{
+    if ( s_currentToken.hasLocalData() )
+        return s_currentToken.localData();
+
+    return CancellationToken();
+}
+
+/**
+ * @brief AnalysisScheduler::isCanceled
+ * @return - whether the task running in the calling thread has been canceled
+ *
+ * Polled by the long running loops of a task, which then stop early.  Always false in a thread not running a task (for instance the GUI thread).
+ */
+bool AnalysisScheduler::isCanceled()
+{
+    return s_currentToken.hasLocalData() && s_currentToken.localData().isCanceled();
+}
+
+/**
+ * @brief AnalysisScheduler::PublishLocker::PublishLocker
+ * @param scheduler - the scheduler running the task of the calling thread
+ *
+ * Takes the publish lock of the scheduler shared, unless called in the GUI thread.  The results of the task should only be emitted
+ * (after checking isCanceled) while the locker exists, and the locker should not be held while waiting on the GUI thread.
+ */
+AnalysisScheduler::PublishLocker::PublishLocker(AnalysisScheduler &scheduler)
+    : m_lock( Q_NULLPTR )
+{
+    QCoreApplication* application = QCoreApplication::instance();
+
+    if ( application && QThread::currentThread() == application->thread() )
+        return;
+
+    m_lock = &scheduler.m_publishLock;
+    m_lock->lockForRead();
+}
+
+/**
+ * @brief AnalysisScheduler::PublishLocker::~PublishLocker
+ *
+ * Releases the publish lock.
+ */
+AnalysisScheduler::PublishLocker::~PublishLocker()
+{
+    if ( m_lock )
+        m_lock->unlock();
+}
+
+/**
+ * @brief AnalysisScheduler::PublishLocker::isCanceled
+ * @return - whether the task running in the calling thread has been canceled
+ *
+ * The result holds for the lifetime of the locker, as tokens are not canceled while it exists.
+ */
+bool AnalysisScheduler::PublishLocker::isCanceled() const
+{
+    return AnalysisScheduler::isCanceled();
+}
+
+/**
+ * @brief AnalysisScheduler::pool
+ * @param lane - the lane
+ * @return - the thread pool of the lane
+ */
+QThreadPool *AnalysisScheduler::pool(Lane lane)
+{
+    switch ( lane ) {
+    case PrefetchLane:
+        return &m_prefetchPool;
+    case ExportLane:
+        return &m_exportPool;
+    default:
+        return &m_visibleViewPool;
+    }
+}
+
+/**
+ * @brief AnalysisScheduler::priority
+ * @param lane - the lane
+ * @return - the thread priority of the tasks of the lane
+ */
+QThread::Priority AnalysisScheduler::priority(Lane lane)
+{
+    switch ( lane ) {
+    case PrefetchLane:
+        return QThread::LowestPriority;
+    case ExportLane:
+        return QThread::LowPriority;
+    default:
+        return QThread::InheritPriority;
+    }
+}
+
+
+} // GUI
+} // ArgoNavis
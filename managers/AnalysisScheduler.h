@@ -0,0 +1,244 @@
+/*!
+   \file AnalysisScheduler.h
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+#ifndef ANALYSISSCHEDULER_H
+#define ANALYSISSCHEDULER_H
+
+#include <QString>
+#include <QMap>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QThread>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QSharedPointer>
+#include <QFuture>
+#include <QtConcurrentRun>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/*!
+ * \brief The CancellationToken class
+ *
+ * A token shared by a scheduled analysis task and its scheduler.  Copies of a token refer to the same cancellation state.
+ * Long running loops of the task poll the token (see AnalysisScheduler::isCanceled) and stop early once it has been canceled.
+ */
+
+class CancellationToken
+{
+public:
+
+    CancellationToken();
+
+    void cancel();
+    bool isCanceled() const;
+
+    bool operator==(const CancellationToken& other) const;
+    bool operator!=(const CancellationToken& other) const;
+
+private:
+
+    QSharedPointer< QAtomicInt > m_canceled;
+
+};
+
+
+/*!
+ * \brief The AnalysisScheduler class
+ *
+ * Runs analysis tasks in separate priority lanes, each with its own thread pool, so that the metric view shown to the user
+ * is never queued behind background work.  Each task is given a cancellation token which is installed in the thread running
+ * the task for the duration of the task.  Tokens are registered by group (the clustering criteria name) and key (the metric
+ * view name): registering a new token for a key cancels the task currently registered for the key, so only the most recent
+ * request for a metric view runs to completion.  A task whose token was canceled before it was started is not run at all.
+ *
+ * Subtasks started by a task with QtConcurrent::run inherit the token of the task when wrapped by inheritToken.  Subtasks are
+ * run in the global thread pool, as the task waits on them and so can not share a lane thread with them.
+ */
+
+class AnalysisScheduler
+{
+public:
+
+    enum Lane {
+        VisibleViewLane,    // metric views requested to be shown
+        PrefetchLane,       // metric views prefetched in idle time
+        ExportLane          // long running batch work which must not delay the other lanes
+    };
+
+    AnalysisScheduler();
+    ~AnalysisScheduler();
+
+    CancellationToken supersede(const QString& group, const QString& key);
+    void release(const QString& group, const QString& key, const CancellationToken& token);
+
+    void cancel(const QString& group, const QString& key);
+    void cancelGroup(const QString& group);
+    void cancelAll();
+
+    void waitForDone();
+
+    template <typename Functor>
+    QFuture<void> run(Lane lane, const CancellationToken& token, const Functor& functor);
+
+    static CancellationToken currentToken();
+    static bool isCanceled();
+
+    template <typename Functor>
+    struct TokenScopedTask;
+
+    template <typename Functor>
+    static TokenScopedTask< Functor > inheritToken(const Functor& functor);
+
+    /*!
+     * \brief The PublishLocker class holds the publish lock of the scheduler while a task emits its results.  Tokens are only canceled
+     * with the publish lock held exclusively, so results emitted by a task which found its token not canceled under the lock are queued
+     * ahead of anything emitted by the task superseding it.  The lock isn't taken in the GUI thread, which supersedes the tasks itself.
+     */
+    class PublishLocker
+    {
+    public:
+        explicit PublishLocker(AnalysisScheduler& scheduler);
+        ~PublishLocker();
+        bool isCanceled() const;
+    private:
+        Q_DISABLE_COPY( PublishLocker )
+        QReadWriteLock* m_lock;
+    };
+
+private:
+
+    /*!
+     * \brief The TokenScope class installs a token as the token of the calling thread for the lifetime of the scope
+     * and restores the previous token (if any) afterwards.
+     */
+    class TokenScope
+    {
+    public:
+        explicit TokenScope(const CancellationToken& token);
+        ~TokenScope();
+    private:
+        bool m_hadToken;
+        CancellationToken m_previous;
+    };
+
+    template <typename Functor>
+    struct ScheduledTask;
+
+    QThreadPool* pool(Lane lane);
+    static QThread::Priority priority(Lane lane);
+
+private:
+
+    QThreadPool m_visibleViewPool;
+    QThreadPool m_prefetchPool;
+    QThreadPool m_exportPool;
+
+    // outer map: key=group  value: inner map of the registered tokens of the group
+    // inner map: key=key  value: the token of the most recent task registered for the key
+    QMap< QString, QMap< QString, CancellationToken > > m_tokens;
+    QMutex m_mutex;
+
+    // held shared by tasks emitting results and exclusively while tokens are canceled (see PublishLocker)
+    QReadWriteLock m_publishLock;
+
+};
+
+/**
+ * @brief The AnalysisScheduler::TokenScopedTask struct provides a Function object (functor) which performs a subtask with the
+ * cancellation token of the task which started it.
+ */
+template <typename Functor>
+struct AnalysisScheduler::TokenScopedTask {
+    typedef typename Functor::result_type result_type;
+    TokenScopedTask(const CancellationToken& token, const Functor& functor) : m_token( token ), m_functor( functor ) { }
+    result_type operator() () {
+        const TokenScope scope( m_token );
+        return m_functor();
+    }
+    CancellationToken m_token;
+    Functor m_functor;
+};
+
+/**
+ * @brief The AnalysisScheduler::ScheduledTask struct provides a Function object (functor) which performs a task of a lane
+ * at the thread priority of the lane unless the task was canceled before it was started.
+ */
+template <typename Functor>
+struct AnalysisScheduler::ScheduledTask {
+    typedef void result_type;
+    ScheduledTask(const CancellationToken& token, const Functor& functor, QThread::Priority priority)
+        : m_token( token ), m_functor( functor ), m_priority( priority ) { }
+    void operator() () {
+        if ( m_token.isCanceled() )
+            return;
+        if ( m_priority != QThread::InheritPriority )
+            QThread::currentThread()->setPriority( m_priority );
+        const TokenScope scope( m_token );
+        m_functor();
+    }
+    CancellationToken m_token;
+    Functor m_functor;
+    QThread::Priority m_priority;
+};
+
+/**
+ * @brief AnalysisScheduler::run
+ * @param lane - the lane in which to run the task
+ * @param token - the cancellation token of the task
+ * @param functor - the task
+ * @return - the future representing the task
+ *
+ * Run the task in the thread pool of the lane.  Before Qt 5.4 tasks can only be run in the global thread pool, so all lanes
+ * share the global thread pool at normal priority.
+ */
+template <typename Functor>
+QFuture<void> AnalysisScheduler::run(Lane lane, const CancellationToken& token, const Functor& functor)
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 4, 0))
+    return QtConcurrent::run( pool( lane ), ScheduledTask< Functor >( token, functor, priority( lane ) ) );
+#else
+    return QtConcurrent::run( ScheduledTask< Functor >( token, functor, QThread::InheritPriority ) );
+#endif
+}
+
+/**
+ * @brief AnalysisScheduler::inheritToken
+ * @param functor - the subtask
+ * @return - the subtask performed with the cancellation token of the calling thread
+ */
+template <typename Functor>
+AnalysisScheduler::TokenScopedTask< Functor > AnalysisScheduler::inheritToken(const Functor& functor)
+{
+    return TokenScopedTask< Functor >( currentToken(), functor );
+}
+
+
+} // GUI
+} // ArgoNavis
+
+#endif // ANALYSISSCHEDULER_H
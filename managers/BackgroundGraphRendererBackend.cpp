@@ -24,6 +24,7 @@
 #include "BackgroundGraphRendererBackend.h"
 
 #include "managers/ApplicationOverrideCursorManager.h"
+#include "managers/BoundedSignalChannel.h"
 
 #include <QtConcurrentRun>
 #include <QFutureSynchronizer>
@@ -79,7 +80,13 @@ bool BackgroundGraphRendererBackend::processDataTransferEvent(const QString& clu
                                                               const Base::Time &time_origin,
                                                               const CUDA::DataTransfer &details)
 {
-    emit addDataTransfer( clusteringName, time_origin, details );
+    BoundedSignalChannel* channel = BoundedSignalChannel::instance();
+    const qint64 bytes = sizeof( CUDA::DataTransfer ) + BoundedSignalChannel::sizeOf( clusteringName );
+
+    if ( channel->acquire( bytes ) ) {
+        emit addDataTransfer( clusteringName, time_origin, details );
+        channel->commit( bytes );
+    }
 
     return true; // continue the visitation
 }
@@ -96,7 +103,13 @@ bool BackgroundGraphRendererBackend::processKernelExecutionEvent(const QString&
                                                                  const Base::Time &time_origin,
                                                                  const CUDA::KernelExecution &details)
 {
-    emit addKernelExecution( clusteringName, time_origin, details );
+    BoundedSignalChannel* channel = BoundedSignalChannel::instance();
+    const qint64 bytes = sizeof( CUDA::KernelExecution ) + BoundedSignalChannel::sizeOf( clusteringName );
+
+    if ( channel->acquire( bytes ) ) {
+        emit addKernelExecution( clusteringName, time_origin, details );
+        channel->commit( bytes );
+    }
 
     return true; // continue the visitation
 }
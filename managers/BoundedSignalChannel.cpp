@@ -0,0 +1,423 @@
+/*!
+   \file BoundedSignalChannel.cpp
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "BoundedSignalChannel.h"
+
+#include "AnalysisScheduler.h"
+
+#include "common/openss-gui-config.h"
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QMutexLocker>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+QAtomicPointer< BoundedSignalChannel > BoundedSignalChannel::s_instance;
+
+// the default bound of the bytes queued to the GUI thread
+const qint64 DEFAULT_CAPACITY = 64 * 1024 * 1024;
+
+// the default time (in msecs) the GUI thread should need to drain a full window
+const int DEFAULT_TIME_SLICE = 50;
+
+// the window never shrinks below this many bytes, so a slow GUI thread still receives reasonably sized batches
+const qint64 MIN_WINDOW = 256 * 1024;
+
+// the bytes a Batch acquires from the channel at a time
+const qint64 BATCH_SIZE = 64 * 1024;
+
+// the weight of a new drain rate measurement in the running drain rate
+const double DRAIN_RATE_WEIGHT = 0.1;
+
+
+/**
+ * @brief BoundedSignalChannel::BoundedSignalChannel
+ * @param parent - the parent QObject instance
+ *
+ * Constructs a BoundedSignalChannel instance living in the GUI thread.  The channel is aborted when the application is about to quit,
+ * so no producer remains blocked once the GUI thread stops draining.  The OPENSS_GUI_SIGNAL_CHANNEL_CAPACITY (bytes) and
+ * OPENSS_GUI_SIGNAL_CHANNEL_TIME_SLICE (msecs) environment variables override the default capacity and time slice.
+ */
+BoundedSignalChannel::BoundedSignalChannel(QObject *parent)
+    : QObject( parent )
+    , m_capacity( DEFAULT_CAPACITY )
+    , m_timeSlice( DEFAULT_TIME_SLICE )
+    , m_pending( 0 )
+    , m_drainRate( 0.0 )
+    , m_aborted( false )
+{
+    bool ok;
+
+    const qint64 capacity = qgetenv( "OPENSS_GUI_SIGNAL_CHANNEL_CAPACITY" ).toLongLong( &ok );
+    if ( ok && capacity > 0 )
+        m_capacity = capacity;
+
+    const int timeSlice = qgetenv( "OPENSS_GUI_SIGNAL_CHANNEL_TIME_SLICE" ).toInt( &ok );
+    if ( ok && timeSlice >= 0 )
+        m_timeSlice = timeSlice;
+
+    QCoreApplication* application = QCoreApplication::instance();
+
+    if ( application ) {
+        // the release markers need to be handled by the GUI thread
+        if ( thread() != application->thread() )
+            moveToThread( application->thread() );
+
+        connect( application, SIGNAL(aboutToQuit()), this, SLOT(abort()) );
+    }
+}
+
+/**
+ * @brief BoundedSignalChannel::instance
+ * @return - return a pointer to the singleton instance
+ *
+ * This method provides a pointer to the singleton instance.
+ */
+BoundedSignalChannel *BoundedSignalChannel::instance()
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+    BoundedSignalChannel* inst = s_instance.loadAcquire();
+#else
+    BoundedSignalChannel* inst = s_instance;
+#endif
+
+    if ( ! inst ) {
+        inst = new BoundedSignalChannel();
+        if ( ! s_instance.testAndSetRelease( 0, inst ) ) {
+            delete inst;
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+            inst = s_instance.loadAcquire();
+#else
+            inst = s_instance;
+#endif
+        }
+    }
+
+    return inst;
+}
+
+/**
+ * @brief BoundedSignalChannel::setCapacity
+ * @param bytes - the bound of the bytes queued to the GUI thread
+ *
+ * Sets the bound of the pending bytes.  Blocked producers are woken to check the new window.
+ */
+void BoundedSignalChannel::setCapacity(qint64 bytes)
+{
+    QMutexLocker guard( &m_mutex );
+
+    m_capacity = qMax( Q_INT64_C(1), bytes );
+
+    m_released.wakeAll();
+}
+
+/**
+ * @brief BoundedSignalChannel::capacity
+ * @return - the bound of the bytes queued to the GUI thread
+ */
+qint64 BoundedSignalChannel::capacity() const
+{
+    QMutexLocker guard( &m_mutex );
+
+    return m_capacity;
+}
+
+/**
+ * @brief BoundedSignalChannel::setTimeSlice
+ * @param msecs - the time the GUI thread should need to drain a full window
+ *
+ * Sets the time slice the window is shrunk to.  A time slice of zero disables shrinking, so the window is the capacity.
+ */
+void BoundedSignalChannel::setTimeSlice(int msecs)
+{
+    QMutexLocker guard( &m_mutex );
+
+    m_timeSlice = qMax( 0, msecs );
+
+    m_released.wakeAll();
+}
+
+/**
+ * @brief BoundedSignalChannel::timeSlice
+ * @return - the time the GUI thread should need to drain a full window
+ */
+int BoundedSignalChannel::timeSlice() const
+{
+    QMutexLocker guard( &m_mutex );
+
+    return m_timeSlice;
+}
+
+/**
+ * @brief BoundedSignalChannel::pendingBytes
+ * @return - the bytes acquired but not yet released
+ */
+qint64 BoundedSignalChannel::pendingBytes() const
+{
+    QMutexLocker guard( &m_mutex );
+
+    return m_pending;
+}
+
+/**
+ * @brief BoundedSignalChannel::acquire
+ * @param bytes - the estimated bytes carried by the signal about to be emitted
+ * @return - false if the channel was aborted or the task of the calling producer was canceled (the signal should not be emitted), true otherwise
+ *
+ * Blocks the calling producer while the pending bytes together with the requested bytes exceed the window.  A request is always admitted
+ * if nothing is pending, so signals larger than the window are delivered one at a time.  Requests from the GUI thread are admitted at once.
+ * A producer whose task is canceled stops waiting when woken by wakeProducers().
+ */
+bool BoundedSignalChannel::acquire(qint64 bytes)
+{
+    QMutexLocker guard( &m_mutex );
+
+    if ( QThread::currentThread() != thread() ) {
+        while ( ! m_aborted && ! AnalysisScheduler::isCanceled() && m_pending > 0 && m_pending + bytes > window() ) {
+            m_released.wait( &m_mutex );
+        }
+    }
+
+    if ( m_aborted || AnalysisScheduler::isCanceled() )
+        return false;
+
+    admit( bytes );
+
+    return true;
+}
+
+/**
+ * @brief BoundedSignalChannel::commit
+ * @param bytes - the bytes acquired for the signal just emitted
+ *
+ * Posts the release marker of the bytes to the GUI thread.  The marker is queued behind the signal just emitted, so the bytes are released
+ * once the GUI thread has handled the signal (provided the receivers of the signal live in the GUI thread).
+ */
+void BoundedSignalChannel::commit(qint64 bytes)
+{
+    QMetaObject::invokeMethod( this, "release", Qt::QueuedConnection, Q_ARG( qlonglong, bytes ) );
+}
+
+/**
+ * @brief BoundedSignalChannel::sizeOf
+ * @param value - the string carried by a signal
+ * @return - the estimated bytes of the string
+ */
+qint64 BoundedSignalChannel::sizeOf(const QString &value)
+{
+    return sizeof( QString ) + value.size() * sizeof( QChar );
+}
+
+/**
+ * @brief BoundedSignalChannel::sizeOf
+ * @param values - the list of values (a row of a metric view) carried by a signal
+ * @return - the estimated bytes of the list
+ */
+qint64 BoundedSignalChannel::sizeOf(const QVariantList &values)
+{
+    qint64 bytes = sizeof( QVariantList ) + values.size() * sizeof( QVariant );
+
+    foreach ( const QVariant& value, values ) {
+        if ( QVariant::String == value.type() )
+            bytes += value.toString().size() * sizeof( QChar );
+    }
+
+    return bytes;
+}
+
+/**
+ * @brief BoundedSignalChannel::abort
+ *
+ * Wakes all blocked producers and refuses all further requests.
+ */
+void BoundedSignalChannel::abort()
+{
+    QMutexLocker guard( &m_mutex );
+
+    m_aborted = true;
+
+    m_released.wakeAll();
+}
+
+/**
+ * @brief BoundedSignalChannel::wakeProducers
+ *
+ * Static method waking all blocked producers, so the producers whose task was canceled stop waiting.  Called by the analysis scheduler
+ * after canceling tasks; the channel is not created if it doesn't exist yet.
+ */
+void BoundedSignalChannel::wakeProducers()
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+    BoundedSignalChannel* inst = s_instance.loadAcquire();
+#else
+    BoundedSignalChannel* inst = s_instance;
+#endif
+
+    if ( ! inst )
+        return;
+
+    QMutexLocker guard( &inst->m_mutex );
+
+    inst->m_released.wakeAll();
+}
+
+/**
+ * @brief BoundedSignalChannel::destroy
+ *
+ * Static method to destroy the singleton instance.
+ */
+void BoundedSignalChannel::destroy()
+{
+    delete s_instance.fetchAndStoreRelease( Q_NULLPTR );
+}
+
+/**
+ * @brief BoundedSignalChannel::Batch::Batch
+ * @param channel - the channel the bytes are acquired from
+ */
+BoundedSignalChannel::Batch::Batch(BoundedSignalChannel *channel)
+    : m_channel( channel )
+    , m_acquired( 0 )
+    , m_used( 0 )
+{
+}
+
+/**
+ * @brief BoundedSignalChannel::Batch::~Batch
+ *
+ * Commits the bytes of the current batch.
+ */
+BoundedSignalChannel::Batch::~Batch()
+{
+    commit();
+}
+
+/**
+ * @brief BoundedSignalChannel::Batch::acquire
+ * @param bytes - the estimated bytes carried by the signal about to be emitted
+ * @return - false if the channel was aborted (the signal should not be emitted), true otherwise
+ *
+ * Uses the bytes of the current batch if enough remain.  Otherwise the current batch is committed and a new batch large enough for the
+ * signal is acquired from the channel, which may block.
+ */
+bool BoundedSignalChannel::Batch::acquire(qint64 bytes)
+{
+    if ( m_used + bytes <= m_acquired ) {
+        m_used += bytes;
+        return true;
+    }
+
+    commit();
+
+    const qint64 batchBytes = qMax( bytes, BATCH_SIZE );
+
+    if ( ! m_channel->acquire( batchBytes ) )
+        return false;
+
+    m_acquired = batchBytes;
+    m_used = bytes;
+
+    return true;
+}
+
+/**
+ * @brief BoundedSignalChannel::Batch::commit
+ *
+ * Posts the release marker of the current batch behind the signals emitted so far.
+ */
+void BoundedSignalChannel::Batch::commit()
+{
+    if ( m_acquired > 0 )
+        m_channel->commit( m_acquired );
+
+    m_acquired = 0;
+    m_used = 0;
+}
+
+/**
+ * @brief BoundedSignalChannel::release
+ * @param bytes - the bytes of a signal handled by the GUI thread
+ *
+ * Releases the bytes and wakes the blocked producers.  The time since the previous release (or since the first bytes became pending)
+ * is the time the GUI thread needed to drain the bytes, which updates the running drain rate.
+ */
+void BoundedSignalChannel::release(qlonglong bytes)
+{
+    QMutexLocker guard( &m_mutex );
+
+    m_pending = qMax( Q_INT64_C(0), m_pending - bytes );
+
+    if ( m_drainTimer.isValid() ) {
+        const qint64 nsecs = m_drainTimer.nsecsElapsed();
+
+        if ( nsecs > 0 ) {
+            const double rate = bytes * 1000000.0 / nsecs;
+            m_drainRate = ( m_drainRate > 0.0 ) ? ( 1.0 - DRAIN_RATE_WEIGHT ) * m_drainRate + DRAIN_RATE_WEIGHT * rate : rate;
+        }
+
+        m_drainTimer.restart();
+    }
+
+    if ( 0 == m_pending )
+        m_drainTimer.invalidate();
+
+    m_released.wakeAll();
+}
+
+/**
+ * @brief BoundedSignalChannel::window
+ * @return - the bound of the pending bytes
+ *
+ * The window is the capacity, shrunk to the bytes the GUI thread drains within a time slice at the measured drain rate.  The caller holds the mutex.
+ */
+qint64 BoundedSignalChannel::window() const
+{
+    if ( m_drainRate <= 0.0 || 0 == m_timeSlice )
+        return m_capacity;
+
+    const qint64 sliceBytes = static_cast< qint64 >( m_drainRate * m_timeSlice );
+
+    return qMin( m_capacity, qMax( MIN_WINDOW, sliceBytes ) );
+}
+
+/**
+ * @brief BoundedSignalChannel::admit
+ * @param bytes - the bytes admitted
+ *
+ * Adds the bytes to the pending bytes; the drain timer starts when the first bytes become pending.  The caller holds the mutex.
+ */
+void BoundedSignalChannel::admit(qint64 bytes)
+{
+    if ( 0 == m_pending )
+        m_drainTimer.start();
+
+    m_pending += bytes;
+}
+
+
+} // GUI
+} // ArgoNavis
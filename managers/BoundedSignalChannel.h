@@ -0,0 +1,142 @@
+/*!
+   \file BoundedSignalChannel.h
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef BOUNDEDSIGNALCHANNEL_H
+#define BOUNDEDSIGNALCHANNEL_H
+
+#include <QObject>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QAtomicPointer>
+#include <QVariant>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/*!
+ * \brief The BoundedSignalChannel class
+ *
+ * Bounds the amount of data queued to the GUI thread by worker threads emitting queued signals.  Before emitting a signal a producer
+ * acquires an estimate of the bytes carried by the signal; after emitting it commits them, which posts a release marker behind the
+ * queued signal so the bytes are released once the GUI thread has handled the signal.  A producer blocks while the pending bytes exceed
+ * the window of the channel, unless the analysis task it runs is canceled.  The window is the capacity of the channel, shrunk to the
+ * number of bytes the GUI thread was measured to drain within a time slice, so the GUI thread returns to its event loop within roughly
+ * one time slice whatever the load.
+ *
+ * The channel lives in the GUI thread; acquiring from the GUI thread never blocks.  The capacity (in bytes) and the time slice (in msecs)
+ * default to the values of the OPENSS_GUI_SIGNAL_CHANNEL_CAPACITY and OPENSS_GUI_SIGNAL_CHANNEL_TIME_SLICE environment variables when set.
+ */
+
+class BoundedSignalChannel : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    static BoundedSignalChannel *instance();
+
+    void setCapacity(qint64 bytes);
+    qint64 capacity() const;
+
+    void setTimeSlice(int msecs);
+    int timeSlice() const;
+
+    qint64 pendingBytes() const;
+
+    bool acquire(qint64 bytes);
+    void commit(qint64 bytes);
+
+    static qint64 sizeOf(const QString& value);
+    static qint64 sizeOf(const QVariantList& values);
+
+    static void wakeProducers();
+
+    static void destroy();
+
+    /*!
+     * \brief The Batch class
+     *
+     * Acquires bytes from the channel in batches for a producer emitting many small signals, so the producer blocks and posts a release
+     * marker once per batch rather than once per signal.  The bytes of the current batch are committed when the next batch is acquired,
+     * when commit() is called or when the batch is destroyed.  A producer commits its batch before acquiring bytes from the channel by other
+     * means, or before finishing while other producers still publish, since the bytes of an uncommitted batch are never released.
+     */
+    class Batch
+    {
+    public:
+
+        explicit Batch(BoundedSignalChannel* channel);
+        ~Batch();
+
+        bool acquire(qint64 bytes);
+        void commit();
+
+    private:
+
+        Q_DISABLE_COPY( Batch )
+
+        BoundedSignalChannel* m_channel;
+        qint64 m_acquired;      // the bytes acquired from the channel for the current batch
+        qint64 m_used;          // the bytes of the current batch used by the signals emitted so far
+
+    };
+
+public slots:
+
+    void abort();
+
+private slots:
+
+    void release(qlonglong bytes);
+
+private:
+
+    explicit BoundedSignalChannel(QObject *parent = 0);
+
+    qint64 window() const;
+    void admit(qint64 bytes);
+
+private:
+
+    static QAtomicPointer< BoundedSignalChannel > s_instance;
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_released;
+
+    qint64 m_capacity;          // the configured bound of the pending bytes
+    int m_timeSlice;            // the time (in msecs) the GUI thread should need to drain a full window
+    qint64 m_pending;           // the bytes acquired but not yet released
+    double m_drainRate;         // the measured drain rate of the GUI thread (in bytes per msec, zero until measured)
+    QElapsedTimer m_drainTimer; // the time since the last release (valid while bytes are pending)
+    bool m_aborted;
+
+};
+
+
+} // GUI
+} // ArgoNavis
+
+#endif // BOUNDEDSIGNALCHANNEL_H
@@ -0,0 +1,359 @@
+/*!
+   \file CalltreeGraphLayout.cpp
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CalltreeGraphLayout.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QHash>
+#include <QSet>
+#include <QList>
+#include <QLineF>
+#include <QDebug>
+
+#include <gvc.h>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+// Graphviz keeps global state and is not reentrant - only one layout is computed at a time
+static QMutex s_graphvizMutex;
+
+// Graphviz node sizes are in inches
+const double POINTS_PER_INCH = 72.0;
+
+// size of the edge arrow heads
+const double ARROW_HEAD_WIDTH = 8.0;
+
+
+/**
+ * @brief setAttribute
+ * @param object - the Graphviz graph, node or edge
+ * @param name - the attribute name
+ * @param value - the attribute value
+ *
+ * Sets the attribute on the Graphviz object, declaring the attribute if necessary.
+ */
+static void setAttribute(void* object, const char* name, const QByteArray& value)
+{
+    agsafeset( object, const_cast< char* >( name ), const_cast< char* >( value.constData() ), const_cast< char* >( "" ) );
+}
+
+/**
+ * @brief edgeWeight
+ * @param edge - the Graphviz edge
+ * @return - the edge weight (the inclusive time of the call) written as the edge label by CalltreeGraphManager::write_graphviz
+ */
+static double edgeWeight(Agedge_t* edge)
+{
+    const char* label = agget( edge, const_cast< char* >( "label" ) );
+
+    return ( label ) ? QByteArray( label ).toDouble() : 0.0;
+}
+
+/**
+ * @brief toScene
+ * @param point - the Graphviz point
+ * @param top - the top of the Graphviz bounding box
+ * @return - the point in scene coordinates
+ *
+ * The Graphviz y axis points up while the scene y axis points down.
+ */
+static QPointF toScene(const pointf& point, double top)
+{
+    return QPointF( point.x, top - point.y );
+}
+
+/**
+ * @brief arrowHead
+ * @param from - the point the arrow points from
+ * @param tip - the tip of the arrow
+ * @return - the arrow head polygon
+ */
+static QPolygonF arrowHead(const QPointF& from, const QPointF& tip)
+{
+    QLineF line( tip, from );
+
+    if ( qFuzzyIsNull( line.length() ) )
+        return QPolygonF();
+
+    line.setLength( ARROW_HEAD_WIDTH * 1.25 );
+
+    const QPointF base = line.p2();
+    const QPointF normal( line.dy() * 0.4, -line.dx() * 0.4 );
+
+    QPolygonF polygon;
+    polygon << tip << base + normal << base - normal;
+
+    return polygon;
+}
+
+/**
+ * @brief computeInclusiveTimes
+ * @param graph - the Graphviz graph
+ * @param inclusiveTimes - returns the inclusive time of each node
+ * @return - the largest inclusive time
+ *
+ * The inclusive time of a function is the sum of the weights of the calls to it.  Functions without callers (the root of the
+ * calltree) use the sum of the weights of the calls they make.
+ */
+static double computeInclusiveTimes(Agraph_t* graph, QHash< Agnode_t*, double >& inclusiveTimes)
+{
+    double maximum( 0.0 );
+
+    for ( Agnode_t* node = agfstnode( graph ); node; node = agnxtnode( graph, node ) ) {
+        double inclusiveTime( 0.0 );
+        bool hasCallers( false );
+
+        for ( Agedge_t* edge = agfstin( graph, node ); edge; edge = agnxtin( graph, edge ) ) {
+            inclusiveTime += edgeWeight( edge );
+            hasCallers = true;
+        }
+
+        if ( ! hasCallers ) {
+            for ( Agedge_t* edge = agfstout( graph, node ); edge; edge = agnxtout( graph, edge ) ) {
+                inclusiveTime += edgeWeight( edge );
+            }
+        }
+
+        inclusiveTimes.insert( node, inclusiveTime );
+
+        maximum = qMax( maximum, inclusiveTime );
+    }
+
+    return maximum;
+}
+
+/**
+ * @brief pruneGraph
+ * @param graph - the Graphviz graph
+ * @param minimumInclusiveTime - the smallest inclusive time of a function kept in the graph
+ * @param inclusiveTimes - the inclusive time of each node; updated for the "other" nodes
+ * @param collapsedNodes - returns the "other" nodes
+ * @return - the number of nodes removed from the graph
+ *
+ * Keeps the nodes whose inclusive time is at least the minimum inclusive time and their ancestors.  For each kept node, the calls
+ * to nodes that are not kept are replaced by a call to a single "other" node.  The nodes that are not kept are then removed.
+ */
+static int pruneGraph(Agraph_t* graph, double minimumInclusiveTime, QHash< Agnode_t*, double >& inclusiveTimes, QSet< Agnode_t* >& collapsedNodes)
+{
+    QSet< Agnode_t* > keep;
+    QList< Agnode_t* > pending;
+
+    for ( Agnode_t* node = agfstnode( graph ); node; node = agnxtnode( graph, node ) ) {
+        if ( inclusiveTimes.value( node ) >= minimumInclusiveTime ) {
+            keep.insert( node );
+            pending << node;
+        }
+    }
+
+    // add the caller paths of the hot nodes
+    while ( ! pending.isEmpty() ) {
+        Agnode_t* node = pending.takeLast();
+        for ( Agedge_t* edge = agfstin( graph, node ); edge; edge = agnxtin( graph, edge ) ) {
+            Agnode_t* caller = agtail( edge );
+            if ( ! keep.contains( caller ) ) {
+                keep.insert( caller );
+                pending << caller;
+            }
+        }
+    }
+
+    QList< Agnode_t* > removed;
+
+    for ( Agnode_t* node = agfstnode( graph ); node; node = agnxtnode( graph, node ) ) {
+        if ( ! keep.contains( node ) )
+            removed << node;
+    }
+
+    if ( removed.isEmpty() )
+        return 0;
+
+    // collapse the calls to the removed nodes
+    const QList< Agnode_t* > kept = keep.toList();
+
+    foreach ( Agnode_t* node, kept ) {
+        int count( 0 );
+        double weight( 0.0 );
+
+        for ( Agedge_t* edge = agfstout( graph, node ); edge; edge = agnxtout( graph, edge ) ) {
+            if ( ! keep.contains( aghead( edge ) ) ) {
+                ++count;
+                weight += edgeWeight( edge );
+            }
+        }
+
+        if ( 0 == count )
+            continue;
+
+        const QByteArray name = QByteArray( "__other_" ) + QByteArray::number( collapsedNodes.size() );
+
+        Agnode_t* other = agnode( graph, const_cast< char* >( name.constData() ), 1 );
+
+        setAttribute( other, "label", QString( "%1 other function%2" ).arg( count ).arg( count > 1 ? "s" : "" ).toLocal8Bit() );
+
+        Agedge_t* edge = agedge( graph, node, other, NULL, 1 );
+
+        setAttribute( edge, "label", QByteArray::number( weight ) );
+
+        inclusiveTimes.insert( other, weight );
+        collapsedNodes.insert( other );
+    }
+
+    foreach ( Agnode_t* node, removed ) {
+        inclusiveTimes.remove( node );
+        agdelnode( graph, node );
+    }
+
+    return removed.size();
+}
+
+/**
+ * @brief CalltreeGraphLayout::CalltreeGraphLayout
+ *
+ * Constructs an empty (invalid) CalltreeGraphLayout instance.
+ */
+CalltreeGraphLayout::CalltreeGraphLayout()
+    : m_valid( false )
+    , m_prunedNodeCount( 0 )
+{
+
+}
+
+/**
+ * @brief CalltreeGraphLayout::create
+ * @param graph - DOT format data representing the calltree graph
+ * @param pruneThreshold - the fraction of the largest inclusive time below which functions are pruned (zero to keep all functions)
+ * @return - the positioned geometry of the calltree graph
+ *
+ * This method parses the DOT format data, prunes the graph and computes the layout using the Graphviz 'dot' layout engine.  The method
+ * may run in any thread; layouts requested concurrently are computed one at a time.
+ */
+CalltreeGraphLayout CalltreeGraphLayout::create(const QByteArray &graph, double pruneThreshold)
+{
+    CalltreeGraphLayout layout;
+
+    if ( graph.isEmpty() )
+        return layout;
+
+    QMutexLocker guard( &s_graphvizMutex );
+
+    Agraph_t* g = agmemread( const_cast< char* >( graph.constData() ) );
+
+    if ( ! g ) {
+        qDebug() << "CalltreeGraphLayout::create: unable to parse calltree graph";
+        return layout;
+    }
+
+    QHash< Agnode_t*, double > inclusiveTimes;
+    QSet< Agnode_t* > collapsedNodes;
+
+    const double maximumInclusiveTime = computeInclusiveTimes( g, inclusiveTimes );
+
+    if ( pruneThreshold > 0.0 && maximumInclusiveTime > 0.0 ) {
+        layout.m_prunedNodeCount = pruneGraph( g, pruneThreshold * maximumInclusiveTime, inclusiveTimes, collapsedNodes );
+    }
+
+    // set graph attributes
+    setAttribute( g, "nodesep", "0.5" );
+
+    GVC_t* gvc = gvContext();
+
+    if ( gvLayout( gvc, g, const_cast< char* >( "dot" ) ) != 0 ) {
+        qDebug() << "CalltreeGraphLayout::create: unable to layout calltree graph";
+        agclose( g );
+        gvFreeContext( gvc );
+        return layout;
+    }
+
+    const boxf bb = GD_bb( g );
+    const double top = bb.UR.y;
+
+    layout.m_boundingRect = QRectF( bb.LL.x, 0.0, bb.UR.x - bb.LL.x, bb.UR.y - bb.LL.y );
+
+    layout.m_nodes.reserve( agnnodes( g ) );
+    layout.m_edges.reserve( agnedges( g ) );
+
+    for ( Agnode_t* node = agfstnode( g ); node; node = agnxtnode( g, node ) ) {
+        Node item;
+
+        const double width = ND_width( node ) * POINTS_PER_INCH;
+        const double height = ND_height( node ) * POINTS_PER_INCH;
+        const QPointF center = toScene( ND_coord( node ), top );
+
+        item.rect = QRectF( center.x() - width / 2.0, center.y() - height / 2.0, width, height );
+        item.label = ( ND_label( node ) ) ? QString::fromLocal8Bit( ND_label( node )->text ) : QString();
+        item.inclusiveTime = inclusiveTimes.value( node );
+        item.rank = ND_rank( node );
+        item.collapsed = collapsedNodes.contains( node );
+
+        layout.m_nodes << item;
+
+        for ( Agedge_t* edge = agfstout( g, node ); edge; edge = agnxtout( g, edge ) ) {
+            Edge edgeItem;
+
+            edgeItem.rank = ND_rank( node );
+
+            const splines* spl = ED_spl( edge );
+
+            for ( int i=0; spl && i<spl->size; ++i ) {
+                const bezier& bz = spl->list[i];
+
+                if ( bz.size < 1 )
+                    continue;
+
+                const QPointF first = toScene( bz.list[0], top );
+                const QPointF last = toScene( bz.list[bz.size-1], top );
+
+                edgeItem.path.moveTo( first );
+                for ( int j=1; j+2<bz.size; j+=3 ) {
+                    edgeItem.path.cubicTo( toScene( bz.list[j], top ), toScene( bz.list[j+1], top ), toScene( bz.list[j+2], top ) );
+                }
+
+                if ( bz.eflag ) {
+                    edgeItem.arrowHead = arrowHead( last, toScene( bz.ep, top ) );
+                }
+            }
+
+            if ( ED_label( edge ) ) {
+                edgeItem.label = QString::fromLocal8Bit( ED_label( edge )->text );
+                edgeItem.labelPosition = toScene( ED_label( edge )->pos, top );
+            }
+
+            layout.m_edges << edgeItem;
+        }
+    }
+
+    gvFreeLayout( gvc, g );
+    agclose( g );
+    gvFreeContext( gvc );
+
+    layout.m_valid = true;
+
+    return layout;
+}
+
+
+} // GUI
+} // ArgoNavis
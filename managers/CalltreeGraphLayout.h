@@ -0,0 +1,99 @@
+/*!
+   \file CalltreeGraphLayout.h
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CALLTREEGRAPHLAYOUT_H
+#define CALLTREEGRAPHLAYOUT_H
+
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QRectF>
+#include <QPointF>
+#include <QPolygonF>
+#include <QPainterPath>
+
+#include "common/openss-gui-config.h"
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/*!
+ * \brief The CalltreeGraphLayout class
+ *
+ * Positioned geometry of a calltree graph computed by the Graphviz 'dot' layout engine from the DOT format data written by
+ * CalltreeGraphManager::write_graphviz.  The layout holds no Qt GUI objects so it can be computed by a worker thread and handed
+ * to the GUI thread which creates the graphics items.  Scene coordinates are in points with the y axis pointing down.
+ *
+ * Before the layout is computed the graph can be pruned to the hot subgraph: only functions whose inclusive time is at least the
+ * prune threshold (a fraction of the largest inclusive time) and the functions on their caller paths are kept.  The calls from a
+ * kept function to functions that are not kept are collapsed into a single "other" node per calling function.
+ */
+
+class CalltreeGraphLayout
+{
+public:
+
+    struct Node {
+        QString label;
+        QRectF rect;
+        double inclusiveTime;
+        int rank;                   // the level of the node in the layout
+        bool collapsed;             // an "other" node representing pruned functions
+    };
+
+    struct Edge {
+        QPainterPath path;
+        QPolygonF arrowHead;
+        QString label;
+        QPointF labelPosition;      // center of the label
+        int rank;                   // the level of the calling node
+    };
+
+    CalltreeGraphLayout();
+
+    static CalltreeGraphLayout create(const QByteArray& graph, double pruneThreshold);
+
+    bool isValid() const { return m_valid; }
+
+    QRectF boundingRect() const { return m_boundingRect; }
+    const QVector< Node >& nodes() const { return m_nodes; }
+    const QVector< Edge >& edges() const { return m_edges; }
+
+    int prunedNodeCount() const { return m_prunedNodeCount; }
+
+private:
+
+    bool m_valid;
+    QRectF m_boundingRect;
+    QVector< Node > m_nodes;
+    QVector< Edge > m_edges;
+    int m_prunedNodeCount;
+
+};
+
+
+} // GUI
+} // ArgoNavis
+
+#endif // CALLTREEGRAPHLAYOUT_H
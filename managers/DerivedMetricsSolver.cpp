@@ -201,12 +201,13 @@ bool DerivedMetricsSolver::isLeftAssociative(const QString& op) const
 /**
  * @brief DerivedMetricsSolver::convertInfixToRPN
  * @param infix - the equal in infix order
+ * @param operands - names which are operands of the equation rather than operators
  * @return - the equivalent equation in postfix (reverse polish notation) order
  *
  * This method converts an equation from infix to postfix (reverse polish notation) order.
  * Edsger Dijkstra's "shunting-yard" algorithm is used - ref. "https://en.wikipedia.org/wiki/Shunting-yard_algorithm".
  */
-std::vector<QString> DerivedMetricsSolver::convertInfixToRPN(const QString& infix) const
+std::vector<QString> DerivedMetricsSolver::convertInfixToRPN(const QString& infix, const QStringList& operands) const
 {
     const QStringList tokenList = infix.split( ' ', QString::SkipEmptyParts );
 
@@ -217,7 +218,7 @@ std::vector<QString> DerivedMetricsSolver::convertInfixToRPN(const QString& infi
 
     foreach ( const QString& token, tokenList ) {
         token.toDouble( &ok );
-        if ( ok ) {
+        if ( ok || operands.contains( token ) ) {
             outputQueue.push( token );
         }
         else {
@@ -357,5 +358,76 @@ void DerivedMetricsSolver::setEnabled(const QString &key, bool enabled)
     }
 }
 
+/**
+ * @brief DerivedMetricsSolver::solve
+ * @param key - the derived metric name
+ * @param hwCounterNames - the PAPI event names of the HW counter columns
+ * @param hwCounterColumns - the HW counter values of each row in a column per PAPI event name
+ * @return - returns the result of solving the formula for each row
+ *
+ * This function solves the formula for every row of HW counter values.  The formula is converted to postfix (reverse polish notation)
+ * once with each PAPI event name resolved to its column; the postfix vector is then processed sequentially for each row.  If the formula
+ * refers to a PAPI event name without a column, the result is zero for every row.
+ */
+QVector<double> DerivedMetricsSolver::solve(const QString &key, const QStringList &hwCounterNames, const std::vector< QVector<qulonglong> > &hwCounterColumns) const
+{
+    const int rowCount = hwCounterColumns.empty() ? 0 : hwCounterColumns.front().size();
+
+    QVector<double> results( rowCount, 0.0 );
+
+    if ( m_derived_definitions.find(key) == m_derived_definitions.end() )
+        return results;
+
+    if ( ! m_derived_definitions[key].enabled )
+        return results;
+
+    // convert equation from infix to postfix (reverse polish notation)
+    const std::vector<QString> equationRPN = convertInfixToRPN( m_derived_definitions[key].formula, hwCounterNames );
+
+    // each operand is either a HW counter column (index >= 0) or a constant (index == -1)
+    std::vector< int > columns( equationRPN.size(), -1 );
+    std::vector< double > constants( equationRPN.size(), 0.0 );
+
+    for ( std::size_t i=0; i<equationRPN.size(); ++i ) {
+        const QString& top = equationRPN.at( i );
+        const int column = hwCounterNames.indexOf( top );
+        if ( column >= 0 && column < (int) hwCounterColumns.size() ) {
+            columns[i] = column;
+        }
+        else if ( top.contains( QStringLiteral("PAPI") ) ) {
+            // check to make sure equation has a value for every PAPI event name
+            return results;
+        }
+        else {
+            constants[i] = top.toDouble();
+        }
+    }
+
+    QStack<double> s;
+
+    for ( int row=0; row<rowCount; ++row ) {
+        s.clear();
+
+        for ( std::size_t i=0; i<equationRPN.size(); ++i ) {
+            const QString& top = equationRPN.at( i );
+            if ( top == "+" || top == "-" || top == "*" || top == "/" ) {
+                double op2 = s.pop();
+                double op1 = s.pop();
+                s.push ( evaluate( op1, op2, top[0] ) );
+            }
+            else if ( columns[i] >= 0 ) {
+                s.push( hwCounterColumns[ columns[i] ][ row ] );
+            }
+            else {
+                s.push( constants[i] );
+            }
+        }
+
+        results[row] = ( s.size() == 1 ) ? s.top() : 0.0;
+    }
+
+    return results;
+}
+
 } // GUI
 } // ArgoNavis
@@ -54,6 +54,7 @@ public:
     QStringList getDerivedMetricList(const std::set<QString>& configured) const;
 
     double solve(const QString &formula, QMap<QString, qulonglong> hwCounterValues) const;
+    QVector<double> solve(const QString &key, const QStringList &hwCounterNames, const std::vector< QVector<qulonglong> > &hwCounterColumns) const;
 
     QVector<QVariantList> getDerivedMetricData() const;
 
@@ -67,7 +68,7 @@ private:
     bool isHigherPrecedence(const QString &op1, const QString &op2) const;
     bool isLeftAssociative(const QString &op) const;
 
-    std::vector<QString> convertInfixToRPN(const QString &infix) const;
+    std::vector<QString> convertInfixToRPN(const QString &infix, const QStringList &operands = QStringList()) const;
 
     double evaluate(double lhs, double rhs, const QChar &op) const;
 
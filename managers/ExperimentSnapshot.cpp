@@ -0,0 +1,478 @@
+/*!
+   \file ExperimentSnapshot.cpp
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "ExperimentSnapshot.h"
+
+#include <QVector>
+#include <QFileInfo>
+#include <QDir>
+#include <QDebug>
+
+#include <cstring>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/**
+ * @brief ExperimentSnapshot::ExperimentSnapshot
+ * @param filePath - the snapshot file to open
+ *
+ * Constructs an ExperimentSnapshot instance by memory-mapping the snapshot file and validating the file header and section directory.
+ * Use ExperimentSnapshot::isValid to determine whether the snapshot was opened successfully.
+ */
+ExperimentSnapshot::ExperimentSnapshot(const QString &filePath)
+    : m_file( filePath )
+    , m_data( Q_NULLPTR )
+    , m_size( 0 )
+{
+    if ( ! m_file.open( QFile::ReadOnly ) ) {
+        m_errorString = m_file.errorString();
+        return;
+    }
+
+    m_size = m_file.size();
+
+    if ( m_size < sizeof(FileHeader) ) {
+        m_errorString = QStringLiteral("file too small to be an experiment snapshot");
+        return;
+    }
+
+    // map the entire file - the pages of the file are only read when accessed
+    const uchar* data = m_file.map( 0, m_size );
+
+    if ( Q_NULLPTR == data ) {
+        m_errorString = m_file.errorString();
+        return;
+    }
+
+    const FileHeader* header = reinterpret_cast< const FileHeader* >( data );
+
+    if ( header->magic != MAGIC ) {
+        m_errorString = QStringLiteral("not an experiment snapshot or byte order mismatch");
+        return;
+    }
+
+    if ( header->version != VERSION ) {
+        m_errorString = QString("unsupported experiment snapshot version %1").arg( header->version );
+        return;
+    }
+
+    // the bounds are checked without computing sums or products which may wrap around for a corrupt file
+    if ( header->fileSize != m_size ||
+         header->directoryOffset > m_size ||
+         header->sectionCount > ( m_size - header->directoryOffset ) / sizeof(SectionEntry) ) {
+        m_errorString = QStringLiteral("truncated experiment snapshot");
+        return;
+    }
+
+    if ( header->directoryOffset % sizeof(quint64) != 0 ) {
+        m_errorString = QStringLiteral("misaligned experiment snapshot directory");
+        return;
+    }
+
+    const SectionEntry* directory = reinterpret_cast< const SectionEntry* >( data + header->directoryOffset );
+
+    for ( quint32 i=0; i<header->sectionCount; ++i ) {
+        const SectionEntry& entry = directory[i];
+        if ( 0 == entry.elementSize ||
+             entry.offset > m_size ||
+             entry.offset % SECTION_ALIGNMENT != 0 ||
+             entry.count > ( m_size - entry.offset ) / entry.elementSize ) {
+            m_errorString = QString("invalid experiment snapshot section %1").arg( entry.id );
+            m_sections.clear();
+            return;
+        }
+        m_sections.insert( entry.id, entry );
+    }
+
+    m_data = data;
+}
+
+/**
+ * @brief ExperimentSnapshot::~ExperimentSnapshot
+ *
+ * Destroys the ExperimentSnapshot instance.  The file mapping is released when the file is closed.
+ */
+ExperimentSnapshot::~ExperimentSnapshot()
+{
+    m_file.close();
+}
+
+/**
+ * @brief ExperimentSnapshot::isValid
+ * @return - whether the snapshot file was opened and validated successfully
+ */
+bool ExperimentSnapshot::isValid() const
+{
+    return m_data != Q_NULLPTR;
+}
+
+/**
+ * @brief ExperimentSnapshot::errorString
+ * @return - description of the reason the snapshot file could not be opened
+ */
+QString ExperimentSnapshot::errorString() const
+{
+    return m_errorString;
+}
+
+/**
+ * @brief ExperimentSnapshot::hasColumn
+ * @param id - the column identifier
+ * @return - whether the snapshot contains the column
+ */
+bool ExperimentSnapshot::hasColumn(ExperimentSnapshot::ColumnId id) const
+{
+    return m_sections.contains( id );
+}
+
+/**
+ * @brief ExperimentSnapshot::rowRange
+ * @param offsetsId - the row offsets column identifier
+ * @param index - the index of the thread (or other entity) whose rows are requested
+ * @param first - the first row
+ * @param last - one past the last row
+ * @return - whether the row offsets column has an entry for the index
+ *
+ * This function returns the range of rows [ first, last ) indexed by the row offsets column for the specified index.
+ */
+bool ExperimentSnapshot::rowRange(ExperimentSnapshot::ColumnId offsetsId, quint32 index, quint64 &first, quint64 &last) const
+{
+    quint64 count;
+
+    const quint64* offsets = column< quint64 >( offsetsId, count );
+
+    first = last = 0;
+
+    if ( Q_NULLPTR == offsets || count < 2 || index > count - 2 || offsets[index] > offsets[index+1] )
+        return false;
+
+    first = offsets[index];
+    last = offsets[index+1];
+
+    return true;
+}
+
+/**
+ * @brief ExperimentSnapshot::stringCount
+ * @return - the number of strings in the snapshot string table
+ */
+quint64 ExperimentSnapshot::stringCount() const
+{
+    quint64 count;
+
+    column< quint64 >( STRING_OFFSETS, count );
+
+    return ( count > 0 ) ? count - 1 : 0;
+}
+
+/**
+ * @brief ExperimentSnapshot::string
+ * @param index - the string index
+ * @return - the string from the snapshot string table
+ *
+ * This function returns the specified string from the snapshot string table.
+ */
+QString ExperimentSnapshot::string(quint32 index) const
+{
+    quint64 offsetCount, dataCount;
+
+    const quint64* offsets = column< quint64 >( STRING_OFFSETS, offsetCount );
+    const char* data = column< char >( STRING_DATA, dataCount );
+
+    if ( Q_NULLPTR == offsets || Q_NULLPTR == data || offsetCount < 2 || index > offsetCount - 2 ||
+         offsets[index] > offsets[index+1] || offsets[index+1] > dataCount )
+        return QString();
+
+    return QString::fromUtf8( data + offsets[index], offsets[index+1] - offsets[index] );
+}
+
+/**
+ * @brief ExperimentSnapshot::threadCount
+ * @return - the number of threads in the snapshot
+ */
+quint32 ExperimentSnapshot::threadCount() const
+{
+    quint64 count;
+
+    column< qint64 >( THREAD_PROCESS_ID, count );
+
+    return count;
+}
+
+
+// the bytes of a column buffered before they are spooled to the temporary file of the column
+const int SPOOL_BUFFER_SIZE = 256 * 1024;
+
+
+/**
+ * @brief ExperimentSnapshotWriter::ExperimentSnapshotWriter
+ * @param filePath - the snapshot file to write
+ *
+ * Constructs an ExperimentSnapshotWriter instance.  The temporary files of the columns are created in the directory of the snapshot file.
+ */
+ExperimentSnapshotWriter::ExperimentSnapshotWriter(const QString &filePath)
+    : m_filePath( filePath )
+    , m_failed( false )
+{
+    // the string table offsets always start with zero
+    append( ExperimentSnapshot::STRING_OFFSETS, quint64( 0 ) );
+}
+
+/**
+ * @brief ExperimentSnapshotWriter::~ExperimentSnapshotWriter
+ *
+ * Destroys the ExperimentSnapshotWriter instance.  The temporary files of the columns are removed.
+ */
+ExperimentSnapshotWriter::~ExperimentSnapshotWriter()
+{
+
+}
+
+/**
+ * @brief ExperimentSnapshotWriter::addString
+ * @param str - the string to add to the string table
+ * @return - the index of the string in the string table
+ *
+ * Add the string to the string table if not already present and return its index.
+ */
+quint32 ExperimentSnapshotWriter::addString(const std::string &str)
+{
+    const QByteArray key( str.data(), str.size() );
+
+    QHash< QByteArray, quint32 >::const_iterator iter = m_stringIndex.constFind( key );
+    if ( iter != m_stringIndex.constEnd() )
+        return iter.value();
+
+    const quint32 index = m_stringIndex.size();
+
+    m_stringIndex.insert( key, index );
+
+    appendData( ExperimentSnapshot::STRING_DATA, sizeof(char), key.constData(), key.size() );
+
+    appendRowOffset( ExperimentSnapshot::STRING_OFFSETS, ExperimentSnapshot::STRING_DATA );
+
+    return index;
+}
+
+/**
+ * @brief ExperimentSnapshotWriter::appendRowOffset
+ * @param offsetsId - the row offsets column identifier
+ * @param rowsId - identifier of a column of the rows being indexed
+ *
+ * Append the current number of rows to the row offsets column.  Called once before the rows of the first thread are added and
+ * once after the rows of each thread are added.
+ */
+void ExperimentSnapshotWriter::appendRowOffset(ExperimentSnapshot::ColumnId offsetsId, ExperimentSnapshot::ColumnId rowsId)
+{
+    append( offsetsId, quint64( count( rowsId ) ) );
+}
+
+/**
+ * @brief ExperimentSnapshotWriter::count
+ * @param id - the column identifier
+ * @return - the number of elements currently in the column
+ */
+quint64 ExperimentSnapshotWriter::count(ExperimentSnapshot::ColumnId id) const
+{
+    QMap< quint32, Column >::const_iterator iter = m_columns.constFind( id );
+
+    if ( iter == m_columns.constEnd() )
+        return 0;
+
+    return iter.value().count;
+}
+
+/**
+ * @brief ExperimentSnapshotWriter::appendData
+ * @param id - the column identifier
+ * @param elementSize - the size of an element of the column
+ * @param data - the elements to append
+ * @param count - the number of elements to append
+ *
+ * Append the elements to the buffer of the column and spool the buffer once it is full.
+ */
+void ExperimentSnapshotWriter::appendData(quint32 id, quint32 elementSize, const char *data, quint64 count)
+{
+    Column& column = m_columns[ id ];
+
+    if ( 0 == column.elementSize )
+        column.elementSize = elementSize;
+
+    Q_ASSERT( column.elementSize == elementSize );
+
+    column.buffer.append( data, count * elementSize );
+    column.count += count;
+
+    if ( column.buffer.size() >= SPOOL_BUFFER_SIZE && ! flush( column ) )
+        m_failed = true;
+}
+
+/**
+ * @brief ExperimentSnapshotWriter::flush
+ * @param column - the column to spool
+ * @return - whether the buffer of the column was spooled successfully
+ *
+ * Spool the buffer of the column to the temporary file of the column.
+ */
+bool ExperimentSnapshotWriter::flush(ExperimentSnapshotWriter::Column &column)
+{
+    if ( column.buffer.isEmpty() )
+        return true;
+
+    if ( column.spool.isNull() ) {
+        const QFileInfo fileInfo( m_filePath );
+        column.spool = QSharedPointer< QTemporaryFile >( new QTemporaryFile( fileInfo.absoluteDir().filePath( fileInfo.fileName() + ".XXXXXX" ) ) );
+        if ( ! column.spool->open() ) {
+            qDebug() << "ExperimentSnapshotWriter::flush: unable to create temporary file" << column.spool->errorString();
+            return false;
+        }
+    }
+
+    if ( column.spool->write( column.buffer ) != column.buffer.size() )
+        return false;
+
+    column.buffer.clear();
+
+    return true;
+}
+
+/**
+ * @brief ExperimentSnapshotWriter::write
+ * @return - whether the snapshot file was written successfully
+ *
+ * Write the snapshot file.  Each column is copied from its temporary file into its own section starting on a page boundary followed
+ * by the section directory.  The file is written under a temporary name and renamed once complete, so neither an incomplete file nor
+ * a partially overwritten previous snapshot is ever recognized as a valid snapshot.
+ */
+bool ExperimentSnapshotWriter::write()
+{
+    if ( m_failed )
+        return false;
+
+    QFile file( m_filePath + ".part" );
+
+    if ( ! file.open( QFile::WriteOnly | QFile::Truncate ) ) {
+        qDebug() << "ExperimentSnapshotWriter::write: unable to open" << file.fileName() << file.errorString();
+        return false;
+    }
+
+    if ( ! writeFile( file ) ) {
+        qDebug() << "ExperimentSnapshotWriter::write: unable to write" << file.fileName() << file.errorString();
+        file.remove();
+        return false;
+    }
+
+    // replace the previous snapshot (if any) - a reader which has the previous snapshot mapped keeps reading the previous file
+    QFile::remove( m_filePath );
+
+    return file.rename( m_filePath );
+}
+
+/**
+ * @brief ExperimentSnapshotWriter::writeFile
+ * @param file - the opened file to write
+ * @return - whether the file was written successfully
+ *
+ * Write the sections, the section directory and finally the file header in the ExperimentSnapshot file layout.
+ */
+bool ExperimentSnapshotWriter::writeFile(QFile &file)
+{
+    ExperimentSnapshot::FileHeader header;
+    memset( &header, 0, sizeof(header) );
+
+    if ( file.write( reinterpret_cast< const char* >( &header ), sizeof(header) ) != sizeof(header) )
+        return false;
+
+    QVector< ExperimentSnapshot::SectionEntry > directory;
+    const QByteArray padding( ExperimentSnapshot::SECTION_ALIGNMENT, '\0' );
+    QByteArray chunk;
+
+    for ( QMap< quint32, Column >::iterator iter = m_columns.begin(); iter != m_columns.end(); ++iter ) {
+        Column& column = iter.value();
+
+        if ( 0 == column.elementSize )
+            continue;
+
+        // start each section on a page boundary
+        const qint64 remainder = file.pos() % ExperimentSnapshot::SECTION_ALIGNMENT;
+        if ( remainder != 0 )
+            file.write( padding.constData(), ExperimentSnapshot::SECTION_ALIGNMENT - remainder );
+
+        ExperimentSnapshot::SectionEntry entry;
+        entry.id = iter.key();
+        entry.elementSize = column.elementSize;
+        entry.offset = file.pos();
+        entry.count = column.count;
+
+        // copy the spooled elements followed by the elements still buffered
+        if ( ! column.spool.isNull() ) {
+            if ( ! column.spool->seek( 0 ) )
+                return false;
+            while ( ! column.spool->atEnd() ) {
+                chunk = column.spool->read( SPOOL_BUFFER_SIZE );
+                if ( chunk.isEmpty() || file.write( chunk ) != chunk.size() )
+                    return false;
+            }
+            column.spool.clear();
+        }
+
+        if ( file.write( column.buffer ) != column.buffer.size() )
+            return false;
+
+        column.buffer.clear();
+
+        if ( quint64( file.pos() ) - entry.offset != entry.count * entry.elementSize )
+            return false;
+
+        directory << entry;
+    }
+
+    // align the directory for direct access from the mapped file
+    const qint64 remainder = file.pos() % sizeof(quint64);
+    if ( remainder != 0 )
+        file.write( padding.constData(), sizeof(quint64) - remainder );
+
+    header.magic = ExperimentSnapshot::MAGIC;
+    header.version = ExperimentSnapshot::VERSION;
+    header.sectionCount = directory.size();
+    header.directoryOffset = file.pos();
+
+    const qint64 directorySize = directory.size() * sizeof(ExperimentSnapshot::SectionEntry);
+    if ( file.write( reinterpret_cast< const char* >( directory.constData() ), directorySize ) != directorySize )
+        return false;
+
+    header.fileSize = file.pos();
+
+    if ( ! file.seek( 0 ) || file.write( reinterpret_cast< const char* >( &header ), sizeof(header) ) != sizeof(header) )
+        return false;
+
+    file.close();
+
+    return file.error() == QFile::NoError;
+}
+
+
+} // GUI
+} // ArgoNavis
@@ -0,0 +1,265 @@
+/*!
+   \file ExperimentSnapshot.h
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef EXPERIMENTSNAPSHOT_H
+#define EXPERIMENTSNAPSHOT_H
+
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QMap>
+#include <QSharedPointer>
+#include <QTemporaryFile>
+
+#include <string>
+
+#include "common/openss-gui-config.h"
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/*!
+ * \brief The ExperimentSnapshot class
+ *
+ * Read-only access to a columnar binary snapshot of an experiment database.  The snapshot file is memory-mapped, so opening
+ * a snapshot only validates the file header and section directory; the pages of a column are read by the operating system
+ * when first accessed.
+ *
+ * File layout (native byte order, the magic number identifies a byte order mismatch):
+ *
+ *   FileHeader                                  - at offset zero
+ *   column sections                             - each section starts on a page boundary and is a packed array of fixed size elements
+ *   SectionEntry[ FileHeader::sectionCount ]    - the section directory at FileHeader::directoryOffset
+ *
+ * Rows belonging to a thread are contiguous; the *_THREAD_OFFSETS columns hold (thread count + 1) row offsets so the rows of
+ * thread 'i' are in the range [ offsets[i], offsets[i+1] ) (see ExperimentSnapshot::rowRange).  The other *_OFFSETS columns index
+ * variable length rows (the definitions of a function, the frames of a stack trace) the same way.  Strings are stored once in
+ * STRING_DATA and referenced by index.
+ */
+
+class ExperimentSnapshot
+{
+public:
+
+    static const quint32 MAGIC = 0x50414e53;    // "SNAP"
+    static const quint32 VERSION = 1;
+    static const quint64 SECTION_ALIGNMENT = 4096;
+
+    // NOTE: column identifiers are stored in the file, so existing values must never change
+    typedef enum {
+        STRING_OFFSETS = 1,                     // quint64 [ string count + 1 ]
+        STRING_DATA = 2,                        // char (UTF-8, not null-terminated)
+        TIME_INTERVAL = 3,                      // quint64 [ 2 ] - begin and end of the experiment extent (nanoseconds) - the begin is the time origin
+        THREAD_HOST = 10,                       // quint32 string index
+        THREAD_PROCESS_ID = 11,                 // qint64
+        THREAD_POSIX_THREAD_ID = 12,            // qint64 (-1 if not available)
+        THREAD_MPI_RANK = 13,                   // qint32 (-1 if not available)
+        THREAD_OPENMP_THREAD_ID = 14,           // qint32 (-1 if not available)
+        LINKED_OBJECT_PATH = 20,                // quint32 string index
+        FUNCTION_NAME = 30,                     // quint32 string index
+        FUNCTION_LINKED_OBJECT = 31,            // quint32 linked object index
+        FUNCTION_DEFINITION_OFFSETS = 32,       // quint64 [ function count + 1 ] - definition offsets
+        FUNCTION_DEFINITION_PATH = 33,          // quint32 string index
+        FUNCTION_DEFINITION_LINE = 34,          // qint32
+        STATEMENT_PATH = 40,                    // quint32 string index
+        STATEMENT_LINE = 41,                    // qint32
+        FUNCTION_METRIC_NAME = 50,              // quint32 [ 1 ] string index of the metric evaluated
+        FUNCTION_METRIC_THREAD_OFFSETS = 51,    // quint64 [ thread count + 1 ]
+        FUNCTION_METRIC_FUNCTION = 52,          // quint32 function index
+        FUNCTION_METRIC_VALUE = 53,             // double
+        CALL_SITE_OFFSETS = 60,                 // quint64 [ call site count + 1 ] - frame offsets
+        CALL_SITE_FRAME_ADDRESS = 61,           // quint64
+        CALL_SITE_FRAME_FUNCTION = 62,          // quint32 function index (NO_INDEX if not resolved)
+        COUNTER_NAME = 70,                      // quint32 string index
+        DATA_TRANSFER_THREAD_OFFSETS = 80,      // quint64 [ thread count + 1 ]
+        DATA_TRANSFER_TIME_BEGIN = 81,          // quint64 (relative to time origin)
+        DATA_TRANSFER_TIME_END = 82,            // quint64 (relative to time origin)
+        DATA_TRANSFER_SIZE = 83,                // quint64
+        DATA_TRANSFER_KIND = 84,                // quint32 string index
+        DATA_TRANSFER_CALL_SITE = 85,           // quint32
+        DATA_TRANSFER_DEVICE = 86,              // quint32
+        KERNEL_EXECUTION_THREAD_OFFSETS = 90,   // quint64 [ thread count + 1 ]
+        KERNEL_EXECUTION_TIME_BEGIN = 91,       // quint64 (relative to time origin)
+        KERNEL_EXECUTION_TIME_END = 92,         // quint64 (relative to time origin)
+        KERNEL_EXECUTION_FUNCTION = 93,         // quint32 string index
+        KERNEL_EXECUTION_CALL_SITE = 94,        // quint32
+        KERNEL_EXECUTION_DEVICE = 95,           // quint32
+        PERIODIC_SAMPLE_THREAD_OFFSETS = 100,   // quint64 [ thread count + 1 ]
+        PERIODIC_SAMPLE_TIME = 101,             // quint64 (relative to time origin)
+        PERIODIC_SAMPLE_COUNTS = 102,           // quint64 [ sample count * counter count ] - row major
+        STACK_TRACE_OFFSETS = 110,              // quint64 [ stack trace count + 1 ] - frame offsets
+        STACK_TRACE_FRAME_ADDRESS = 111,        // quint64
+        STACK_TRACE_FRAME_FUNCTION = 112,       // quint32 function index (NO_INDEX if not resolved)
+        TRACE_EVENT_METRIC_NAME = 120,          // quint32 [ 1 ] string index of the details metric evaluated
+        TRACE_EVENT_THREAD_OFFSETS = 121,       // quint64 [ thread count + 1 ]
+        TRACE_EVENT_TIME_BEGIN = 122,           // quint64 (relative to time origin)
+        TRACE_EVENT_TIME_END = 123,             // quint64 (relative to time origin)
+        TRACE_EVENT_FUNCTION = 124,             // quint32 function index
+        TRACE_EVENT_STACK_TRACE = 125,          // quint32 stack trace index
+        STACK_SAMPLE_METRIC_NAME = 130,         // quint32 [ 1 ] string index of the details metric evaluated
+        STACK_SAMPLE_THREAD_OFFSETS = 131,      // quint64 [ thread count + 1 ]
+        STACK_SAMPLE_STACK_TRACE = 132,         // quint32 stack trace index
+        STACK_SAMPLE_COUNT = 133,               // quint64
+        STACK_SAMPLE_TIME = 134                 // double (seconds)
+    } ColumnId;
+
+    static const quint32 NO_INDEX = 0xffffffff;
+
+    struct FileHeader {
+        quint32 magic;
+        quint32 version;
+        quint32 sectionCount;
+        quint32 reserved;
+        quint64 directoryOffset;
+        quint64 fileSize;
+    };
+
+    struct SectionEntry {
+        quint32 id;
+        quint32 elementSize;
+        quint64 offset;
+        quint64 count;
+    };
+
+    explicit ExperimentSnapshot(const QString& filePath);
+    virtual ~ExperimentSnapshot();
+
+    bool isValid() const;
+    QString errorString() const;
+
+    bool hasColumn(ColumnId id) const;
+
+    template <typename T>
+    const T* column(ColumnId id, quint64& count) const;
+
+    bool rowRange(ColumnId offsetsId, quint32 index, quint64& first, quint64& last) const;
+
+    quint64 stringCount() const;
+    QString string(quint32 index) const;
+
+    quint32 threadCount() const;
+
+private:
+
+    QFile m_file;
+    const uchar* m_data;
+    quint64 m_size;
+    QString m_errorString;
+    QHash< quint32, SectionEntry > m_sections;
+
+};
+
+/**
+ * @brief ExperimentSnapshot::column
+ * @param id - the column identifier
+ * @param count - the number of elements in the column
+ * @return - pointer to the first element of the column in the mapped file or NULL if not present or element type doesn't match
+ *
+ * This function returns a pointer to the column elements directly within the memory-mapped snapshot file.
+ */
+template <typename T>
+const T* ExperimentSnapshot::column(ExperimentSnapshot::ColumnId id, quint64& count) const
+{
+    count = 0;
+
+    if ( Q_NULLPTR == m_data || ! m_sections.contains( id ) )
+        return Q_NULLPTR;
+
+    const SectionEntry& entry = m_sections[ id ];
+
+    if ( entry.elementSize != sizeof(T) )
+        return Q_NULLPTR;
+
+    count = entry.count;
+
+    return reinterpret_cast< const T* >( m_data + entry.offset );
+}
+
+
+/*!
+ * \brief The ExperimentSnapshotWriter class
+ *
+ * Writes the columns of an experiment snapshot in the ExperimentSnapshot file layout.  The values appended to a column are buffered
+ * and spooled to a temporary file in the directory of the snapshot file, so the size of a column is not bounded by the memory of the
+ * process.  The spooled columns are copied into the sections of the snapshot file by ExperimentSnapshotWriter::write.
+ */
+
+class ExperimentSnapshotWriter
+{
+public:
+
+    explicit ExperimentSnapshotWriter(const QString& filePath);
+    virtual ~ExperimentSnapshotWriter();
+
+    quint32 addString(const std::string& str);
+
+    template <typename T>
+    void append(ExperimentSnapshot::ColumnId id, const T& value);
+
+    void appendRowOffset(ExperimentSnapshot::ColumnId offsetsId, ExperimentSnapshot::ColumnId rowsId);
+
+    quint64 count(ExperimentSnapshot::ColumnId id) const;
+
+    bool write();
+
+private:
+
+    struct Column {
+        Column() : elementSize( 0 ), count( 0 ) { }
+        quint32 elementSize;
+        quint64 count;                              // the number of elements appended (buffered or spooled)
+        QByteArray buffer;                          // the elements not yet spooled
+        QSharedPointer< QTemporaryFile > spool;     // the elements spooled (created when the buffer is first flushed)
+    };
+
+    void appendData(quint32 id, quint32 elementSize, const char* data, quint64 count);
+    bool flush(Column& column);
+    bool writeFile(QFile& file);
+
+    QString m_filePath;
+    QMap< quint32, Column > m_columns;
+    QHash< QByteArray, quint32 > m_stringIndex;
+    bool m_failed;
+
+};
+
+/**
+ * @brief ExperimentSnapshotWriter::append
+ * @param id - the column identifier
+ * @param value - the value to append
+ *
+ * Append the value to the specified column.  All values of a column must have the same type.
+ */
+template <typename T>
+void ExperimentSnapshotWriter::append(ExperimentSnapshot::ColumnId id, const T& value)
+{
+    appendData( id, sizeof(T), reinterpret_cast< const char* >( &value ), 1 );
+}
+
+
+} // GUI
+} // ArgoNavis
+
+#endif // EXPERIMENTSNAPSHOT_H
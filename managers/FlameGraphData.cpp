@@ -0,0 +1,252 @@
+/*!
+   \file FlameGraphData.cpp
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "FlameGraphData.h"
+
+#include <QPair>
+
+#include <algorithm>
+#include <vector>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/**
+ * @brief FlameGraphData::FlameGraphData
+ *
+ * Constructs an empty FlameGraphData instance.
+ */
+FlameGraphData::FlameGraphData()
+    : m_maxDepth( 0 )
+{
+
+}
+
+/**
+ * @brief FlameGraphData::create
+ * @param trie - the stack trace trie containing the sampled call paths
+ * @param leafValues - the metric value of each sampled call path (keyed by the trie node of its innermost frame)
+ * @return - the flame graph data
+ *
+ * This method merges the call paths of all threads by function into a prefix tree, computes the inclusive value of each frame and
+ * flattens the tree in preorder with the horizontal extents of the frames.  Each trie node is visited once as the mapping from trie
+ * nodes to prefix tree nodes is memoized.
+ */
+FlameGraphData FlameGraphData::create(const StackTraceTrie &trie, const QHash< StackTraceTrie::NodeId, double > &leafValues)
+{
+    FlameGraphData data;
+
+    if ( leafValues.isEmpty() )
+        return data;
+
+    const int functionCount = trie.functionCount();
+
+    for ( int i=0; i<functionCount; ++i ) {
+        data.m_names << QString::fromStdString( trie.function( i ).getDemangledName() );
+    }
+
+    const int unknownNameIndex = data.m_names.size();
+    data.m_names << QStringLiteral("[unknown]");
+
+    struct Node {
+        quint32 parent;
+        qint32 nameIndex;
+        quint32 depth;
+        double value;
+    };
+
+    // node 0 is the root; parents are always created before their children
+    Node root = { NO_FRAME, -1, 0, 0.0 };
+    std::vector< Node > nodes( 1, root );
+
+    QHash< QPair< quint32, qint32 >, quint32 > children;
+    QHash< StackTraceTrie::NodeId, quint32 > mapped;
+
+    std::vector< StackTraceTrie::NodeId > path;
+
+    for ( QHash< StackTraceTrie::NodeId, double >::const_iterator iter = leafValues.constBegin(); iter != leafValues.constEnd(); ++iter ) {
+        StackTraceTrie::NodeId node = iter.key();
+        quint32 current = 0;
+
+        // find the innermost frame of the call path already merged
+        path.clear();
+        while ( ! trie.isRoot( node ) ) {
+            QHash< StackTraceTrie::NodeId, quint32 >::const_iterator miter = mapped.constFind( node );
+            if ( miter != mapped.constEnd() ) {
+                current = miter.value();
+                break;
+            }
+            path.push_back( node );
+            node = trie.parent( node );
+        }
+
+        // merge the remaining frames from the outermost to the innermost
+        for ( std::vector< StackTraceTrie::NodeId >::reverse_iterator piter = path.rbegin(); piter != path.rend(); ++piter ) {
+            const int functionIndex = trie.functionIndex( *piter );
+            const QPair< quint32, qint32 > key( current, ( functionIndex >= 0 ) ? functionIndex : unknownNameIndex );
+
+            QHash< QPair< quint32, qint32 >, quint32 >::const_iterator citer = children.constFind( key );
+
+            if ( citer != children.constEnd() ) {
+                current = citer.value();
+            }
+            else {
+                Node child = { current, key.second, nodes[ current ].depth + 1, 0.0 };
+                const quint32 index = nodes.size();
+                nodes.push_back( child );
+                children.insert( key, index );
+                current = index;
+            }
+
+            mapped.insert( *piter, current );
+        }
+
+        nodes[ current ].value += iter.value();
+    }
+
+    children.clear();
+    mapped.clear();
+
+    // accumulate the inclusive values and subtree sizes bottom-up
+    std::vector< quint32 > subtreeSize( nodes.size(), 1 );
+    std::vector< std::vector< quint32 > > childLists( nodes.size() );
+
+    for ( std::size_t i=nodes.size()-1; i>0; --i ) {
+        const quint32 parent = nodes[ i ].parent;
+        nodes[ parent ].value += nodes[ i ].value;
+        subtreeSize[ parent ] += subtreeSize[ i ];
+        childLists[ parent ].push_back( i );
+    }
+
+    const QStringList& names( data.m_names );
+
+    for ( std::size_t i=0; i<childLists.size(); ++i ) {
+        std::sort( childLists[ i ].begin(), childLists[ i ].end(), [&nodes, &names](quint32 lhs, quint32 rhs) {
+            return names[ nodes[ lhs ].nameIndex ] < names[ nodes[ rhs ].nameIndex ];
+        } );
+    }
+
+    // flatten the prefix tree in preorder
+    struct Pending {
+        quint32 node;
+        quint32 parent;
+        double start;
+    };
+
+    data.m_frames.resize( nodes.size() );
+
+    std::vector< Pending > stack;
+    Pending first = { 0, NO_FRAME, 0.0 };
+    stack.push_back( first );
+
+    quint32 next( 0 );
+
+    while ( ! stack.empty() ) {
+        const Pending pending = stack.back();
+        stack.pop_back();
+
+        const Node& node( nodes[ pending.node ] );
+        const quint32 index = next++;
+
+        Frame& frame( data.m_frames[ index ] );
+        frame.parent = pending.parent;
+        frame.end = index + subtreeSize[ pending.node ];
+        frame.depth = node.depth;
+        frame.nameIndex = node.nameIndex;
+        frame.start = pending.start;
+        frame.value = node.value;
+
+        data.m_maxDepth = qMax( data.m_maxDepth, (int) node.depth );
+
+        // push the children in reverse order so they are visited in name order
+        const std::vector< quint32 >& childList( childLists[ pending.node ] );
+
+        std::vector< double > starts( childList.size() );
+        double start = pending.start;
+        for ( std::size_t i=0; i<childList.size(); ++i ) {
+            starts[ i ] = start;
+            start += nodes[ childList[ i ] ].value;
+        }
+
+        for ( std::size_t i=childList.size(); i>0; --i ) {
+            Pending child = { childList[ i-1 ], index, starts[ i-1 ] };
+            stack.push_back( child );
+        }
+    }
+
+    return data;
+}
+
+/**
+ * @brief FlameGraphData::isEmpty
+ * @return - whether there are no frames
+ */
+bool FlameGraphData::isEmpty() const
+{
+    return m_frames.isEmpty();
+}
+
+/**
+ * @brief FlameGraphData::size
+ * @return - the number of frames
+ */
+int FlameGraphData::size() const
+{
+    return m_frames.size();
+}
+
+/**
+ * @brief FlameGraphData::maxDepth
+ * @return - the depth of the deepest frame
+ */
+int FlameGraphData::maxDepth() const
+{
+    return m_maxDepth;
+}
+
+/**
+ * @brief FlameGraphData::frame
+ * @param index - the frame index
+ * @return - the frame
+ */
+const FlameGraphData::Frame& FlameGraphData::frame(int index) const
+{
+    return m_frames.at( index );
+}
+
+/**
+ * @brief FlameGraphData::frameName
+ * @param index - the frame index
+ * @return - the function name of the frame
+ */
+QString FlameGraphData::frameName(int index) const
+{
+    const qint32 nameIndex = m_frames.at( index ).nameIndex;
+
+    return ( nameIndex < 0 ) ? QStringLiteral("all") : m_names.at( nameIndex );
+}
+
+
+} // GUI
+} // ArgoNavis
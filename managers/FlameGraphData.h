@@ -0,0 +1,89 @@
+/*!
+   \file FlameGraphData.h
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef FLAMEGRAPHDATA_H
+#define FLAMEGRAPHDATA_H
+
+#include <QVector>
+#include <QStringList>
+#include <QHash>
+#include <QMetaType>
+
+#include "common/openss-gui-config.h"
+
+#include "managers/StackTraceTrie.h"
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/*!
+ * \brief The FlameGraphData class
+ *
+ * The backing store of the flame graph: a prefix tree of call paths merged across all threads and flattened into an array in preorder.
+ * Frame 0 is the root frame spanning all samples.  The subtree of a frame occupies the contiguous range [index, end) of the array,
+ * and the horizontal extent of each frame (start and inclusive value) is precomputed in metric units relative to the root frame, so the
+ * view can skip a whole subtree in constant time and zoom into any frame without recomputation.  Siblings are ordered by name.
+ */
+
+class FlameGraphData
+{
+public:
+
+    static const quint32 NO_FRAME = 0xffffffff;
+
+    struct Frame {
+        quint32 parent;         // index of the calling frame or NO_FRAME for the root frame
+        quint32 end;            // one past the index of the last frame in the subtree of this frame
+        quint32 depth;          // the depth of the frame (0 for the root frame)
+        qint32 nameIndex;       // index into the function names or -1 for the root frame
+        double start;           // offset of the frame from the start of the root frame
+        double value;           // inclusive value (width) of the frame
+    };
+
+    FlameGraphData();
+
+    static FlameGraphData create(const StackTraceTrie& trie, const QHash< StackTraceTrie::NodeId, double >& leafValues);
+
+    bool isEmpty() const;
+    int size() const;
+    int maxDepth() const;
+
+    const Frame& frame(int index) const;
+    QString frameName(int index) const;
+
+private:
+
+    QVector< Frame > m_frames;
+    QStringList m_names;
+    int m_maxDepth;
+
+};
+
+
+} // GUI
+} // ArgoNavis
+
+Q_DECLARE_METATYPE( ArgoNavis::GUI::FlameGraphData )
+
+#endif // FLAMEGRAPHDATA_H
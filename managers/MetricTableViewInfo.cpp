@@ -23,6 +23,8 @@
 
 #include "MetricTableViewInfo.h"
 
+#include "ExperimentSnapshot.h"
+
 namespace ArgoNavis { namespace GUI {
 
 #if (QT_VERSION >= QT_VERSION_CHECK(5,0,0))
@@ -90,13 +92,16 @@ MetricTableViewInfo::MetricTableViewInfo(const MetricTableViewInfo& other)
  * @brief MetricTableViewInfo::add
  * @param metricViewName - new metric view to add to list
  *
- * This method adds the metric view to the metric view list if not already present.
+ * This method adds the metric view to the metric view list if not already present.  Since the metric view is being
+ * generated for the current time interval, it is no longer stale nor waiting to be prefetched.
  */
 void MetricTableViewInfo::addMetricView(const QString& name)
 {
     QMutexLocker guard( &m_mutex );
     if ( ! m_metricViewList.contains( name ) )
         m_metricViewList << name;
+    m_staleMetricViews.remove( name );
+    m_deferredMetricViews.removeAll( name );
 }
 
 /**
@@ -205,6 +210,106 @@ const OpenSpeedShop::Framework::Experiment *MetricTableViewInfo::experiment()
     return m_experiment;
 }
 
+/**
+ * @brief MetricTableViewInfo::setVisibleMetricView
+ * @param name - the metric view currently shown
+ *
+ * This method records the metric view currently shown in the metric table view.
+ */
+void MetricTableViewInfo::setVisibleMetricView(const QString &name)
+{
+    QMutexLocker guard( &m_mutex );
+    m_visibleMetricView = name;
+}
+
+/**
+ * @brief MetricTableViewInfo::getVisibleMetricView
+ * @return - the metric view currently shown
+ *
+ * This method returns the metric view currently shown in the metric table view.
+ */
+QString MetricTableViewInfo::getVisibleMetricView()
+{
+    QMutexLocker guard( &m_mutex );
+    return m_visibleMetricView;
+}
+
+/**
+ * @brief MetricTableViewInfo::setMetricViewStale
+ * @param name - the metric view to mark as stale
+ *
+ * This method marks the metric view as having been generated for a previous time interval.
+ */
+void MetricTableViewInfo::setMetricViewStale(const QString &name)
+{
+    QMutexLocker guard( &m_mutex );
+    m_staleMetricViews.insert( name );
+}
+
+/**
+ * @brief MetricTableViewInfo::isMetricViewStale
+ * @param name - the metric view name
+ * @return - whether the metric view was generated for a previous time interval
+ *
+ * This function returns whether the metric view needs to be generated again before it is shown.
+ */
+bool MetricTableViewInfo::isMetricViewStale(const QString &name)
+{
+    QMutexLocker guard( &m_mutex );
+    return m_staleMetricViews.contains( name );
+}
+
+/**
+ * @brief MetricTableViewInfo::addDeferredMetricView
+ * @param name - the metric view to prefetch
+ *
+ * This method adds the metric view to the list of metric views waiting to be prefetched if not already present.
+ */
+void MetricTableViewInfo::addDeferredMetricView(const QString &name)
+{
+    QMutexLocker guard( &m_mutex );
+    if ( ! m_deferredMetricViews.contains( name ) )
+        m_deferredMetricViews << name;
+}
+
+/**
+ * @brief MetricTableViewInfo::takeDeferredMetricView
+ * @return - the next metric view to prefetch or an empty string if none are waiting
+ *
+ * This method removes and returns the next metric view waiting to be prefetched.
+ */
+QString MetricTableViewInfo::takeDeferredMetricView()
+{
+    QMutexLocker guard( &m_mutex );
+    if ( m_deferredMetricViews.isEmpty() )
+        return QString();
+    return m_deferredMetricViews.takeFirst();
+}
+
+/**
+ * @brief MetricTableViewInfo::setSnapshot
+ * @param snapshot - the snapshot of the experiment database
+ *
+ * This method sets the snapshot of the experiment database from which metric views may be read instead of querying the experiment database.
+ */
+void MetricTableViewInfo::setSnapshot(const QSharedPointer< const ExperimentSnapshot > &snapshot)
+{
+    QMutexLocker guard( &m_mutex );
+    m_snapshot = snapshot;
+}
+
+/**
+ * @brief MetricTableViewInfo::getSnapshot
+ * @return - the snapshot of the experiment database or a null pointer if there is no current snapshot
+ *
+ * This function returns the snapshot of the experiment database.
+ */
+QSharedPointer< const ExperimentSnapshot > MetricTableViewInfo::getSnapshot()
+{
+    QMutexLocker guard( &m_mutex );
+    return m_snapshot;
+}
+
 
 } // GUI
 } // ArgoNavis
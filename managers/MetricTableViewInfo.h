@@ -31,10 +31,14 @@
 
 #include <QString>
 #include <QStringList>
+#include <QSet>
 #include <QMutex>
+#include <QSharedPointer>
 
 namespace ArgoNavis { namespace GUI {
 
+class ExperimentSnapshot;
+
 class MetricTableViewInfo
 {
 public:
@@ -48,6 +52,10 @@ public:
         m_metricViewList = other.m_metricViewList;
         m_experiment = other.m_experiment;
         m_interval = other.m_interval;
+        m_visibleMetricView = other.m_visibleMetricView;
+        m_staleMetricViews = other.m_staleMetricViews;
+        m_deferredMetricViews = other.m_deferredMetricViews;
+        m_snapshot = other.m_snapshot;
         return *this;
     }
 
@@ -62,12 +70,24 @@ public:
     void setInterval(const OpenSpeedShop::Framework::Time& lower, const OpenSpeedShop::Framework::Time& upper);
     QStringList getMetricViewList();
     const OpenSpeedShop::Framework::Experiment* experiment();
+    void setVisibleMetricView(const QString& name);
+    QString getVisibleMetricView();
+    void setMetricViewStale(const QString& name);
+    bool isMetricViewStale(const QString& name);
+    void addDeferredMetricView(const QString& name);
+    QString takeDeferredMetricView();
+    void setSnapshot(const QSharedPointer< const ExperimentSnapshot >& snapshot);
+    QSharedPointer< const ExperimentSnapshot > getSnapshot();
 
 private:
 
     const OpenSpeedShop::Framework::Experiment* m_experiment;
     OpenSpeedShop::Framework::TimeInterval m_interval;
     QStringList m_metricViewList;           // [ <metric name> | "Details" ] - [ <View Name> ]
+    QString m_visibleMetricView;            // metric view currently shown in the metric table view
+    QSet< QString > m_staleMetricViews;     // metric views generated for a previous time interval
+    QStringList m_deferredMetricViews;      // metric views waiting to be prefetched in idle time
+    QSharedPointer< const ExperimentSnapshot > m_snapshot;  // snapshot of the experiment database (if current)
     QMutex m_mutex;
 
 };
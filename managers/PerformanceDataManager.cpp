@@ -27,7 +27,9 @@
 
 #include "managers/BackgroundGraphRenderer.h"
 #include "managers/ApplicationOverrideCursorManager.h"
+#include "managers/BoundedSignalChannel.h"
 #include "managers/DerivedMetricsSolver.h"
+#include "managers/ExperimentSnapshot.h"
 #include "widgets/PerformanceDataMetricView.h"
 #include "CBTF-ArgoNavis-Ext/DataTransferDetails.h"
 #include "CBTF-ArgoNavis-Ext/KernelExecutionDetails.h"
@@ -51,8 +53,13 @@
 #include <QThread>
 #include <QTimer>
 #include <QMap>
+#include <QSet>
 #include <QFutureSynchronizer>
+#include <QThreadPool>
 #include <qmath.h>
+#if defined(HAS_CALLTREE_PROCESSING_TIMING) || defined(HAS_SAMPLE_COUNTERS_PROCESSING_TIMING)
+#include <QElapsedTimer>
+#endif
 
 #include <ArgoNavis/CUDA/PerformanceData.hpp>
 #include <ArgoNavis/CUDA/DataTransfer.hpp>
@@ -83,7 +90,11 @@ using namespace OpenSpeedShop::Framework;
 using namespace OpenSpeedShop::Queries;
 
 #if defined(HAS_OSSCUDA2XML)
-extern int cuda2xml(const QString& dbFilename, QTextStream& xml);
+extern int cuda2xml(const QString& dbFilename, QIODevice& xml);
+extern int cuda2ndjson(const QString& dbFilename, QIODevice& json);
+#endif
+#if defined(HAS_OSSSNAPSHOT)
+extern int experiment2snapshot(const QString& dbFilename, const QString& snapshotFilename);
 #endif
 
 Q_DECLARE_METATYPE( ArgoNavis::Base::Time )
@@ -185,6 +196,7 @@ QMap< QString, QMap< QString, QString > > PerformanceDataManager::INIT_TRACING_E
 const QString CUDA_EVENT_DETAILS_METRIC = QStringLiteral( "Details" );
 const QString TRACE_EVENT_DETAILS_METRIC = QStringLiteral( "Trace" );
 const QString ALL_EVENTS_DETAILS_VIEW = QStringLiteral( "All Events" );
+const QString FUNCTION_SUMMARY_VIEW = QStringLiteral( "Function Summary" );
 const QString KERNEL_EXECUTION_DETAILS_VIEW = QStringLiteral( "Kernel Execution" );
 const QString DATA_TRANSFER_DETAILS_VIEW = QStringLiteral( "Data Transfer" );
 const QString TIME_METRIC = QStringLiteral( "time" );
@@ -192,6 +204,12 @@ const QString DETAIL_METRIC = QStringLiteral( "detail" );
 const QString TIME_UNIT_MSEC = QStringLiteral( "(msec)" );
 const QString COUNTER_COUNT = QStringLiteral( "(count)" );
 
+// number of stack traces of a function processed by one calltree work unit
+const std::size_t CALLTREE_STACKTRACE_CHUNK_SIZE = 4096;
+
+// number of time buckets of the envelope across all ranks of the mem and io trace graphs
+const int ENVELOPE_BUCKET_COUNT = 2048;
+
 QAtomicPointer< PerformanceDataManager > PerformanceDataManager::s_instance = nullptr;
 
 #if defined(HAS_OSSCUDA2XML)
@@ -207,13 +225,99 @@ void PerformanceDataManager::xmlDump(const QString &filePath)
     QString xmlFilename( filePath + ".xml" );
     QFile file( xmlFilename );
     if ( file.open( QFile::WriteOnly | QFile::Truncate ) ) {
-        QTextStream xml( &file );
-        cuda2xml( filePath, xml );
+        cuda2xml( filePath, file );
+        file.close();
+    }
+}
+
+/**
+ * @brief PerformanceDataManager::ndjsonDump
+ * @param filePath  Filename path to experiment database file with CUDA data collection (.openss file)
+ *
+ * Generate a newline-delimited JSON formatted dump of the experiment database.  Will write output to a file located in the directory
+ * where the experiment database is located having the same name as the experiment database with ".ndjson" suffix.
+ */
+void PerformanceDataManager::ndjsonDump(const QString &filePath)
+{
+    QString jsonFilename( filePath + ".ndjson" );
+    QFile file( jsonFilename );
+    if ( file.open( QFile::WriteOnly | QFile::Truncate ) ) {
+        cuda2ndjson( filePath, file );
         file.close();
     }
 }
 #endif
 
+#if defined(HAS_OSSSNAPSHOT)
+/**
+ * @brief PerformanceDataManager::snapshotDump
+ * @param filePath  Filename path to experiment database file (.openss file)
+ *
+ * Generate a columnar binary snapshot of the experiment database (see ExperimentSnapshot).  Will write output to a file located in
+ * the directory where the experiment database is located having the same name as the experiment database with ".snapshot" suffix.
+ * The snapshot is written by a task in the export lane of the analysis scheduler, so the calling thread isn't blocked.
+ */
+void PerformanceDataManager::snapshotDump(const QString &filePath)
+{
+    m_scheduler.run( AnalysisScheduler::ExportLane, m_scheduler.supersede( filePath, QStringLiteral("snapshot") ),
+                     boost::bind( &PerformanceDataManager::writeSnapshot, this, filePath ) );
+}
+
+/**
+ * @brief PerformanceDataManager::writeSnapshot
+ * @param filePath  Filename path to experiment database file (.openss file)
+ *
+ * Writes the snapshot of the experiment database unless the existing snapshot is newer than the experiment database.
+ */
+void PerformanceDataManager::writeSnapshot(const QString &filePath)
+{
+    const QString snapshotFilename( filePath + ".snapshot" );
+
+    const QFileInfo snapshotInfo( snapshotFilename );
+
+    if ( snapshotInfo.exists() && snapshotInfo.lastModified() >= QFileInfo( filePath ).lastModified() && ExperimentSnapshot( snapshotFilename ).isValid() ) {
+        m_scheduler.release( filePath, QStringLiteral("snapshot"), AnalysisScheduler::currentToken() );
+        return;
+    }
+
+    if ( experiment2snapshot( filePath, snapshotFilename ) != 0 && ! AnalysisScheduler::isCanceled() ) {
+        qDebug() << "PerformanceDataManager::snapshotDump: unable to write" << snapshotFilename;
+    }
+
+    m_scheduler.release( filePath, QStringLiteral("snapshot"), AnalysisScheduler::currentToken() );
+}
+
+/**
+ * @brief PerformanceDataManager::openSnapshot
+ * @param filePath  Filename path to experiment database file (.openss file)
+ * @param extent - the time interval of the experiment
+ * @return - the snapshot of the experiment database or a null pointer if there is no current snapshot
+ *
+ * Opens the snapshot of the experiment database written by PerformanceDataManager::snapshotDump.  A snapshot older than the
+ * experiment database or for a different experiment extent isn't current and isn't used.
+ */
+QSharedPointer< const ExperimentSnapshot > PerformanceDataManager::openSnapshot(const QString &filePath, const TimeInterval &extent)
+{
+    const QString snapshotFilename( filePath + ".snapshot" );
+
+    const QFileInfo snapshotInfo( snapshotFilename );
+
+    if ( ! snapshotInfo.exists() || snapshotInfo.lastModified() < QFileInfo( filePath ).lastModified() )
+        return QSharedPointer< const ExperimentSnapshot >();
+
+    QSharedPointer< const ExperimentSnapshot > snapshot( new ExperimentSnapshot( snapshotFilename ) );
+
+    quint64 count;
+    const quint64* interval = snapshot->column< quint64 >( ExperimentSnapshot::TIME_INTERVAL, count );
+
+    if ( ! snapshot->isValid() || Q_NULLPTR == interval || count != 2 ||
+         interval[0] != extent.getBegin().getValue() || interval[1] != extent.getEnd().getValue() )
+        return QSharedPointer< const ExperimentSnapshot >();
+
+    return snapshot;
+}
+#endif
+
 /**
  * @brief Get_Subextents_To_Object
  * @param tgrp - the set of threads
@@ -242,7 +346,7 @@ void Get_Subextents_To_Object (
  * @param object - the view object (Function, Statements, LinkedObject, Loops, etc)
  * @param subextents_map - a map for each thread to its extents in the view object
  *
- * Return the map for each thread to its extents in the view object.
+ * Return the map for each thread to its extents in the view object.  The map is incomplete if the calling task was canceled.
  */
 template <typename TS>
 void Get_Subextents_To_Object_Map (
@@ -251,6 +355,9 @@ void Get_Subextents_To_Object_Map (
         std::map<Framework::Thread, Framework::ExtentGroup>& subextents_map)
 {
     for (ThreadGroup::iterator ti = tgrp.begin(); ti != tgrp.end(); ti++) {
+        if ( AnalysisScheduler::isCanceled() )
+            break;
+
         ExtentGroup newExtents = object.getExtentIn (*ti);
         Framework::ExtentGroup subextents;
 
@@ -295,11 +402,25 @@ inline std::int64_t stack_contains_N_calls(const Framework::StackTrace& st, Fram
     return num_calls;
 }
 
+/**
+ * @brief visitAndCommit
+ * @param visitation - the visitation of the CUDA events of a thread publishing its rows through the batch
+ * @param batch - the batch of the visitation
+ *
+ * Runs the visitation and commits the bytes of its last batch, so the bytes are released while the other visitations still publish.
+ */
+void visitAndCommit(const boost::function< void () >& visitation, BoundedSignalChannel::Batch* batch)
+{
+    visitation();
+
+    batch->commit();
+}
+
 /**
  * @brief The ltST struct provides a Function object (functor) to sort a container of Framework::StackTrace items.
  */
 struct ltST {
-    bool operator() (Framework::StackTrace stl, Framework::StackTrace str) {
+    bool operator() (const Framework::StackTrace& stl, const Framework::StackTrace& str) const {
         if (stl.getTime() < str.getTime()) { return true; }
         if (stl.getTime() > str.getTime()) { return false; }
 
@@ -310,7 +431,6 @@ struct ltST {
     }
 };
 
-
 /**
  * @brief PerformanceDataManager::PerformanceDataManager
  * @param parent - the parent QObject (in any - ie non-NULL)
@@ -322,12 +442,22 @@ PerformanceDataManager::PerformanceDataManager(QObject *parent)
     , m_renderer( new BackgroundGraphRenderer )
     , m_numberLoadWorkUnitsInProgress( 0 )
     , m_loadInProgress( 0 )
+    , m_prefetchInProgress( 0 )
+    , m_foregroundRequestsInProgress( 0 )
 {
     qRegisterMetaType< Base::Time >("Base::Time");
     qRegisterMetaType< CUDA::DataTransfer >("CUDA::DataTransfer");
     qRegisterMetaType< CUDA::KernelExecution >("CUDA::KernelExecution");
     qRegisterMetaType< QVector< QString > >("QVector< QString >");
     qRegisterMetaType< QVector< bool > >("QVector< bool >");
+    qRegisterMetaType< QVector< double > >("QVector< double >");
+    qRegisterMetaType< QVector< QVariantList > >("QVector< QVariantList >");
+    qRegisterMetaType< QVector< int > >("QVector< int >");
+    qRegisterMetaType< FlameGraphData >("FlameGraphData");
+    qRegisterMetaType< RankEnvelopeData >("RankEnvelopeData");
+
+    // create the channel bounding the data queued to the GUI thread in the GUI thread
+    BoundedSignalChannel::instance();
 
 #if defined(HAS_EXPERIMENTAL_CONCURRENT_PLOT_TO_IMAGE)
     m_thread.start();
@@ -357,6 +487,10 @@ PerformanceDataManager::PerformanceDataManager(QObject *parent)
  */
 PerformanceDataManager::~PerformanceDataManager()
 {
+    // stop the work units still running early and wait for them before the members they use are destroyed
+    m_scheduler.cancelAll();
+    m_scheduler.waitForDone();
+
 #if defined(HAS_EXPERIMENTAL_CONCURRENT_PLOT_TO_IMAGE)
     m_thread.quit();
     m_thread.wait();
@@ -412,66 +546,99 @@ void PerformanceDataManager::destroy()
  * Handler for external request to produce metric view data for specified metric view.
  */
 void PerformanceDataManager::handleRequestMetricView(const QString& clusteringCriteriaName, const QString& metricName, const QString& viewName)
+{
+    requestMetricView( clusteringCriteriaName, metricName, viewName, false );
+}
+
+/**
+ * @brief PerformanceDataManager::requestMetricView
+ * @param clusteringCriteriaName - the name of the clustering criteria
+ * @param metricName - the name of the metric requested in the metric view
+ * @param viewName - the name of the view requested in the metric view
+ * @param prefetch - whether the metric view is being prefetched in idle time
+ * @return - whether generation of the metric view was started
+ *
+ * Start generation of the metric view data for the specified metric view.  Metric views requested to be shown use the visible view lane
+ * of the analysis scheduler and are monitored by the application cursor manager.  Metric views being prefetched use the low priority
+ * prefetch lane.  A generation of the metric view still in progress (for instance for a previous time range) is canceled.
+ */
+bool PerformanceDataManager::requestMetricView(const QString& clusteringCriteriaName, const QString& metricName, const QString& viewName, bool prefetch)
 {
     if ( ! m_tableViewInfo.contains( clusteringCriteriaName ) || metricName.isEmpty() || viewName.isEmpty() )
-        return;
+        return false;
 
 #ifdef HAS_CONCURRENT_PROCESSING_VIEW_DEBUG
-    qDebug() << "PerformanceDataManager::handleRequestMetricView: clusteringCriteriaName=" << clusteringCriteriaName << "metric=" << metricName << "view=" << viewName;
+    qDebug() << "PerformanceDataManager::requestMetricView: clusteringCriteriaName=" << clusteringCriteriaName << "metric=" << metricName << "view=" << viewName << "prefetch=" << prefetch;
 #endif
 
     MetricTableViewInfo& info = m_tableViewInfo[ clusteringCriteriaName ];
 
     const CollectorGroup collectors = info.getCollectors();
 
-    if ( collectors.size() > 0 ) {
-        const QString METRIC_MODE_NAME = PerformanceDataMetricView::getMetricModeName( PerformanceDataMetricView::METRIC_MODE );
-        const QString CALLTREE_MODE_NAME = PerformanceDataMetricView::getMetricModeName( PerformanceDataMetricView::CALLTREE_MODE );
-        const QString modeName = ( viewName != CALLTREE_MODE_NAME ) ? METRIC_MODE_NAME : CALLTREE_MODE_NAME;
-        const QString metricNameStr = ( viewName != CALLTREE_MODE_NAME ) ? metricName : QStringLiteral("None");
-
-        const QString metricViewName = PerformanceDataMetricView::getMetricViewName( modeName, metricNameStr, viewName );
+    if ( 0 == collectors.size() )
+        return false;
 
-        ApplicationOverrideCursorManager* cursorManager = ApplicationOverrideCursorManager::instance();
-        if ( cursorManager ) {
-            cursorManager->startWaitingOperation( QString("generate-%1").arg(metricViewName) );
-        }
+    const QString METRIC_MODE_NAME = PerformanceDataMetricView::getMetricModeName( PerformanceDataMetricView::METRIC_MODE );
+    const QString CALLTREE_MODE_NAME = PerformanceDataMetricView::getMetricModeName( PerformanceDataMetricView::CALLTREE_MODE );
+    const QString modeName = ( viewName != CALLTREE_MODE_NAME ) ? METRIC_MODE_NAME : CALLTREE_MODE_NAME;
+    const QString metricNameStr = ( viewName != CALLTREE_MODE_NAME ) ? metricName : QStringLiteral("None");
 
-        info.addMetricView( metricViewName );
+    const QString metricViewName = PerformanceDataMetricView::getMetricViewName( modeName, metricNameStr, viewName );
 
-        QVector< QFuture<void> >* futures = allocateFutureVector( clusteringCriteriaName, metricViewName );
+    const CancellationToken token = m_scheduler.supersede( clusteringCriteriaName, metricViewName );
 
-        if ( ! futures )
-            return;
+    QVector< QFuture<void> > futures;
 
-        const Collector& collector( *collectors.begin() );
-        const QString collectorId( collector.getMetadata().getUniqueId().c_str() );
+    // prefetching metric views in the background isn't indicated to the user
+    ApplicationOverrideCursorManager* cursorManager = prefetch ? Q_NULLPTR : ApplicationOverrideCursorManager::instance();
+    if ( cursorManager ) {
+        cursorManager->startWaitingOperation( QString("generate-%1").arg(metricViewName) );
+    }
 
-        if ( s_SAMPLING_EXPERIMENTS.contains( collectorId ) ) {
-            futures->append( QtConcurrent::run( this, &PerformanceDataManager::handleRequestSampleCountersView, clusteringCriteriaName, metricName, viewName ) );
-        }
-        else {
-            loadCudaMetricViews(*futures,
-                                clusteringCriteriaName,
-                                QStringList() << metricName,
-                                QStringList() << viewName);
-        }
+    info.addMetricView( metricViewName );
 
-        if ( futures->size() > 0 ) {
-            // Determine full time interval extent of this experiment
-            const Extent extent = info.getExtent();
-            const Base::TimeInterval experimentInterval = ConvertToArgoNavis( extent.getTimeInterval() );
-            const TimeInterval interval = info.getInterval();
+    const AnalysisScheduler::Lane lane = prefetch ? AnalysisScheduler::PrefetchLane : AnalysisScheduler::VisibleViewLane;
 
-            const Base::TimeInterval graphInterval = ConvertToArgoNavis( interval );
+    const Collector& collector( *collectors.begin() );
+    const QString collectorId( collector.getMetadata().getUniqueId().c_str() );
 
-            const double lower = ( graphInterval.begin() - experimentInterval.begin() ) / 1000000.0;
-            const double upper = ( graphInterval.end() - experimentInterval.begin() ) / 1000000.0;
+    if ( s_SAMPLING_EXPERIMENTS.contains( collectorId ) ) {
+        futures.append( m_scheduler.run( lane, token, boost::bind( &PerformanceDataManager::handleRequestSampleCountersView, this, clusteringCriteriaName, metricName, viewName ) ) );
+    }
+    else {
+        loadCudaMetricViews(futures,
+                            clusteringCriteriaName,
+                            QStringList() << metricName,
+                            QStringList() << viewName,
+                            lane,
+                            token);
+    }
 
-            QtConcurrent::run( boost::bind( &PerformanceDataManager::monitorMetricViewComplete, this,
-                                            futures, clusteringCriteriaName, modeName, metricName, viewName, lower, upper ) );
+    if ( futures.size() == 0 ) {
+        m_scheduler.release( clusteringCriteriaName, metricViewName, token );
+        if ( cursorManager ) {
+            cursorManager->finishWaitingOperation( QString("generate-%1").arg(metricViewName) );
         }
+        return false;
+    }
+
+    if ( ! prefetch ) {
+        m_foregroundRequestsInProgress.ref();
     }
+
+    // Determine full time interval extent of this experiment
+    const Extent extent = info.getExtent();
+    const Base::TimeInterval experimentInterval = ConvertToArgoNavis( extent.getTimeInterval() );
+    const TimeInterval interval = info.getInterval();
+
+    const Base::TimeInterval graphInterval = ConvertToArgoNavis( interval );
+
+    const double lower = ( graphInterval.begin() - experimentInterval.begin() ) / 1000000.0;
+    const double upper = ( graphInterval.end() - experimentInterval.begin() ) / 1000000.0;
+
+    watchMetricViewComplete( clusteringCriteriaName, modeName, metricName, viewName, lower, upper, prefetch, futures, token );
+
+    return true;
 }
 
 void PerformanceDataManager::handleRequestDerivedMetricView(const QString &clusteringCriteriaName, const QString &metricName, const QString &viewName)
@@ -527,55 +694,134 @@ void PerformanceDataManager::handleRequestDerivedMetricView(const QString &clust
 }
 
 /**
- * @brief PerformanceDataManager::monitorMetricViewComplete
- * @param futures - pointer to a vector of futures that this method takes ownership of (and thus needs to delete)
+ * @brief PerformanceDataManager::watchMetricViewComplete
  * @param clusteringCriteriaName - the name of the clustering criteria
  * @param modeName - the mode name
  * @param metricName - the name of the metric requested in the metric view
  * @param viewName - the name of the view requested in the metric view
  * @param lower - the lower value of the interval to process
  * @param upper - the upper value of the interval to process
- * 
- * This method takes the vector of futures and adds them to a future sychronizer which is used to wait for all futures to complete.
- * The vector of futures represents the work units required to complete the metric view specified by the combination of mode, metric and view names.
- * Upon completion the signal 'requestMetricViewComplete' is emitted and the cursor manager is called to indicate the operation has finished.
- * The vector of futures is destroyed.
+ * @param prefetch - whether the metric view is being prefetched in idle time
+ * @param futures - the work units of the metric view
+ * @param token - the cancellation token of the work units
+ *
+ * Arrange for the completion of the metric view to be signalled once all its work units have finished.
+ * The work units are watched in the thread of this instance, so this method may be called from any thread and never blocks.
  */
-void PerformanceDataManager::monitorMetricViewComplete(const QVector< QFuture<void> >* futures, const QString& clusteringCriteriaName, const QString modeName, const QString metricName, const QString viewName, double lower, double upper)
+void PerformanceDataManager::watchMetricViewComplete(const QString &clusteringCriteriaName, const QString &modeName, const QString &metricName, const QString &viewName,
+                                                     double lower, double upper, bool prefetch, const QVector< QFuture<void> >& futures, const CancellationToken& token)
 {
-    // initialize a future synchronizer with the set of futures required for the specified metric view
-    QFutureSynchronizer<void> synchronizer;
+    QSharedPointer< MetricViewCompletion > completion( new MetricViewCompletion );
+    completion->clusteringCriteriaName = clusteringCriteriaName;
+    completion->modeName = modeName;
+    completion->metricName = metricName;
+    completion->viewName = viewName;
+    completion->lower = lower;
+    completion->upper = upper;
+    completion->prefetch = prefetch;
+    completion->futures = futures;
+    completion->token = token;
+    completion->remaining = futures.size();
+
+    {
+        QMutexLocker guard( &m_pendingMetricViewCompletionsMutex );
 
-    for ( int i=0; i<futures->size(); ++i ) {
-        synchronizer.addFuture( futures->at(i) );
+        m_pendingMetricViewCompletions.append( completion );
     }
 
-    // wait for the set of futures to complete
-    synchronizer.waitForFinished();
+    QMetaObject::invokeMethod( this, "handleWatchMetricViewComplete", Qt::AutoConnection );
+}
+
+/**
+ * @brief PerformanceDataManager::handleWatchMetricViewComplete
+ *
+ * Create a future watcher for each work unit of the pending metric view completions sharing one completion countdown per metric view.
+ */
+void PerformanceDataManager::handleWatchMetricViewComplete()
+{
+    QList< QSharedPointer< MetricViewCompletion > > completions;
+
+    {
+        QMutexLocker guard( &m_pendingMetricViewCompletionsMutex );
+
+        completions.swap( m_pendingMetricViewCompletions );
+    }
+
+    foreach ( const QSharedPointer< MetricViewCompletion >& completion, completions ) {
+        if ( completion->futures.isEmpty() ) {
+            completeMetricView( *completion );
+            continue;
+        }
+
+        foreach ( const QFuture<void>& future, completion->futures ) {
+            QFutureWatcher<void>* watcher = new QFutureWatcher<void>( this );
+
+            m_metricViewWatchers.insert( watcher, completion );
+
+            connect( watcher, SIGNAL(finished()), this, SLOT(handleMetricViewWorkUnitFinished()) );
 
-    // if the user has exitted the application and cancellation of the futures caused the QFutureSynchronizer::waitForFinished() to complete,
+            watcher->setFuture( future );
+        }
+
+        // the watchers hold the futures from now on
+        completion->futures.clear();
+    }
+}
+
+/**
+ * @brief PerformanceDataManager::handleMetricViewWorkUnitFinished
+ *
+ * Handler for the QFutureWatcher::finished() signal of a work unit of a metric view (also emitted when the work unit was canceled).
+ * When the last work unit of the metric view has finished the metric view is completed.
+ */
+void PerformanceDataManager::handleMetricViewWorkUnitFinished()
+{
+    QFutureWatcherBase* watcher = qobject_cast< QFutureWatcherBase* >( sender() );
+
+    if ( Q_NULLPTR == watcher )
+        return;
+
+    QSharedPointer< MetricViewCompletion > completion = m_metricViewWatchers.take( watcher );
+
+    watcher->deleteLater();
+
+    if ( completion && 0 == --completion->remaining )
+        completeMetricView( *completion );
+}
+
+/**
+ * @brief PerformanceDataManager::completeMetricView
+ * @param completion - the metric view whose work units have all finished
+ *
+ * Upon completion of all work units the signal 'requestMetricViewComplete' is emitted and, for metric views requested to be shown, the cursor
+ * manager is called to indicate the operation has finished.  The signal is not emitted if the work units were canceled because the metric view was requested again (the new request signals
+ * the completion) or the views of the clustering criteria were unloaded.  Finally prefetching of the next deferred metric view is scheduled.
+ */
+void PerformanceDataManager::completeMetricView(const MetricViewCompletion &completion)
+{
+    // if the user has exitted the application and cancellation of the futures finished the work units,
     // then let's return from this method based on the state of the QApplication::closingDown() method.
     if ( qApp->closingDown() )
         return;
 
+    const QString& clusteringCriteriaName( completion.clusteringCriteriaName );
+    const QString& modeName( completion.modeName );
+    const QString& viewName( completion.viewName );
+
     const QString CALLTREE_MODE_NAME = PerformanceDataMetricView::getMetricModeName( PerformanceDataMetricView::CALLTREE_MODE );
-    const QString metricNameStr = ( viewName != CALLTREE_MODE_NAME ) ? metricName : QStringLiteral("None");
+    const QString metricNameStr = ( viewName != CALLTREE_MODE_NAME ) ? completion.metricName : QStringLiteral("None");
     const QString metricViewName = PerformanceDataMetricView::getMetricViewName( modeName, metricNameStr, viewName );
 
-    {
-        // delete the vector of futures instance since this method takes ownership
-        QMutexLocker guard( &m_futureMapMutex );
-
-        if ( m_futureMap.contains( clusteringCriteriaName ) ) {
-            delete m_futureMap[ clusteringCriteriaName ].take( metricViewName );
+    if ( ! completion.token.isCanceled() ) {
+        m_scheduler.release( clusteringCriteriaName, metricViewName, completion.token );
 
-            // indicate that the processing for the metric view has completed
-            emit requestMetricViewComplete( clusteringCriteriaName, modeName, metricNameStr, viewName, lower, upper );
-        }
+        // indicate that the processing for the metric view has completed
+        emit requestMetricViewComplete( clusteringCriteriaName, modeName, metricNameStr, viewName, completion.lower, completion.upper );
     }
 
     // indicate that the work associated with the generation of the metric view can be removed from monitoring by the application cursor manager
-    ApplicationOverrideCursorManager* cursorManager = ApplicationOverrideCursorManager::instance();
+    // (each request shown to the user started exactly one waiting operation - prefetched metric views aren't monitored)
+    ApplicationOverrideCursorManager* cursorManager = completion.prefetch ? Q_NULLPTR : ApplicationOverrideCursorManager::instance();
     if ( cursorManager ) {
         cursorManager->finishWaitingOperation( QString("generate-%1").arg(metricViewName) );
     }
@@ -585,40 +831,57 @@ void PerformanceDataManager::monitorMetricViewComplete(const QVector< QFuture<vo
 #else
     if ( m_loadInProgress != 0 && ! m_numberLoadWorkUnitsInProgress.deref() ) {
 #endif
-        // dereference the 'load in progress' indicator (subtract one)
-        Q_ASSERT( ! m_loadInProgress.deref() );
+        // dereference the 'load in progress' indicator (subtract one) - not within Q_ASSERT so that it is also done in release builds
+        const bool loadDone = ! m_loadInProgress.deref();
+        Q_ASSERT( loadDone );
+        Q_UNUSED( loadDone );
 
         emit loadComplete();
     }
+
+    if ( completion.prefetch )
+        m_prefetchInProgress.fetchAndStoreOrdered( 0 );
+    else
+        m_foregroundRequestsInProgress.deref();
+
+    // prefetch the next deferred metric view if now idle
+    QMetaObject::invokeMethod( this, "handlePrefetchDeferredMetricViews", Qt::QueuedConnection, Q_ARG( QString, clusteringCriteriaName ) );
 }
 
 /**
- * @brief PerformanceDataManager::allocateFutureVector
- * @param clusteringCriteriaName
- * @param metricViewName
- * @return
+ * @brief PerformanceDataManager::handlePrefetchDeferredMetricViews
+ * @param clusteringCriteriaName - the name of the clustering criteria
+ *
+ * When the application is idle (no experiment loading and no requested metric view being generated), start prefetching the
+ * next deferred metric view in the low priority prefetch thread pool.  Only one metric view is prefetched at a time.
  */
-QVector< QFuture<void> > *PerformanceDataManager::allocateFutureVector(const QString &clusteringCriteriaName, const QString &metricViewName)
+void PerformanceDataManager::handlePrefetchDeferredMetricViews(const QString &clusteringCriteriaName)
 {
-    QMutexLocker guard( &m_futureMapMutex );
+    if ( ! m_tableViewInfo.contains( clusteringCriteriaName ) )
+        return;
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+    if ( m_loadInProgress.load() || m_foregroundRequestsInProgress.load() )
+#else
+    if ( m_loadInProgress != 0 || m_foregroundRequestsInProgress != 0 )
+#endif
+        return;
 
-    // if clusteringCriterianName not currently in map an entry will automatically be created
-    QMap< QString, QVector< QFuture<void> >* >& futureMap = m_futureMap[ clusteringCriteriaName ];
+    if ( ! m_prefetchInProgress.testAndSetOrdered( 0, 1 ) )
+        return;
 
-    // make sure the metric view isn't already in the map
-    if ( futureMap.contains( metricViewName ) ) {
-        qDebug() << Q_FUNC_INFO << "ERROR ENTRY EXISTS IN FUTURE MAP FOR metricViewName=" << metricViewName;
-        return Q_NULLPTR;
-    }
+    MetricTableViewInfo& info = m_tableViewInfo[ clusteringCriteriaName ];
 
-    // create the vector of futures for this metric view
-    QVector< QFuture<void> >* futures = new QVector< QFuture<void> >();
+    QString metricViewName = info.takeDeferredMetricView();
 
-    // insert into the map
-    futureMap.insert( metricViewName, futures );
+    while ( ! metricViewName.isEmpty() ) {
+        const QStringList tokens = metricViewName.split('-');
+        if ( tokens.size() == 3 && requestMetricView( clusteringCriteriaName, tokens[1], tokens[2], true ) )
+            return;
+        metricViewName = info.takeDeferredMetricView();
+    }
 
-    // return the vector
-    return futures;
+    m_prefetchInProgress.fetchAndStoreOrdered( 0 );
 }
 
 /**
@@ -829,7 +1092,7 @@ void PerformanceDataManager::handleRequestCompareView(const QString &clusteringC
  *
  * This method handles a request for a new detail view.  After building the ArgoNavis::CUDA::PerformanceData object for threads of interest,
  * it will begin processing of the all CUDA event types by executing the visitor methods in a separate thread (via QtConcurrent::run) over
- * the entire duration of the experiment and waits for the thread to complete.
+ * the entire duration of the experiment and waits for the thread to complete.  The visitations stop early when the details views are canceled.
  */
 void PerformanceDataManager::handleProcessDetailViews(const QString &clusteringCriteriaName)
 { 
@@ -898,26 +1161,49 @@ void PerformanceDataManager::handleProcessDetailViews(const QString &clusteringC
             tableColumnList << columnName;
     }
 
-    // for details view emit signal to create just the model
-    emit addMetricView( clusteringCriteriaName, CUDA_EVENT_DETAILS_METRIC, QStringLiteral("None"), ALL_EVENTS_DETAILS_VIEW, tableColumnList );
+    {
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+        if ( publishing.isCanceled() )
+            return;
+
+        // for details view emit signal to create just the model
+        emit addMetricView( clusteringCriteriaName, CUDA_EVENT_DETAILS_METRIC, QStringLiteral("None"), ALL_EVENTS_DETAILS_VIEW, tableColumnList );
 
-    // build the proxy views and tree views for the three details views: "All Events", "Kernel Executions" and "Data Transfers"
-    emit addAssociatedMetricView( clusteringCriteriaName, CUDA_EVENT_DETAILS_METRIC, QStringLiteral("None"), ALL_EVENTS_DETAILS_VIEW, metricViewName, commonColumnList );
-    emit addAssociatedMetricView( clusteringCriteriaName, CUDA_EVENT_DETAILS_METRIC, QStringLiteral("None"), KERNEL_EXECUTION_DETAILS_VIEW, metricViewName, ArgoNavis::CUDA::getKernelExecutionDetailsHeaderList() );
-    emit addAssociatedMetricView( clusteringCriteriaName, CUDA_EVENT_DETAILS_METRIC, QStringLiteral("None"), DATA_TRANSFER_DETAILS_VIEW, metricViewName, ArgoNavis::CUDA::getDataTransferDetailsHeaderList() );
+        // build the proxy views and tree views for the three details views: "All Events", "Kernel Executions" and "Data Transfers"
+        emit addAssociatedMetricView( clusteringCriteriaName, CUDA_EVENT_DETAILS_METRIC, QStringLiteral("None"), ALL_EVENTS_DETAILS_VIEW, metricViewName, commonColumnList );
+        emit addAssociatedMetricView( clusteringCriteriaName, CUDA_EVENT_DETAILS_METRIC, QStringLiteral("None"), KERNEL_EXECUTION_DETAILS_VIEW, metricViewName, ArgoNavis::CUDA::getKernelExecutionDetailsHeaderList() );
+        emit addAssociatedMetricView( clusteringCriteriaName, CUDA_EVENT_DETAILS_METRIC, QStringLiteral("None"), DATA_TRANSFER_DETAILS_VIEW, metricViewName, ArgoNavis::CUDA::getDataTransferDetailsHeaderList() );
+    }
 
     QFutureSynchronizer<void> synchronizer;
 
     const Base::TimeInterval interval( ConvertToArgoNavis( info.getInterval() ) );
 
+    QList< BoundedSignalChannel::Batch* > batches;
+
+    // the visitations inherit the cancellation token of this work unit
     foreach( const ArgoNavis::Base::ThreadName thread, threads.keys() ) {
-        synchronizer.addFuture( QtConcurrent::run( &data, &CUDA::PerformanceData::visitDataTransfers, thread, interval,
-                                                   boost::bind( &PerformanceDataManager::processDataTransferDetails, this,
-                                                                boost::cref(clusteringCriteriaName), boost::cref(data.interval().begin()), _1 ) ) );
+        BoundedSignalChannel::Batch* dataTransferBatch = new BoundedSignalChannel::Batch( BoundedSignalChannel::instance() );
+        BoundedSignalChannel::Batch* kernelExecutionBatch = new BoundedSignalChannel::Batch( BoundedSignalChannel::instance() );
+
+        batches << dataTransferBatch << kernelExecutionBatch;
+
+        const boost::function< bool (const CUDA::DataTransfer&) > dataTransferVisitor =
+                boost::bind( &PerformanceDataManager::processDataTransferDetails, this, boost::cref(clusteringCriteriaName), boost::cref(data.interval().begin()), _1, dataTransferBatch );
+        const boost::function< bool (const CUDA::KernelExecution&) > kernelExecutionVisitor =
+                boost::bind( &PerformanceDataManager::processKernelExecutionDetails, this, boost::cref(clusteringCriteriaName), boost::cref(data.interval().begin()), _1, kernelExecutionBatch );
+
+        const boost::function< void () > dataTransferVisitation =
+                boost::bind( &CUDA::PerformanceData::visitDataTransfers, &data, thread, interval, dataTransferVisitor );
+        const boost::function< void () > kernelExecutionVisitation =
+                boost::bind( &CUDA::PerformanceData::visitKernelExecutions, &data, thread, interval, kernelExecutionVisitor );
 
-        synchronizer.addFuture( QtConcurrent::run( &data, &CUDA::PerformanceData::visitKernelExecutions, thread, interval,
-                                                   boost::bind( &PerformanceDataManager::processKernelExecutionDetails, this,
-                                                                boost::cref(clusteringCriteriaName), boost::cref(data.interval().begin()), _1 ) ) );
+        synchronizer.addFuture( QtConcurrent::run( AnalysisScheduler::inheritToken(
+                                                       boost::bind( &visitAndCommit, dataTransferVisitation, dataTransferBatch ) ) ) );
+
+        synchronizer.addFuture( QtConcurrent::run( AnalysisScheduler::inheritToken(
+                                                       boost::bind( &visitAndCommit, kernelExecutionVisitation, kernelExecutionBatch ) ) ) );
     }
 
     // Determine full time interval extent of this experiment
@@ -930,6 +1216,15 @@ void PerformanceDataManager::handleProcessDetailViews(const QString &clusteringC
 
     synchronizer.waitForFinished();
 
+    qDeleteAll( batches );
+
+    m_scheduler.release( clusteringCriteriaName, metricViewName, AnalysisScheduler::currentToken() );
+
+    const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+    if ( publishing.isCanceled() )
+        return;
+
     emit requestMetricViewComplete( clusteringCriteriaName, CUDA_EVENT_DETAILS_METRIC, QStringLiteral("None"), ALL_EVENTS_DETAILS_VIEW, lower, upper );
     emit requestMetricViewComplete( clusteringCriteriaName, CUDA_EVENT_DETAILS_METRIC, QStringLiteral("None"), KERNEL_EXECUTION_DETAILS_VIEW, lower, upper );
     emit requestMetricViewComplete( clusteringCriteriaName, CUDA_EVENT_DETAILS_METRIC, QStringLiteral("None"), DATA_TRANSFER_DETAILS_VIEW, lower, upper );
@@ -981,6 +1276,8 @@ void PerformanceDataManager::handleRequestTraceView(const QString &clusteringCri
     foreach ( const QString& metric, metricList ) {
         const QString metricViewName = PerformanceDataMetricView::getMetricViewName( TRACE_EVENT_DETAILS_METRIC, metric, viewName );
         info.addMetricView( metricViewName );
+        const QString summaryMetricViewName = PerformanceDataMetricView::getMetricViewName( TRACE_EVENT_DETAILS_METRIC, metric, FUNCTION_SUMMARY_VIEW );
+        info.addMetricView( summaryMetricViewName );
     }
 
     const TimeInterval interval( info.getInterval() );
@@ -1018,28 +1315,32 @@ void PerformanceDataManager::handleRequestTraceView(const QString &clusteringCri
 
         const QString metricViewName = PerformanceDataMetricView::getMetricViewName( TRACE_EVENT_DETAILS_METRIC, metric, viewName );
 
-        QVector< QFuture<void> >* futures = allocateFutureVector( clusteringCriteriaName, metricViewName );
+        // a trace view still being generated (for instance for a previous time range) is canceled
+        const CancellationToken token = m_scheduler.supersede( clusteringCriteriaName, metricViewName );
 
-        if ( ! futures )
-            return;
+        QVector< QFuture<void> > futures;
 
         cursorManager->startWaitingOperation( QString("generate-%1").arg(metricViewName) );
 
         if ( collectorId == "mpit" ) {
-            futures->append( QtConcurrent::run( std::bind( &PerformanceDataManager::ShowTraceDetail< std::vector<Framework::MPITDetail> >, this,
-                                                clusteringCriteriaNameStr, collector, threadGroup, time_origin, lower, upper, interval, functions, metric ) ) );
+            futures.append( m_scheduler.run( AnalysisScheduler::VisibleViewLane, token,
+                                             std::bind( &PerformanceDataManager::ShowTraceDetail< std::vector<Framework::MPITDetail> >, this,
+                                                        clusteringCriteriaNameStr, collector, threadGroup, time_origin, lower, upper, interval, functions, metric ) ) );
         }
         else if ( collectorId == "mem" ) {
-            futures->append( QtConcurrent::run( std::bind( &PerformanceDataManager::ShowTraceDetail< std::vector<Framework::MemDetail> >, this,
-                                                clusteringCriteriaNameStr, collector, threadGroup, time_origin, lower, upper, interval, functions, metric ) ) );
+            futures.append( m_scheduler.run( AnalysisScheduler::VisibleViewLane, token,
+                                             std::bind( &PerformanceDataManager::ShowTraceDetail< std::vector<Framework::MemDetail> >, this,
+                                                        clusteringCriteriaNameStr, collector, threadGroup, time_origin, lower, upper, interval, functions, metric ) ) );
         }
         else if ( collectorId == "iot" ) {
-            futures->append( QtConcurrent::run( std::bind( &PerformanceDataManager::ShowTraceDetail< std::vector<Framework::IOTDetail> >, this,
-                                                clusteringCriteriaNameStr, collector, threadGroup, time_origin, lower, upper, interval, functions, metric ) ) );
+            futures.append( m_scheduler.run( AnalysisScheduler::VisibleViewLane, token,
+                                             std::bind( &PerformanceDataManager::ShowTraceDetail< std::vector<Framework::IOTDetail> >, this,
+                                                        clusteringCriteriaNameStr, collector, threadGroup, time_origin, lower, upper, interval, functions, metric ) ) );
         }
 
-        QtConcurrent::run( boost::bind( &PerformanceDataManager::monitorMetricViewComplete, this,
-                                        futures, clusteringCriteriaName, TRACE_EVENT_DETAILS_METRIC, metric, viewName, lower, upper ) );
+        m_foregroundRequestsInProgress.ref();
+
+        watchMetricViewComplete( clusteringCriteriaName, TRACE_EVENT_DETAILS_METRIC, metric, viewName, lower, upper, false, futures, token );
     }
 }
 
@@ -1072,10 +1373,8 @@ void PerformanceDataManager::handleRequestSampleCountersView(const QString &clus
 
     const QString metricViewName = metricName + "-" + viewName;
 
-    ApplicationOverrideCursorManager* cursorManager = ApplicationOverrideCursorManager::instance();
-    if ( cursorManager ) {
-        cursorManager->startWaitingOperation( QString("generate-%1").arg(metricViewName) );
-    }
+    // NOTE: the waiting operation for the metric view is indicated by PerformanceDataManager::requestMetricView
+    // except when being prefetched in idle time
 
     info.addMetricView( metricViewName );
 
@@ -1107,10 +1406,6 @@ void PerformanceDataManager::handleRequestSampleCountersView(const QString &clus
         else if ( viewName == s_loopsView )
             ShowSampleCountersDetail< Framework::Loop, std::vector<Framework::HWCSampDetail> >( clusteringCriteriaName, collector, info.getThreads(), lower, upper, interval, metricName, viewName );
     }
-
-    if ( cursorManager ) {
-        cursorManager->finishWaitingOperation( QString("generate-%1").arg(metricViewName) );
-    }
 }
 
 /**
@@ -1154,7 +1449,13 @@ bool PerformanceDataManager::processDataTransferEvent(const Base::Time& time_ori
                                                       const QString& clusterName,
                                                       const QString& clusteringCriteriaName)
 {
-    emit addDataTransfer( clusteringCriteriaName, clusterName, time_origin, details );
+    BoundedSignalChannel* channel = BoundedSignalChannel::instance();
+    const qint64 bytes = sizeof( CUDA::DataTransfer ) + BoundedSignalChannel::sizeOf( clusterName );
+
+    if ( channel->acquire( bytes ) ) {
+        emit addDataTransfer( clusteringCriteriaName, clusterName, time_origin, details );
+        channel->commit( bytes );
+    }
 
     return true; // continue the visitation
 }
@@ -1174,7 +1475,13 @@ bool PerformanceDataManager::processKernelExecutionEvent(const Base::Time& time_
                                                          const QString& clusterName,
                                                          const QString& clusteringCriteriaName)
 {
-    emit addKernelExecution( clusteringCriteriaName, clusterName, time_origin, details );
+    BoundedSignalChannel* channel = BoundedSignalChannel::instance();
+    const qint64 bytes = sizeof( CUDA::KernelExecution ) + BoundedSignalChannel::sizeOf( clusterName );
+
+    if ( channel->acquire( bytes ) ) {
+        emit addKernelExecution( clusteringCriteriaName, clusterName, time_origin, details );
+        channel->commit( bytes );
+    }
 
     return true; // continue the visitation
 }
@@ -1184,56 +1491,103 @@ bool PerformanceDataManager::processKernelExecutionEvent(const Base::Time& time_
  * @param time_origin - the time origin of the experiment
  * @param time - the time of the period sample collection
  * @param counts - the vector of periodic sample counts for the time period
- * @param gpuCounterIndexes - the list of GPU sample counter indexes
- * @param clusterName - the cluster group name
- * @param clusteringCriteriaName - the clustering criteria name associated with the cluster group
+ * @param series - the periodic sample series of the thread being visited
  * @return - continue (=true) or not continue (=false) the visitation
  *
- * Emit signal for each periodic sample collected at the indicated experiment time.
+ * Append the periodic sample collected at the indicated experiment time to the series of the thread being visited.
  */
 bool PerformanceDataManager::processPeriodicSample(const Base::Time& time_origin,
                                                    const Base::Time& time,
                                                    const std::vector<boost::uint64_t>& counts,
-                                                   const QSet< int >& gpuCounterIndexes,
-                                                   const QString& clusterName,
-                                                   const QString& clusteringCriteriaName)
+                                                   PeriodicSampleSeries& series)
 {
-    Q_UNUSED( gpuCounterIndexes )
+    series.timeStamps << static_cast<boost::uint64_t>( time - time_origin ) / 1000000.0;
 
-    double timeStamp = static_cast<boost::uint64_t>( time - time_origin ) / 1000000.0;
-    double lastTimeStamp;
+    if ( series.rawCounts.size() < counts.size() )
+        series.rawCounts.resize( counts.size() );
 
-    if ( m_sampleKeys.size() > 0 )
-        lastTimeStamp = m_sampleKeys.last();
-    else
-        lastTimeStamp = 0.0;
+    for ( std::vector<boost::uint64_t>::size_type i = 0; i < counts.size(); ++i ) {
+        series.rawCounts[i] << counts[i];
+    }
+
+    return true; // continue the visitation
+}
+
+/**
+ * @brief PerformanceDataManager::emitPeriodicSamples
+ * @param series - the periodic sample series of a thread
+ * @param firstCounter - the counter index of the first raw count array of the series
+ * @param clusterName - the cluster group name
+ * @param clusteringCriteriaName - the clustering criteria name associated with the cluster group
+ *
+ * Compute the value of each counter for each sample period from the difference of the raw counts at the beginning and end of the period
+ * (divided by the period duration when USE_PERIODIC_SAMPLE_AVG is defined) and emit the non-zero sample periods of each counter in one signal.
+ */
+void PerformanceDataManager::emitPeriodicSamples(const PeriodicSampleSeries& series,
+                                                 int firstCounter,
+                                                 const QString& clusterName,
+                                                 const QString& clusteringCriteriaName)
+{
+    const int sampleCount = series.timeStamps.size();
 
-    m_sampleKeys << timeStamp;
+    if ( sampleCount < 2 )
+        return;
 
-    double value( 0.0 );
+    const double* timeStamps = series.timeStamps.constData();
 
-    for ( std::vector<boost::uint64_t>::size_type i = 0; i < counts.size(); ++i ) {
-        const QVector< double >& counterValues = m_rawValues[i];
+    // the duration of each sample period (index 'i' is the period ending at sample 'i')
+    QVector< double > durations( sampleCount );
+    durations[0] = 0.0;
+    for ( int i = 1; i < sampleCount; ++i ) {
+        durations[i] = timeStamps[i] - timeStamps[i-1];
+    }
+
+    QVector< double > deltas( sampleCount );
+
+    for ( std::size_t counter = 0; counter < series.rawCounts.size(); ++counter ) {
+        const QVector< double >& rawCounts = series.rawCounts[counter];
+
+        if ( rawCounts.size() != sampleCount )
+            continue;
+
+        QVector< double > timeBegins;
+        QVector< double > timeEnds;
+        QVector< double > values;
+
+        const double* raw = rawCounts.constData();
+        double* delta = deltas.data();
+
+        for ( int i = 1; i < sampleCount; ++i ) {
+            delta[i] = raw[i] - raw[i-1];
+        }
 
-        if ( counterValues.size() != 0 ) {
-            value = counts[i] - counterValues.last();
 #ifdef USE_PERIODIC_SAMPLE_AVG
-            double duration( timeStamp - lastTimeStamp );
-            if ( duration > 0.0 )
-                value /= duration;
+        for ( int i = 1; i < sampleCount; ++i ) {
+            if ( durations[i] > 0.0 )
+                delta[i] /= durations[i];
+        }
 #endif
+
+        for ( int i = 1; i < sampleCount; ++i ) {
+            if ( delta[i] > 0 && durations[i] > 0.0 ) {
+                // only add non-zero periodic sample bins
+                timeBegins << timeStamps[i-1];
+                timeEnds << timeStamps[i];
+                values << delta[i];
+            }
         }
 
-        m_sampleValues[i] << value;
-        m_rawValues[i] << counts[i];
+        if ( values.isEmpty() )
+            continue;
+
+        BoundedSignalChannel* channel = BoundedSignalChannel::instance();
+        const qint64 bytes = 3 * values.size() * sizeof( double );
 
-        if ( value > 0 && timeStamp > lastTimeStamp ) {
-            // only add non-zero periodic sample bins
-            emit addPeriodicSample( clusteringCriteriaName, clusterName, lastTimeStamp, timeStamp, value );
+        if ( channel->acquire( bytes ) ) {
+            emit addPeriodicSamples( clusteringCriteriaName, clusterName, firstCounter + static_cast< int >( counter ), timeBegins, timeEnds, values );
+            channel->commit( bytes );
         }
     }
-
-    return true; // continue the visitation
 }
 
 /**
@@ -1246,12 +1600,19 @@ bool PerformanceDataManager::processPeriodicSample(const Base::Time& time_origin
  *
  * Initiate visitations for data transfer and kernel execution events and period sample data.
  * Emit signals for each of these to be handled by the performance data view to build graph items for plotting.
+ * The periodic samples of the thread are accumulated in a series local to this visitation and emitted in one signal, so the threads
+ * may be processed concurrently (see loadCudaView).
  */
 bool PerformanceDataManager::processPerformanceData(const CUDA::PerformanceData& data,
                                                     const Base::ThreadName& thread,
                                                     const QSet< int >& gpuCounterIndexes,
                                                     const QString& clusteringCriteriaName)
 {
+    Q_UNUSED( gpuCounterIndexes )
+
+    if ( AnalysisScheduler::isCanceled() )
+        return false; // stop the visitation
+
     QString clusterName = ArgoNavis::CUDA::getUniqueClusterName( thread );
 
 #ifdef HAS_CONCURRENT_PROCESSING_VIEW_DEBUG
@@ -1264,21 +1625,21 @@ bool PerformanceDataManager::processPerformanceData(const CUDA::PerformanceData&
     for ( std::size_t counter = 0; counter < numCounters; counter++ ) {
         Base::PeriodicSamples samples = data.periodic( thread, duration, counter );
         Base::PeriodicSamples intervalSamples = samples.resample( duration, rate );
+        PeriodicSampleSeries series;
         intervalSamples.visit( duration,
-                               boost::bind( &PerformanceDataManager::processPeriodicSample, instance(),
-                                            boost::cref(duration.begin()), _1, _2,
-                                            boost::cref(gpuCounterIndexes),
-                                            boost::cref(clusterName), boost::cref(clusteringCriteriaName) )
+                               boost::bind( &PerformanceDataManager::processPeriodicSample,
+                                            boost::cref(duration.begin()), _1, _2, boost::ref(series) )
                                );
+        emitPeriodicSamples( series, counter, clusterName, clusteringCriteriaName );
     }
 #else
+    PeriodicSampleSeries series;
     data.visitPeriodicSamples(
                 thread, data.interval(),
-                boost::bind( &PerformanceDataManager::processPeriodicSample, instance(),
-                             boost::cref(data.interval().begin()), _1, _2,
-                             boost::cref(gpuCounterIndexes),
-                             boost::cref(clusterName), boost::cref(clusteringCriteriaName) )
+                boost::bind( &PerformanceDataManager::processPeriodicSample,
+                             boost::cref(data.interval().begin()), _1, _2, boost::ref(series) )
                 );
+    emitPeriodicSamples( series, 0, clusterName, clusteringCriteriaName );
 #endif
 
     return true; // continue the visitation
@@ -1289,14 +1650,26 @@ bool PerformanceDataManager::processPerformanceData(const CUDA::PerformanceData&
  * @param clusteringCriteriaName - the clustering criteria name
  * @param time_origin - the time origin of the experiment
  * @param details - the CUDA data transfer details
- * @return - indicates whether visitation should continue (always true)
+ * @param batch - the batch of channel bytes of the visitation
+ * @return - indicates whether visitation should continue (until the details views are canceled)
  *
  * Visitation method to process each CUDA data transfer event and provide to CUDA event details view.
  */
-bool PerformanceDataManager::processDataTransferDetails(const QString &clusteringCriteriaName, const Base::Time &time_origin, const CUDA::DataTransfer &details)
+bool PerformanceDataManager::processDataTransferDetails(const QString &clusteringCriteriaName, const Base::Time &time_origin, const CUDA::DataTransfer &details, BoundedSignalChannel::Batch* batch)
 {
+    if ( AnalysisScheduler::isCanceled() )
+        return false; // stop the visitation
+
     QVariantList detailsData = ArgoNavis::CUDA::getDataTransferDetailsDataList( time_origin, details );
 
+    if ( ! batch->acquire( BoundedSignalChannel::sizeOf( detailsData ) ) )
+        return false; // stop the visitation
+
+    const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+    if ( publishing.isCanceled() )
+        return false; // stop the visitation
+
     emit addMetricViewData( clusteringCriteriaName, CUDA_EVENT_DETAILS_METRIC, QStringLiteral("None"), ALL_EVENTS_DETAILS_VIEW, detailsData, ArgoNavis::CUDA::getDataTransferDetailsHeaderList() );
 
     return true; // continue the visitation
@@ -1307,14 +1680,26 @@ bool PerformanceDataManager::processDataTransferDetails(const QString &clusterin
  * @param clusterName - the clustering criteria name
  * @param time_origin - the time origin of the experiment
  * @param details - the CUDA kernel execution details
- * @return - indicates whether visitation should continue (always true)
+ * @param batch - the batch of channel bytes of the visitation
+ * @return - indicates whether visitation should continue (until the details views are canceled)
  *
  * Visitation method to process each CUDA kernel executiopn event and provide to CUDA event details view.
  */
-bool PerformanceDataManager::processKernelExecutionDetails(const QString &clusteringCriteriaName, const Base::Time &time_origin, const CUDA::KernelExecution &details)
+bool PerformanceDataManager::processKernelExecutionDetails(const QString &clusteringCriteriaName, const Base::Time &time_origin, const CUDA::KernelExecution &details, BoundedSignalChannel::Batch* batch)
 {
+    if ( AnalysisScheduler::isCanceled() )
+        return false; // stop the visitation
+
     QVariantList detailsData = ArgoNavis::CUDA::getKernelExecutionDetailsDataList( time_origin, details );
 
+    if ( ! batch->acquire( BoundedSignalChannel::sizeOf( detailsData ) ) )
+        return false; // stop the visitation
+
+    const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+    if ( publishing.isCanceled() )
+        return false; // stop the visitation
+
     emit addMetricViewData( clusteringCriteriaName, CUDA_EVENT_DETAILS_METRIC, QStringLiteral("None"), ALL_EVENTS_DETAILS_VIEW, detailsData, ArgoNavis::CUDA::getKernelExecutionDetailsHeaderList() );
 
     return true; // continue the visitation
@@ -1470,13 +1855,16 @@ std::set<Loop> PerformanceDataManager::getThreadSet<Loop>(const ThreadGroup& thr
 /**
  * @brief PerformanceDataManager::getLocationInfo
  * @param metric - the Function metric object reference
+ * @param filename - the source filename of the defining location
+ * @param lineNumber - the line number of the defining location
  * @return - the defining location information form the metric object reference
  *
  * This is a template specialization of getLocationInfo template for the Function typename.
- * The function accesses the Function object and returns the defining location information,
+ * The function queries the definitions of the Function object once and returns the defining location information.
+ * The source location is the last defining location shown in the location information or an empty filename if there is none.
  */
 template <>
-QString PerformanceDataManager::getLocationInfo(const Function& metric)
+QString PerformanceDataManager::getLocationInfo(const Function& metric, QString& filename, int& lineNumber)
 {
     QString locationInfo;
 
@@ -1486,24 +1874,47 @@ QString PerformanceDataManager::getLocationInfo(const Function& metric)
     locationInfo = QString( metric.getDemangledName().c_str() );
 #endif
 
+    filename.clear();
+    lineNumber = 0;
+
     std::set<Statement> definitions = metric.getDefinitions();
-    for(std::set<Statement>::const_iterator j = definitions.begin(); j != definitions.end(); ++j)
+    for(std::set<Statement>::const_iterator j = definitions.begin(); j != definitions.end(); ++j) {
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-        locationInfo += " (" + QString::fromStdString( j->getPath().getDirName() ) + QString::fromStdString( j->getPath().getBaseName() ) + ", " + QString::number( j->getLine() ) + ")";
+        filename = QString::fromStdString( j->getPath().getDirName() ) + QString::fromStdString( j->getPath().getBaseName() );
 #else
-        locationInfo += " (" + QString( j->getPath().getDirName().c_str() ) + QString( j->getPath().getBaseName().c_str() ) + ", " + QString::number( j->getLine() ) + ")";
+        filename = QString( j->getPath().getDirName().c_str() ) + QString( j->getPath().getBaseName().c_str() );
 #endif
+        lineNumber = j->getLine();
+        locationInfo += " (" + filename + ", " + QString::number( lineNumber ) + ")";
+    }
 
     return locationInfo;
 }
 
 /**
  * @brief PerformanceDataManager::getLocationInfo
- * @param metric - the LinkedObject metric object reference
+ * @param metric - the Function metric object reference
  * @return - the defining location information form the metric object reference
  *
- * This is a template specialization of getLocationInfo template for the LinkedObject typename.
- * The function accesses the LinkedObject object and returns the defining location information,
+ * This is a template specialization of getLocationInfo template for the Function typename.
+ * The function accesses the Function object and returns the defining location information,
+ */
+template <>
+QString PerformanceDataManager::getLocationInfo(const Function& metric)
+{
+    QString filename;
+    int lineNumber;
+
+    return getLocationInfo( metric, filename, lineNumber );
+}
+
+/**
+ * @brief PerformanceDataManager::getLocationInfo
+ * @param metric - the LinkedObject metric object reference
+ * @return - the defining location information form the metric object reference
+ *
+ * This is a template specialization of getLocationInfo template for the LinkedObject typename.
+ * The function accesses the LinkedObject object and returns the defining location information,
  */
 template <>
 QString PerformanceDataManager::getLocationInfo(const LinkedObject& metric)
@@ -1519,6 +1930,29 @@ QString PerformanceDataManager::getLocationInfo(const LinkedObject& metric)
     return locationInfo;
 }
 
+/**
+ * @brief PerformanceDataManager::getLocationInfo
+ * @param metric - the Statement metric object reference
+ * @param filename - the source filename of the statement
+ * @param lineNumber - the line number of the statement
+ * @return - the defining location information form the metric object reference
+ *
+ * This is a template specialization of getLocationInfo template for the Statement typename.
+ * The function accesses the Statement object and returns the defining location information and the source location.
+ */
+template <>
+QString PerformanceDataManager::getLocationInfo(const Statement& metric, QString& filename, int& lineNumber)
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+    filename = QString::fromStdString( metric.getPath() );
+#else
+    filename = QString( metric.getPath().c_str() );
+#endif
+    lineNumber = metric.getLine();
+
+    return filename + ", " + QString::number( lineNumber );
+}
+
 /**
  * @brief PerformanceDataManager::getLocationInfo
  * @param metric - the Statement metric object reference
@@ -1529,15 +1963,42 @@ QString PerformanceDataManager::getLocationInfo(const LinkedObject& metric)
  */
 template <>
 QString PerformanceDataManager::getLocationInfo(const Statement& metric)
+{
+    QString filename;
+    int lineNumber;
+
+    return getLocationInfo( metric, filename, lineNumber );
+}
+
+/**
+ * @brief PerformanceDataManager::getLocationInfo
+ * @param metric - the Loop metric object reference
+ * @param filename - the source filename of the defining location
+ * @param lineNumber - the line number of the defining location
+ * @return - the defining location information form the metric object reference
+ *
+ * This is a template specialization of getLocationInfo template for the Loop typename.
+ * The function queries the definitions of the Loop object once and returns the defining location information.
+ * The source location is the last defining location shown in the location information or an empty filename if there is none.
+ */
+template <>
+QString PerformanceDataManager::getLocationInfo(const Loop& metric, QString& filename, int& lineNumber)
 {
     QString locationInfo;
 
+    filename.clear();
+    lineNumber = 0;
+
+    std::set<Statement> definitions = metric.getDefinitions();
+    for(std::set<Statement>::const_iterator j = definitions.begin(); j != definitions.end(); ++j) {
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-    locationInfo = QString::fromStdString( metric.getPath() );
+       filename = QString::fromStdString( j->getPath().getDirName() ) + QString::fromStdString( j->getPath().getBaseName() );
 #else
-    locationInfo = QString( metric.getPath().c_str() );
+       filename = QString( j->getPath().getDirName().c_str() ) + QString( j->getPath().getBaseName().c_str() );
 #endif
-    locationInfo += ", " + QString::number( metric.getLine() );
+       lineNumber = j->getLine();
+       locationInfo += filename + ", " + QString::number( lineNumber );
+    }
 
     return locationInfo;
 }
@@ -1553,17 +2014,47 @@ QString PerformanceDataManager::getLocationInfo(const Statement& metric)
 template <>
 QString PerformanceDataManager::getLocationInfo(const Loop& metric)
 {
-    QString locationInfo;
+    QString filename;
+    int lineNumber;
 
-    std::set<Statement> definitions = metric.getDefinitions();
-    for(std::set<Statement>::const_iterator j = definitions.begin(); j != definitions.end(); ++j)
-#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-       locationInfo += QString::fromStdString( j->getPath().getDirName() ) + QString::fromStdString( j->getPath().getBaseName() ) + ", " + QString::number( j->getLine() );
-#else
-       locationInfo += QString( j->getPath().getDirName().c_str() ) + QString( j->getPath().getBaseName().c_str() ) + ", " + QString::number( j->getLine() );
-#endif
+    return getLocationInfo( metric, filename, lineNumber );
+}
 
-    return locationInfo;
+/**
+ * @brief PerformanceDataManager::emitSourceLineMetricData
+ * @param clusteringCriteriaName - the name of the clustering criteria
+ * @param modeName - the mode name
+ * @param metricName - the name of the metric requested in the metric view
+ * @param viewName - the name of the view requested in the metric view
+ * @param metrics - the source line metrics of the rows of the metric view
+ *
+ * Publishes the source line metrics of all rows of the metric view to the source view with a single signal.  The bytes of the signal are
+ * acquired from the channel, so the caller commits its batch of rows first.
+ */
+void PerformanceDataManager::emitSourceLineMetricData(const QString &clusteringCriteriaName, const QString &modeName, const QString &metricName, const QString &viewName, const SourceLineMetrics &metrics)
+{
+    if ( metrics.data.isEmpty() || AnalysisScheduler::isCanceled() )
+        return;
+
+    BoundedSignalChannel* channel = BoundedSignalChannel::instance();
+
+    qint64 bytes( 0 );
+
+    for ( int i=0; i<metrics.data.size(); ++i ) {
+        bytes += BoundedSignalChannel::sizeOf( metrics.filenames[i] ) + sizeof( int ) + BoundedSignalChannel::sizeOf( metrics.data[i] );
+    }
+
+    if ( ! channel->acquire( bytes ) )
+        return;
+
+    {
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+        if ( ! publishing.isCanceled() )
+            emit addSourceLineMetricData( clusteringCriteriaName, modeName, metricName, viewName, metrics.filenames, metrics.lineNumbers, metrics.data );
+    }
+
+    channel->commit( bytes );
 }
 
 /**
@@ -1867,12 +2358,17 @@ void PerformanceDataManager::processCompareThreadView(const CollectorGroup& coll
 
     emit addMetricView( clusteringCriteriaName, compareMode, metric, viewName, metricDesc );
 
+    BoundedSignalChannel::Batch batch( BoundedSignalChannel::instance() );
+
     for ( typename QMap< TS, QVariantList >::iterator i = metricData.begin(); i != metricData.end(); ++i ) {
         QVariantList& data = i.value();
         // fill in null values for each thread not containing TS
         while ( data.size() < count+1 ) {
             data << NULL_VALUE;
         }
+        const qint64 bytes = BoundedSignalChannel::sizeOf( data );
+        if ( ! batch.acquire( bytes ) )
+            break;
         emit addMetricViewData( clusteringCriteriaName, compareMode, metric, viewName, data );
     }
 
@@ -1881,6 +2377,228 @@ void PerformanceDataManager::processCompareThreadView(const CollectorGroup& coll
 #endif
 }
 
+/**
+ * @brief PerformanceDataManager::getMetricViewRows
+ * @param collector - the collector used for the metric view
+ * @param metric - the metric to generate data for
+ * @param interval - the time interval of the metric view
+ * @param threadGroup - the threads selected for the metric view
+ * @param rows - the rows of the metric view
+ * @return - false if the metric view was canceled
+ *
+ * Evaluates the metric for all objects of the TS typename in the selected threads by querying the experiment database.  The rows are
+ * ordered by decreasing metric value and hold the sum, minimum, maximum and mean of the values over the threads for each object.
+ */
+template <typename TM, typename TS>
+bool PerformanceDataManager::getMetricViewRows(const Collector &collector,
+                                               const QString &metric,
+                                               const TimeInterval &interval,
+                                               const ThreadGroup &threadGroup,
+                                               MetricViewRows<TM> &rows)
+{
+    // Evaluate the first collector's time metric for all functions
+    SmartPtr<std::map<TS, std::map<Thread, TM> > > individual;
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+    std::string metricStr = metric.toStdString();
+#else
+    std::string metricStr = std::string( metric.toLatin1().data() );
+#endif
+    Queries::GetMetricValues( collector,
+                              metricStr,
+                              interval,
+                              threadGroup,
+                              getThreadSet<TS>( threadGroup ),
+                              individual );
+
+    // the remaining steps are skipped once the metric view has been superseded or unloaded
+    if ( AnalysisScheduler::isCanceled() )
+        return false;
+
+    SmartPtr<std::map<TS, TM> > data =
+            Queries::Reduction::Apply( individual, Queries::Reduction::Summation );
+    SmartPtr<std::map<TS, TM> > dataMin =
+            Queries::Reduction::Apply( individual, Queries::Reduction::Minimum );
+    SmartPtr<std::map<TS, TM> > dataMax =
+            Queries::Reduction::Apply( individual, Queries::Reduction::Maximum );
+    SmartPtr<std::map<TS, TM> > dataMean =
+            Queries::Reduction::Apply( individual, Queries::Reduction::ArithmeticMean );
+    individual = SmartPtr<std::map<TS, std::map<Thread, TM> > >();
+
+    if ( AnalysisScheduler::isCanceled() )
+        return false;
+
+    // Sort the results
+    std::multimap<TM, TS> sorted;
+    for( typename std::map<TS, TM>::const_iterator i = data->begin(); i != data->end(); ++i ) {
+        sorted.insert(std::make_pair(i->second, i->first));
+        rows.total += i->second;
+    }
+
+    rows.reserve( sorted.size() );
+
+    for ( typename std::multimap<TM, TS>::reverse_iterator i = sorted.rbegin(); i != sorted.rend(); ++i ) {
+        QString filename;
+        int lineNumber;
+        rows.locations << getLocationInfo<TS>( i->second, filename, lineNumber );
+        rows.filenames << filename;
+        rows.lineNumbers << lineNumber;
+        rows.values.push_back( i->first );
+        rows.minimums.push_back( dataMin->at(i->second) );
+        rows.maximums.push_back( dataMax->at(i->second) );
+        rows.means.push_back( dataMean->at(i->second) );
+    }
+
+    return true;
+}
+
+/**
+ * @brief PerformanceDataManager::getSnapshotMetricViewRows<double, Function>
+ * @param info - the metric table view information of the clustering criteria
+ * @param collector - the collector used for the metric view
+ * @param metric - the metric to generate data for
+ * @param interval - the time interval of the metric view
+ * @param threadGroup - the threads selected for the metric view
+ * @param rows - the rows of the metric view
+ * @return - whether the rows were read from the snapshot
+ *
+ * This is a template specialization of the getSnapshotMetricViewRows template for the double and Function typenames.  The snapshot holds
+ * the per-thread values of one time metric of the first collector for all functions over the whole experiment (see ExperimentSnapshot).
+ * When the metric view is for that metric over the whole experiment and all selected threads are found in the snapshot, the rows are
+ * computed from the mapped snapshot columns exactly as getMetricViewRows computes them from the experiment database.
+ */
+template <>
+bool PerformanceDataManager::getSnapshotMetricViewRows<double, Function>(MetricTableViewInfo &info,
+                                                                         const Collector &collector,
+                                                                         const QString &metric,
+                                                                         const TimeInterval &interval,
+                                                                         const ThreadGroup &threadGroup,
+                                                                         MetricViewRows<double> &rows)
+{
+    Q_UNUSED( collector );
+
+    const QSharedPointer< const ExperimentSnapshot > snapshot = info.getSnapshot();
+
+    if ( snapshot.isNull() || threadGroup.empty() )
+        return false;
+
+    quint64 count;
+
+    // the snapshot values are for the whole experiment
+    const quint64* extent = snapshot->column< quint64 >( ExperimentSnapshot::TIME_INTERVAL, count );
+
+    if ( Q_NULLPTR == extent || count != 2 || interval.getBegin().getValue() != extent[0] || interval.getEnd().getValue() != extent[1] )
+        return false;
+
+    const quint32* metricName = snapshot->column< quint32 >( ExperimentSnapshot::FUNCTION_METRIC_NAME, count );
+
+    if ( Q_NULLPTR == metricName || count != 1 || snapshot->string( metricName[0] ) != metric )
+        return false;
+
+    quint64 functionCount, valueCount, hostCount, pidCount, tidCount;
+
+    const quint32* functionNames = snapshot->column< quint32 >( ExperimentSnapshot::FUNCTION_NAME, functionCount );
+    const quint32* functions = snapshot->column< quint32 >( ExperimentSnapshot::FUNCTION_METRIC_FUNCTION, count );
+    const double* values = snapshot->column< double >( ExperimentSnapshot::FUNCTION_METRIC_VALUE, valueCount );
+    const quint32* hosts = snapshot->column< quint32 >( ExperimentSnapshot::THREAD_HOST, hostCount );
+    const qint64* pids = snapshot->column< qint64 >( ExperimentSnapshot::THREAD_PROCESS_ID, pidCount );
+    const qint64* tids = snapshot->column< qint64 >( ExperimentSnapshot::THREAD_POSIX_THREAD_ID, tidCount );
+
+    if ( Q_NULLPTR == functionNames || Q_NULLPTR == functions || Q_NULLPTR == values || Q_NULLPTR == hosts || Q_NULLPTR == pids || Q_NULLPTR == tids ||
+         count != valueCount || pidCount != hostCount || tidCount != hostCount || ! snapshot->hasColumn( ExperimentSnapshot::FUNCTION_DEFINITION_OFFSETS ) )
+        return false;
+
+    // find the snapshot thread of each selected thread
+    QHash< QString, quint32 > snapshotThreads;
+
+    for ( quint32 i=0; i<hostCount; ++i ) {
+        snapshotThreads.insert( QString("%1:%2:%3").arg( snapshot->string( hosts[i] ) ).arg( pids[i] ).arg( tids[i] ), i );
+    }
+
+    // the sum, minimum, maximum and sample count of each function over the selected threads
+    QHash< quint32, double > sums, minimums, maximums;
+    QHash< quint32, int > counts;
+
+    for ( ThreadGroup::const_iterator iter = threadGroup.begin(); iter != threadGroup.end(); ++iter ) {
+        const std::pair< bool, pthread_t > tid = iter->getPosixThreadId();
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+        const QString host = QString::fromStdString( iter->getHost() );
+#else
+        const QString host = QString( iter->getHost().c_str() );
+#endif
+        const QString key = QString("%1:%2:%3").arg( host ).arg( qint64( iter->getProcessId() ) ).arg( tid.first ? qint64( tid.second ) : qint64( -1 ) );
+
+        QHash< QString, quint32 >::const_iterator thread = snapshotThreads.constFind( key );
+
+        quint64 first, last;
+
+        if ( thread == snapshotThreads.constEnd() ||
+             ! snapshot->rowRange( ExperimentSnapshot::FUNCTION_METRIC_THREAD_OFFSETS, thread.value(), first, last ) || last > count )
+            return false;
+
+        for ( quint64 row=first; row<last; ++row ) {
+            const quint32 function = functions[row];
+            const double value = values[row];
+
+            if ( function >= functionCount )
+                return false;
+
+            if ( counts.contains( function ) ) {
+                sums[ function ] += value;
+                minimums[ function ] = qMin( minimums[ function ], value );
+                maximums[ function ] = qMax( maximums[ function ], value );
+                counts[ function ]++;
+            }
+            else {
+                sums.insert( function, value );
+                minimums.insert( function, value );
+                maximums.insert( function, value );
+                counts.insert( function, 1 );
+            }
+        }
+    }
+
+    // Sort the results
+    std::multimap< double, quint32 > sorted;
+    for ( QHash< quint32, double >::const_iterator iter = sums.constBegin(); iter != sums.constEnd(); ++iter ) {
+        sorted.insert( std::make_pair( iter.value(), iter.key() ) );
+        rows.total += iter.value();
+    }
+
+    const quint32* definitionPaths = snapshot->column< quint32 >( ExperimentSnapshot::FUNCTION_DEFINITION_PATH, count );
+    const qint32* definitionLines = snapshot->column< qint32 >( ExperimentSnapshot::FUNCTION_DEFINITION_LINE, valueCount );
+
+    rows.reserve( sorted.size() );
+
+    for ( std::multimap< double, quint32 >::reverse_iterator i = sorted.rbegin(); i != sorted.rend(); ++i ) {
+        const quint32 function = i->second;
+
+        // the location information has the same form as the one from getLocationInfo<Function>
+        QString locationInfo = snapshot->string( functionNames[ function ] );
+        QString filename;
+        int lineNumber( 0 );
+
+        quint64 first, last;
+
+        if ( snapshot->rowRange( ExperimentSnapshot::FUNCTION_DEFINITION_OFFSETS, function, first, last ) && last <= count && last <= valueCount ) {
+            for ( quint64 j=first; j<last; ++j ) {
+                filename = snapshot->string( definitionPaths[j] );
+                lineNumber = definitionLines[j];
+                locationInfo += " (" + filename + ", " + QString::number( lineNumber ) + ")";
+            }
+        }
+
+        rows.locations << locationInfo;
+        rows.filenames << filename;
+        rows.lineNumbers << lineNumber;
+        rows.values.push_back( i->first );
+        rows.minimums.push_back( minimums[ function ] );
+        rows.maximums.push_back( maximums[ function ] );
+        rows.means.push_back( i->first / counts[ function ] );
+    }
+
+    return true;
+}
+
 /**
  * @brief PerformanceDataManager::processMetricView
  * @param clusteringCriteriaName - the name of the clustering criteria
@@ -1943,36 +2661,16 @@ void PerformanceDataManager::processMetricView(const QString clusteringCriteriaN
 
     const QString viewName = getViewName<TS>();
 
-    // Evaluate the first collector's time metric for all functions
-    SmartPtr<std::map<TS, std::map<Thread, TM> > > individual;
-#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-    std::string metricStr = metric.toStdString();
-#else
-    std::string metricStr = std::string( metric.toLatin1().data() );
-#endif
-    Queries::GetMetricValues( collector,
-                              metricStr,
-                              interval,
-                              threadGroup,
-                              getThreadSet<TS>( threadGroup ),
-                              individual );
-    SmartPtr<std::map<TS, TM> > data =
-            Queries::Reduction::Apply( individual, Queries::Reduction::Summation );
-    SmartPtr<std::map<TS, TM> > dataMin =
-            Queries::Reduction::Apply( individual, Queries::Reduction::Minimum );
-    SmartPtr<std::map<TS, TM> > dataMax =
-            Queries::Reduction::Apply( individual, Queries::Reduction::Maximum );
-    SmartPtr<std::map<TS, TM> > dataMean =
-            Queries::Reduction::Apply( individual, Queries::Reduction::ArithmeticMean );
-    individual = SmartPtr<std::map<TS, std::map<Thread, TM> > >();
+    // the metric view over the whole experiment is read from the snapshot of the experiment database when one is current
+    MetricViewRows<TM> rows;
 
-    // Sort the results
-    std::multimap<TM, TS> sorted;
-    TM total( 0 );
-    for( typename std::map<TS, TM>::const_iterator i = data->begin(); i != data->end(); ++i ) {
-        sorted.insert(std::make_pair(i->second, i->first));
-        total += i->second;
-    }
+    if ( ! getSnapshotMetricViewRows<TM, TS>( info, collector, metric, interval, threadGroup, rows ) &&
+         ! getMetricViewRows<TM, TS>( collector, metric, interval, threadGroup, rows ) )
+        return;
+
+    // the remaining steps are skipped once the metric view has been superseded or unloaded
+    if ( AnalysisScheduler::isCanceled() )
+        return;
 
     // Display the results
 
@@ -1986,43 +2684,67 @@ void PerformanceDataManager::processMetricView(const QString clusteringCriteriaN
 
     const QString METRIC_MODE_VIEW = QStringLiteral("Metric");
 
-    emit addMetricView( clusteringCriteriaName, METRIC_MODE_VIEW, metric, viewName, metricDesc );
-
     // get collector type
     const QString collectorId( collector.getMetadata().getUniqueId().c_str() );
 
     // flag indicating emit signals for add trace item (=false) or graph item (=true)
     const bool emitGraphItem( s_METRIC_GRAPH_VIEWS.contains( collectorId ) );
 
-    if ( emitGraphItem ) {
-        QStringList items;
+    {
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
 
-        for ( typename std::multimap<TM, TS>::reverse_iterator i = sorted.rbegin(); i != sorted.rend(); ++i ) {
-            items << getLocationInfo<TS>( i->second );
-        }
+        if ( publishing.isCanceled() )
+            return;
 
-        QString graphTitle;
+        emit addMetricView( clusteringCriteriaName, METRIC_MODE_VIEW, metric, viewName, metricDesc );
 
-        if ( s_TRACING_EXPERIMENTS_GRAPH_TITLES.contains( collectorId ) && s_TRACING_EXPERIMENTS_GRAPH_TITLES[ collectorId ].contains( metric ) ) {
-            graphTitle = s_TRACING_EXPERIMENTS_GRAPH_TITLES[ collectorId ][ metric ];
-        }
+        if ( emitGraphItem ) {
+            QString graphTitle;
+
+            if ( s_TRACING_EXPERIMENTS_GRAPH_TITLES.contains( collectorId ) && s_TRACING_EXPERIMENTS_GRAPH_TITLES[ collectorId ].contains( metric ) ) {
+                graphTitle = s_TRACING_EXPERIMENTS_GRAPH_TITLES[ collectorId ][ metric ];
+            }
 
-        emit createGraphItems( clusteringCriteriaName, graphTitle, metric, viewName, QStringList() << metricDesc[0], items );
+            emit createGraphItems( clusteringCriteriaName, graphTitle, metric, viewName, QStringList() << metricDesc[0], rows.locations );
+        }
     }
 
     int index( 0 );
 
-    for ( typename std::multimap<TM, TS>::reverse_iterator i = sorted.rbegin(); i != sorted.rend(); ++i ) {
+    BoundedSignalChannel::Batch batch( BoundedSignalChannel::instance() );
+
+    SourceLineMetrics sourceLineMetrics;
+
+    for ( int row=0; row<rows.locations.size(); ++row ) {
+
+        if ( AnalysisScheduler::isCanceled() )
+            break;
+
+        QVariantList metricData = getMetricValues( rows.locations[row], rows.values[row], rows.total, rows.minimums[row], rows.maximums[row], rows.means[row] );
+
+        // the row is published to the metric view and the graph view
+        const qint64 bytes = BoundedSignalChannel::sizeOf( metricData );
+        if ( ! batch.acquire( bytes ) )
+            break;
+
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
 
-        QVariantList metricData = getMetricValues( getLocationInfo<TS>( i->second ), i->first, total, dataMin->at(i->second), dataMax->at(i->second), dataMean->at(i->second) );
+        if ( publishing.isCanceled() )
+            break;
 
         emit addMetricViewData( clusteringCriteriaName, METRIC_MODE_VIEW, metric, viewName, metricData );
 
+        sourceLineMetrics.append( rows.filenames[row], rows.lineNumbers[row], metricData );
+
         if ( emitGraphItem && metricData.size() == metricDesc.size() && metricData.size() > 2 ) {
             emit addGraphItem( metric, viewName, metricDesc[0], index++, metricData[0].toDouble() );
         }
     }
 
+    batch.commit();
+
+    emitSourceLineMetricData( clusteringCriteriaName, METRIC_MODE_VIEW, metric, viewName, sourceLineMetrics );
+
 #if defined(HAS_PARALLEL_PROCESS_METRIC_VIEW_DEBUG)
     qDebug() << "PerformanceDataManager::processMetricView FINISHED" << metric;
 #endif
@@ -2123,6 +2845,8 @@ void PerformanceDataManager::processLoadBalanceView(const CollectorGroup& collec
 
     const DT factor = ( metricDesc.contains( s_minimumTitle ) ) ? 1000 : 1;
 
+    BoundedSignalChannel::Batch batch( BoundedSignalChannel::instance() );
+
     for( typename std::map< TS, TM >::const_iterator i = dataMax->begin(); i != dataMax->end(); ++i ) {
         QVariantList metricData;
 
@@ -2138,6 +2862,9 @@ void PerformanceDataManager::processLoadBalanceView(const CollectorGroup& collec
         metricData << ArgoNavis::CUDA::getUniqueClusterName( meanThreads.at( i->first ) );
         metricData << getLocationInfo<TS>( i->first );
 
+        const qint64 bytes = BoundedSignalChannel::sizeOf( metricData );
+        if ( ! batch.acquire( bytes ) )
+            break;
         emit addMetricViewData( clusteringCriteriaName, QStringLiteral("Load Balance"), metric, viewName, metricData );
     }
 
@@ -2402,6 +3129,20 @@ void PerformanceDataManager::loadDefaultViews(const QString &filePath)
         }
 
         MetricTableViewInfo info( experiment, interval, metricList );
+#if defined(HAS_OSSSNAPSHOT)
+        info.setSnapshot( openSnapshot( filePath, experiment_interval ) );
+#endif
+
+        // Only the metric view initially shown is generated while loading the experiment.  The remaining metric views
+        // are generated when first shown or prefetched once the application is idle.
+        const QString METRIC_MODE_NAME = PerformanceDataMetricView::getMetricModeName( PerformanceDataMetricView::METRIC_MODE );
+        for ( int i=0; i<metricList.size(); ++i ) {
+            const QString metricViewName = PerformanceDataMetricView::getMetricViewName( METRIC_MODE_NAME, metricList[i], s_functionsView );
+            if ( 0 == i )
+                info.setVisibleMetricView( metricViewName );
+            else
+                info.addDeferredMetricView( metricViewName );
+        }
 
         m_tableViewInfo.insert( clusteringCriteriaName, info );
 
@@ -2418,16 +3159,22 @@ void PerformanceDataManager::loadDefaultViews(const QString &filePath)
 #endif
         }
 
-        foreach ( const QString& metricName, metricList ) {
+        emit addDeferredMetrics( clusteringCriteriaName, metricList );
+
+        if ( ! metricList.isEmpty() ) {
             m_numberLoadWorkUnitsInProgress.ref();
 
-            handleRequestMetricView( clusteringCriteriaName, metricName, s_functionsView );
+            handleRequestMetricView( clusteringCriteriaName, metricList.first(), s_functionsView );
         }
 
         if ( hasCudaCollector ) {
             QtConcurrent::run( this, &PerformanceDataManager::loadCudaView, experimentName, clusteringCriteriaName, collector.get(), experiment->getThreads() );
 
-            QtConcurrent::run( this, &PerformanceDataManager::handleProcessDetailViews, clusteringCriteriaName );
+            // the details views are canceled when the views of the clustering criteria are unloaded
+            const QString detailsViewName = PerformanceDataMetricView::getMetricViewName( CUDA_EVENT_DETAILS_METRIC, QStringLiteral("None"), ALL_EVENTS_DETAILS_VIEW );
+
+            m_scheduler.run( AnalysisScheduler::VisibleViewLane, m_scheduler.supersede( clusteringCriteriaName, detailsViewName ),
+                             boost::bind( &PerformanceDataManager::handleProcessDetailViews, this, clusteringCriteriaName ) );
         }
         else {
             // set default metric view
@@ -2474,6 +3221,9 @@ void PerformanceDataManager::loadDefaultViews(const QString &filePath)
  * @param upper - the upper value of the interval to process
  *
  * This handler in invoked when the waiting period has benn reached and actual processing of the CUDA metric view can proceed.
+ * Only the metric view currently shown is generated again for the new interval.  The other metric views are marked stale and
+ * are generated again when next shown or prefetched once the application is idle.  Generations still in progress for the previous
+ * interval are canceled, so zooming several times in a row only generates the metric views for the final interval.
  */
 void PerformanceDataManager::handleLoadCudaMetricViewsTimeout(const QString& clusteringCriteriaName, double lower, double upper)
 {
@@ -2497,6 +3247,8 @@ void PerformanceDataManager::handleLoadCudaMetricViewsTimeout(const QString& clu
     // update interval
     info.setInterval( lowerTime, upperTime );
 
+    const QString visibleMetricViewName = info.getVisibleMetricView();
+
     foreach ( const QString& metricViewName, info.getMetricViewList() ) {
         QStringList tokens = metricViewName.split('-');
         if ( tokens.size() != 3 )
@@ -2505,6 +3257,14 @@ void PerformanceDataManager::handleLoadCudaMetricViewsTimeout(const QString& clu
             // Emit signal to update detail views corresponding to timeline in graph view
             emit metricViewRangeChanged( clusteringCriteriaName, tokens[0], tokens[1], tokens[2], lower, upper );
         }
+        else if ( metricViewName != visibleMetricViewName ) {
+            // a generation of the metric view for the previous time range is of no use
+            m_scheduler.cancel( clusteringCriteriaName, metricViewName );
+            info.setMetricViewStale( metricViewName );
+            // compare and load balance views are generated synchronously and thus only when shown
+            if ( ! tokens[0].startsWith("Compare") && QStringLiteral("Load Balance") != tokens[0] )
+                info.addDeferredMetricView( metricViewName );
+        }
         else if ( tokens[0].startsWith("Compare") ) {
             handleRequestCompareView( clusteringCriteriaName, tokens[0], tokens[1], tokens[2] );
         }
@@ -2515,6 +3275,8 @@ void PerformanceDataManager::handleLoadCudaMetricViewsTimeout(const QString& clu
             handleRequestMetricView( clusteringCriteriaName, tokens[1], tokens[2] );
         }
     }
+
+    handlePrefetchDeferredMetricViews( clusteringCriteriaName );
 }
 
 /**
@@ -2564,10 +3326,12 @@ void PerformanceDataManager::handleLoadComplete()
 
 /**
  * @brief PerformanceDataManager::loadCudaMetricViews
- * @param futures - the vector of futures used to store futures returned from invoking QtConcurrent::run
+ * @param futures - the vector of futures used to store futures returned from running the work units
  * @param clusteringCriteriaName - the clustering criteria name
  * @param metricList - the list of metrics to process and add to metric view
  * @param viewList - the list of views to process and add to the metric view
+ * @param lane - the lane of the analysis scheduler in which to process the metric views
+ * @param token - the cancellation token of the work units
  *
  * Process the specified metric views.
  */
@@ -2575,56 +3339,58 @@ void PerformanceDataManager::loadCudaMetricViews(
         QVector< QFuture<void> >& futures,
         const QString& clusteringCriteriaName,
         const QStringList& metricList,
-        const QStringList& viewList)
+        const QStringList& viewList,
+        AnalysisScheduler::Lane lane,
+        const CancellationToken& token)
 {
     foreach ( QString metricName, metricList ) {
         foreach ( QString viewName, viewList ) {
             if ( viewName == s_functionsView ) {
                 if ( metricName == QStringLiteral("overflows") )
-                    futures << QtConcurrent::run(
+                    futures << m_scheduler.run( lane, token,
                                 boost::bind( &PerformanceDataManager::processMetricView<std::uint64_t, Function>, this,
                                              clusteringCriteriaName, metricName ) );
                 else
-                    futures << QtConcurrent::run(
+                    futures << m_scheduler.run( lane, token,
                                 boost::bind( &PerformanceDataManager::processMetricView<double, Function>, this,
                                              clusteringCriteriaName, metricName ) );
             }
 
             else if ( viewName == s_statementsView ) {
                 if ( metricName == QStringLiteral("overflows") )
-                    futures << QtConcurrent::run(
+                    futures << m_scheduler.run( lane, token,
                                 boost::bind( &PerformanceDataManager::processMetricView<std::uint64_t, Statement>, this,
                                              clusteringCriteriaName, metricName ) );
                 else
-                    futures << QtConcurrent::run(
+                    futures << m_scheduler.run( lane, token,
                                 boost::bind( &PerformanceDataManager::processMetricView<double, Statement>, this,
                                              clusteringCriteriaName, metricName ) );
             }
 
             else if ( viewName == s_linkedObjectsView ) {
                 if ( metricName == QStringLiteral("overflows") )
-                    futures << QtConcurrent::run(
+                    futures << m_scheduler.run( lane, token,
                                 boost::bind( &PerformanceDataManager::processMetricView<std::uint64_t, LinkedObject>, this,
                                              clusteringCriteriaName, metricName ) );
                 else
-                    futures << QtConcurrent::run(
+                    futures << m_scheduler.run( lane, token,
                                 boost::bind( &PerformanceDataManager::processMetricView<double, LinkedObject>, this,
                                              clusteringCriteriaName, metricName ) );
             }
 
             else if ( viewName == s_loopsView ) {
                 if ( metricName == QStringLiteral("overflows") )
-                    futures << QtConcurrent::run(
+                    futures << m_scheduler.run( lane, token,
                                 boost::bind( &PerformanceDataManager::processMetricView<std::uint64_t, Loop>, this,
                                              clusteringCriteriaName, metricName ) );
                 else
-                    futures << QtConcurrent::run(
+                    futures << m_scheduler.run( lane, token,
                                 boost::bind( &PerformanceDataManager::processMetricView<double, Loop>, this,
                                              clusteringCriteriaName, metricName ) );
             }
 
             else if ( viewName == QStringLiteral("CallTree") ) {
-                futures << QtConcurrent::run( this, &PerformanceDataManager::processCalltreeView, clusteringCriteriaName );
+                futures << m_scheduler.run( lane, token, boost::bind( &PerformanceDataManager::processCalltreeView, this, clusteringCriteriaName ) );
             }
         }
     }
@@ -2638,33 +3404,15 @@ void PerformanceDataManager::loadCudaMetricViews(
  */
 void PerformanceDataManager::unloadViews(const QString &clusteringCriteriaName)
 {
+    // cancel all work units running or queued for the clustering criteria name
+    m_scheduler.cancelGroup( clusteringCriteriaName );
+
     if ( m_tableViewInfo.contains( clusteringCriteriaName ) ) {
         const OpenSpeedShop::Framework::Experiment* experiment = m_tableViewInfo[ clusteringCriteriaName ].experiment();
         delete experiment;
         m_tableViewInfo.remove( clusteringCriteriaName );
     }
 
-    QMutexLocker guard( &m_futureMapMutex );
-
-    if ( m_futureMap.contains( clusteringCriteriaName ) ) {
-        QMap< QString, QVector< QFuture<void> >* > futureMap = m_futureMap.take( clusteringCriteriaName );
-        // cancel all futures maintained for the clustering criteria name
-        for ( QMap< QString, QVector< QFuture<void> >* >::iterator iter = futureMap.begin(); iter != futureMap.end(); iter++ ) {
-            QVector< QFuture<void> >*& futures( iter.value() );
-            while ( ! futures->empty() ) {
-#if (QT_VERSION >= QT_VERSION_CHECK(5,0,0))
-                futures->takeFirst().cancel();
-#else
-                futures->first().cancel();
-                futures->pop_front();
-#endif
-            }
-        }
-        qDeleteAll( futureMap );
-    }
-
-    Q_ASSERT( m_tableViewInfo.size() == m_futureMap.size() );
-
     if ( 0 == m_tableViewInfo.size() ) {
 #if (QT_VERSION >= QT_VERSION_CHECK(5,0,0))
         disconnect( this, &PerformanceDataManager::graphRangeChanged, m_renderer, &BackgroundGraphRenderer::handleGraphRangeChanged );
@@ -2679,13 +3427,43 @@ void PerformanceDataManager::unloadViews(const QString &clusteringCriteriaName)
 }
 
 /**
- * @brief PerformanceDataManager::unloadCudaViews
+ * @brief PerformanceDataManager::setVisibleMetricView
  * @param clusteringCriteriaName - the clustering criteria name
- * @param clusterNames - the list of associated clusters
+ * @param metricViewName - the metric view currently shown
  *
- * Unload all CUDA views for the specified clusters in the clustering criteria.
+ * Record the metric view currently shown.  This is the only metric view generated again when the time interval changes.
  */
-void PerformanceDataManager::unloadCudaViews(const QString &clusteringCriteriaName, const QStringList &clusterNames)
+void PerformanceDataManager::setVisibleMetricView(const QString &clusteringCriteriaName, const QString &metricViewName)
+{
+    if ( m_tableViewInfo.contains( clusteringCriteriaName ) ) {
+        m_tableViewInfo[ clusteringCriteriaName ].setVisibleMetricView( metricViewName );
+    }
+}
+
+/**
+ * @brief PerformanceDataManager::isMetricViewStale
+ * @param clusteringCriteriaName - the clustering criteria name
+ * @param metricViewName - the metric view name
+ * @return - whether the metric view was generated for a previous time interval
+ *
+ * Returns whether the metric view needs to be generated again before being shown.
+ */
+bool PerformanceDataManager::isMetricViewStale(const QString &clusteringCriteriaName, const QString &metricViewName)
+{
+    if ( ! m_tableViewInfo.contains( clusteringCriteriaName ) )
+        return false;
+
+    return m_tableViewInfo[ clusteringCriteriaName ].isMetricViewStale( metricViewName );
+}
+
+/**
+ * @brief PerformanceDataManager::unloadCudaViews
+ * @param clusteringCriteriaName - the clustering criteria name
+ * @param clusterNames - the list of associated clusters
+ *
+ * Unload all CUDA views for the specified clusters in the clustering criteria.
+ */
+void PerformanceDataManager::unloadCudaViews(const QString &clusteringCriteriaName, const QStringList &clusterNames)
 {
     if ( m_renderer ) {
         m_renderer->unloadCudaViews( clusteringCriteriaName, clusterNames );
@@ -3110,9 +3888,19 @@ void PerformanceDataManager::loadCudaView(const QString& experimentName, const Q
         emit addCluster( clusteringCriteriaName, clusterName, lower, upper, false, 0.0, hasGpuPercentageCounter ? 100.0 : -1.0 );
     }
 
-    data.visitThreads( boost::bind(
-                           &PerformanceDataManager::processPerformanceData, instance(),
-                           boost::cref(data), _1, boost::cref(gpuCounterIndexes), boost::cref(clusteringCriteriaName) ) );
+    // the periodic samples of each thread are processed concurrently - the performance data is only read from here on
+    std::vector< Base::ThreadName > dataThreads;
+    data.visitThreads( [&dataThreads](const Base::ThreadName& thread) { dataThreads.push_back( thread ); return true; } );
+
+    QFutureSynchronizer< bool > synchronizer;
+
+    for ( std::vector< Base::ThreadName >::const_iterator titer = dataThreads.begin(); titer != dataThreads.end(); ++titer ) {
+        synchronizer.addFuture( QtConcurrent::run( AnalysisScheduler::inheritToken(
+                                                       boost::bind( &PerformanceDataManager::processPerformanceData, this,
+                                                                    boost::cref(data), *titer, boost::cref(gpuCounterIndexes), boost::cref(clusteringCriteriaName) ) ) ) );
+    }
+
+    synchronizer.waitForFinished();
 
     // make connections to the 'graphRangeChanged' signal
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
@@ -3196,11 +3984,6 @@ void PerformanceDataManager::loadCudaView(const QString& experimentName, const Q
         }
 
         emit addDevice( i, definedDevice, attributes, maximumLimits );
-
-        // clear temporary data structures used during thread visitation
-        m_sampleKeys.clear();
-        m_sampleValues.clear();
-        m_rawValues.clear();
     }
 
 #if defined(HAS_PARALLEL_PROCESS_METRIC_VIEW_DEBUG)
@@ -3309,6 +4092,10 @@ void PerformanceDataManager::detail_reduction(
     using namespace boost;
 #endif
     for ( std::set< tuple< std::set< Function >, Function > >::iterator fit = caller_function_list.begin(); fit != caller_function_list.end(); fit++) {
+        // the reduced details of a canceled calltree view are not used
+        if ( AnalysisScheduler::isCanceled() )
+            return;
+
         const tuple< std::set< Function >, Function > elem( *fit );
 
         // getting called function name and linked object name
@@ -3593,53 +4380,234 @@ std::pair< std::uint64_t, double > PerformanceDataManager::getDetailTotals(const
 }
 
 /**
- * @brief PerformanceDataManager::ShowCalltreeDetail
- * @param collector - the experiment collector used for the calltree view
- * @param threadGroup - the set of threads applicable to the calltree view
- * @param interval - the time interval for the calltree view
- * @param functions - the set of functions involved in the calltree view
- * @param metric - the metric computed in the calltree view
- * @param metricDesc - the metric table column headers for the calltree view
- * @param clusteringCriteriaName - the clustering criteria name
+ * @brief PerformanceDataManager::processCalltreeStackTraces
+ * @param function - the function whose stack traces are processed
+ * @param first - the first stack trace of the range to process
+ * @param last - the end of the range of stack traces to process
+ * @param subextents_map - the extents of the function in each thread
+ * @param trie - the stack trace trie built from all stack traces and shared by all ranges of stack traces
+ * @return - the caller/callee aggregates of the range of stack traces
  *
- * This method computes the data for the calltree view in accordance with the various contraints for the view -
- * set of threads, set of functions, time interval and the metric name.
+ * This method finds the number of calls and the caller of the function in each stack trace in the range and computes the detail totals.
+ * The caller is found by walking the interned frames of the stack trace in the trie, in which each unique frame was resolved to its function once.
+ * The value of each stack trace is also recorded for the flame graph.
+ * Processing stops at a stack trace without calls or without a caller, as the sequential walk of all stack traces of the function did.
+ * Ranges of stack traces are processed concurrently by ShowCalltreeDetail.
  */
 template <typename DETAIL_t>
-void PerformanceDataManager::ShowCalltreeDetail(
-        const Framework::Collector& collector,
-        const Framework::ThreadGroup& threadGroup,
-        const Framework::TimeInterval& interval,
-        const std::set<Function> functions,
-        const QString metric,
-        const QStringList metricDesc,
-        const QString &clusteringCriteriaName)
+PerformanceDataManager::CalltreeChunk PerformanceDataManager::processCalltreeStackTraces(
+        const Function& function,
+        typename std::map< Framework::StackTrace, DETAIL_t >::const_iterator first,
+        typename std::map< Framework::StackTrace, DETAIL_t >::const_iterator last,
+        const std::map< Framework::Thread, Framework::ExtentGroup >* subextents_map,
+        const StackTraceTrie* trie)
 {
-    // get view name
-    const QString viewName = getViewName<DETAIL_t>();
+    CalltreeChunk chunk;
 
-    emit addMetricView( clusteringCriteriaName, viewName, QStringLiteral("None"), viewName, metricDesc );
+    // index of the interned function (-1 if no frame of the stack traces is in the function)
+    const int functionIndex = trie->functionIndex( function );
 
-    SmartPtr< std::map< Function,
-                std::map< Framework::Thread,
-                    std::map< Framework::StackTrace, DETAIL_t > > > > raw_items;
+    for ( typename std::map< Framework::StackTrace, DETAIL_t >::const_iterator siter = first; siter != last; siter++ ) {
+        // the caller/callee aggregates of a canceled calltree view are not used
+        if ( AnalysisScheduler::isCanceled() ) {
+            chunk.stopped = true;
+            break;
+        }
 
-    Queries::GetMetricValues( collector, metric.toStdString(), interval, threadGroup, functions,  // input - metric search criteria
-                              raw_items );                                                        // output - raw metric values
+        const Framework::StackTrace& stacktrace( siter->first );
 
-    SmartPtr< std::map<Function, std::map<Framework::StackTrace, DETAIL_t > > > data =
-            Queries::Reduction::Apply( raw_items, Queries::Reduction::Summation );
+        // Find the extents associated with the stack trace's thread.
+        std::map< Framework::Thread, Framework::ExtentGroup >::const_iterator tei = subextents_map->find( stacktrace.getThread() );
+        Framework::ExtentGroup subExtents;
+        if ( tei != subextents_map->end() ) {
+            subExtents = (*tei).second;
+        }
+
+        const double num_calls = ( subExtents.begin() == subExtents.end() ) ? 1.0 : (double) stack_contains_N_calls( stacktrace, subExtents );
+
+        if ( 0 == num_calls ) {
+            chunk.stopped = true;
+            break;
+        }
+
+        // the interned stack trace - the trie was built from all stack traces before the chunks were started
+        StackTraceTrie::NodeId node = trie->find( stacktrace );
+
+        // the value of the stack trace (without the recursion factor) for the flame graph
+        if ( StackTraceTrie::NO_NODE != node ) {
+            const CalltreeSample sample = { node, stacktrace.getTime().getValue(), getDetailTotals( siter->second, 1.0 ).second };
+            chunk.samples.push_back( sample );
+        }
+
+        // walk from the innermost frame to the first frame of the function
+        while ( functionIndex >= 0 && ! trie->isRoot( node ) && trie->functionIndex( node ) != functionIndex ) {
+            node = trie->parent( node );
+        }
+
+        std::set< Function > caller;
+
+        if ( functionIndex >= 0 && ! trie->isRoot( node ) ) {
+            const StackTraceTrie::NodeId callerNode = trie->parent( node );
+            const int callerIndex = trie->functionIndex( callerNode );
+            if ( ! trie->isRoot( callerNode ) && callerIndex >= 0 )
+                caller.insert( trie->function( callerIndex ) );
+        }
+
+        if ( 0 == caller.size() ) {
+            chunk.stopped = true;
+            break;
+        }
+
+        const DETAIL_t& detail( siter->second );
+
+        // compute the 'count' and 'time' metric for this 'detail' instance
+        std::pair< std::uint64_t, double > results = getDetailTotals( detail, num_calls );
 
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-    typedef std::tuple< std::set< Function >, Function > CallerCallee_t;
+        chunk.details.push_back( std::make_tuple( results.first, results.second, function, caller ) );
+        chunk.callerFunctions.insert( std::make_tuple( caller, function ) );
+#else
+        chunk.details.push_back( boost::make_tuple( results.first, results.second, function, caller ) );
+        chunk.callerFunctions.insert( boost::make_tuple( caller, function ) );
+#endif
+    }
+
+    return chunk;
+}
+
+/**
+ * @brief buildStackTraceTrie
+ * @param data - the stack traces of each function
+ * @param trie - the stack trace trie to build
+ *
+ * Builds the stack trace trie from the stack traces of all functions in map order.  A stack trace is in the stack traces of each
+ * function it contains; the trie resolves each unique frame once regardless.
+ */
+template <typename DETAIL_t>
+void buildStackTraceTrie(const std::map< Function, std::map< Framework::StackTrace, DETAIL_t > >& data, StackTraceTrie& trie)
+{
+    std::vector< const Framework::StackTrace* > stacktraces;
+
+    for ( typename std::map< Function, std::map< Framework::StackTrace, DETAIL_t > >::const_iterator iter = data.begin(); iter != data.end(); ++iter ) {
+        for ( typename std::map< Framework::StackTrace, DETAIL_t >::const_iterator siter = iter->second.begin(); siter != iter->second.end(); ++siter ) {
+            stacktraces.push_back( &siter->first );
+        }
+    }
+
+    trie.build( stacktraces );
+}
+
+/**
+ * @brief PerformanceDataManager::processCalltreeChunks
+ * @param pool - the thread pool running the chunks (or a null pointer for the global thread pool)
+ * @param chunkSize - the number of stack traces of a function processed by one work unit
+ * @param data - the stack traces of each function of the calltree view
+ * @param subextents_maps - the extents of each function in each thread (in the order of the functions in 'data')
+ * @param trie - the stack trace trie built from the stack traces and shared by all work units
+ * @param aggregates - the merged caller/callee aggregates and flame graph leaf values
+ *
+ * The stack trace trie is built from the stack traces of all functions first.  The stack traces of each function are then partitioned into
+ * contiguous chunks which are processed concurrently by processCalltreeStackTraces.
+ * The chunks are merged in map order, so the aggregates are the same as those of a sequential walk of the stack traces of each function.
+ */
+template <typename DETAIL_t>
+void PerformanceDataManager::processCalltreeChunks(QThreadPool* pool,
+                                                   std::size_t chunkSize,
+                                                   const std::map< Function, std::map< Framework::StackTrace, DETAIL_t > >& data,
+                                                   const std::vector< std::map< Framework::Thread, Framework::ExtentGroup > >& subextents_maps,
+                                                   StackTraceTrie& trie,
+                                                   CalltreeAggregates& aggregates)
+{
+    typedef std::map< Framework::StackTrace, DETAIL_t > StackTraceMap;
+    typedef typename std::map< Function, StackTraceMap >::const_iterator FunctionIterator;
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 4, 0))
+    if ( Q_NULLPTR == pool )
+        pool = QThreadPool::globalInstance();
 #else
-    typedef boost::tuple< std::set< Function >, Function > CallerCallee_t;
+    // before Qt 5.4 QtConcurrent::run always runs in the global thread pool
+    Q_UNUSED( pool );
 #endif
 
-    TALLDETAILS all_details;
-    std::set< CallerCallee_t > caller_function_list;
+    buildStackTraceTrie( data, trie );
+
+    if ( AnalysisScheduler::isCanceled() )
+        return;
+
+    // partition the stack traces of each function into chunks which are processed concurrently
+    std::vector< std::vector< QFuture< CalltreeChunk > > > chunks( data.size() );
+
+    std::size_t index( 0 );
+    for ( FunctionIterator iter = data.begin(); iter != data.end(); ++iter, ++index ) {
+        const StackTraceMap& tracemap( iter->second );
+
+        typename StackTraceMap::const_iterator first = tracemap.begin();
+
+        while ( first != tracemap.end() ) {
+            typename StackTraceMap::const_iterator last = first;
+            for ( std::size_t n=0; n<chunkSize && last != tracemap.end(); ++n )
+                ++last;
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 4, 0))
+            chunks[ index ].push_back( QtConcurrent::run( pool, AnalysisScheduler::inheritToken(
+                                                              boost::bind( &PerformanceDataManager::processCalltreeStackTraces< DETAIL_t >, this,
+                                                                           boost::cref( iter->first ), first, last, &subextents_maps[ index ], &trie ) ) ) );
+#else
+            chunks[ index ].push_back( QtConcurrent::run( AnalysisScheduler::inheritToken(
+                                                              boost::bind( &PerformanceDataManager::processCalltreeStackTraces< DETAIL_t >, this,
+                                                                           boost::cref( iter->first ), first, last, &subextents_maps[ index ], &trie ) ) ) );
+#endif
+
+            first = last;
+        }
+    }
+
+    // a stack trace is in the stack traces of each function it contains - the flame graph counts it once
+    QSet< QPair< StackTraceTrie::NodeId, quint64 > > samples_seen;
+
+    // merge the chunks in the same order as a sequential walk of the stack traces
+    for ( std::size_t i=0; i<chunks.size(); ++i ) {
+        bool stopped( false );
+
+        for ( std::size_t j=0; j<chunks[i].size(); ++j ) {
+            const CalltreeChunk chunk = chunks[i][j].result();
 
-    for ( typename std::map< Function, std::map< Framework::StackTrace, DETAIL_t > >::iterator iter = data->begin(); iter != data->end(); iter++ ) {
+            for ( std::vector< CalltreeSample >::const_iterator siter = chunk.samples.begin(); siter != chunk.samples.end(); ++siter ) {
+                const QPair< StackTraceTrie::NodeId, quint64 > key( siter->leaf, siter->time );
+                if ( samples_seen.contains( key ) )
+                    continue;
+                samples_seen.insert( key );
+                aggregates.leafValues[ siter->leaf ] += siter->value;
+            }
+
+            // the caller/callee aggregates of the remaining chunks of the function are not used
+            if ( stopped )
+                continue;
+
+            aggregates.details.insert( aggregates.details.end(), chunk.details.begin(), chunk.details.end() );
+            aggregates.callerFunctions.insert( chunk.callerFunctions.begin(), chunk.callerFunctions.end() );
+
+            stopped = chunk.stopped;
+        }
+    }
+}
+
+#ifdef HAS_CALLTREE_PROCESSING_TIMING
+/**
+ * @brief PerformanceDataManager::walkCalltreeStackTraces
+ * @param threadGroup - the set of threads applicable to the calltree view
+ * @param data - the stack traces of each function of the calltree view
+ * @param aggregates - the caller/callee aggregates of all stack traces
+ *
+ * The original sequential walk of the stack traces of ShowCalltreeDetail, kept unchanged as the reference of benchmarkCalltreeChunks.
+ * The extents of each function are found and each stack trace is walked frame by frame to the caller of the function.
+ */
+template <typename DETAIL_t>
+void PerformanceDataManager::walkCalltreeStackTraces(const Framework::ThreadGroup& threadGroup,
+                                                     const std::map< Function, std::map< Framework::StackTrace, DETAIL_t > >& data,
+                                                     CalltreeAggregates& aggregates)
+{
+    for ( typename std::map< Function, std::map< Framework::StackTrace, DETAIL_t > >::const_iterator iter = data.begin(); iter != data.end(); iter++ ) {
         const Framework::Function& function( iter->first );
 
         const std::map< Framework::StackTrace, DETAIL_t >& tracemap( iter->second );
@@ -3692,17 +4660,215 @@ void PerformanceDataManager::ShowCalltreeDetail(
             std::pair< std::uint64_t, double > results = getDetailTotals( detail, num_calls );
 
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-            all_details_data_t detail_tuple = std::make_tuple( results.first, results.second, function, caller );
-            CallerCallee_t callerCalleeInfo = std::make_tuple( caller, function );
+            aggregates.details.push_back( std::make_tuple( results.first, results.second, function, caller ) );
+            aggregates.callerFunctions.insert( std::make_tuple( caller, function ) );
 #else
-            all_details_data_t detail_tuple = boost::make_tuple( results.first, results.second, function, caller );
-            CallerCallee_t callerCalleeInfo = boost::make_tuple( caller, function );
+            aggregates.details.push_back( boost::make_tuple( results.first, results.second, function, caller ) );
+            aggregates.callerFunctions.insert( boost::make_tuple( caller, function ) );
 #endif
-            all_details.push_back( detail_tuple );
-
-            caller_function_list.insert( callerCalleeInfo );
         }
     }
+}
+
+/**
+ * @brief PerformanceDataManager::benchmarkCalltreeChunks
+ * @param viewName - the name of the calltree view
+ * @param threadGroup - the set of threads applicable to the calltree view
+ * @param data - the stack traces of each function of the calltree view
+ * @param subextents_maps - the extents of each function in each thread (in the order of the functions in 'data')
+ *
+ * Scaling harness for the concurrent stack trace processing of ShowCalltreeDetail.  The reference aggregates are computed by the original
+ * sequential walk (walkCalltreeStackTraces).  The chunked processing is then timed sequentially (one chunk per function processed in the
+ * calling thread) and repeated in thread pools of 1, 2, 4, ... threads up to the ideal thread count; for each run the elapsed time and
+ * speedup over the original walk are logged, and the aggregates from which the calltree view is built (the caller/callee details and the
+ * caller sets) are compared with the reference.  Before Qt 5.4 the concurrent processing can't be run in a private thread pool, so only
+ * the sequential runs are timed.
+ */
+template <typename DETAIL_t>
+void PerformanceDataManager::benchmarkCalltreeChunks(const QString& viewName,
+                                                     const Framework::ThreadGroup& threadGroup,
+                                                     const std::map< Function, std::map< Framework::StackTrace, DETAIL_t > >& data,
+                                                     const std::vector< std::map< Framework::Thread, Framework::ExtentGroup > >& subextents_maps)
+{
+    typedef std::map< Framework::StackTrace, DETAIL_t > StackTraceMap;
+    typedef typename std::map< Function, StackTraceMap >::const_iterator FunctionIterator;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // the reference: the original walk of the stack traces
+    CalltreeAggregates reference;
+
+    walkCalltreeStackTraces< DETAIL_t >( threadGroup, data, reference );
+
+    const qint64 referenceTime = timer.elapsed();
+
+    qDebug() << "PerformanceDataManager::benchmarkCalltreeChunks:" << viewName << "original walk of" << reference.details.size() << "stack traces in" << referenceTime << "msec";
+
+    timer.restart();
+
+    // the stack traces of each function are walked in order by the calling thread
+    StackTraceTrie sequentialTrie;
+    CalltreeAggregates sequential;
+
+    buildStackTraceTrie( data, sequentialTrie );
+
+    std::size_t index( 0 );
+    for ( FunctionIterator iter = data.begin(); iter != data.end(); ++iter, ++index ) {
+        const CalltreeChunk chunk = processCalltreeStackTraces< DETAIL_t >( iter->first, iter->second.begin(), iter->second.end(), &subextents_maps[ index ], &sequentialTrie );
+
+        sequential.details.insert( sequential.details.end(), chunk.details.begin(), chunk.details.end() );
+        sequential.callerFunctions.insert( chunk.callerFunctions.begin(), chunk.callerFunctions.end() );
+    }
+
+    const qint64 sequentialTime = timer.elapsed();
+
+    const bool sequentialEquivalent = ( sequential.details == reference.details && sequential.callerFunctions == reference.callerFunctions );
+
+    qDebug() << "PerformanceDataManager::benchmarkCalltreeChunks:" << viewName << "sequential chunks time" << sequentialTime << "msec"
+             << "speedup" << ( sequentialTime > 0 ? double( referenceTime ) / sequentialTime : 0.0 )
+             << ( sequentialEquivalent ? "equivalent to the original walk" : "DIFFERS FROM THE ORIGINAL WALK" );
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 4, 0))
+    for ( int threadCount = 1; ; threadCount *= 2 ) {
+        threadCount = qMin( threadCount, QThread::idealThreadCount() );
+
+        QThreadPool pool;
+        pool.setMaxThreadCount( threadCount );
+
+        StackTraceTrie trie;
+        CalltreeAggregates concurrent;
+
+        timer.restart();
+
+        processCalltreeChunks< DETAIL_t >( &pool, CALLTREE_STACKTRACE_CHUNK_SIZE, data, subextents_maps, trie, concurrent );
+
+        const qint64 concurrentTime = timer.elapsed();
+
+        const bool equivalent = ( concurrent.details == reference.details && concurrent.callerFunctions == reference.callerFunctions );
+
+        qDebug() << "PerformanceDataManager::benchmarkCalltreeChunks:" << viewName << "threads" << threadCount << "time" << concurrentTime << "msec"
+                 << "speedup" << ( concurrentTime > 0 ? double( referenceTime ) / concurrentTime : 0.0 )
+                 << ( equivalent ? "equivalent to the original walk" : "DIFFERS FROM THE ORIGINAL WALK" );
+
+        if ( threadCount >= QThread::idealThreadCount() )
+            break;
+    }
+#endif
+}
+#endif
+
+/**
+ * @brief PerformanceDataManager::ShowCalltreeDetail
+ * @param collector - the experiment collector used for the calltree view
+ * @param threadGroup - the set of threads applicable to the calltree view
+ * @param interval - the time interval for the calltree view
+ * @param functions - the set of functions involved in the calltree view
+ * @param metric - the metric computed in the calltree view
+ * @param metricDesc - the metric table column headers for the calltree view
+ * @param clusteringCriteriaName - the clustering criteria name
+ *
+ * This method computes the data for the calltree view in accordance with the various contraints for the view -
+ * set of threads, set of functions, time interval and the metric name.
+ */
+template <typename DETAIL_t>
+void PerformanceDataManager::ShowCalltreeDetail(
+        const Framework::Collector& collector,
+        const Framework::ThreadGroup& threadGroup,
+        const Framework::TimeInterval& interval,
+        const std::set<Function> functions,
+        const QString metric,
+        const QStringList metricDesc,
+        const QString &clusteringCriteriaName)
+{
+    // get view name
+    const QString viewName = getViewName<DETAIL_t>();
+
+    {
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+        if ( publishing.isCanceled() )
+            return;
+
+        emit addMetricView( clusteringCriteriaName, viewName, QStringLiteral("None"), viewName, metricDesc );
+    }
+
+    SmartPtr< std::map< Function,
+                std::map< Framework::Thread,
+                    std::map< Framework::StackTrace, DETAIL_t > > > > raw_items;
+
+    Queries::GetMetricValues( collector, metric.toStdString(), interval, threadGroup, functions,  // input - metric search criteria
+                              raw_items );                                                        // output - raw metric values
+
+    if ( AnalysisScheduler::isCanceled() )
+        return;
+
+    SmartPtr< std::map<Function, std::map<Framework::StackTrace, DETAIL_t > > > data =
+            Queries::Reduction::Apply( raw_items, Queries::Reduction::Summation );
+
+    // reset raw metric values
+    raw_items = SmartPtr< std::map< Function, std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > > > >();
+
+    typedef std::map< Framework::StackTrace, DETAIL_t > StackTraceMap;
+    typedef typename std::map< Function, StackTraceMap >::const_iterator FunctionIterator;
+
+#ifdef HAS_CALLTREE_PROCESSING_TIMING
+    QElapsedTimer timer;
+    timer.start();
+#endif
+
+    // find the extents of each function in each thread
+    std::vector< std::map< Framework::Thread, Framework::ExtentGroup > > subextents_maps( data->size() );
+
+    QFutureSynchronizer<void> synchronizer;
+
+    std::size_t index( 0 );
+    for ( FunctionIterator iter = data->begin(); iter != data->end(); ++iter, ++index ) {
+        synchronizer.addFuture( QtConcurrent::run( AnalysisScheduler::inheritToken(
+                                                       boost::bind( &Get_Subextents_To_Object_Map< const Framework::Function >,
+                                                                    boost::cref( threadGroup ), boost::cref( iter->first ), boost::ref( subextents_maps[ index ] ) ) ) ) );
+    }
+
+    synchronizer.waitForFinished();
+
+    if ( AnalysisScheduler::isCanceled() )
+        return;
+
+    // interned stack frames shared by all functions
+    StackTraceTrie trie;
+
+    CalltreeAggregates aggregates;
+
+    processCalltreeChunks< DETAIL_t >( Q_NULLPTR, CALLTREE_STACKTRACE_CHUNK_SIZE, *data, subextents_maps, trie, aggregates );
+
+#ifdef HAS_CALLTREE_PROCESSING_TIMING
+    qDebug() << "PerformanceDataManager::ShowCalltreeDetail:" << viewName << "processed" << aggregates.details.size() << "stack traces in" << timer.elapsed()
+             << "msec with" << trie.size() << "interned frames using" << QThreadPool::globalInstance()->maxThreadCount() << "threads";
+
+    benchmarkCalltreeChunks< DETAIL_t >( viewName, threadGroup, *data, subextents_maps );
+#endif
+
+    // the calltree and flame graph are built from the interned stack frames and the aggregates only, so the stack traces are released
+    data = SmartPtr< std::map< Function, StackTraceMap > >();
+    std::vector< std::map< Framework::Thread, Framework::ExtentGroup > >().swap( subextents_maps );
+
+    TALLDETAILS& all_details( aggregates.details );
+    FunctionSet& caller_function_list( aggregates.callerFunctions );
+
+    // all chunks have finished, so nothing refers to the stack traces any more
+    if ( AnalysisScheduler::isCanceled() )
+        return;
+
+    {
+        const FlameGraphData flameGraph = FlameGraphData::create( trie, aggregates.leafValues );
+
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+        if ( publishing.isCanceled() )
+            return;
+
+        emit signalDisplayCalltreeFlameGraph( flameGraph );
+    }
 
     // Define map for Function to calltree depth from "_start" invocation to the Function
     std::map< Function, uint32_t > call_depth_map;
@@ -3722,6 +4888,9 @@ void PerformanceDataManager::ShowCalltreeDetail(
 
     detail_reduction( caller_function_list, call_depth_map, all_details, callPairToWeightMap, reduced_details );
 
+    if ( AnalysisScheduler::isCanceled() )
+        return;
+
     std::sort( reduced_details.begin(), reduced_details.end(), details_compare );
 
     CalltreeGraphManager::EdgeWeightMap edgeWeightMap;
@@ -3734,9 +4903,21 @@ void PerformanceDataManager::ShowCalltreeDetail(
     // Generate the DOT formatted data from the graph
     std::ostringstream oss;
     graphManager.write_graphviz( oss );
-    emit signalDisplayCalltreeGraph( QString::fromStdString( oss.str() ) );
+
+    {
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+        if ( publishing.isCanceled() )
+            return;
+
+        emit signalDisplayCalltreeGraph( QString::fromStdString( oss.str() ) );
+    }
+
+    BoundedSignalChannel::Batch batch( BoundedSignalChannel::instance() );
 
     for ( TDETAILS::const_reverse_iterator i = reduced_details.rbegin(); i != reduced_details.rend(); ++i ) {
+        if ( AnalysisScheduler::isCanceled() )
+            break;
         const details_data_t& d( *i );
         QVariantList metricData;
         std::ostringstream oss;
@@ -3751,6 +4932,12 @@ void PerformanceDataManager::ShowCalltreeDetail(
 #endif
         oss << func.getName() << " (" << func.getLinkedObject().getPath().getBaseName() << ")";
         metricData << QString::fromStdString( oss.str() );
+        const qint64 bytes = BoundedSignalChannel::sizeOf( metricData );
+        if ( ! batch.acquire( bytes ) )
+            break;
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+        if ( publishing.isCanceled() )
+            break;
         emit addMetricViewData( clusteringCriteriaName, viewName, QStringLiteral("None"), viewName, metricData );
     }
 }
@@ -3897,6 +5084,22 @@ QStringList PerformanceDataManager::getMetricsDesc<std::vector<IOTDetail>>() con
     return metrics;
 }
 
+/**
+ * @brief PerformanceDataManager::getTraceSummaryDesc
+ * @return - the names of columns for the function summary trace view.
+ *
+ * The function returns the names of columns for the function summary trace view which summarizes the durations of the trace events of each function.
+ */
+QStringList PerformanceDataManager::getTraceSummaryDesc() const
+{
+    QStringList metrics;
+
+    metrics << s_functionTitle << tr("Calls") << tr("Total Duration (ms)") << tr("Minimum Duration (ms)") << tr("Median Duration (ms)")
+            << tr("95th Percentile Duration (ms)") << tr("99th Percentile Duration (ms)") << tr("Maximum Duration (ms)");
+
+    return metrics;
+}
+
 /**
  * @brief PerformanceDataManager::getMetricsDesc<double>
  * @return - the metrics descriptions (names of columns for time-based load balance views of type double).
@@ -4003,6 +5206,77 @@ QStringList PerformanceDataManager::getMetricsDesc<std::uint64_t>(const QStringL
     return metricDesc;
 }
 
+/**
+ * @brief PerformanceDataManager::processTraceFunction
+ * @param function - the function whose trace events are processed
+ * @param threads - the stack traces of the function in each thread
+ * @param time_origin - the start time of the experiment
+ * @param columnCount - the number of columns of the trace metric view
+ * @return - the trace events of the function
+ *
+ * This method generates the rows of the trace metric view for each unique stack trace of the function and extracts the begin time, end time,
+ * rank and graphed value columns of the rows having all the columns of the trace metric view.  The durations of the events are accumulated in
+ * a quantile sketch per thread and the sketches are merged into the sketch of the function.  The stack traces of a thread are unique and
+ * carry the thread, so no stack trace is processed twice.  The functions of the trace view are processed concurrently by ShowTraceDetail.
+ */
+template <typename DETAIL_t>
+PerformanceDataManager::TraceEventBlock PerformanceDataManager::processTraceFunction(
+        const Function& function,
+        const std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > >* threads,
+        const Framework::Time::value_type time_origin,
+        int columnCount)
+{
+    TraceEventBlock block;
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+    block.functionName = QString::fromStdString( function.getDemangledName() );
+#else
+    block.functionName = QString( function.getDemangledName().c_str() );
+#endif
+
+    for ( typename std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > >::const_iterator titer = threads->begin(); titer != threads->end(); titer++ ) {
+        const typename std::map< Framework::StackTrace, DETAIL_t >& tracemap( titer->second );
+
+        // the distribution of the durations of the events of the function in this thread
+        QuantileSketch durations;
+
+        for ( typename std::map< Framework::StackTrace, DETAIL_t >::const_iterator siter = tracemap.begin(); siter != tracemap.end(); siter++ ) {
+            // the block of a canceled trace view is not published
+            if ( AnalysisScheduler::isCanceled() )
+                return block;
+
+            const Framework::StackTrace& stacktrace( siter->first );
+            const DETAIL_t& details( siter->second );
+
+            QString definingLocation;
+            std::set< Statement > statements = stacktrace.getStatementsAt( 1 );
+            if ( statements.size() > 0 ) {
+                Statement statement( *statements.begin() );
+                definingLocation = QStringLiteral(" (") + getLocationInfo(statement ) + QStringLiteral(" )");
+            }
+
+            const int first = block.metricData.size();
+
+            getTraceMetricValues( block.functionName + definingLocation, time_origin, details, block.metricData );
+
+            for ( int i=first; i<block.metricData.size(); ++i ) {
+                const QVariantList& list( block.metricData[i] );
+                if ( list.size() == columnCount ) {
+                    block.timeBegins.append( list[1].toDouble() );
+                    block.timeEnds.append( list[2].toDouble() );
+                    block.ranks.append( list[4].toInt() );
+                    block.values.append( list.size() > 7 ? list[7].toDouble() : 0.0 );
+                    durations.add( list[3].toDouble() );
+                }
+            }
+        }
+
+        block.durations.merge( durations );
+    }
+
+    return block;
+}
+
 /*
  * @brief PerformanceDataManager::ShowTraceDetail
  * @param clusteringCriteriaName - the clustering criteria name
@@ -4035,8 +5309,15 @@ void PerformanceDataManager::ShowTraceDetail(
 
     const QStringList metricDesc = getMetricsDesc<DETAIL_t>();
 
-    // for details view emit signal to create just the model
-    emit addMetricView( clusteringCriteriaName, traceViewName, metric, ALL_EVENTS_DETAILS_VIEW, metricDesc );
+    {
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+        if ( publishing.isCanceled() )
+            return;
+
+        // for details view emit signal to create just the model
+        emit addMetricView( clusteringCriteriaName, traceViewName, metric, ALL_EVENTS_DETAILS_VIEW, metricDesc );
+    }
 
     // get collector type
     const QString collectorId( collector.getMetadata().getUniqueId().c_str() );
@@ -4053,115 +5334,238 @@ void PerformanceDataManager::ShowTraceDetail(
 
     const QString metricViewName = PerformanceDataMetricView::getMetricViewName( traceViewName, metric, ALL_EVENTS_DETAILS_VIEW );
 
-    // build the proxy views and tree views for the various trace views: "All Events"
-    // NOTE: functions[0] .. functions[N-10] will be added below
-    emit addAssociatedMetricView( clusteringCriteriaName, traceViewName, metric, ALL_EVENTS_DETAILS_VIEW, metricViewName, metricDesc );
+    // build the model and view for the "Function Summary" trace view
+    const QStringList summaryDesc = getTraceSummaryDesc();
+    const QString summaryMetricViewName = PerformanceDataMetricView::getMetricViewName( traceViewName, metric, FUNCTION_SUMMARY_VIEW );
 
-    QVector< double > metricData;
-    metricData.fill( 0.0, threadGroup.size() );
-    int maxRank = -1;
+    {
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
 
-    if ( metricData.size() < 1 )
-        return;
+        if ( publishing.isCanceled() )
+            return;
 
-    for ( typename std::map< Function, std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > > >::iterator iter = raw_items->begin(); iter != raw_items->end(); iter++ ) {
-        const Framework::Function& function( iter->first );
+        // build the proxy views and tree views for the various trace views: "All Events"
+        // NOTE: functions[0] .. functions[N-10] will be added below
+        emit addAssociatedMetricView( clusteringCriteriaName, traceViewName, metric, ALL_EVENTS_DETAILS_VIEW, metricViewName, metricDesc );
 
-#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-        const QString functionName = QString::fromStdString( function.getDemangledName() );
-#else
-        const QString functionName = QString( function.getDemangledName().c_str() );
-#endif
+        if ( threadGroup.size() < 1 )
+            return;
 
-        emit addAssociatedMetricView( clusteringCriteriaName, traceViewName, metric, functionName, metricViewName, metricDesc );
+        emit addMetricView( clusteringCriteriaName, traceViewName, metric, FUNCTION_SUMMARY_VIEW, summaryDesc );
+        emit addAssociatedMetricView( clusteringCriteriaName, traceViewName, metric, FUNCTION_SUMMARY_VIEW, summaryMetricViewName, summaryDesc );
+    }
 
-        typename std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > >& thread( iter->second );
+    typedef std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > > ThreadMap;
+    typedef typename std::map< Function, ThreadMap >::const_iterator FunctionIterator;
 
-        std::map< Framework::Thread, Framework::ExtentGroup > subextents_map;
-        Get_Subextents_To_Object_Map( threadGroup, function, subextents_map );
+    std::vector< FunctionIterator > functionIters;
+    functionIters.reserve( raw_items->size() );
 
-        std::set< Framework::StackTrace, ltST > StackTraces_Processed;
+    for ( FunctionIterator iter = raw_items->begin(); iter != raw_items->end(); iter++ ) {
+        functionIters.push_back( iter );
+    }
 
-        for ( typename std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > >::iterator titer = thread.begin(); titer != thread.end(); titer++ ) {
-            const typename std::map< Framework::StackTrace, DETAIL_t >& tracemap( titer->second );
+    // the trace events of the functions are processed concurrently within a window of blocks ahead of the block published next,
+    // so only the blocks of the window are held in memory
+    const std::size_t windowSize = qMax( 1, QThread::idealThreadCount() );
 
-            for ( typename std::map< Framework::StackTrace, DETAIL_t >::const_iterator siter = tracemap.begin(); siter != tracemap.end(); siter++ ) {
-                const Framework::StackTrace& stacktrace( siter->first );
-                const DETAIL_t& details( siter->second );
+    std::vector< QFuture< TraceEventBlock > > blocks( functionIters.size() );
 
-                std::pair< std::set< Framework::StackTrace >::iterator, bool > ret = StackTraces_Processed.insert( stacktrace );
-                if ( ! ret.second )
-                    continue;
+    std::size_t started( 0 );
 
-                QString definingLocation;
-                std::set< Statement > statements = stacktrace.getStatementsAt( 1 );
-                if ( statements.size() > 0 ) {
-                    Statement statement( *statements.begin() );
-                    definingLocation = QStringLiteral(" (") + getLocationInfo(statement ) + QStringLiteral(" )");
-                }
+    const bool graphMetric( emitGraphItem && s_TRACING_EXPERIMENTS_GRAPH_TITLES.contains( collectorId ) && s_TRACING_EXPERIMENTS_GRAPH_TITLES[ collectorId ].contains( metric ) );
 
-                QVector< QVariantList > traceList;
-                getTraceMetricValues( functionName + definingLocation, time_origin, details, traceList );
-
-                foreach( const QVariantList& list, traceList ) {
-                    if ( list.size() == metricDesc.size() ) {
-                        if ( emitGraphItem ) {
-                            if ( s_TRACING_EXPERIMENTS_GRAPH_TITLES.contains( collectorId ) && s_TRACING_EXPERIMENTS_GRAPH_TITLES[ collectorId ].contains( metric ) ) {
-                                    const QString graphTitle = s_TRACING_EXPERIMENTS_GRAPH_TITLES[ collectorId ][ metric ];
-                                    int rankOrThread = ( metricData.size() == 1 ) ? 0 : list[4].toInt();
-
-                                    emit addGraphItem( clusteringCriteriaName, graphTitle, metric, list[1].toDouble(), list[7].toDouble(), rankOrThread );
-
-                                    if ( list[7].toDouble() > metricData[ rankOrThread ] ) {
-                                        metricData[ rankOrThread ] = list[7].toDouble();
-                                    }
-                                    if ( rankOrThread > maxRank ) {
-                                        maxRank = rankOrThread;
-                                    }
-                            }
-                        }
-                        else {
-                            emit addTraceItem( clusteringCriteriaName, clusteringCriteriaName, functionName, list[1].toDouble(), list[2].toDouble(), list[4].toInt() );
-                        }
-                    }
-                }
+    // the per-rank graph values reduced to an envelope across all ranks once all trace events are processed
+    RankEnvelopeData envelope;
 
-                foreach( const QVariantList& metricData, traceList ) {
-                    emit addMetricViewData( clusteringCriteriaName, traceViewName, metric, ALL_EVENTS_DETAILS_VIEW, metricData );
-                }
-            }
+    // the duration statistics of each function published once all trace events are processed
+    QVector< QVariantList > summaryData;
+
+    BoundedSignalChannel* channel = BoundedSignalChannel::instance();
+
+    // set once the channel is aborted; nothing further is published
+    bool aborted( false );
+
+    // publish the blocks in function order regardless of the order in which the blocks were completed
+    for ( std::size_t i=0; i<blocks.size(); ++i ) {
+        // no further blocks are started once publishing has stopped
+        while ( started < blocks.size() && started < i + windowSize && ! aborted && ! AnalysisScheduler::isCanceled() ) {
+            const FunctionIterator iter = functionIters[ started ];
+
+            blocks[ started++ ] = QtConcurrent::run( AnalysisScheduler::inheritToken(
+                                                         boost::bind( &PerformanceDataManager::processTraceFunction< DETAIL_t >, this,
+                                                                      boost::cref( iter->first ), &iter->second, time_origin, metricDesc.size() ) ) );
         }
 
-        emit requestMetricViewComplete( clusteringCriteriaName, traceViewName, metric, functionName, lower, upper );
-    }
+        if ( i >= started )
+            break;
 
-    if ( emitGraphItem && maxRank >= metricData.size() ) {
-        if ( s_TRACING_EXPERIMENTS_GRAPH_TITLES.contains( collectorId ) && s_TRACING_EXPERIMENTS_GRAPH_TITLES[ collectorId ].contains( metric ) ) {
-            auto minmax = std::minmax_element( metricData.begin(), metricData.begin() + maxRank );
+        const TraceEventBlock block = blocks[i].result();
 
-            const double average = std::accumulate( metricData.begin(), metricData.begin() + maxRank, 0.0 ) / ( maxRank + 1 );
+        blocks[i] = QFuture< TraceEventBlock >();
 
-            QVector< double >::iterator closestIter = metricData.begin();
+        // the blocks already started are still waited for as they refer to the raw metric values
+        if ( aborted || AnalysisScheduler::isCanceled() )
+            continue;
 
-            if ( metricData.size() > 1 ) {
-                for ( QVector< double >::iterator iter = metricData.begin()+1; iter != metricData.begin() + maxRank; iter++ ) {
-                    if ( std::abs( *iter - average ) < std::abs( *closestIter - average ) ) {
-                        closestIter = iter;
-                    }
-                }
+        // the trace items and the rows of the block are published as one batch
+        qint64 bytes = ( emitGraphItem ) ? 0 : block.ranks.size() * ( 2 * sizeof( double ) + sizeof( int ) + BoundedSignalChannel::sizeOf( block.functionName ) );
+        foreach ( const QVariantList& row, block.metricData ) {
+            bytes += BoundedSignalChannel::sizeOf( row );
+        }
+        if ( ! channel->acquire( bytes ) ) {
+            aborted = true;
+            continue;
+        }
+
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+        if ( publishing.isCanceled() ) {
+            channel->commit( bytes );
+            continue;
+        }
+
+        emit addAssociatedMetricView( clusteringCriteriaName, traceViewName, metric, block.functionName, metricViewName, metricDesc );
+
+        for ( int j=0; j<block.ranks.size(); ++j ) {
+            if ( graphMetric ) {
+                const int rankOrThread = ( threadGroup.size() == 1 ) ? 0 : block.ranks[j];
+
+                envelope.addValue( rankOrThread, block.timeBegins[j], block.values[j] );
             }
+            else if ( ! emitGraphItem ) {
+                emit addTraceItem( clusteringCriteriaName, clusteringCriteriaName, block.functionName, block.timeBegins[j], block.timeEnds[j], block.ranks[j] );
+            }
+        }
+
+        emit addTraceViewData( clusteringCriteriaName, traceViewName, metric, ALL_EVENTS_DETAILS_VIEW, block.functionName, block.metricData );
+
+        channel->commit( bytes );
 
-            const int rankWithMinValue = std::distance( metricData.begin(), minmax.first );
-            const int rankWithMaxValue = std::distance( metricData.begin(), minmax.second );
-            const int rankClosestToAvgValue = std::distance( metricData.begin(), closestIter );
+        if ( ! block.durations.isEmpty() ) {
+            const QuantileSketch& durations( block.durations );
 
-            emit signalGraphMinAvgMaxRanks( metric, rankWithMinValue, rankClosestToAvgValue, rankWithMaxValue );
+            summaryData.push_back( QVariantList() << block.functionName << QVariant::fromValue<qulonglong>( static_cast< qulonglong >( durations.count() ) ) << durations.sum()
+                                                  << durations.min() << durations.quantile( 0.5 ) << durations.quantile( 0.95 ) << durations.quantile( 0.99 )
+                                                  << durations.max() );
         }
+
+        emit requestMetricViewComplete( clusteringCriteriaName, traceViewName, metric, block.functionName, lower, upper );
     }
 
+    if ( aborted || AnalysisScheduler::isCanceled() )
+        return;
+
+    if ( emitGraphItem && ! envelope.isEmpty() )
+        envelope.reduce( ENVELOPE_BUCKET_COUNT );
+
+    const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+    if ( publishing.isCanceled() )
+        return;
+
+    if ( emitGraphItem && ! envelope.isEmpty() ) {
+        const QString graphTitle = s_TRACING_EXPERIMENTS_GRAPH_TITLES[ collectorId ][ metric ];
+
+        emit signalDisplayGraphEnvelope( clusteringCriteriaName, graphTitle, metric, envelope );
+    }
+
+    foreach( const QVariantList& metricData, summaryData ) {
+        emit addMetricViewData( clusteringCriteriaName, traceViewName, metric, FUNCTION_SUMMARY_VIEW, metricData );
+    }
+
+    emit requestMetricViewComplete( clusteringCriteriaName, traceViewName, metric, FUNCTION_SUMMARY_VIEW, lower, upper );
+
     emit requestMetricViewComplete( clusteringCriteriaName, traceViewName, metric, ALL_EVENTS_DETAILS_VIEW, lower, upper );
 }
 
+#ifdef HAS_SAMPLE_COUNTERS_PROCESSING_TIMING
+/**
+ * @brief PerformanceDataManager::benchmarkSampleCounterRows
+ *
+ * Scaling harness for the row processing of ShowSampleCountersDetail and ShowSampleCountersDerivedMetricDetail.  Synthetic rows of
+ * sample counter values, keyed like the rows of the metric values in a std::map, are processed from 1k to 1M rows: the rows are indexed
+ * while iterating and the counter values are summed into preallocated typed columns.  For comparison, the original processing finding
+ * the index of each row with std::distance and building a QVariantList of counter values per row is timed up to 10k rows, beyond which
+ * its quadratic cost is prohibitive, and its columns are compared with the single pass.  The elapsed time per row is logged for each size.
+ */
+void PerformanceDataManager::benchmarkSampleCounterRows()
+{
+    const int COUNTER_COUNT( 4 );
+    const int QUADRATIC_ROW_LIMIT( 10000 );
+
+    struct SampleRow {
+        qulonglong counters[ COUNTER_COUNT ];
+    };
+
+    typedef std::map< int, SampleRow >::const_iterator RowIterator;
+
+    for ( int rowCount=1000; rowCount<=1000000; rowCount*=10 ) {
+        std::map< int, SampleRow > rows;
+
+        for ( int i=0; i<rowCount; ++i ) {
+            SampleRow& sampleRow( rows[ i ] );
+            for ( int index=0; index<COUNTER_COUNT; index++ )
+                sampleRow.counters[ index ] = static_cast< qulonglong >( i ) * ( index + 1 );
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+
+        // the single pass: the row index is carried alongside the iteration
+        std::vector< QVector< qulonglong > > counterColumns( COUNTER_COUNT, QVector< qulonglong >( rowCount, 0 ) );
+
+        int row( 0 );
+
+        for ( RowIterator iter = rows.begin(); iter != rows.end(); iter++, row++ ) {
+            for ( int index=0; index<COUNTER_COUNT; index++ ) {
+                counterColumns[index][row] += iter->second.counters[ index ];
+            }
+        }
+
+        const qint64 singlePassTime = timer.nsecsElapsed();
+
+        qDebug() << "PerformanceDataManager::benchmarkSampleCounterRows:" << rowCount << "rows in a single pass in" << singlePassTime / 1000000.0
+                 << "msec," << singlePassTime / rowCount << "nsec per row";
+
+        if ( rowCount > QUADRATIC_ROW_LIMIT )
+            continue;
+
+        timer.restart();
+
+        // the original processing: the row index is found from the beginning of the map for each row
+        QVector< QVariantList > counterValues( rowCount );
+
+        for ( RowIterator iter = rows.begin(); iter != rows.end(); iter++ ) {
+            const int originalRow = std::distance( rows.begin(), iter );
+
+            QVariantList values;
+
+            for ( int index=0; index<COUNTER_COUNT; index++ ) {
+                values << iter->second.counters[ index ];
+            }
+
+            counterValues[ originalRow ] = values;
+        }
+
+        const qint64 originalTime = timer.nsecsElapsed();
+
+        bool equivalent( true );
+
+        for ( int i=0; i<rowCount && equivalent; ++i ) {
+            for ( int index=0; index<COUNTER_COUNT; index++ ) {
+                if ( counterValues[ i ][ index ].toULongLong() != counterColumns[index][i] )
+                    equivalent = false;
+            }
+        }
+
+        qDebug() << "PerformanceDataManager::benchmarkSampleCounterRows:" << rowCount << "rows by the original processing in" << originalTime / 1000000.0
+                 << "msec," << originalTime / rowCount << "nsec per row, speedup" << static_cast< double >( originalTime ) / qMax( singlePassTime, Q_INT64_C(1) )
+                 << ( equivalent ? "equivalent to the single pass" : "DIFFERS FROM THE SINGLE PASS" );
+    }
+}
+#endif
+
 /*
  * @brief PerformanceDataManager::ShowSampleCountersDetail
  * @param clusteringCriteriaName - the clustering criteria name
@@ -4206,8 +5610,15 @@ void PerformanceDataManager::ShowSampleCountersDetail(const QString& clusteringC
 
     const QStringList metricDesc = getMetricsDesc<DETAIL_t>( sampleCounterNames );
 
-    // for details view emit signal to create just the model
-    emit addMetricView( clusteringCriteriaName, METRIC_VIEW_MODE, metricName, viewName, metricDesc );
+    {
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+        if ( publishing.isCanceled() )
+            return;
+
+        // for details view emit signal to create just the model
+        emit addMetricView( clusteringCriteriaName, METRIC_VIEW_MODE, metricName, viewName, metricDesc );
+    }
 
     SmartPtr< std::map< TS,
                 std::map< Framework::Thread,
@@ -4216,70 +5627,118 @@ void PerformanceDataManager::ShowSampleCountersDetail(const QString& clusteringC
     Queries::GetMetricValues( collector, metricName.toStdString(), interval, threadGroup, getThreadSet<TS>( threadGroup ),  // input - metric search criteria
                               raw_items );
 
-    if ( emitGraphItem ) {
-        QStringList items;
+    if ( AnalysisScheduler::isCanceled() )
+        return;
 
-        for ( typename std::map< TS, std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > > >::iterator iter = raw_items->begin(); iter != raw_items->end(); iter++ ) {
-            items << getLocationInfo( iter->first );
-        }
+#ifdef HAS_SAMPLE_COUNTERS_PROCESSING_TIMING
+    benchmarkSampleCounterRows();
+#endif
+
+    typedef typename std::map< TS, std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > > >::const_iterator RowIterator;
+
+    const int rowCount = raw_items->size();
 
+    QStringList locations;
+    QVector< QString > filenames( rowCount );
+    QVector< int > lineNumbers( rowCount );
+    locations.reserve( rowCount );
+
+    int row( 0 );
+
+    for ( RowIterator iter = raw_items->begin(); iter != raw_items->end(); iter++, row++ ) {
+        locations << getLocationInfo( iter->first, filenames[row], lineNumbers[row] );
+    }
+
+    if ( emitGraphItem ) {
         QString graphTitle;
 
         if ( s_TRACING_EXPERIMENTS_GRAPH_TITLES.contains( collectorId ) && s_TRACING_EXPERIMENTS_GRAPH_TITLES[ collectorId ].contains( metricName ) ) {
             graphTitle = s_TRACING_EXPERIMENTS_GRAPH_TITLES[ collectorId ][ metricName ];
         }
 
-        emit createGraphItems( clusteringCriteriaName, graphTitle, metricName, viewName, sampleCounterNames, items );
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+        if ( publishing.isCanceled() )
+            return;
+
+        emit createGraphItems( clusteringCriteriaName, graphTitle, metricName, viewName, sampleCounterNames, locations );
     }
 
-    for ( typename std::map< TS, std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > > >::iterator iter = raw_items->begin(); iter != raw_items->end(); iter++ ) {
+    // the columns of sample counter totals and time totals indexed by row
+    std::vector< QVector< qulonglong > > counterColumns( sampleCounterNames.size(), QVector< qulonglong >( rowCount, 0 ) );
+    QVector< double > timeColumn( rowCount, 0.0 );
 
-        const QString locationName = getLocationInfo( iter->first );
+    const bool hasTimeColumn = metricDesc.contains( s_timeSecTitle );
 
-        typename std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > >& thread( iter->second );
+    BoundedSignalChannel::Batch batch( BoundedSignalChannel::instance() );
 
-        std::map< Framework::Thread, Framework::ExtentGroup > subextents_map;
-        Get_Subextents_To_Object_Map( threadGroup, iter->first, subextents_map );
+    SourceLineMetrics sourceLineMetrics;
+
+    row = 0;
+
+    for ( RowIterator iter = raw_items->begin(); iter != raw_items->end(); iter++, row++ ) {
+        if ( AnalysisScheduler::isCanceled() )
+            return;
 
-        QVector< qulonglong > totalSampleCount( sampleCounterNames.size(), 0 );
-        double totalTime( 0.0 );
+        const typename std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > >& thread( iter->second );
 
-        for ( typename std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > >::iterator titer = thread.begin(); titer != thread.end(); titer++ ) {
+        for ( typename std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > >::const_iterator titer = thread.begin(); titer != thread.end(); titer++ ) {
             const typename std::map< Framework::StackTrace, DETAIL_t >& tracemap( titer->second );
 
             for ( typename std::map< Framework::StackTrace, DETAIL_t >::const_iterator siter = tracemap.begin(); siter != tracemap.end(); siter++ ) {
                 const DETAIL_t& details( siter->second );
 
                 for ( int index=0; index<sampleCounterNames.size(); index++ ) {
-                    totalSampleCount[index] += getSampleCounterValue( details, index );
+                    counterColumns[index][row] += getSampleCounterValue( details, index );
                 }
 
-                totalTime += getSampleCounterTimeValue( details );
+                timeColumn[row] += getSampleCounterTimeValue( details );
             }
         }
 
         // generate each column of metric values
         QVariantList metricValues;
 
-        if ( metricDesc.contains( s_timeSecTitle ) ) {
-            metricValues << totalTime;
+        if ( hasTimeColumn ) {
+            metricValues << timeColumn[row];
         }
 
         for ( int index=0; index<sampleCounterNames.size(); index++ ) {
-            metricValues << totalSampleCount[index];
+            metricValues << counterColumns[index][row];
         }
 
-        metricValues << locationName;
+        metricValues << locations[row];
+
+        // the row is published to the metric view and the graph view
+        const qint64 bytes = BoundedSignalChannel::sizeOf( metricValues );
+        if ( ! batch.acquire( bytes ) )
+            break;
+
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+        if ( publishing.isCanceled() )
+            break;
 
         emit addMetricViewData( clusteringCriteriaName, METRIC_VIEW_MODE, metricName, viewName, metricValues );
 
+        sourceLineMetrics.append( filenames[row], lineNumbers[row], metricValues );
+
         if ( emitGraphItem ) {
             for ( int index=0; index<sampleCounterNames.size(); index++ ) {
-                emit addGraphItem( metricName, viewName, sampleCounterNames[index], std::distance( raw_items->begin(), iter ), totalSampleCount[index] );
+                emit addGraphItem( metricName, viewName, sampleCounterNames[index], row, counterColumns[index][row] );
             }
         }
     }
 
+    batch.commit();
+
+    emitSourceLineMetricData( clusteringCriteriaName, METRIC_VIEW_MODE, metricName, viewName, sourceLineMetrics );
+
+    const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+    if ( publishing.isCanceled() )
+        return;
+
     emit requestMetricViewComplete( clusteringCriteriaName, METRIC_VIEW_MODE, metricName, viewName, lower, upper );
 }
 
@@ -4336,8 +5795,15 @@ void PerformanceDataManager::ShowSampleCountersDerivedMetricDetail(const QString
     metricDesc.prepend( s_timeSecTitle );
     metricDesc.append( s_functionTitle );
 
-    // for details view emit signal to create just the model
-    emit addMetricView( clusteringCriteriaName, METRIC_VIEW_MODE, metricName, viewName, metricDesc );
+    {
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+        if ( publishing.isCanceled() )
+            return;
+
+        // for details view emit signal to create just the model
+        emit addMetricView( clusteringCriteriaName, METRIC_VIEW_MODE, metricName, viewName, metricDesc );
+    }
 
     SmartPtr< std::map< TS,
                 std::map< Framework::Thread,
@@ -4346,62 +5812,112 @@ void PerformanceDataManager::ShowSampleCountersDerivedMetricDetail(const QString
     Queries::GetMetricValues( collector, metricName.toStdString(), interval, threadGroup, getThreadSet<TS>( threadGroup ),  // input - metric search criteria
                               raw_items );
 
-    if ( emitGraphItem ) {
-        QStringList items;
+    if ( AnalysisScheduler::isCanceled() )
+        return;
 
-        for ( typename std::map< TS, std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > > >::iterator iter = raw_items->begin(); iter != raw_items->end(); iter++ ) {
-            items << getLocationInfo( iter->first );
-        }
+    typedef typename std::map< TS, std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > > >::const_iterator RowIterator;
+
+    const int rowCount = raw_items->size();
+
+    QStringList locations;
+    QVector< QString > filenames( rowCount );
+    QVector< int > lineNumbers( rowCount );
+    locations.reserve( rowCount );
 
-        emit createGraphItems( clusteringCriteriaName, METRIC_VIEW_MODE, metricName, viewName, derivedMetricList, items );
+    int row( 0 );
+
+    for ( RowIterator iter = raw_items->begin(); iter != raw_items->end(); iter++, row++ ) {
+        locations << getLocationInfo( iter->first, filenames[row], lineNumbers[row] );
     }
 
-    for ( typename std::map< TS, std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > > >::iterator iter = raw_items->begin(); iter != raw_items->end(); iter++ ) {
+    if ( emitGraphItem ) {
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+        if ( publishing.isCanceled() )
+            return;
 
-        const QString locationName = getLocationInfo( iter->first );
+        emit createGraphItems( clusteringCriteriaName, METRIC_VIEW_MODE, metricName, viewName, derivedMetricList, locations );
+    }
 
-        typename std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > >& thread( iter->second );
+    // the columns of sample counter totals and time totals indexed by row
+    std::vector< QVector< qulonglong > > counterColumns( sampleCounterNames.size(), QVector< qulonglong >( rowCount, 0 ) );
+    QVector< double > timeColumn( rowCount, 0.0 );
 
-        std::map< Framework::Thread, Framework::ExtentGroup > subextents_map;
-        Get_Subextents_To_Object_Map( threadGroup, iter->first, subextents_map );
+    row = 0;
 
-        QMap< QString, qulonglong > totalSampleCount;
-        double totalTime( 0.0 );
+    for ( RowIterator iter = raw_items->begin(); iter != raw_items->end(); iter++, row++ ) {
+        const typename std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > >& thread( iter->second );
 
-        for ( typename std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > >::iterator titer = thread.begin(); titer != thread.end(); titer++ ) {
+        for ( typename std::map< Framework::Thread, std::map< Framework::StackTrace, DETAIL_t > >::const_iterator titer = thread.begin(); titer != thread.end(); titer++ ) {
             const typename std::map< Framework::StackTrace, DETAIL_t >& tracemap( titer->second );
 
             for ( typename std::map< Framework::StackTrace, DETAIL_t >::const_iterator siter = tracemap.begin(); siter != tracemap.end(); siter++ ) {
                 const DETAIL_t& details( siter->second );
 
                 for ( int index=0; index<sampleCounterNames.size(); index++ ) {
-                    totalSampleCount[ sampleCounterNames[index] ] += getSampleCounterValue( details, index );
+                    counterColumns[index][row] += getSampleCounterValue( details, index );
                 }
 
-                totalTime += getSampleCounterTimeValue( details );
+                timeColumn[row] += getSampleCounterTimeValue( details );
             }
         }
+    }
+
+    // solve each derived metric formula once for all rows
+    std::vector< QVector< double > > derivedColumns( derivedMetricList.size() );
+
+    for ( int index=0; index<derivedMetricList.size(); index++ ) {
+        derivedColumns[index] = solver->solve( derivedMetricList[index], sampleCounterNames, counterColumns );
+    }
 
+    BoundedSignalChannel::Batch batch( BoundedSignalChannel::instance() );
+
+    SourceLineMetrics sourceLineMetrics;
+
+    row = 0;
+
+    for ( RowIterator iter = raw_items->begin(); iter != raw_items->end(); iter++, row++ ) {
         // generate each column of metric values
         QVariantList metricValues;
 
-        metricValues << totalTime;
+        metricValues << timeColumn[row];
 
-        foreach ( const QString& key, derivedMetricList ) {
-            metricValues << solver->solve( key, totalSampleCount );
+        for ( int index=0; index<derivedMetricList.size(); index++ ) {
+            metricValues << derivedColumns[index][row];
         }
 
-        metricValues << locationName;
+        metricValues << locations[row];
+
+        // the row is published to the metric view and the graph view
+        const qint64 bytes = BoundedSignalChannel::sizeOf( metricValues );
+        if ( ! batch.acquire( bytes ) )
+            break;
+
+        const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+        if ( publishing.isCanceled() )
+            break;
 
         emit addMetricViewData( clusteringCriteriaName, METRIC_VIEW_MODE, metricName, viewName, metricValues );
 
+        sourceLineMetrics.append( filenames[row], lineNumbers[row], metricValues );
+
         if ( emitGraphItem ) {
             for ( int index=0; index<derivedMetricList.size(); index++ ) {
-                emit addGraphItem( metricName, viewName, derivedMetricList[index], std::distance( raw_items->begin(), iter ), metricValues[ index+1 ].toDouble() );
+                emit addGraphItem( metricName, viewName, derivedMetricList[index], row, derivedColumns[index][row] );
             }
         }
     }
 
+    batch.commit();
+
+    emitSourceLineMetricData( clusteringCriteriaName, METRIC_VIEW_MODE, metricName, viewName, sourceLineMetrics );
+
+    const AnalysisScheduler::PublishLocker publishing( m_scheduler );
+
+    if ( publishing.isCanceled() )
+        return;
+
     emit requestMetricViewComplete( clusteringCriteriaName, METRIC_VIEW_MODE, metricName, viewName, lower, upper );
 }
 
@@ -33,7 +33,10 @@
 #include <QVariant>
 #include <QAtomicPointer>
 #include <QFutureSynchronizer>
+#include <QFutureWatcher>
+#include <QSharedPointer>
 #include <QMutex>
+#include <QHash>
 
 #include <vector>
 #include <set>
@@ -67,11 +70,18 @@
 #include "widgets/ShowDeviceDetailsDialog.h"
 #include "managers/CalltreeGraphManager.h"
 #include "managers/MetricTableViewInfo.h"
+#include "managers/StackTraceTrie.h"
+#include "managers/FlameGraphData.h"
+#include "managers/RankEnvelopeData.h"
+#include "managers/QuantileSketch.h"
+#include "managers/AnalysisScheduler.h"
+#include "managers/BoundedSignalChannel.h"
 
 
 class QTimer;
 class QCPAxisRect;
 class QTextStream;
+class QThreadPool;
 
 
 namespace ArgoNavis {
@@ -110,8 +120,15 @@ public:
     void unloadViews(const QString& clusteringCriteriaName);
     void unloadCudaViews(const QString& clusteringCriteriaName, const QStringList& clusterNames);
 
+    void setVisibleMetricView(const QString& clusteringCriteriaName, const QString& metricViewName);
+    bool isMetricViewStale(const QString& clusteringCriteriaName, const QString& metricViewName);
+
 #if defined(HAS_OSSCUDA2XML)
     void xmlDump(const QString& filePath);
+    void ndjsonDump(const QString& filePath);
+#endif
+#if defined(HAS_OSSSNAPSHOT)
+    void snapshotDump(const QString& filePath);
 #endif
 
 public slots:
@@ -151,11 +168,12 @@ signals:
                             const Base::Time& time_origin,
                             const CUDA::KernelExecution& details);
 
-    void addPeriodicSample(const QString& clusteringCriteriaName,
-                           const QString& clusterName,
-                           const double& time_begin,
-                           const double& time_end,
-                           const double& count);
+    void addPeriodicSamples(const QString& clusteringCriteriaName,
+                            const QString& clusterName,
+                            int counterIndex,
+                            const QVector< double >& timeBegins,
+                            const QVector< double >& timeEnds,
+                            const QVector< double >& counts);
 
     void addTraceItem(const QString &clusteringCriteriaName,
                       const QString &clusterName,
@@ -164,13 +182,6 @@ signals:
                       double endTime,
                       int rankOrThread);
 
-    void addGraphItem(const QString &clusteringCriteriaName,
-                      const QString &metricNameTitle,
-                      const QString &metricName,
-                      double eventTime,
-                      double eventData,
-                      int rankOrThread);
-
     void addGraphItem(const QString &metricName,
                       const QString &viewName,
                       const QString &eventName,
@@ -184,17 +195,20 @@ signals:
                           const QStringList& eventNames,
                           const QStringList& items);
 
-    void signalGraphMinAvgMaxRanks(const QString &metricName,
-                                   int rankWithMinValue,
-                                   int rankClosestToAvgValue,
-                                   int rankWithMaxValue);
+    void signalDisplayGraphEnvelope(const QString &clusteringCriteriaName,
+                                    const QString &metricNameTitle,
+                                    const QString &metricName,
+                                    const RankEnvelopeData &envelope);
 
     void addCudaEventSnapshot(const QString& clusteringCriteriaName, const QString& clusteringName, double lower, double upper, const QImage& image);
 
     void addMetricView(const QString& clusteringCriteriaName, const QString& modeName, const QString& metricName, const QString& viewName, const QStringList& metrics);
     void addAssociatedMetricView(const QString& clusteringCriteriaName, const QString& modeName, const QString& metricName, const QString& viewName, const QString& attachedMetricViewName, const QStringList& metrics);
+    void addDeferredMetrics(const QString& clusteringCriteriaName, const QStringList& metricNames);
 
     void addMetricViewData(const QString& clusteringCriteriaName, const QString& modeName, const QString& metricName, const QString& viewName, const QVariantList& data, const QStringList& columnHeaders = QStringList());
+    void addTraceViewData(const QString& clusteringCriteriaName, const QString& modeName, const QString& metricName, const QString& viewName, const QString& functionName, const QVector< QVariantList >& data);
+    void addSourceLineMetricData(const QString& clusteringCriteriaName, const QString& modeName, const QString& metricName, const QString& viewName, const QVector<QString>& filenames, const QVector<int>& lineNumbers, const QVector<QVariantList>& data);
 
     void addCluster(const QString& clusteringCriteriaName, const QString& clusterName, double xAxisLower, double xAxisUpper, bool yAxisVisible, double yAxisLower, double yAxisUpper);
     void removeCluster(const QString& clusteringCriteriaName, const QString& clusterName);
@@ -208,6 +222,7 @@ signals:
     void requestMetricViewComplete(const QString& clusteringCriteriaName, const QString& modeName, const QString& metricName, const QString& viewName, double lower, double upper);
 
     void signalDisplayCalltreeGraph(const QString& graph);
+    void signalDisplayCalltreeFlameGraph(const FlameGraphData& flameGraph);
 
     void signalSelectedClustersChanged(const QString& criteriaName, const QSet< QString >& selected);
 
@@ -223,6 +238,12 @@ private slots:
 
     void handleLoadComplete();
 
+    void handlePrefetchDeferredMetricViews(const QString& clusteringCriteriaName);
+
+    void handleWatchMetricViewComplete();
+
+    void handleMetricViewWorkUnitFinished();
+
 private:
 
     explicit PerformanceDataManager(QObject* parent = 0);
@@ -255,12 +276,61 @@ private:
     void loadCudaMetricViews(QVector<QFuture<void> > &futures,
                              const QString &clusteringCriteriaName,
                              const QStringList& metricList,
-                             const QStringList& viewList);
+                             const QStringList& viewList,
+                             AnalysisScheduler::Lane lane,
+                             const CancellationToken& token);
+
+    bool requestMetricView(const QString& clusteringCriteriaName, const QString& metricName, const QString& viewName, bool prefetch);
 
     template <typename TM, typename TS>
     void processMetricView(const QString clusteringCriteriaName,
                            QString metric);
 
+    // the rows of a metric view ordered by decreasing metric value: the location information, source location and metric values of each row
+    template <typename TM>
+    struct MetricViewRows {
+        MetricViewRows() : total( 0 ) { }
+        void reserve(int size) {
+            locations.reserve( size );
+            filenames.reserve( size );
+            lineNumbers.reserve( size );
+            values.reserve( size );
+            minimums.reserve( size );
+            maximums.reserve( size );
+            means.reserve( size );
+        }
+        QStringList locations;
+        QVector< QString > filenames;
+        QVector< int > lineNumbers;
+        std::vector< TM > values;
+        std::vector< TM > minimums;
+        std::vector< TM > maximums;
+        std::vector< TM > means;
+        TM total;
+    };
+
+    template <typename TM, typename TS>
+    bool getMetricViewRows(const OpenSpeedShop::Framework::Collector& collector,
+                           const QString& metric,
+                           const OpenSpeedShop::Framework::TimeInterval& interval,
+                           const OpenSpeedShop::Framework::ThreadGroup& threadGroup,
+                           MetricViewRows<TM>& rows);
+
+    template <typename TM, typename TS>
+    bool getSnapshotMetricViewRows(MetricTableViewInfo& info,
+                                   const OpenSpeedShop::Framework::Collector& collector,
+                                   const QString& metric,
+                                   const OpenSpeedShop::Framework::TimeInterval& interval,
+                                   const OpenSpeedShop::Framework::ThreadGroup& threadGroup,
+                                   MetricViewRows<TM>& rows) {
+        Q_UNUSED(info) Q_UNUSED(collector) Q_UNUSED(metric) Q_UNUSED(interval) Q_UNUSED(threadGroup) Q_UNUSED(rows) return false;
+    }
+
+#if defined(HAS_OSSSNAPSHOT)
+    QSharedPointer< const ExperimentSnapshot > openSnapshot(const QString& filePath, const OpenSpeedShop::Framework::TimeInterval& extent);
+    void writeSnapshot(const QString& filePath);
+#endif
+
     template<typename TS, typename TM, typename DT>
     void processLoadBalanceView(const OpenSpeedShop::Framework::CollectorGroup& collectors,
                                 const OpenSpeedShop::Framework::ThreadGroup& all_threads,
@@ -283,9 +353,29 @@ private:
     template <typename TS>
     QString getLocationInfo(const TS& metric) { Q_UNUSED(metric) return QString(); }
 
+    // looks up the location of a row together with its source location, so each row is looked up once for the metric view, the source view and the graph items
+    template <typename TS>
+    QString getLocationInfo(const TS& metric, QString& filename, int& lineNumber) { filename.clear(); lineNumber = 0; return getLocationInfo<TS>( metric ); }
+
     template <typename TS>
     QString getViewName() const { return QString("CallTree"); }
 
+    // the source line metrics of the rows of a metric view: the defining location and the metric values of each row having a source location
+    struct SourceLineMetrics {
+        void append(const QString& filename, int lineNumber, const QVariantList& values) {
+            if ( ! filename.isEmpty() ) {
+                filenames << filename;
+                lineNumbers << lineNumber;
+                data << values;
+            }
+        }
+        QVector< QString > filenames;
+        QVector< int > lineNumbers;
+        QVector< QVariantList > data;
+    };
+
+    void emitSourceLineMetricData(const QString& clusteringCriteriaName, const QString& modeName, const QString& metricName, const QString& viewName, const SourceLineMetrics& metrics);
+
     template <typename TM>
     double getMetricValue(const TM& tm, int index = 0) { Q_UNUSED(index); return tm; }
 
@@ -351,6 +441,8 @@ private:
     template <typename TS>
     QStringList getMetricsDesc(const QStringList& eventNames) const { QStringList list( eventNames ); list.prepend( s_timeTitle ); list << s_functionTitle; return list; }
 
+    QStringList getTraceSummaryDesc() const;
+
     template <typename DETAIL_t>
     void getTraceMetricValues(const QString& functionName, const OpenSpeedShop::Framework::Time::value_type time_origin, const DETAIL_t& details, QVector<QVariantList>& metricData);
 
@@ -363,6 +455,74 @@ private:
                             const QStringList metricDesc,
                             const QString& clusteringCriteriaName);
 
+    // the value of one stack trace identified by the trie node of its innermost frame and its time
+    struct CalltreeSample {
+        StackTraceTrie::NodeId leaf;
+        quint64 time;
+        double value;
+    };
+
+    // the caller/callee aggregates of a contiguous range of the stack traces of one function
+    struct CalltreeChunk {
+        CalltreeChunk() : stopped( false ) { }
+        TALLDETAILS details;
+        FunctionSet callerFunctions;
+        std::vector< CalltreeSample > samples;
+        bool stopped;       // a stack trace without calls or caller ended the processing of the function's stack traces
+    };
+
+    template <typename DETAIL_t>
+    CalltreeChunk processCalltreeStackTraces(const OpenSpeedShop::Framework::Function& function,
+                                             typename std::map< OpenSpeedShop::Framework::StackTrace, DETAIL_t >::const_iterator first,
+                                             typename std::map< OpenSpeedShop::Framework::StackTrace, DETAIL_t >::const_iterator last,
+                                             const std::map< OpenSpeedShop::Framework::Thread, OpenSpeedShop::Framework::ExtentGroup >* subextents_map,
+                                             const StackTraceTrie* trie);
+
+    // the merged caller/callee aggregates of all stack traces of the calltree view and the values of the flame graph leaves
+    struct CalltreeAggregates {
+        TALLDETAILS details;
+        FunctionSet callerFunctions;
+        QHash< StackTraceTrie::NodeId, double > leafValues;
+    };
+
+    template <typename DETAIL_t>
+    void processCalltreeChunks(QThreadPool* pool,
+                               std::size_t chunkSize,
+                               const std::map< OpenSpeedShop::Framework::Function, std::map< OpenSpeedShop::Framework::StackTrace, DETAIL_t > >& data,
+                               const std::vector< std::map< OpenSpeedShop::Framework::Thread, OpenSpeedShop::Framework::ExtentGroup > >& subextents_maps,
+                               StackTraceTrie& trie,
+                               CalltreeAggregates& aggregates);
+
+#ifdef HAS_CALLTREE_PROCESSING_TIMING
+    template <typename DETAIL_t>
+    void walkCalltreeStackTraces(const OpenSpeedShop::Framework::ThreadGroup& threadGroup,
+                                 const std::map< OpenSpeedShop::Framework::Function, std::map< OpenSpeedShop::Framework::StackTrace, DETAIL_t > >& data,
+                                 CalltreeAggregates& aggregates);
+
+    template <typename DETAIL_t>
+    void benchmarkCalltreeChunks(const QString& viewName,
+                                 const OpenSpeedShop::Framework::ThreadGroup& threadGroup,
+                                 const std::map< OpenSpeedShop::Framework::Function, std::map< OpenSpeedShop::Framework::StackTrace, DETAIL_t > >& data,
+                                 const std::vector< std::map< OpenSpeedShop::Framework::Thread, OpenSpeedShop::Framework::ExtentGroup > >& subextents_maps);
+#endif
+
+    // the trace events of one function: the rows of the trace metric view and the typed event columns of the rows
+    struct TraceEventBlock {
+        QString functionName;
+        QVector< QVariantList > metricData;
+        QVector< double > timeBegins;
+        QVector< double > timeEnds;
+        QVector< int > ranks;
+        QVector< double > values;       // the graphed value of each event (or zero if the trace metric has no such column)
+        QuantileSketch durations;       // the distribution of the durations of the events merged from the sketch of each thread
+    };
+
+    template <typename DETAIL_t>
+    TraceEventBlock processTraceFunction(const OpenSpeedShop::Framework::Function& function,
+                                         const std::map< OpenSpeedShop::Framework::Thread, std::map< OpenSpeedShop::Framework::StackTrace, DETAIL_t > >* threads,
+                                         const OpenSpeedShop::Framework::Time::value_type time_origin,
+                                         int columnCount);
+
     template <typename DETAIL_t>
     void ShowTraceDetail(const QString clusteringCriteriaName,
                          const OpenSpeedShop::Framework::Collector collector,
@@ -394,6 +554,10 @@ private:
                                                const QString metricName,
                                                const QString viewName);
 
+#ifdef HAS_SAMPLE_COUNTERS_PROCESSING_TIMING
+    static void benchmarkSampleCounterRows();
+#endif
+
     void processCalltreeView(const QString clusteringCriteriaName);
 
     bool processDataTransferEvent(const ArgoNavis::Base::Time& time_origin,
@@ -406,12 +570,21 @@ private:
                                      const QString& clusterName,
                                      const QString& clusteringCriteriaName);
 
-    bool processPeriodicSample(const ArgoNavis::Base::Time& time_origin,
-                               const ArgoNavis::Base::Time& time,
-                               const std::vector<boost::uint64_t>& counts,
-                               const QSet< int >& gpuCounterIndexes,
-                               const QString& clusterName,
-                               const QString& clusteringCriteriaName);
+    // the periodic samples of one thread: the sample times and, for each counter, the raw counts at the sample times
+    struct PeriodicSampleSeries {
+        QVector< double > timeStamps;
+        std::vector< QVector< double > > rawCounts;
+    };
+
+    static bool processPeriodicSample(const ArgoNavis::Base::Time& time_origin,
+                                      const ArgoNavis::Base::Time& time,
+                                      const std::vector<boost::uint64_t>& counts,
+                                      PeriodicSampleSeries& series);
+
+    void emitPeriodicSamples(const PeriodicSampleSeries& series,
+                             int firstCounter,
+                             const QString& clusterName,
+                             const QString& clusteringCriteriaName);
 
     bool processPerformanceData(const ArgoNavis::CUDA::PerformanceData& data,
                                 const ArgoNavis::Base::ThreadName& thread,
@@ -420,9 +593,9 @@ private:
 
     // visitor functions to process CUDA details view
 
-    bool processDataTransferDetails(const QString& clusterName, const Base::Time &time_origin, const CUDA::DataTransfer &details);
+    bool processDataTransferDetails(const QString& clusterName, const Base::Time &time_origin, const CUDA::DataTransfer &details, BoundedSignalChannel::Batch* batch);
 
-    bool processKernelExecutionDetails(const QString& clusterName, const Base::Time &time_origin, const CUDA::KernelExecution &details);
+    bool processKernelExecutionDetails(const QString& clusterName, const Base::Time &time_origin, const CUDA::KernelExecution &details, BoundedSignalChannel::Batch* batch);
 
     // visitor functions to determine whether thread has CUDA events
 
@@ -441,9 +614,23 @@ private:
                        const ArgoNavis::Base::ThreadName& thread,
                        QMap< Base::ThreadName, bool >& flags);
 
-    void monitorMetricViewComplete(const QVector<QFuture<void> > *futures, const QString &clusteringCriteriaName, const QString modeName, const QString metricName, const QString viewName, double lower, double upper);
-
-    QVector< QFuture<void> >* allocateFutureVector(const QString &clusteringCriteriaName, const QString& metricViewName);
+    // a metric view whose work units are watched until the last one has finished
+    struct MetricViewCompletion {
+        QString clusteringCriteriaName;
+        QString modeName;
+        QString metricName;
+        QString viewName;
+        double lower;
+        double upper;
+        bool prefetch;
+        QVector< QFuture<void> > futures;   // the work units of the metric view
+        CancellationToken token;            // canceled when the metric view was superseded or unloaded
+        int remaining;                      // the number of work units not yet finished
+    };
+
+    void watchMetricViewComplete(const QString &clusteringCriteriaName, const QString& modeName, const QString& metricName, const QString& viewName,
+                                 double lower, double upper, bool prefetch, const QVector< QFuture<void> >& futures, const CancellationToken& token);
+    void completeMetricView(const MetricViewCompletion& completion);
 
     static QMap< QString, QMap< QString, QString > > INIT_TRACING_EXPERIMENTS_GRAPH_TITLES();
 
@@ -484,10 +671,6 @@ private:
 
     static QMap< QString, QMap< QString, QString > > s_TRACING_EXPERIMENTS_GRAPH_TITLES;
 
-    QVector<double> m_sampleKeys;
-    QMap< int, QVector<double> > m_sampleValues;
-    QMap< int, QVector<double> > m_rawValues;
-
     BackgroundGraphRenderer* m_renderer;
 
 #if defined(HAS_EXPERIMENTAL_CONCURRENT_PLOT_TO_IMAGE)
@@ -512,14 +695,22 @@ private:
     QMap< QString, QSet< QString > > m_selectedClusters;
     QMutex m_mutex;
 
-    // outer map: key=clustering criteria name  value: inner map of future vectors for each metric view
-    // inner map: key=metric view name  value: vector of futures providing work for generating the metric view
-    QMap< QString, QMap< QString, QVector< QFuture<void> >* > > m_futureMap;
-    QMutex m_futureMapMutex;
+    // runs the work units of the metric views (group=clustering criteria name  key=metric view name)
+    AnalysisScheduler m_scheduler;
+
+    // the metric view completions waiting for their work unit watchers to be created in the thread of this instance
+    QList< QSharedPointer< MetricViewCompletion > > m_pendingMetricViewCompletions;
+    QMutex m_pendingMetricViewCompletionsMutex;
+
+    // the metric view completion each work unit watcher belongs to (only accessed in the thread of this instance)
+    QMap< QFutureWatcherBase*, QSharedPointer< MetricViewCompletion > > m_metricViewWatchers;
 
     QAtomicInt m_numberLoadWorkUnitsInProgress;
     QAtomicInt m_loadInProgress;
 
+    QAtomicInt m_prefetchInProgress;
+    QAtomicInt m_foregroundRequestsInProgress;
+
 };
 
 
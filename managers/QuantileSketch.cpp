@@ -0,0 +1,265 @@
+/*!
+   \file QuantileSketch.cpp
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "QuantileSketch.h"
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+// the buffered values are merged into the centroids once the buffer holds this many values per unit of compression
+const int BUFFER_SIZE_FACTOR = 5;
+
+
+/**
+ * @brief QuantileSketch::QuantileSketch
+ * @param compression - the compression parameter bounding the number of centroids
+ *
+ * Constructs an empty QuantileSketch instance.  Larger compression values give more accurate quantiles at the expense of more centroids.
+ */
+QuantileSketch::QuantileSketch(double compression)
+    : m_compression( qMax( 20.0, compression ) )
+    , m_count( 0.0 )
+    , m_sum( 0.0 )
+    , m_min( std::numeric_limits<double>::max() )
+    , m_max( std::numeric_limits<double>::lowest() )
+{
+
+}
+
+/**
+ * @brief QuantileSketch::add
+ * @param value - the value to add
+ * @param weight - the number of occurrences of the value
+ *
+ * Adds the value to the sketch.  The value is buffered until enough values are buffered to merge them into the centroids.
+ */
+void QuantileSketch::add(double value, double weight)
+{
+    if ( weight <= 0.0 )
+        return;
+
+    m_buffer.append( Centroid( value, weight ) );
+
+    m_count += weight;
+    m_sum += value * weight;
+    m_min = qMin( m_min, value );
+    m_max = qMax( m_max, value );
+
+    if ( m_buffer.size() >= BUFFER_SIZE_FACTOR * m_compression )
+        compress();
+}
+
+/**
+ * @brief QuantileSketch::merge
+ * @param other - the sketch to merge into this sketch
+ *
+ * Merges the centroids and buffered values of the other sketch into this sketch.
+ */
+void QuantileSketch::merge(const QuantileSketch &other)
+{
+    if ( other.isEmpty() )
+        return;
+
+    m_buffer << other.m_centroids << other.m_buffer;
+
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = qMin( m_min, other.m_min );
+    m_max = qMax( m_max, other.m_max );
+
+    compress();
+}
+
+/**
+ * @brief QuantileSketch::flush
+ *
+ * Merges the buffered values into the centroids.
+ */
+void QuantileSketch::flush()
+{
+    compress();
+}
+
+/**
+ * @brief QuantileSketch::isEmpty
+ * @return - whether no values were added
+ */
+bool QuantileSketch::isEmpty() const
+{
+    return m_count <= 0.0;
+}
+
+/**
+ * @brief QuantileSketch::count
+ * @return - the number of values added
+ */
+double QuantileSketch::count() const
+{
+    return m_count;
+}
+
+/**
+ * @brief QuantileSketch::sum
+ * @return - the sum of the values added
+ */
+double QuantileSketch::sum() const
+{
+    return m_sum;
+}
+
+/**
+ * @brief QuantileSketch::min
+ * @return - the smallest value added (or zero if no values were added)
+ */
+double QuantileSketch::min() const
+{
+    return isEmpty() ? 0.0 : m_min;
+}
+
+/**
+ * @brief QuantileSketch::max
+ * @return - the largest value added (or zero if no values were added)
+ */
+double QuantileSketch::max() const
+{
+    return isEmpty() ? 0.0 : m_max;
+}
+
+/**
+ * @brief QuantileSketch::quantile
+ * @param q - the quantile in the range [0 .. 1]
+ * @return - the estimated value of the quantile (or zero if no values were added)
+ *
+ * Each centroid is taken to represent values centered on its mean, so the value of the quantile is interpolated between the means of
+ * the two centroids enclosing its rank.  Below the first and above the last centroid the value is interpolated to the smallest and
+ * largest value added.  Call flush() before publishing a sketch having buffered values to avoid merging them on each call.
+ */
+double QuantileSketch::quantile(double q) const
+{
+    if ( isEmpty() )
+        return 0.0;
+
+    // the buffered values are merged into the centroids of a copy, as a const sketch may be shared by several threads
+    if ( ! m_buffer.isEmpty() ) {
+        QuantileSketch sketch( *this );
+        sketch.compress();
+        return sketch.quantile( q );
+    }
+
+    const int n = m_centroids.size();
+
+    if ( 1 == n )
+        return m_centroids[0].mean;
+
+    const double rank = qBound( 0.0, q, 1.0 ) * m_count;
+
+    // the ranks from zero to the center of the first centroid lie between the smallest value and the first mean
+    double weightSoFar = m_centroids[0].weight / 2.0;
+
+    if ( rank < weightSoFar )
+        return m_min + ( m_centroids[0].mean - m_min ) * rank / weightSoFar;
+
+    for ( int i=0; i<n-1; ++i ) {
+        const double delta = ( m_centroids[i].weight + m_centroids[i+1].weight ) / 2.0;
+
+        if ( weightSoFar + delta > rank ) {
+            const double t = ( rank - weightSoFar ) / delta;
+            return m_centroids[i].mean + t * ( m_centroids[i+1].mean - m_centroids[i].mean );
+        }
+
+        weightSoFar += delta;
+    }
+
+    // the ranks from the center of the last centroid to the count lie between the last mean and the largest value
+    const double remaining = m_count - weightSoFar;
+
+    if ( remaining <= 0.0 )
+        return m_max;
+
+    return m_centroids[n-1].mean + ( m_max - m_centroids[n-1].mean ) * qMin( 1.0, ( rank - weightSoFar ) / remaining );
+}
+
+/**
+ * @brief QuantileSketch::compress
+ *
+ * Merges the buffered values into the centroids.  Adjacent values are combined into a centroid as long as the quantile span of the
+ * centroid stays within one unit of the arcsine scale function, which limits centroids near the extreme quantiles to few values.
+ */
+void QuantileSketch::compress()
+{
+    if ( m_buffer.isEmpty() )
+        return;
+
+    QVector< Centroid > all;
+    all.reserve( m_centroids.size() + m_buffer.size() );
+    all << m_centroids << m_buffer;
+
+    std::sort( all.begin(), all.end() );
+
+    m_buffer.clear();
+    m_centroids.clear();
+
+    double total( 0.0 );
+    foreach ( const Centroid& centroid, all ) {
+        total += centroid.weight;
+    }
+
+    const double normalizer = m_compression / ( 2.0 * M_PI );
+
+    // the scale function maps a quantile to the index of the centroid which contains it and its inverse
+    auto scale = [normalizer](double q) { return normalizer * std::asin( 2.0 * qBound( 0.0, q, 1.0 ) - 1.0 ); };
+    auto inverseScale = [normalizer](double k) { return ( std::sin( qBound( -M_PI_2, k / normalizer, M_PI_2 ) ) + 1.0 ) / 2.0; };
+
+    double weightSoFar( 0.0 );
+    double quantileLimit = inverseScale( scale( 0.0 ) + 1.0 );
+
+    Centroid current( all[0] );
+
+    for ( int i=1; i<all.size(); ++i ) {
+        const Centroid& next( all[i] );
+        const double proposedWeight = current.weight + next.weight;
+
+        if ( ( weightSoFar + proposedWeight ) / total <= quantileLimit ) {
+            current.mean += ( next.mean - current.mean ) * next.weight / proposedWeight;
+            current.weight = proposedWeight;
+        }
+        else {
+            m_centroids.append( current );
+            weightSoFar += current.weight;
+            quantileLimit = inverseScale( scale( weightSoFar / total ) + 1.0 );
+            current = next;
+        }
+    }
+
+    m_centroids.append( current );
+}
+
+
+} // GUI
+} // ArgoNavis
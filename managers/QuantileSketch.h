@@ -0,0 +1,92 @@
+/*!
+   \file QuantileSketch.h
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef QUANTILESKETCH_H
+#define QUANTILESKETCH_H
+
+#include <QVector>
+
+#include "common/openss-gui-config.h"
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/*!
+ * \brief The QuantileSketch class
+ *
+ * A mergeable streaming estimate of the distribution of a series of values (a merging t-digest).  Values are buffered and periodically
+ * merged into a bounded number of weighted centroids which are small near the extreme quantiles and larger near the median, so tail
+ * quantiles (for example the 95th and 99th percentile) remain accurate without retaining or sorting the values.  The number of
+ * centroids is bounded by the compression parameter.  Sketches accumulated separately (for example per thread) are combined with merge(),
+ * which leaves no values buffered.  The const methods never modify the sketch, so a published sketch may be read from several threads.
+ */
+
+class QuantileSketch
+{
+public:
+
+    explicit QuantileSketch(double compression = 100.0);
+
+    void add(double value, double weight = 1.0);
+    void merge(const QuantileSketch& other);
+    void flush();
+
+    bool isEmpty() const;
+    double count() const;
+    double sum() const;
+    double min() const;
+    double max() const;
+
+    double quantile(double q) const;
+
+private:
+
+    void compress();
+
+    // a group of adjacent values summarized by their mean and number
+    struct Centroid {
+        Centroid(double m = 0.0, double w = 0.0) : mean( m ), weight( w ) { }
+        bool operator<(const Centroid& other) const { return mean < other.mean; }
+        double mean;
+        double weight;
+    };
+
+    double m_compression;
+
+    QVector< Centroid > m_centroids;    // the merged centroids in order of their means
+    QVector< Centroid > m_buffer;       // the values not yet merged into the centroids
+
+    double m_count;
+    double m_sum;
+    double m_min;
+    double m_max;
+
+};
+
+
+} // GUI
+} // ArgoNavis
+
+#endif // QUANTILESKETCH_H
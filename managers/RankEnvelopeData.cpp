@@ -0,0 +1,311 @@
+/*!
+   \file RankEnvelopeData.cpp
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "RankEnvelopeData.h"
+
+#include <limits>
+#include <vector>
+#include <cmath>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/**
+ * @brief RankEnvelopeData::RankEnvelopeData
+ *
+ * Constructs an empty RankEnvelopeData instance.
+ */
+RankEnvelopeData::RankEnvelopeData()
+    : m_rankWithMinValue( -1 )
+    , m_rankClosestToAvgValue( -1 )
+    , m_rankWithMaxValue( -1 )
+{
+
+}
+
+/**
+ * @brief RankEnvelopeData::addValue
+ * @param rank - the rank (or thread) of the value
+ * @param time - the time of the value
+ * @param value - the value
+ *
+ * Appends the value to the raw series of the rank.
+ */
+void RankEnvelopeData::addValue(int rank, double time, double value)
+{
+    Series& series = m_series[ rank ];
+
+    if ( series.values.isEmpty() || value > series.peak )
+        series.peak = value;
+
+    series.times.append( time );
+    series.values.append( value );
+}
+
+/**
+ * @brief RankEnvelopeData::reduce
+ * @param bucketCount - the number of time buckets of the envelope
+ *
+ * Reduces the raw series of all ranks into the minimum, mean and maximum value of each time bucket spanning the time range of the
+ * values.  The mean of a bucket is the mean of the mean values of the ranks having values in the bucket.  Only the non-empty buckets are kept; the time of a bucket is its center.  The representative ranks are the ranks with
+ * the smallest and largest peak value and the rank whose peak value is closest to the average peak value.
+ */
+void RankEnvelopeData::reduce(int bucketCount)
+{
+    m_envelopeTimes.clear();
+    m_envelopeMin.clear();
+    m_envelopeMean.clear();
+    m_envelopeMax.clear();
+
+    m_rankWithMinValue = m_rankClosestToAvgValue = m_rankWithMaxValue = -1;
+
+    if ( m_series.isEmpty() || bucketCount < 1 )
+        return;
+
+    double lower( std::numeric_limits<double>::max() );
+    double upper( std::numeric_limits<double>::lowest() );
+    double minPeak( std::numeric_limits<double>::max() );
+    double maxPeak( std::numeric_limits<double>::lowest() );
+    double peakSum( 0.0 );
+
+    for ( QMap< int, Series >::const_iterator iter = m_series.constBegin(); iter != m_series.constEnd(); ++iter ) {
+        const Series& series( iter.value() );
+
+        foreach ( const double time, series.times ) {
+            lower = qMin( lower, time );
+            upper = qMax( upper, time );
+        }
+
+        if ( series.peak < minPeak ) {
+            minPeak = series.peak;
+            m_rankWithMinValue = iter.key();
+        }
+        if ( series.peak > maxPeak ) {
+            maxPeak = series.peak;
+            m_rankWithMaxValue = iter.key();
+        }
+
+        peakSum += series.peak;
+    }
+
+    const double average = peakSum / m_series.size();
+    double closestDistance( std::numeric_limits<double>::max() );
+
+    for ( QMap< int, Series >::const_iterator iter = m_series.constBegin(); iter != m_series.constEnd(); ++iter ) {
+        const double distance = std::abs( iter->peak - average );
+        if ( distance < closestDistance ) {
+            closestDistance = distance;
+            m_rankClosestToAvgValue = iter.key();
+        }
+    }
+
+    const double bucketWidth = ( upper > lower ) ? ( upper - lower ) / bucketCount : 1.0;
+
+    std::vector< double > minValues( bucketCount, std::numeric_limits<double>::max() );
+    std::vector< double > maxValues( bucketCount, std::numeric_limits<double>::lowest() );
+    std::vector< double > sums( bucketCount, 0.0 );     // the sum of the per-rank mean values
+    std::vector< int > counts( bucketCount, 0 );        // the number of ranks having values
+
+    // the sum and number of the values of the current rank in each bucket and the buckets having values of the current rank
+    std::vector< double > rankSums( bucketCount, 0.0 );
+    std::vector< int > rankCounts( bucketCount, 0 );
+    std::vector< int > rankBuckets;
+
+    for ( QMap< int, Series >::const_iterator iter = m_series.constBegin(); iter != m_series.constEnd(); ++iter ) {
+        const Series& series( iter.value() );
+
+        for ( int i=0; i<series.times.size(); ++i ) {
+            const int bucket = qBound( 0, static_cast< int >( ( series.times[ i ] - lower ) / bucketWidth ), bucketCount - 1 );
+            const double value = series.values[ i ];
+
+            minValues[ bucket ] = qMin( minValues[ bucket ], value );
+            maxValues[ bucket ] = qMax( maxValues[ bucket ], value );
+
+            if ( 0 == rankCounts[ bucket ]++ )
+                rankBuckets.push_back( bucket );
+            rankSums[ bucket ] += value;
+        }
+
+        // each rank contributes its mean value in the bucket, so a rank with many events doesn't outweigh the other ranks
+        for ( std::vector< int >::const_iterator biter = rankBuckets.begin(); biter != rankBuckets.end(); ++biter ) {
+            sums[ *biter ] += rankSums[ *biter ] / rankCounts[ *biter ];
+            counts[ *biter ]++;
+            rankSums[ *biter ] = 0.0;
+            rankCounts[ *biter ] = 0;
+        }
+
+        rankBuckets.clear();
+    }
+
+    for ( int bucket=0; bucket<bucketCount; ++bucket ) {
+        if ( 0 == counts[ bucket ] )
+            continue;
+
+        m_envelopeTimes.append( lower + ( bucket + 0.5 ) * bucketWidth );
+        m_envelopeMin.append( minValues[ bucket ] );
+        m_envelopeMean.append( sums[ bucket ] / counts[ bucket ] );
+        m_envelopeMax.append( maxValues[ bucket ] );
+    }
+}
+
+/**
+ * @brief RankEnvelopeData::isEmpty
+ * @return - whether there are no values
+ */
+bool RankEnvelopeData::isEmpty() const
+{
+    return m_series.isEmpty();
+}
+
+/**
+ * @brief RankEnvelopeData::rankCount
+ * @return - the number of ranks having values
+ */
+int RankEnvelopeData::rankCount() const
+{
+    return m_series.size();
+}
+
+/**
+ * @brief RankEnvelopeData::ranks
+ * @return - the ranks having values in ascending order
+ */
+QList< int > RankEnvelopeData::ranks() const
+{
+    return m_series.keys();
+}
+
+/**
+ * @brief RankEnvelopeData::hasRank
+ * @param rank - the rank (or thread)
+ * @return - whether the rank has values
+ */
+bool RankEnvelopeData::hasRank(int rank) const
+{
+    return m_series.contains( rank );
+}
+
+/**
+ * @brief RankEnvelopeData::times
+ * @param rank - the rank (or thread)
+ * @return - the times of the raw series of the rank
+ */
+const QVector< double >& RankEnvelopeData::times(int rank) const
+{
+    static const QVector< double > s_empty;
+
+    QMap< int, Series >::const_iterator iter = m_series.constFind( rank );
+
+    return ( iter != m_series.constEnd() ) ? iter->times : s_empty;
+}
+
+/**
+ * @brief RankEnvelopeData::values
+ * @param rank - the rank (or thread)
+ * @return - the values of the raw series of the rank
+ */
+const QVector< double >& RankEnvelopeData::values(int rank) const
+{
+    static const QVector< double > s_empty;
+
+    QMap< int, Series >::const_iterator iter = m_series.constFind( rank );
+
+    return ( iter != m_series.constEnd() ) ? iter->values : s_empty;
+}
+
+/**
+ * @brief RankEnvelopeData::envelopeTimes
+ * @return - the center times of the non-empty time buckets
+ */
+const QVector< double >& RankEnvelopeData::envelopeTimes() const
+{
+    return m_envelopeTimes;
+}
+
+/**
+ * @brief RankEnvelopeData::envelopeMin
+ * @return - the minimum value across all ranks of each non-empty time bucket
+ */
+const QVector< double >& RankEnvelopeData::envelopeMin() const
+{
+    return m_envelopeMin;
+}
+
+/**
+ * @brief RankEnvelopeData::envelopeMean
+ * @return - the mean of the per-rank mean values of each non-empty time bucket
+ */
+const QVector< double >& RankEnvelopeData::envelopeMean() const
+{
+    return m_envelopeMean;
+}
+
+/**
+ * @brief RankEnvelopeData::envelopeMax
+ * @return - the maximum value across all ranks of each non-empty time bucket
+ */
+const QVector< double >& RankEnvelopeData::envelopeMax() const
+{
+    return m_envelopeMax;
+}
+
+/**
+ * @brief RankEnvelopeData::rankWithMinValue
+ * @return - the rank with the smallest peak value (or -1 if there are no values)
+ */
+int RankEnvelopeData::rankWithMinValue() const
+{
+    return m_rankWithMinValue;
+}
+
+/**
+ * @brief RankEnvelopeData::rankClosestToAvgValue
+ * @return - the rank whose peak value is closest to the average peak value (or -1 if there are no values)
+ */
+int RankEnvelopeData::rankClosestToAvgValue() const
+{
+    return m_rankClosestToAvgValue;
+}
+
+/**
+ * @brief RankEnvelopeData::rankWithMaxValue
+ * @return - the rank with the largest peak value (or -1 if there are no values)
+ */
+int RankEnvelopeData::rankWithMaxValue() const
+{
+    return m_rankWithMaxValue;
+}
+
+/**
+ * @brief RankEnvelopeData::maxValue
+ * @return - the largest value of all ranks
+ */
+double RankEnvelopeData::maxValue() const
+{
+    return ( m_rankWithMaxValue != -1 ) ? m_series.value( m_rankWithMaxValue ).peak : 0.0;
+}
+
+
+} // GUI
+} // ArgoNavis
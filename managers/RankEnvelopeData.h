@@ -0,0 +1,104 @@
+/*!
+   \file RankEnvelopeData.h
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef RANKENVELOPEDATA_H
+#define RANKENVELOPEDATA_H
+
+#include <QVector>
+#include <QMap>
+#include <QMetaType>
+
+#include "common/openss-gui-config.h"
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/*!
+ * \brief The RankEnvelopeData class
+ *
+ * The summary of a per-rank line graph (for example the memory or I/O trace values of each rank over time).  The values of all ranks
+ * are reduced into a min/mean/max envelope over fixed time buckets, and the ranks with the smallest peak value, the largest peak value
+ * and the peak value closest to the average peak are picked to represent all ranks.  The raw series of every rank is retained, so the
+ * graph of any other rank can be materialized on request.
+ */
+
+class RankEnvelopeData
+{
+public:
+
+    RankEnvelopeData();
+
+    void addValue(int rank, double time, double value);
+    void reduce(int bucketCount);
+
+    bool isEmpty() const;
+    int rankCount() const;
+    QList< int > ranks() const;
+    bool hasRank(int rank) const;
+
+    const QVector< double >& times(int rank) const;
+    const QVector< double >& values(int rank) const;
+
+    const QVector< double >& envelopeTimes() const;
+    const QVector< double >& envelopeMin() const;
+    const QVector< double >& envelopeMean() const;
+    const QVector< double >& envelopeMax() const;
+
+    int rankWithMinValue() const;
+    int rankClosestToAvgValue() const;
+    int rankWithMaxValue() const;
+
+    double maxValue() const;
+
+private:
+
+    // the raw series of one rank
+    struct Series {
+        Series() : peak( 0.0 ) { }
+        QVector< double > times;
+        QVector< double > values;
+        double peak;        // the largest value of the series
+    };
+
+    QMap< int, Series > m_series;
+
+    // the envelope of the non-empty time buckets
+    QVector< double > m_envelopeTimes;
+    QVector< double > m_envelopeMin;
+    QVector< double > m_envelopeMean;
+    QVector< double > m_envelopeMax;
+
+    int m_rankWithMinValue;
+    int m_rankClosestToAvgValue;
+    int m_rankWithMaxValue;
+
+};
+
+
+} // GUI
+} // ArgoNavis
+
+Q_DECLARE_METATYPE( ArgoNavis::GUI::RankEnvelopeData )
+
+#endif // RANKENVELOPEDATA_H
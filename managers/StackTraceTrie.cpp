@@ -0,0 +1,278 @@
+/*!
+   \file StackTraceTrie.cpp
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "StackTraceTrie.h"
+
+#include "managers/AnalysisScheduler.h"
+
+#include <QtConcurrentMap>
+
+
+using namespace OpenSpeedShop::Framework;
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+const StackTraceTrie::NodeId StackTraceTrie::NO_NODE;
+
+
+/**
+ * @brief The StackTraceTrie::FrameResolver struct provides a Function object (functor) which resolves the function of a frame
+ * unless the task building the trie was canceled.
+ */
+struct StackTraceTrie::FrameResolver {
+    typedef void result_type;
+    explicit FrameResolver(const CancellationToken& token) : m_token( token ) { }
+    void operator() (Frame& frame) const {
+        if ( m_token.isCanceled() )
+            return;
+        const std::pair< bool, Function > result = frame.stacktrace->getFunctionAt( frame.index );
+        if ( result.first )
+            frame.function = result.second;
+    }
+    CancellationToken m_token;
+};
+
+
+/**
+ * @brief StackTraceTrie::StackTraceTrie
+ *
+ * Constructs an empty StackTraceTrie instance.
+ */
+StackTraceTrie::StackTraceTrie()
+{
+
+}
+
+/**
+ * @brief StackTraceTrie::build
+ * @param stacktraces - the stack traces to add
+ *
+ * Add the stack traces to the trie.  The unique frames (thread and address) of the stack traces are found first and their functions are
+ * resolved concurrently, each at the first stack trace containing the frame; the nodes are then created without further experiment
+ * database queries.  Must be called before the trie is read by other threads.
+ */
+void StackTraceTrie::build(const std::vector< const StackTrace* >& stacktraces)
+{
+    typedef std::map< std::pair< Thread, quint64 >, std::size_t > FrameMap;
+
+    // find the unique frames in the order of the stack traces
+    FrameMap frameIndexes;
+    std::vector< Frame > frames;
+
+    for ( std::vector< const StackTrace* >::const_iterator iter = stacktraces.begin(); iter != stacktraces.end(); ++iter ) {
+        const StackTrace& stacktrace( **iter );
+
+        for ( std::size_t i=0; i<stacktrace.size(); ++i ) {
+            const std::pair< FrameMap::iterator, bool > result =
+                    frameIndexes.insert( std::make_pair( std::make_pair( stacktrace.getThread(), quint64( stacktrace[i].getValue() ) ), frames.size() ) );
+
+            if ( result.second ) {
+                Frame frame;
+                frame.stacktrace = &stacktrace;
+                frame.index = i;
+                frames.push_back( frame );
+            }
+        }
+    }
+
+    // resolve the function of each unique frame once
+    QtConcurrent::blockingMap( frames, FrameResolver( AnalysisScheduler::currentToken() ) );
+
+    if ( AnalysisScheduler::isCanceled() )
+        return;
+
+    for ( std::vector< const StackTrace* >::const_iterator iter = stacktraces.begin(); iter != stacktraces.end(); ++iter ) {
+        const StackTrace& stacktrace( **iter );
+        const std::size_t count = stacktrace.size();
+
+        NodeId node;
+
+        std::map< Thread, NodeId >::const_iterator root = m_roots.find( stacktrace.getThread() );
+
+        if ( root != m_roots.end() ) {
+            node = root->second;
+        }
+        else {
+            Node item;
+            item.parent = NO_NODE;
+            item.functionIndex = -1;
+
+            node = m_nodes.size();
+            m_nodes.push_back( item );
+            m_roots.insert( std::make_pair( stacktrace.getThread(), node ) );
+        }
+
+        // add the frames from the outermost frame
+        for ( std::size_t i=0; i<count; ++i ) {
+            const quint64 address = stacktrace[ count-1-i ].getValue();
+
+            NodeId child = findChild( node, address );
+
+            if ( NO_NODE == child ) {
+                const Frame& frame( frames[ frameIndexes[ std::make_pair( stacktrace.getThread(), address ) ] ] );
+
+                Node item;
+                item.parent = node;
+                item.functionIndex = ( frame.function ) ? internFunction( *frame.function ) : -1;
+
+                child = m_nodes.size();
+                m_nodes.push_back( item );
+                m_children.insert( qMakePair( node, address ), child );
+            }
+
+            node = child;
+        }
+    }
+}
+
+/**
+ * @brief StackTraceTrie::find
+ * @param stacktrace - the stack trace
+ * @return - the id of the node representing the stack trace or NO_NODE if the stack trace wasn't added to the trie
+ */
+StackTraceTrie::NodeId StackTraceTrie::find(const StackTrace &stacktrace) const
+{
+    std::map< Thread, NodeId >::const_iterator root = m_roots.find( stacktrace.getThread() );
+
+    if ( root == m_roots.end() )
+        return NO_NODE;
+
+    NodeId node = root->second;
+
+    const std::size_t count = stacktrace.size();
+
+    for ( std::size_t i=0; i<count && NO_NODE != node; ++i ) {
+        node = findChild( node, stacktrace[ count-1-i ].getValue() );
+    }
+
+    return node;
+}
+
+/**
+ * @brief StackTraceTrie::parent
+ * @param node - the node id
+ * @return - the id of the node of the calling frame or the thread root node (NO_NODE for a root node)
+ */
+StackTraceTrie::NodeId StackTraceTrie::parent(NodeId node) const
+{
+    return ( node < m_nodes.size() ) ? m_nodes[ node ].parent : NO_NODE;
+}
+
+/**
+ * @brief StackTraceTrie::isRoot
+ * @param node - the node id
+ * @return - whether the node is the root node of a thread (has no frame)
+ */
+bool StackTraceTrie::isRoot(NodeId node) const
+{
+    return NO_NODE == parent( node );
+}
+
+/**
+ * @brief StackTraceTrie::functionIndex
+ * @param node - the node id
+ * @return - the index of the interned function of the node's frame or -1 if the frame has no function
+ */
+int StackTraceTrie::functionIndex(NodeId node) const
+{
+    return ( node < m_nodes.size() ) ? m_nodes[ node ].functionIndex : -1;
+}
+
+/**
+ * @brief StackTraceTrie::functionIndex
+ * @param function - the function
+ * @return - the index of the interned function or -1 if the function isn't the function of any frame in the trie
+ */
+int StackTraceTrie::functionIndex(const Function &function) const
+{
+    std::map< Function, int >::const_iterator iter = m_functionIndexes.find( function );
+
+    return ( iter != m_functionIndexes.end() ) ? iter->second : -1;
+}
+
+/**
+ * @brief StackTraceTrie::function
+ * @param functionIndex - the index of an interned function
+ * @return - the interned function
+ */
+Function StackTraceTrie::function(int functionIndex) const
+{
+    return m_functions.at( functionIndex );
+}
+
+/**
+ * @brief StackTraceTrie::functionCount
+ * @return - the number of interned functions
+ */
+int StackTraceTrie::functionCount() const
+{
+    return m_functions.size();
+}
+
+/**
+ * @brief StackTraceTrie::size
+ * @return - the number of nodes in the trie
+ */
+std::size_t StackTraceTrie::size() const
+{
+    return m_nodes.size();
+}
+
+/**
+ * @brief StackTraceTrie::findChild
+ * @param node - the node id
+ * @param address - the frame address
+ * @return - the id of the child node for the frame address or NO_NODE if not present
+ */
+StackTraceTrie::NodeId StackTraceTrie::findChild(NodeId node, quint64 address) const
+{
+    return m_children.value( qMakePair( node, address ), NO_NODE );
+}
+
+/**
+ * @brief StackTraceTrie::internFunction
+ * @param function - the function
+ * @return - the index of the interned function
+ *
+ * Add the function to the interned functions if not already present.
+ */
+int StackTraceTrie::internFunction(const Function &function)
+{
+    std::map< Function, int >::const_iterator iter = m_functionIndexes.find( function );
+
+    if ( iter != m_functionIndexes.end() )
+        return iter->second;
+
+    const int index = m_functions.size();
+
+    m_functions.push_back( function );
+    m_functionIndexes.insert( std::make_pair( function, index ) );
+
+    return index;
+}
+
+
+} // GUI
+} // ArgoNavis
@@ -0,0 +1,113 @@
+/*!
+   \file StackTraceTrie.h
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef STACKTRACETRIE_H
+#define STACKTRACETRIE_H
+
+#include <QHash>
+#include <QPair>
+
+#include <map>
+#include <vector>
+
+#include "common/openss-gui-config.h"
+
+#include "boost/optional.hpp"
+
+#include "Function.hxx"
+#include "StackTrace.hxx"
+#include "Thread.hxx"
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/*!
+ * \brief The StackTraceTrie class
+ *
+ * A prefix trie of interned stack frames.  Each thread has a root node and each node below it represents a unique call path from the
+ * outermost frame of a stack trace, so every unique stack trace of a thread is identified by a single node id and two stack traces are
+ * equal when their node ids are equal.  The functions are interned so they can be compared by index.
+ *
+ * The trie is built once by StackTraceTrie::build.  The function of each unique frame (thread and address) is resolved before any node
+ * is created, at the first stack trace containing the frame in the order given to build, so the function of a node doesn't depend on the
+ * order in which threads process the stack traces.  Once built the trie is read-only and may be read concurrently without locking.
+ */
+
+class StackTraceTrie
+{
+public:
+
+    typedef quint32 NodeId;
+
+    static const NodeId NO_NODE = 0xffffffff;
+
+    StackTraceTrie();
+
+    void build(const std::vector< const OpenSpeedShop::Framework::StackTrace* >& stacktraces);
+
+    NodeId find(const OpenSpeedShop::Framework::StackTrace& stacktrace) const;
+
+    NodeId parent(NodeId node) const;
+    bool isRoot(NodeId node) const;
+
+    int functionIndex(NodeId node) const;
+    int functionIndex(const OpenSpeedShop::Framework::Function& function) const;
+    OpenSpeedShop::Framework::Function function(int functionIndex) const;
+    int functionCount() const;
+
+    std::size_t size() const;
+
+private:
+
+    struct Node {
+        NodeId parent;
+        int functionIndex;          // index of the interned function of the frame or -1 if the frame has no function
+    };
+
+    // a unique frame of the stack traces and the stack trace used to resolve its function
+    struct Frame {
+        const OpenSpeedShop::Framework::StackTrace* stacktrace;
+        std::size_t index;
+        boost::optional< OpenSpeedShop::Framework::Function > function;
+    };
+
+    struct FrameResolver;
+
+    NodeId findChild(NodeId node, quint64 address) const;
+    int internFunction(const OpenSpeedShop::Framework::Function& function);
+
+    std::vector< Node > m_nodes;
+    QHash< QPair< NodeId, quint64 >, NodeId > m_children;
+    std::map< OpenSpeedShop::Framework::Thread, NodeId > m_roots;
+
+    std::vector< OpenSpeedShop::Framework::Function > m_functions;
+    std::map< OpenSpeedShop::Framework::Function, int > m_functionIndexes;
+
+};
+
+
+} // GUI
+} // ArgoNavis
+
+#endif // STACKTRACETRIE_H
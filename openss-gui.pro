@@ -127,6 +127,8 @@ greaterThan(QT_MAJOR_VERSION, 4) {
 }
 DEFINES += HAS_CONCURRENT_PROCESSING_VIEW_DEBUG
 #DEFINES += HAS_TIMER_THREAD_DESTROYED_CHECKING
+#DEFINES += HAS_CALLTREE_PROCESSING_TIMING
+#DEFINES += HAS_SAMPLE_COUNTERS_PROCESSING_TIMING
 #DEFINES += HAS_PROCESS_EVENT_DEBUG
 #DEFINES += HAS_TEST_DATA_RANGE_CONSTRAINT
 DEFINES += HAS_SOURCE_CODE_LINE_HIGHLIGHTS
@@ -180,9 +182,12 @@ SOURCES += \
     graphitems/OSSDataTransferItem.cpp \
     graphitems/OSSKernelExecutionItem.cpp \
     graphitems/OSSEventItem.cpp \
-    graphitems/OSSPeriodicSampleItem.cpp \
+    graphitems/OSSPeriodicSamplesPlottable.cpp \
     graphitems/OSSEventsSummaryItem.cpp \
     graphitems/OSSTraceItem.cpp \
+    graphitems/OSSTraceEventsPlottable.cpp \
+    graphitems/OSSIntervalIndex.cpp \
+    graphitems/OSSDecimatedSeries.cpp \
     widgets/TreeItem.cpp \
     widgets/TreeModel.cpp \
     widgets/ExperimentPanel.cpp \
@@ -197,16 +202,28 @@ SOURCES += \
     CBTF-ArgoNavis-Ext/DataTransferDetails.cpp \
     CBTF-ArgoNavis-Ext/KernelExecutionDetails.cpp \
     widgets/ViewSortFilterProxyModel.cpp \
+    widgets/TraceSliceProxyModel.cpp \
+    widgets/TraceRowIndex.cpp \
     CBTF-ArgoNavis-Ext/ClusterNameBuilder.cpp \
     managers/CalltreeGraphManager.cpp \
+    managers/CalltreeGraphLayout.cpp \
+    managers/StackTraceTrie.cpp \
+    managers/FlameGraphData.cpp \
+    managers/RankEnvelopeData.cpp \
+    managers/QuantileSketch.cpp \
     widgets/CalltreeGraphView.cpp \
+    widgets/CalltreeGraphItems.cpp \
+    widgets/FlameGraphView.cpp \
     widgets/MetricViewManager.cpp \
     widgets/MetricViewDelegate.cpp \
     managers/ApplicationOverrideCursorManager.cpp \
+    managers/BoundedSignalChannel.cpp \
+    managers/AnalysisScheduler.cpp \
     widgets/ShowDeviceDetailsDialog.cpp \
     CBTF-ArgoNavis-Ext/CudaDeviceHelper.cpp \
     widgets/ThreadSelectionCommand.cpp \
     managers/MetricTableViewInfo.cpp \
+    managers/ExperimentSnapshot.cpp \
     SourceView/SourceViewMetricsCache.cpp \
     graphitems/OSSHighlightItem.cpp \
     widgets/MetricViewFilterDialog.cpp \
@@ -220,10 +237,18 @@ SOURCES += \
 greaterThan(QT_MAJOR_VERSION, 4): {
 # uncomment the following to produce XML dump of database
 #DEFINES += HAS_OSSCUDA2XML
+# uncomment the following as well to produce a newline-delimited JSON dump instead
+#DEFINES += HAS_OSSCUDA2NDJSON
 contains(DEFINES, HAS_OSSCUDA2XML): {
     SOURCES += \
     util/osscuda2xml.cxx \
 }
+# uncomment the following to produce a binary snapshot of database
+#DEFINES += HAS_OSSSNAPSHOT
+contains(DEFINES, HAS_OSSSNAPSHOT): {
+    SOURCES += \
+    util/osssnapshot.cxx \
+}
 }
 
 HEADERS += \
@@ -234,9 +259,12 @@ HEADERS += \
     graphitems/OSSDataTransferItem.h \
     graphitems/OSSKernelExecutionItem.h \
     graphitems/OSSEventItem.h \
-    graphitems/OSSPeriodicSampleItem.h \
+    graphitems/OSSPeriodicSamplesPlottable.h \
     graphitems/OSSEventsSummaryItem.h \
     graphitems/OSSTraceItem.h \
+    graphitems/OSSTraceEventsPlottable.h \
+    graphitems/OSSIntervalIndex.h \
+    graphitems/OSSDecimatedSeries.h \
     widgets/TreeItem.h \
     widgets/TreeModel.h \
     widgets/ExperimentPanel.h \
@@ -251,17 +279,29 @@ HEADERS += \
     CBTF-ArgoNavis-Ext/DataTransferDetails.h \
     CBTF-ArgoNavis-Ext/KernelExecutionDetails.h \
     widgets/ViewSortFilterProxyModel.h \
+    widgets/TraceSliceProxyModel.h \
+    widgets/TraceRowIndex.h \
     CBTF-ArgoNavis-Ext/ClusterNameBuilder.h \
     managers/CalltreeGraphManager.h \
+    managers/CalltreeGraphLayout.h \
+    managers/StackTraceTrie.h \
+    managers/FlameGraphData.h \
+    managers/RankEnvelopeData.h \
+    managers/QuantileSketch.h \
     widgets/CalltreeGraphView.h \
+    widgets/CalltreeGraphItems.h \
+    widgets/FlameGraphView.h \
     widgets/MetricViewManager.h \
     widgets/MetricViewDelegate.h \
     managers/ApplicationOverrideCursorManager.h \
+    managers/BoundedSignalChannel.h \
+    managers/AnalysisScheduler.h \
     widgets/ShowDeviceDetailsDialog.h \
     CBTF-ArgoNavis-Ext/NameValueDefines.h \
     CBTF-ArgoNavis-Ext/CudaDeviceHelper.h \
     widgets/ThreadSelectionCommand.h \
     managers/MetricTableViewInfo.h \
+    managers/ExperimentSnapshot.h \
     SourceView/SourceViewMetricsCache.h \
     graphitems/OSSHighlightItem.h \
     widgets/MetricViewFilterDialog.h \
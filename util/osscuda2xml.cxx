@@ -26,11 +26,16 @@
 #include <cxxabi.h>
 
 #include <set>
-#include <sstream>
 #include <stdexcept>
 #include <vector>
 
-#include <QTextStream>
+#include <QIODevice>
+#include <QByteArray>
+#include <QList>
+#include <QScopedPointer>
+#include <QFuture>
+#include <QThreadPool>
+#include <QtConcurrentRun>
 
 #include <ArgoNavis/Base/StackTrace.hpp>
 #include <ArgoNavis/Base/Time.hpp>
@@ -50,6 +55,22 @@ using namespace OpenSpeedShop::Framework;
 using namespace OpenSpeedShop::Queries;
 
 
+/**
+ * The output formats produced by the CUDA performance data exporter.
+ */
+typedef enum {
+    CUDA_EXPORT_XML,        // XML document
+    CUDA_EXPORT_NDJSON      // newline-delimited JSON - one self-describing record per line
+} CudaExportFormat;
+
+/**
+ * The version of the CUDA performance data export layout.  Version 1 (no version attribute) had the counters, devices and call
+ * sites as children of the document element; since version 2 these are written inside each <DataSet> with ids local to the data set.
+ * Readers should check the "version" attribute of the <CUDA> element (or the "version" member of the NDJSON "time" record).
+ */
+static const int CUDA_EXPORT_VERSION = 2;
+
+
 /**
  * @brief demangle
  * @param mangled
@@ -62,7 +83,7 @@ std::string demangle(const std::string& mangled)
 
     int status = -2;
     char* tmp = abi::__cxa_demangle(mangled.c_str(), NULL, NULL, &status);
-    
+
     if (tmp != NULL) {
         if (status == 0) {
             demangled = std::string(tmp);
@@ -73,100 +94,513 @@ std::string demangle(const std::string& mangled)
     return demangled;
 }
 
+
+namespace {
+
 /**
- * @brief text
- * @param tag
+ * @brief xmlEscape
  * @param value
  * @return
- * Create an XML element containing a text value.
+ * Escape the XML markup characters of a text value.
  */
-template <typename T>
-QString text(const std::string& tag, const T& value)
+QByteArray xmlEscape(const std::string& value)
 {
-    std::stringstream stream;
-    stream << "  <" << tag << ">" << value << "</" << tag << ">" << std::endl;
-    return QString::fromStdString( stream.str() );
+    QByteArray escaped;
+    escaped.reserve( value.size() );
+
+    for ( std::string::const_iterator i = value.begin(); i != value.end(); ++i ) {
+        switch ( *i ) {
+        case '<': escaped.append( "&lt;" ); break;
+        case '>': escaped.append( "&gt;" ); break;
+        case '&': escaped.append( "&amp;" ); break;
+        case '"': escaped.append( "&quot;" ); break;
+        default: escaped.append( *i );
+        }
+    }
+
+    return escaped;
 }
 
 /**
- * @brief xyz
- * @param tag
+ * @brief jsonString
  * @param value
  * @return
- * Create a XML element with x, y, and z attributes from a Vector3u value.
+ * Create a quoted JSON string from a text value.
  */
-QString xyz(const std::string& tag, const CUDA::Vector3u& value)
+QByteArray jsonString(const std::string& value)
 {
-    std::stringstream stream;
-    stream << "  <" << tag
-           << " x=\"" << value.get<0>() << "\""
-           << " y=\"" << value.get<1>() << "\""
-           << " z=\"" << value.get<2>() << "\""
-           << "/>" << std::endl;
-    return QString::fromStdString( stream.str() );
+    static const char hex[] = "0123456789abcdef";
+
+    QByteArray quoted;
+    quoted.reserve( value.size() + 2 );
+    quoted.append( '"' );
+
+    for ( std::string::const_iterator i = value.begin(); i != value.end(); ++i ) {
+        const unsigned char c = *i;
+        switch ( c ) {
+        case '"': quoted.append( "\\\"" ); break;
+        case '\\': quoted.append( "\\\\" ); break;
+        case '\n': quoted.append( "\\n" ); break;
+        case '\r': quoted.append( "\\r" ); break;
+        case '\t': quoted.append( "\\t" ); break;
+        default:
+            if ( c < 0x20 ) {
+                quoted.append( "\\u00" );
+                quoted.append( hex[ c >> 4 ] );
+                quoted.append( hex[ c & 0xf ] );
+            }
+            else {
+                quoted.append( c );
+            }
+        }
+    }
+
+    quoted.append( '"' );
+
+    return quoted;
 }
 
+
 /**
- * @brief convert_counters
- * @param data
- * @param xml
- * Convert counters into XML and output them to a stream.
+ * @brief The RecordWriter class
+ *
+ * Appends the records of the CUDA performance data export to a buffer.  The XML and NDJSON formats implement this interface,
+ * so the data set conversion below is independent of the output format.  A data set contains the counters, devices and call sites
+ * referenced by its events; the ids of these are local to the data set.
  */
-void convert_counters(const CUDA::PerformanceData& data, QTextStream& xml)
+class RecordWriter
 {
-    xml << endl;
-    for ( std::vector<std::string>::size_type i = 0; i < data.counters().size(); ++i ) {
-        xml << "<Counter id=\"" << i << "\">"
-#ifdef HAS_METRIC_TYPES
-            << QString::fromStdString( data.counters()[i].name )
-#else
-            << QString::fromStdString( data.counters()[i] )
-#endif
-            << "</Counter>\n";
+public:
+
+    explicit RecordWriter(QByteArray& buffer) : m_out( buffer ) { }
+    virtual ~RecordWriter() { }
+
+    virtual void beginDocument(const Base::TimeInterval& interval) = 0;
+    virtual void endDocument() = 0;
+
+    virtual void beginDataSet(quint32 dataset, const Base::ThreadName& thread) = 0;
+    virtual void endDataSet() = 0;
+
+    virtual void counter(std::size_t id, const std::string& name) = 0;
+    virtual void device(std::size_t id, const CUDA::Device& device) = 0;
+    virtual void callSite(std::size_t id, const StackTrace* trace, const Base::StackTrace& addresses) = 0;
+    virtual void dataTransfer(const Base::Time& time_origin, const CUDA::DataTransfer& details) = 0;
+    virtual void kernelExecution(const Base::Time& time_origin, const CUDA::KernelExecution& details) = 0;
+    virtual void periodicSample(const Base::Time& time_origin, const Base::Time& time, const std::vector<uint64_t>& counts) = 0;
+
+protected:
+
+    QByteArray& m_out;
+
+};
+
+
+/**
+ * @brief The XmlRecordWriter class
+ *
+ * Writes the CUDA performance data export as an XML document.
+ */
+class XmlRecordWriter : public RecordWriter
+{
+public:
+
+    explicit XmlRecordWriter(QByteArray& buffer) : RecordWriter( buffer ) { }
+
+    void beginDocument(const Base::TimeInterval& interval)
+    {
+        m_out.append( "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n" );
+        m_out.append( "<CUDA version=\"" ).append( QByteArray::number( CUDA_EXPORT_VERSION ) ).append( "\">\n" );
+        m_out.append( "\n<Time>\n" );
+        text( "Origin", static_cast<uint64_t>(interval.begin()) );
+        text( "Duration", static_cast<uint64_t>(interval.end() - interval.begin()) );
+        m_out.append( "</Time>\n" );
     }
-}
+
+    void endDocument()
+    {
+        m_out.append( "\n</CUDA>\n" );
+    }
+
+    void beginDataSet(quint32 /*dataset*/, const Base::ThreadName& thread)
+    {
+        m_out.append( "\n<DataSet>\n" );
+        m_out.append( "\n<Thread>\n" );
+        text( "Host", thread.host() );
+        text( "ProcessId", static_cast<int64_t>(thread.pid()) );
+        if ( thread.tid() )
+            text( "PosixThreadId", static_cast<uint64_t>(*thread.tid()) );
+        if ( thread.mpi_rank() )
+            text( "MPIRank", static_cast<int64_t>(*thread.mpi_rank()) );
+        if ( thread.omp_rank() )
+            text( "OpenMPThreadId", static_cast<int64_t>(*thread.omp_rank()) );
+        m_out.append( "</Thread>\n" );
+    }
+
+    void endDataSet()
+    {
+        m_out.append( "\n</DataSet>\n" );
+    }
+
+    void counter(std::size_t id, const std::string& name)
+    {
+        m_out.append( "<Counter id=\"" ).append( QByteArray::number( quint64( id ) ) ).append( "\">" );
+        m_out.append( xmlEscape( name ) );
+        m_out.append( "</Counter>\n" );
+    }
+
+    void device(std::size_t id, const CUDA::Device& device)
+    {
+        m_out.append( "\n<Device id=\"" ).append( QByteArray::number( quint64( id ) ) ).append( "\">\n" );
+        text( "Name", device.name );
+        m_out.append( "  <ComputeCapability major=\"" ).append( QByteArray::number( device.compute_capability.get<0>() ) )
+             .append( "\" minor=\"" ).append( QByteArray::number( device.compute_capability.get<1>() ) ).append( "\"/>\n" );
+        xyz( "MaxGrid", device.max_grid );
+        xyz( "MaxBlock", device.max_block );
+        text( "GlobalMemoryBandwidth", static_cast<uint64_t>(1024ULL * device.global_memory_bandwidth) );
+        text( "GlobalMemorySize", static_cast<uint64_t>(device.global_memory_size) );
+        text( "ConstantMemorySize", static_cast<uint64_t>(device.constant_memory_size) );
+        text( "L2CacheSize", static_cast<uint64_t>(device.l2_cache_size) );
+        text( "ThreadsPerWarp", static_cast<uint64_t>(device.threads_per_warp) );
+        text( "CoreClockRate", static_cast<uint64_t>(1024ULL * device.core_clock_rate) );
+        text( "MemcpyEngines", static_cast<uint64_t>(device.memcpy_engines) );
+        text( "Multiprocessors", static_cast<uint64_t>(device.multiprocessors) );
+        text( "MaxIPC", static_cast<uint64_t>(device.max_ipc) );
+        text( "MaxWarpsPerMultiprocessor", static_cast<uint64_t>(device.max_warps_per_multiprocessor) );
+        text( "MaxBlocksPerMultiprocessor", static_cast<uint64_t>(device.max_blocks_per_multiprocessor) );
+        text( "MaxRegistersPerBlock", static_cast<uint64_t>(device.max_registers_per_block) );
+        text( "MaxSharedMemoryPerBlock", static_cast<uint64_t>(device.max_shared_memory_per_block) );
+        text( "MaxThreadsPerBlock", static_cast<uint64_t>(device.max_threads_per_block) );
+        m_out.append( "</Device>\n" );
+    }
+
+    void callSite(std::size_t id, const StackTrace* trace, const Base::StackTrace& addresses)
+    {
+        m_out.append( "\n<CallSite id=\"" ).append( QByteArray::number( quint64( id ) ) ).append( "\">\n" );
+
+        if ( trace ) {
+            for ( StackTrace::size_type j = 0; j < trace->size(); ++j ) {
+                m_out.append( "  <Frame>\n" );
+                m_out.append( "    " );
+                text( "Address", static_cast<uint64_t>((*trace)[j].getValue()) );
+
+                std::pair<bool, LinkedObject> linked_object = trace->getLinkedObjectAt(j);
+                if ( linked_object.first ) {
+                    m_out.append( "    " );
+                    text( "LinkedObject", linked_object.second.getPath() );
+                }
+
+                std::pair<bool, Function> function = trace->getFunctionAt(j);
+                if ( function.first ) {
+                    m_out.append( "    " );
+                    text( "Function", function.second.getDemangledName() );
+                }
+
+                std::set<Statement> statements = trace->getStatementsAt(j);
+                for ( std::set<Statement>::const_iterator k = statements.begin(); k != statements.end(); ++k ) {
+                    m_out.append( "    " );
+                    text( "Statement", std::string( k->getPath() ) + ", " + std::to_string( k->getLine() ) );
+                }
+
+                m_out.append( "  </Frame>\n" );
+            }
+        }
+        else {
+            for ( Base::StackTrace::const_iterator j = addresses.begin(); j != addresses.end(); ++j ) {
+                m_out.append( "  <Frame>\n" );
+                m_out.append( "    <Address>" ).append( QByteArray::number( quint64( Address(*j).getValue() ) ) ).append( "</Address>\n" );
+                m_out.append( "  </Frame>\n" );
+            }
+        }
+
+        m_out.append( "</CallSite>\n" );
+    }
+
+    void dataTransfer(const Base::Time& time_origin, const CUDA::DataTransfer& details)
+    {
+        m_out.append( "\n<DataTransfer call_site=\"" ).append( QByteArray::number( quint64( details.call_site ) ) )
+             .append( "\" device=\"" ).append( QByteArray::number( quint64( details.device ) ) ).append( "\">\n" );
+        text( "Time", static_cast<uint64_t>(details.time - time_origin) );
+        text( "TimeBegin", static_cast<uint64_t>(details.time_begin - time_origin) );
+        text( "TimeEnd", static_cast<uint64_t>(details.time_end - time_origin) );
+        text( "Size", static_cast<uint64_t>(details.size) );
+        text( "Kind", CUDA::stringify(details.kind) );
+        text( "SourceKind", CUDA::stringify(details.source_kind) );
+        text( "DestinationKind", CUDA::stringify(details.destination_kind) );
+        text( "Asynchronous", std::string( details.asynchronous ? "true" : "false" ) );
+        m_out.append( "</DataTransfer>\n" );
+    }
+
+    void kernelExecution(const Base::Time& time_origin, const CUDA::KernelExecution& details)
+    {
+        m_out.append( "\n<KernelExecution call_site=\"" ).append( QByteArray::number( quint64( details.call_site ) ) )
+             .append( "\" device=\"" ).append( QByteArray::number( quint64( details.device ) ) ).append( "\">\n" );
+        text( "Time", static_cast<uint64_t>(details.time - time_origin) );
+        text( "TimeBegin", static_cast<uint64_t>(details.time_begin - time_origin) );
+        text( "TimeEnd", static_cast<uint64_t>(details.time_end - time_origin) );
+        text( "Function", demangle(details.function) );
+        xyz( "Grid", details.grid );
+        xyz( "Block", details.block );
+        text( "CachePreference", CUDA::stringify(details.cache_preference) );
+        text( "RegistersPerThread", static_cast<uint64_t>(details.registers_per_thread) );
+        text( "StaticSharedMemory", static_cast<uint64_t>(details.static_shared_memory) );
+        text( "DynamicSharedMemory", static_cast<uint64_t>(details.dynamic_shared_memory) );
+        text( "LocalMemory", static_cast<uint64_t>(details.local_memory) );
+        m_out.append( "</KernelExecution>\n" );
+    }
+
+    void periodicSample(const Base::Time& time_origin, const Base::Time& time, const std::vector<uint64_t>& counts)
+    {
+        m_out.append( "<Sample>\n" );
+        text( "Time", static_cast<uint64_t>(time - time_origin) );
+        for ( std::vector<uint64_t>::size_type i = 0; i < counts.size(); ++i ) {
+            m_out.append( "  <Count counter=\"" ).append( QByteArray::number( quint64( i ) ) ).append( "\">" )
+                 .append( QByteArray::number( quint64( counts[i] ) ) ).append( "</Count>\n" );
+        }
+        m_out.append( "</Sample>\n" );
+    }
+
+private:
+
+    // Append an XML element containing a text value.
+    void text(const char* tag, const std::string& value)
+    {
+        m_out.append( "  <" ).append( tag ).append( '>' ).append( xmlEscape( value ) ).append( "</" ).append( tag ).append( ">\n" );
+    }
+
+    void text(const char* tag, uint64_t value)
+    {
+        m_out.append( "  <" ).append( tag ).append( '>' ).append( QByteArray::number( quint64( value ) ) ).append( "</" ).append( tag ).append( ">\n" );
+    }
+
+    void text(const char* tag, int64_t value)
+    {
+        m_out.append( "  <" ).append( tag ).append( '>' ).append( QByteArray::number( qint64( value ) ) ).append( "</" ).append( tag ).append( ">\n" );
+    }
+
+    // Append a XML element with x, y, and z attributes from a Vector3u value.
+    void xyz(const char* tag, const CUDA::Vector3u& value)
+    {
+        m_out.append( "  <" ).append( tag )
+             .append( " x=\"" ).append( QByteArray::number( value.get<0>() ) ).append( '"' )
+             .append( " y=\"" ).append( QByteArray::number( value.get<1>() ) ).append( '"' )
+             .append( " z=\"" ).append( QByteArray::number( value.get<2>() ) ).append( '"' )
+             .append( "/>\n" );
+    }
+
+};
+
 
 /**
- * @brief convert_devices
- * @param data
- * @param xml
- * Convert devices into XML and output them to a stream.
+ * @brief The JsonRecordWriter class
+ *
+ * Writes the CUDA performance data export as newline-delimited JSON.  Every record is a single line JSON object having a "type"
+ * member; records of a data set carry the "dataset" member so the lines can be processed independently.
  */
-void convert_devices(const CUDA::PerformanceData& data, QTextStream& xml)
+class JsonRecordWriter : public RecordWriter
 {
-    for ( std::vector<CUDA::Device>::size_type i = 0; i < data.devices().size(); ++i ) {
-        const CUDA::Device& device = data.devices()[i];
-        
-        xml << endl << "<Device id=\"" << i << "\">" << endl;
-        xml << text("Name", device.name);
-        xml << "  <ComputeCapability"
-            << " major=\"" << device.compute_capability.get<0>() << "\""
-            << " minor=\"" << device.compute_capability.get<1>() << "\""
-            << "/>" << endl;
-        xml << xyz("MaxGrid", device.max_grid);
-        xml << xyz("MaxBlock", device.max_block);
-        xml << text("GlobalMemoryBandwidth",
-                    1024ULL * device.global_memory_bandwidth);
-        xml << text("GlobalMemorySize", device.global_memory_size);
-        xml << text("ConstantMemorySize", device.constant_memory_size);
-        xml << text("L2CacheSize", device.l2_cache_size);
-        xml << text("ThreadsPerWarp", device.threads_per_warp);
-        xml << text("CoreClockRate", 1024ULL * device.core_clock_rate);
-        xml << text("MemcpyEngines", device.memcpy_engines);
-        xml << text("Multiprocessors", device.multiprocessors);
-        xml << text("MaxIPC", device.max_ipc);
-        xml << text("MaxWarpsPerMultiprocessor",
-                    device.max_warps_per_multiprocessor);
-        xml << text("MaxBlocksPerMultiprocessor",
-                    device.max_blocks_per_multiprocessor);
-        xml << text("MaxRegistersPerBlock", device.max_registers_per_block);
-        xml << text("MaxSharedMemoryPerBlock",
-                    device.max_shared_memory_per_block);
-        xml << text("MaxThreadsPerBlock", device.max_threads_per_block);
-        xml << "</Device>" << endl;
+public:
+
+    explicit JsonRecordWriter(QByteArray& buffer) : RecordWriter( buffer ), m_dataset( 0 ) { }
+
+    void beginDocument(const Base::TimeInterval& interval)
+    {
+        m_out.append( "{\"type\":\"time\",\"version\":" ).append( QByteArray::number( CUDA_EXPORT_VERSION ) )
+             .append( ",\"origin\":" ).append( QByteArray::number( quint64( static_cast<uint64_t>(interval.begin()) ) ) )
+             .append( ",\"duration\":" ).append( QByteArray::number( quint64( static_cast<uint64_t>(interval.end() - interval.begin()) ) ) )
+             .append( "}\n" );
+    }
+
+    void endDocument() { }
+
+    void beginDataSet(quint32 dataset, const Base::ThreadName& thread)
+    {
+        m_dataset = dataset;
+        begin( "thread" );
+        m_out.append( ",\"host\":" ).append( jsonString( thread.host() ) );
+        m_out.append( ",\"pid\":" ).append( QByteArray::number( qint64( thread.pid() ) ) );
+        if ( thread.tid() )
+            m_out.append( ",\"posix_tid\":" ).append( QByteArray::number( quint64( *thread.tid() ) ) );
+        if ( thread.mpi_rank() )
+            m_out.append( ",\"mpi_rank\":" ).append( QByteArray::number( qint64( *thread.mpi_rank() ) ) );
+        if ( thread.omp_rank() )
+            m_out.append( ",\"omp_tid\":" ).append( QByteArray::number( qint64( *thread.omp_rank() ) ) );
+        m_out.append( "}\n" );
+    }
+
+    void endDataSet() { }
+
+    void counter(std::size_t id, const std::string& name)
+    {
+        begin( "counter" );
+        m_out.append( ",\"id\":" ).append( QByteArray::number( quint64( id ) ) );
+        m_out.append( ",\"name\":" ).append( jsonString( name ) );
+        m_out.append( "}\n" );
+    }
+
+    void device(std::size_t id, const CUDA::Device& device)
+    {
+        begin( "device" );
+        m_out.append( ",\"id\":" ).append( QByteArray::number( quint64( id ) ) );
+        m_out.append( ",\"name\":" ).append( jsonString( device.name ) );
+        m_out.append( ",\"compute_capability\":[" ).append( QByteArray::number( device.compute_capability.get<0>() ) )
+             .append( ',' ).append( QByteArray::number( device.compute_capability.get<1>() ) ).append( ']' );
+        xyz( "max_grid", device.max_grid );
+        xyz( "max_block", device.max_block );
+        number( "global_memory_bandwidth", 1024ULL * device.global_memory_bandwidth );
+        number( "global_memory_size", device.global_memory_size );
+        number( "constant_memory_size", device.constant_memory_size );
+        number( "l2_cache_size", device.l2_cache_size );
+        number( "threads_per_warp", device.threads_per_warp );
+        number( "core_clock_rate", 1024ULL * device.core_clock_rate );
+        number( "memcpy_engines", device.memcpy_engines );
+        number( "multiprocessors", device.multiprocessors );
+        number( "max_ipc", device.max_ipc );
+        number( "max_warps_per_multiprocessor", device.max_warps_per_multiprocessor );
+        number( "max_blocks_per_multiprocessor", device.max_blocks_per_multiprocessor );
+        number( "max_registers_per_block", device.max_registers_per_block );
+        number( "max_shared_memory_per_block", device.max_shared_memory_per_block );
+        number( "max_threads_per_block", device.max_threads_per_block );
+        m_out.append( "}\n" );
+    }
+
+    void callSite(std::size_t id, const StackTrace* trace, const Base::StackTrace& addresses)
+    {
+        begin( "call_site" );
+        m_out.append( ",\"id\":" ).append( QByteArray::number( quint64( id ) ) );
+        m_out.append( ",\"frames\":[" );
+
+        if ( trace ) {
+            for ( StackTrace::size_type j = 0; j < trace->size(); ++j ) {
+                if ( j > 0 )
+                    m_out.append( ',' );
+                m_out.append( "{\"address\":" ).append( QByteArray::number( quint64( (*trace)[j].getValue() ) ) );
+
+                std::pair<bool, LinkedObject> linked_object = trace->getLinkedObjectAt(j);
+                if ( linked_object.first )
+                    m_out.append( ",\"linked_object\":" ).append( jsonString( linked_object.second.getPath() ) );
+
+                std::pair<bool, Function> function = trace->getFunctionAt(j);
+                if ( function.first )
+                    m_out.append( ",\"function\":" ).append( jsonString( function.second.getDemangledName() ) );
+
+                std::set<Statement> statements = trace->getStatementsAt(j);
+                if ( ! statements.empty() ) {
+                    m_out.append( ",\"statements\":[" );
+                    for ( std::set<Statement>::const_iterator k = statements.begin(); k != statements.end(); ++k ) {
+                        if ( k != statements.begin() )
+                            m_out.append( ',' );
+                        m_out.append( "{\"path\":" ).append( jsonString( k->getPath() ) )
+                             .append( ",\"line\":" ).append( QByteArray::number( k->getLine() ) ).append( '}' );
+                    }
+                    m_out.append( ']' );
+                }
+
+                m_out.append( '}' );
+            }
+        }
+        else {
+            for ( Base::StackTrace::const_iterator j = addresses.begin(); j != addresses.end(); ++j ) {
+                if ( j != addresses.begin() )
+                    m_out.append( ',' );
+                m_out.append( "{\"address\":" ).append( QByteArray::number( quint64( Address(*j).getValue() ) ) ).append( '}' );
+            }
+        }
+
+        m_out.append( "]}\n" );
+    }
+
+    void dataTransfer(const Base::Time& time_origin, const CUDA::DataTransfer& details)
+    {
+        begin( "data_transfer" );
+        number( "call_site", details.call_site );
+        number( "device", details.device );
+        number( "time", static_cast<uint64_t>(details.time - time_origin) );
+        number( "time_begin", static_cast<uint64_t>(details.time_begin - time_origin) );
+        number( "time_end", static_cast<uint64_t>(details.time_end - time_origin) );
+        number( "size", details.size );
+        m_out.append( ",\"kind\":" ).append( jsonString( CUDA::stringify(details.kind) ) );
+        m_out.append( ",\"source_kind\":" ).append( jsonString( CUDA::stringify(details.source_kind) ) );
+        m_out.append( ",\"destination_kind\":" ).append( jsonString( CUDA::stringify(details.destination_kind) ) );
+        m_out.append( ",\"asynchronous\":" ).append( details.asynchronous ? "true" : "false" );
+        m_out.append( "}\n" );
     }
+
+    void kernelExecution(const Base::Time& time_origin, const CUDA::KernelExecution& details)
+    {
+        begin( "kernel_execution" );
+        number( "call_site", details.call_site );
+        number( "device", details.device );
+        number( "time", static_cast<uint64_t>(details.time - time_origin) );
+        number( "time_begin", static_cast<uint64_t>(details.time_begin - time_origin) );
+        number( "time_end", static_cast<uint64_t>(details.time_end - time_origin) );
+        m_out.append( ",\"function\":" ).append( jsonString( demangle(details.function) ) );
+        xyz( "grid", details.grid );
+        xyz( "block", details.block );
+        m_out.append( ",\"cache_preference\":" ).append( jsonString( CUDA::stringify(details.cache_preference) ) );
+        number( "registers_per_thread", details.registers_per_thread );
+        number( "static_shared_memory", details.static_shared_memory );
+        number( "dynamic_shared_memory", details.dynamic_shared_memory );
+        number( "local_memory", details.local_memory );
+        m_out.append( "}\n" );
+    }
+
+    void periodicSample(const Base::Time& time_origin, const Base::Time& time, const std::vector<uint64_t>& counts)
+    {
+        begin( "sample" );
+        number( "time", static_cast<uint64_t>(time - time_origin) );
+        m_out.append( ",\"counts\":[" );
+        for ( std::vector<uint64_t>::size_type i = 0; i < counts.size(); ++i ) {
+            if ( i > 0 )
+                m_out.append( ',' );
+            m_out.append( QByteArray::number( quint64( counts[i] ) ) );
+        }
+        m_out.append( "]}\n" );
+    }
+
+private:
+
+    // Start a data set record of the specified type.
+    void begin(const char* type)
+    {
+        m_out.append( "{\"type\":\"" ).append( type ).append( "\",\"dataset\":" ).append( QByteArray::number( m_dataset ) );
+    }
+
+    void number(const char* name, uint64_t value)
+    {
+        m_out.append( ",\"" ).append( name ).append( "\":" ).append( QByteArray::number( quint64( value ) ) );
+    }
+
+    void xyz(const char* name, const CUDA::Vector3u& value)
+    {
+        m_out.append( ",\"" ).append( name ).append( "\":[" )
+             .append( QByteArray::number( value.get<0>() ) ).append( ',' )
+             .append( QByteArray::number( value.get<1>() ) ).append( ',' )
+             .append( QByteArray::number( value.get<2>() ) ).append( ']' );
+    }
+
+    quint32 m_dataset;
+
+};
+
+
+/**
+ * @brief createRecordWriter
+ * @param format
+ * @param buffer
+ * @return
+ * Create the record writer for the requested output format.
+ */
+RecordWriter* createRecordWriter(CudaExportFormat format, QByteArray& buffer)
+{
+    if ( CUDA_EXPORT_NDJSON == format )
+        return new JsonRecordWriter( buffer );
+
+    return new XmlRecordWriter( buffer );
 }
 
+} // anonymous namespace
+
+
 /**
  * @brief convert_sites_in_event
  * @param data
@@ -185,120 +619,55 @@ bool convert_sites_in_event(const CUDA::PerformanceData& data,
                             size_t& sites_found)
 {
     size_t n = details.call_site;
-    
+
     if (!sites[n]) {
         sites[n].reset(new StackTrace(thread, Time(details.time)));
-        
+
         for ( Base::StackTrace::const_iterator
                  i = data.sites()[n].begin(); i != data.sites()[n].end(); ++i ) {
             sites[n]->push_back(Address(*i));
         }
-        
+
         sites_found++;
     }
-    
+
     return sites_found < data.sites().size();
 }
 
 /**
- * @brief convert_sites_in_thread
+ * @brief convert_sites
  * @param data
- * @param threads
  * @param thread
- * @param sites
- * @param sites_found
- * @return
- * Convert call sites into Open|SpeedShop Framework StackTrace objects.
+ * @param name
+ * @param writer
+ * Convert the call sites of a data set into Open|SpeedShop Framework StackTrace objects and output them.
  */
-bool convert_sites_in_thread(const CUDA::PerformanceData& data,
-                             const std::map<Base::ThreadName, Thread>& threads,
-                             const Base::ThreadName& thread,
-                             std::vector<std::shared_ptr<StackTrace> >& sites,
-                             size_t& sites_found)
+void convert_sites(const CUDA::PerformanceData& data,
+                   const Thread& thread,
+                   const Base::ThreadName& name,
+                   RecordWriter& writer)
 {
+    std::vector<std::shared_ptr<StackTrace> > sites(data.sites().size());
+    size_t sites_found = 0;
+
     data.visitDataTransfers(
-        thread, data.interval(),
+        name, data.interval(),
         boost::bind(&convert_sites_in_event<CUDA::DataTransfer>,
-             boost::cref(data), boost::cref(threads.find(thread)->second), _1,
+             boost::cref(data), boost::cref(thread), _1,
              boost::ref(sites), boost::ref(sites_found))
         );
-    
-    if ( sites_found == data.sites().size() ) {
-        return false;
+
+    if ( sites_found < data.sites().size() ) {
+        data.visitKernelExecutions(
+            name, data.interval(),
+            boost::bind(&convert_sites_in_event<CUDA::KernelExecution>,
+                 boost::cref(data), boost::cref(thread), _1,
+                 boost::ref(sites), boost::ref(sites_found))
+            );
     }
-    
-    data.visitKernelExecutions(
-        thread, data.interval(),
-        boost::bind(&convert_sites_in_event<CUDA::KernelExecution>,
-             boost::cref(data), boost::cref(threads.find(thread)->second), _1,
-             boost::ref(sites), boost::ref(sites_found))
-        );
-    
-    return sites_found < data.sites().size();
-}
 
-/**
- * @brief convert_sites
- * @param data
- * @param threads
- * @param xml
- * Convert call sites into XML and output them to a stream.
- */
-void convert_sites(const CUDA::PerformanceData& data, 
-                   const std::map<Base::ThreadName, Thread>& threads,
-                   QTextStream& xml)
-{
-    std::vector<std::shared_ptr<StackTrace> > sites(data.sites().size());
-    size_t sites_found = 0;
-    
-    data.visitThreads(
-        boost::bind(&convert_sites_in_thread,
-             boost::cref(data), boost::cref(threads), _1, boost::ref(sites), boost::ref(sites_found))
-        );
-    
     for (size_t i = 0; i < sites.size(); ++i) {
-        xml << endl << "<CallSite id=\"" << i << "\">" << endl;
-
-        if (sites[i]) {
-            const StackTrace& trace = *sites[i];
-            
-            for (StackTrace::size_type j = 0; j < trace.size(); ++j) {
-                xml << "  <Frame>" << endl;
-                xml << "    " << text("Address", trace[j]);
-                
-                std::pair<bool, LinkedObject> linked_object =
-                    trace.getLinkedObjectAt(j);
-                if (linked_object.first) {
-                    xml << "    " << text("LinkedObject", linked_object.second.getPath());
-                }
-                
-                std::pair<bool, Function> function = trace.getFunctionAt(j);
-                if (function.first) {
-                    xml << "    " << text("Function", function.second.getDemangledName());
-                }
-                
-                std::set<Statement> statements = trace.getStatementsAt(j);
-                for (std::set<Statement>::const_iterator
-                         k = statements.begin(); k != statements.end(); ++k) {
-                    std::stringstream str;
-                    str << k->getPath() << ", " << k->getLine();
-                    xml << "    " << text("Statement", str.str());
-                }
-                
-                xml << "  </Frame>" << endl;
-            }
-        }
-        else {
-            const Base::StackTrace& trace = data.sites()[i];
-            
-            for (StackTrace::size_type j = 0; j < trace.size(); ++j) {
-                xml << "  <Frame>" << endl;
-                xml << "    <Address>" << trace[j] << "</Address>" << endl;
-                xml << "  </Frame>" << endl;
-            }
-        }
-
-        xml << "</CallSite>" << endl;
+        writer.callSite( i, sites[i].get(), data.sites()[i] );
     }
 }
 
@@ -306,30 +675,15 @@ void convert_sites(const CUDA::PerformanceData& data,
  * @brief convert_data_transfer
  * @param time_origin
  * @param details
- * @param xml
+ * @param writer
  * @return
- * Convert a data transfer into XML and output it to a stream.
+ * Convert a data transfer and output it.
  */
 bool convert_data_transfer(const Base::Time& time_origin,
                            const CUDA::DataTransfer& details,
-                           QTextStream& xml)
+                           RecordWriter& writer)
 {
-    xml << endl << "<DataTransfer"
-        << " call_site=\"" << details.call_site << "\""
-        << " device=\"" << details.device << "\""
-        ">" << endl;
-    xml << text("Time",
-                static_cast<uint64_t>(details.time - time_origin));
-    xml << text("TimeBegin",
-                static_cast<uint64_t>(details.time_begin - time_origin));
-    xml << text("TimeEnd",
-                static_cast<uint64_t>(details.time_end - time_origin));
-    xml << text("Size", details.size);
-    xml << text("Kind", CUDA::stringify(details.kind));
-    xml << text("SourceKind", CUDA::stringify(details.source_kind));
-    xml << text("DestinationKind", CUDA::stringify(details.destination_kind));
-    xml << text("Asynchronous", (details.asynchronous ? "true" : "false"));
-    xml << "</DataTransfer>" << endl;
+    writer.dataTransfer( time_origin, details );
 
     return true; // Always continue the visitation
 }
@@ -338,33 +692,15 @@ bool convert_data_transfer(const Base::Time& time_origin,
  * @brief convert_kernel_execution
  * @param time_origin
  * @param details
- * @param xml
+ * @param writer
  * @return
- * Convert a kernel execution into XML and output it to a stream.
+ * Convert a kernel execution and output it.
  */
 bool convert_kernel_execution(const Base::Time& time_origin,
                               const CUDA::KernelExecution& details,
-                              QTextStream& xml)
+                              RecordWriter& writer)
 {
-    xml << endl << "<KernelExecution"
-        << " call_site=\"" << details.call_site << "\""
-        << " device=\"" << details.device << "\""
-        ">" << endl;
-    xml << text("Time",
-                static_cast<uint64_t>(details.time - time_origin));
-    xml << text("TimeBegin",
-                static_cast<uint64_t>(details.time_begin - time_origin));
-    xml << text("TimeEnd",
-                static_cast<uint64_t>(details.time_end - time_origin));
-    xml << text("Function", demangle(details.function));
-    xml << xyz("Grid", details.grid);
-    xml << xyz("Block", details.block);
-    xml << text("CachePreference", CUDA::stringify(details.cache_preference));
-    xml << text("RegistersPerThread", details.registers_per_thread);
-    xml << text("StaticSharedMemory", details.static_shared_memory);
-    xml << text("DynamicSharedMemory", details.dynamic_shared_memory);
-    xml << text("LocalMemory", details.local_memory);
-    xml << "</KernelExecution>" << endl;
+    writer.kernelExecution( time_origin, details );
 
     return true; // Always continue the visitation
 }
@@ -374,103 +710,118 @@ bool convert_kernel_execution(const Base::Time& time_origin,
  * @param time_origin
  * @param time
  * @param counts
- * @param xml
+ * @param writer
  * @return
- * Convert a periodic sample into XML and output it to a stream.
+ * Convert a periodic sample and output it.
  */
 bool convert_periodic_sample(const Base::Time& time_origin,
                              const Base::Time& time,
                              const std::vector<uint64_t>& counts,
-                             QTextStream& xml)
+                             RecordWriter& writer)
 {
-    xml << "<Sample>" << endl;
-    xml << text("Time", static_cast<uint64_t>(time - time_origin));
-    for ( std::vector<uint64_t>::size_type i = 0; i < counts.size(); ++i ) {
-        xml << "  <Count counter=\"" << i << "\">"
-            << counts[i]
-            << "</Count>" << endl;
-    }
-    xml << "</Sample>" << endl;
+    writer.periodicSample( time_origin, time, counts );
 
     return true; // Always continue the visitation
 }
 
 /**
- * @brief convert_thread
+ * @brief has_thread
  * @param thread
- * @param xml
- * Convert a thread into XML and output it to a stream.
+ * @param found
+ * @return
+ * Note that the performance data contains a thread and stop the visitation.
  */
-void convert_thread(const Base::ThreadName& thread, QTextStream& xml)
+bool has_thread(const Base::ThreadName& /*thread*/, bool& found)
 {
-    xml << endl << "<Thread>" << endl;
-    xml << text("Host", thread.host());
-    xml << "  <ProcessId>" << thread.pid() << "</ProcessId>" << endl;
-
-    if ( thread.tid() ) {
-        xml << "  <PosixThreadId>" << *thread.tid() 
-            << "</PosixThreadId>" << endl;
-    }
+    found = true;
 
-    if ( thread.mpi_rank() ) {
-        xml << "  <MPIRank>" << *thread.mpi_rank() << "</MPIRank>" << endl;
-    }
-    
-    if ( thread.omp_rank() ) {
-        xml << "  <OpenMPThreadId>" << *thread.omp_rank()
-            << "</OpenMPThreadId>" << endl;
-    }
-    
-    xml << "</Thread>" << endl;
+    return false; // Stop the visitation
 }
 
 /**
  * @brief convert_performance_data
- * @param data
+ * @param collector
  * @param thread
- * @param xml
+ * @param dataset
+ * @param time_origin
+ * @param format
  * @return
- * Convert CUDA performance data into XML and output it to a stream.
+ * Load the CUDA performance data of a single thread and convert it into a data set.  Only the performance data of this thread
+ * is held in memory, and it is released as soon as the data set has been converted.  Safe to call concurrently for different threads.
  */
-bool convert_performance_data(const CUDA::PerformanceData& data,
-                              const Base::ThreadName& thread,
-                              QTextStream& xml)
+QByteArray convert_performance_data(const Collector& collector,
+                                    const Thread& thread,
+                                    quint32 dataset,
+                                    const Base::Time& time_origin,
+                                    CudaExportFormat format)
 {
-    xml << endl << "<DataSet>" << endl;
+    QByteArray buffer;
+
+    CUDA::PerformanceData data;
+    GetCUDAPerformanceData( collector, thread, data );
+
+    bool found( false );
+    data.visitThreads( boost::bind( &has_thread, _1, boost::ref(found) ) );
+
+    if ( ! found )
+        return buffer;
+
+    const Base::ThreadName name( ConvertToArgoNavis( thread ) );
+
+    QScopedPointer< RecordWriter > writer( createRecordWriter( format, buffer ) );
+
+    writer->beginDataSet( dataset, name );
 
-    convert_thread(thread, xml);
+    for ( std::vector<std::string>::size_type i = 0; i < data.counters().size(); ++i ) {
+#ifdef HAS_METRIC_TYPES
+        writer->counter( i, data.counters()[i].name );
+#else
+        writer->counter( i, data.counters()[i] );
+#endif
+    }
+
+    for ( std::vector<CUDA::Device>::size_type i = 0; i < data.devices().size(); ++i ) {
+        writer->device( i, data.devices()[i] );
+    }
+
+    convert_sites( data, thread, name, *writer );
 
     data.visitDataTransfers(
-        thread, data.interval(),
+        name, data.interval(),
         boost::bind(&convert_data_transfer,
-             boost::cref(data.interval().begin()), _1, boost::ref(xml))
+             boost::cref(time_origin), _1, boost::ref(*writer))
         );
 
     data.visitKernelExecutions(
-        thread, data.interval(),
+        name, data.interval(),
         boost::bind(&convert_kernel_execution,
-            boost::cref(data.interval().begin()), _1, boost::ref(xml))
+            boost::cref(time_origin), _1, boost::ref(*writer))
         );
 
     data.visitPeriodicSamples(
-        thread, data.interval(),
+        name, data.interval(),
         boost::bind(&convert_periodic_sample,
-             boost::cref(data.interval().begin()), _1, _2, boost::ref(xml))
+             boost::cref(time_origin), _1, _2, boost::ref(*writer))
         );
-    
-    xml << endl << "</DataSet>" << endl;
 
-    return true; // Always continue the visitation
+    writer->endDataSet();
+
+    return buffer;
 }
 
 /**
- * Parse the requested CUDA performance data to XML.
+ * Stream the requested CUDA performance data in the specified format.
  *
- * @param dbFilename  Filename path to xperiment database file with CUDA data collection (.openss file)
- * @param xml         Output stream to use to write XML dump of experiment file
+ * The data sets of the threads are converted concurrently on the global thread pool.  At most one data set per pool thread is
+ * pending at any time and the data sets are written in the experiment's thread order as they complete, so memory use is bounded by
+ * the largest per-thread data sets rather than the size of the experiment and the output is identical for every run.
+ *
+ * @param dbFilename  Filename path to experiment database file with CUDA data collection (.openss file)
+ * @param device      Output device to use to write the dump of the experiment file
+ * @param format      The output format
  * @return            Exit code. Either 1 if a failure occurred, or 0 otherwise.
  */
-int cuda2xml(const QString& dbFilename, QTextStream& xml)
+int cuda2stream(const QString& dbFilename, QIODevice& device, CudaExportFormat format)
 {
     Experiment experiment( dbFilename.toStdString() );
 
@@ -487,44 +838,75 @@ int cuda2xml(const QString& dbFilename, QTextStream& xml)
     if ( ! collector )
         return 1;
 
-    std::set<int> ranks;
+    const Base::TimeInterval interval( ConvertToArgoNavis( experiment.getPerformanceDataExtent().getTimeInterval() ) );
+    const Base::Time time_origin( interval.begin() );
 
-    xml << "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << endl;
-    xml << "<CUDA>" << endl;
+    {
+        QByteArray header;
+        QScopedPointer< RecordWriter > writer( createRecordWriter( format, header ) );
+        writer->beginDocument( interval );
+        if ( device.write( header ) != header.size() )
+            return 1;
+    }
 
-    CUDA::PerformanceData data;
-    std::map<Base::ThreadName, Thread> threads;
+    const int maxPending = qMax( 1, QThreadPool::globalInstance()->maxThreadCount() );
+
+    QList< QFuture<QByteArray> > pending;
+    bool ok( true );
 
     ThreadGroup all_threads = experiment.getThreads();
-    for ( ThreadGroup::const_iterator
-             i = all_threads.begin(); i != all_threads.end(); ++i ) {
-        std::pair<bool, int> rank = i->getMPIRank();
-        
-        if ( ranks.empty() ||
-             (rank.first && (ranks.find(rank.second) != ranks.end())) ) {
-            GetCUDAPerformanceData( *collector, *i, data );
-            threads.insert(std::make_pair( ConvertToArgoNavis(*i), *i) );
+
+    ThreadGroup::const_iterator next = all_threads.begin();
+    quint32 dataset( 0 );
+
+    while ( ok && ( next != all_threads.end() || ! pending.isEmpty() ) ) {
+        // keep the pool busy without letting completed data sets accumulate ahead of the writer
+        while ( next != all_threads.end() && pending.size() < maxPending ) {
+            pending << QtConcurrent::run( boost::bind( &convert_performance_data,
+                                                       boost::cref(*collector), *next, dataset++, boost::cref(time_origin), format ) );
+            ++next;
         }
+
+        const QByteArray buffer = pending.takeFirst().result();
+        if ( ! buffer.isEmpty() )
+            ok = ( device.write( buffer ) == buffer.size() );
+    }
+
+    // wait for conversions still running after a write failure before the experiment goes out of scope
+    foreach ( QFuture<QByteArray> future, pending ) {
+        future.waitForFinished();
     }
 
-    xml << endl << "<Time>" << endl;
-    xml << "  <Origin>"
-         << static_cast<uint64_t>(data.interval().begin())
-         << "</Origin>" << endl;
-    xml << "  <Duration>"
-         << static_cast<uint64_t>(data.interval().end() - data.interval().begin())
-         << "</Duration>" << endl;
-    xml << "</time>" << endl;
-    
-    convert_counters( data, xml );
-    convert_devices( data, xml );
-    convert_sites( data, threads, xml );
-    
-    data.visitThreads( boost::bind(
-        &convert_performance_data, boost::cref(data), _1, boost::ref(xml)
-        ) );
-    
-    xml << endl << "</CUDA>" << endl;
-    
-    return 0;
+    if ( ! ok )
+        return 1;
+
+    QByteArray footer;
+    QScopedPointer< RecordWriter > writer( createRecordWriter( format, footer ) );
+    writer->endDocument();
+
+    return ( device.write( footer ) == footer.size() ) ? 0 : 1;
+}
+
+/**
+ * Parse the requested CUDA performance data to XML.
+ *
+ * @param dbFilename  Filename path to xperiment database file with CUDA data collection (.openss file)
+ * @param xml         Output device to use to write XML dump of experiment file
+ * @return            Exit code. Either 1 if a failure occurred, or 0 otherwise.
+ */
+int cuda2xml(const QString& dbFilename, QIODevice& xml)
+{
+    return cuda2stream( dbFilename, xml, CUDA_EXPORT_XML );
+}
+
+/**
+ * Parse the requested CUDA performance data to newline-delimited JSON.
+ *
+ * @param dbFilename  Filename path to experiment database file with CUDA data collection (.openss file)
+ * @param json        Output device to use to write NDJSON dump of experiment file
+ * @return            Exit code. Either 1 if a failure occurred, or 0 otherwise.
+ */
+int cuda2ndjson(const QString& dbFilename, QIODevice& json)
+{
+    return cuda2stream( dbFilename, json, CUDA_EXPORT_NDJSON );
 }
@@ -0,0 +1,785 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2016 Argo Navis Technologies. All Rights Reserved.
+// Copyright (c) 2018 Schultz Software Solutions, LLC. All Rights Reserved.
+//
+// This library is free software; you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation, Inc.,
+// 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/optional.hpp>
+#include <boost/ref.hpp>
+
+#include <cxxabi.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <QString>
+
+#include <ArgoNavis/Base/StackTrace.hpp>
+#include <ArgoNavis/Base/Time.hpp>
+
+#include <ArgoNavis/CUDA/DataTransfer.hpp>
+#include <ArgoNavis/CUDA/KernelExecution.hpp>
+#include <ArgoNavis/CUDA/PerformanceData.hpp>
+#include <ArgoNavis/CUDA/stringify.hpp>
+
+#include "ToolAPI.hxx"
+#include "Queries.hxx"
+#include "CUDAQueries.hxx"
+
+#include "collectors/usertime/UserTimeDetail.hxx"
+#include "collectors/mpit/MPITDetail.hxx"
+#include "collectors/iot/IOTDetail.hxx"
+#include "collectors/mem/MemDetail.hxx"
+
+#include "managers/ExperimentSnapshot.h"
+#include "managers/AnalysisScheduler.h"
+
+using namespace ArgoNavis;
+using namespace OpenSpeedShop::Framework;
+using namespace OpenSpeedShop::Queries;
+
+using ArgoNavis::GUI::ExperimentSnapshot;
+using ArgoNavis::GUI::ExperimentSnapshotWriter;
+using ArgoNavis::GUI::AnalysisScheduler;
+
+
+namespace {
+
+/**
+ * @brief demangle_function_name
+ * @param mangled
+ * @return
+ * Demangle a C++ function name.
+ */
+std::string demangle_function_name(const std::string& mangled)
+{
+    std::string demangled = mangled;
+
+    int status = -2;
+    char* tmp = abi::__cxa_demangle(mangled.c_str(), NULL, NULL, &status);
+
+    if (tmp != NULL) {
+        if (status == 0) {
+            demangled = std::string(tmp);
+        }
+        free(tmp);
+    }
+
+    return demangled;
+}
+
+/**
+ * @brief snapshot_threads
+ * @param threads
+ * @param writer
+ * Add the thread columns to the snapshot.
+ */
+void snapshot_threads(const ThreadGroup& threads, ExperimentSnapshotWriter& writer)
+{
+    for ( ThreadGroup::const_iterator i = threads.begin(); i != threads.end(); ++i ) {
+        writer.append( ExperimentSnapshot::THREAD_HOST, writer.addString( i->getHost() ) );
+        writer.append( ExperimentSnapshot::THREAD_PROCESS_ID, qint64( i->getProcessId() ) );
+
+        std::pair<bool, pthread_t> tid = i->getPosixThreadId();
+        writer.append( ExperimentSnapshot::THREAD_POSIX_THREAD_ID, qint64( tid.first ? qint64( tid.second ) : -1 ) );
+
+        std::pair<bool, int> rank = i->getMPIRank();
+        writer.append( ExperimentSnapshot::THREAD_MPI_RANK, qint32( rank.first ? rank.second : -1 ) );
+
+        std::pair<bool, int> omp = i->getOpenMPThreadId();
+        writer.append( ExperimentSnapshot::THREAD_OPENMP_THREAD_ID, qint32( omp.first ? omp.second : -1 ) );
+    }
+}
+
+/**
+ * @brief snapshot_symbols
+ * @param threads
+ * @param functionIndex
+ * @param writer
+ * Add the linked object, function (with the defining locations) and statement columns to the snapshot.  Returns the function
+ * to function index map used by the metric, call site and stack trace columns.
+ */
+void snapshot_symbols(const ThreadGroup& threads,
+                      std::map<Function, quint32>& functionIndex,
+                      ExperimentSnapshotWriter& writer)
+{
+    std::map<LinkedObject, quint32> linkedObjectIndex;
+
+    const std::set<LinkedObject> linkedObjects( threads.getLinkedObjects() );
+    for ( std::set<LinkedObject>::const_iterator i = linkedObjects.begin(); i != linkedObjects.end(); ++i ) {
+        linkedObjectIndex.insert( std::make_pair( *i, quint32( linkedObjectIndex.size() ) ) );
+        writer.append( ExperimentSnapshot::LINKED_OBJECT_PATH, writer.addString( i->getPath() ) );
+    }
+
+    writer.appendRowOffset( ExperimentSnapshot::FUNCTION_DEFINITION_OFFSETS, ExperimentSnapshot::FUNCTION_DEFINITION_LINE );
+
+    const std::set<Function> functions( threads.getFunctions() );
+    for ( std::set<Function>::const_iterator i = functions.begin(); i != functions.end(); ++i ) {
+        functionIndex.insert( std::make_pair( *i, quint32( functionIndex.size() ) ) );
+        writer.append( ExperimentSnapshot::FUNCTION_NAME, writer.addString( i->getDemangledName() ) );
+
+        std::map<LinkedObject, quint32>::const_iterator lo = linkedObjectIndex.find( i->getLinkedObject() );
+        writer.append( ExperimentSnapshot::FUNCTION_LINKED_OBJECT, quint32( lo != linkedObjectIndex.end() ? lo->second : ExperimentSnapshot::NO_INDEX ) );
+
+        // the defining locations in the order shown by the metric views
+        const std::set<Statement> definitions( i->getDefinitions() );
+        for ( std::set<Statement>::const_iterator j = definitions.begin(); j != definitions.end(); ++j ) {
+            writer.append( ExperimentSnapshot::FUNCTION_DEFINITION_PATH, writer.addString( std::string( j->getPath().getDirName() ) + std::string( j->getPath().getBaseName() ) ) );
+            writer.append( ExperimentSnapshot::FUNCTION_DEFINITION_LINE, qint32( j->getLine() ) );
+        }
+        writer.appendRowOffset( ExperimentSnapshot::FUNCTION_DEFINITION_OFFSETS, ExperimentSnapshot::FUNCTION_DEFINITION_LINE );
+    }
+
+    const std::set<Statement> statements( threads.getStatements() );
+    for ( std::set<Statement>::const_iterator i = statements.begin(); i != statements.end(); ++i ) {
+        writer.append( ExperimentSnapshot::STATEMENT_PATH, writer.addString( i->getPath() ) );
+        writer.append( ExperimentSnapshot::STATEMENT_LINE, qint32( i->getLine() ) );
+    }
+}
+
+/**
+ * @brief snapshot_function_metric
+ * @param collector
+ * @param interval
+ * @param threads
+ * @param functionIndex
+ * @param writer
+ * Evaluate the collector's first "time" metric for all functions and add the per-thread values to the snapshot.
+ */
+void snapshot_function_metric(const Collector& collector,
+                              const TimeInterval& interval,
+                              const ThreadGroup& threads,
+                              const std::map<Function, quint32>& functionIndex,
+                              ExperimentSnapshotWriter& writer)
+{
+    const std::set<Metadata> metrics( collector.getMetrics() );
+
+    std::string metricStr;
+    for ( std::set<Metadata>::const_iterator i = metrics.begin(); i != metrics.end(); ++i ) {
+        if ( i->getUniqueId().find( "time" ) != std::string::npos && i->isType( typeid(double) ) ) {
+            metricStr = i->getUniqueId();
+            break;
+        }
+    }
+
+    if ( metricStr.empty() )
+        return;
+
+    SmartPtr<std::map<Function, std::map<Thread, double> > > individual;
+    GetMetricValues( collector, metricStr, interval, threads, threads.getFunctions(), individual );
+
+    writer.append( ExperimentSnapshot::FUNCTION_METRIC_NAME, writer.addString( metricStr ) );
+
+    // rows are grouped by thread in the same order as the thread columns
+    writer.appendRowOffset( ExperimentSnapshot::FUNCTION_METRIC_THREAD_OFFSETS, ExperimentSnapshot::FUNCTION_METRIC_VALUE );
+
+    for ( ThreadGroup::const_iterator t = threads.begin(); t != threads.end() && ! AnalysisScheduler::isCanceled(); ++t ) {
+        for ( std::map<Function, std::map<Thread, double> >::const_iterator
+                  i = individual->begin(); i != individual->end(); ++i ) {
+            std::map<Thread, double>::const_iterator value = i->second.find( *t );
+            std::map<Function, quint32>::const_iterator index = functionIndex.find( i->first );
+            if ( value == i->second.end() || index == functionIndex.end() )
+                continue;
+            writer.append( ExperimentSnapshot::FUNCTION_METRIC_FUNCTION, index->second );
+            writer.append( ExperimentSnapshot::FUNCTION_METRIC_VALUE, value->second );
+        }
+        writer.appendRowOffset( ExperimentSnapshot::FUNCTION_METRIC_THREAD_OFFSETS, ExperimentSnapshot::FUNCTION_METRIC_VALUE );
+    }
+}
+
+/**
+ * @brief resolve_site_in_event
+ * @param data
+ * @param thread
+ * @param details
+ * @param sites
+ * @param sites_found
+ * @return
+ * Convert call sites into Open|SpeedShop Framework StackTrace objects.
+ */
+template <typename T>
+bool resolve_site_in_event(const CUDA::PerformanceData& data,
+                           const Thread& thread,
+                           const T& details,
+                           std::vector<std::shared_ptr<StackTrace> >& sites,
+                           size_t& sites_found)
+{
+    size_t n = details.call_site;
+
+    if (!sites[n]) {
+        sites[n].reset(new StackTrace(thread, Time(details.time)));
+
+        for ( Base::StackTrace::const_iterator
+                 i = data.sites()[n].begin(); i != data.sites()[n].end(); ++i ) {
+            sites[n]->push_back(Address(*i));
+        }
+
+        sites_found++;
+    }
+
+    return sites_found < data.sites().size();
+}
+
+/**
+ * @brief snapshot_call_sites
+ * @param data
+ * @param threads
+ * @param functionIndex
+ * @param writer
+ * Add the CUDA call sites to the snapshot.  Each frame is resolved to a function when the call site is referenced by an event.
+ */
+void snapshot_call_sites(const CUDA::PerformanceData& data,
+                         const std::vector< std::pair<Base::ThreadName, Thread> >& threads,
+                         const std::map<Function, quint32>& functionIndex,
+                         ExperimentSnapshotWriter& writer)
+{
+    std::vector<std::shared_ptr<StackTrace> > sites(data.sites().size());
+    size_t sites_found = 0;
+
+    for ( std::vector< std::pair<Base::ThreadName, Thread> >::const_iterator
+              i = threads.begin(); i != threads.end() && sites_found < sites.size(); ++i ) {
+        data.visitDataTransfers(
+            i->first, data.interval(),
+            boost::bind(&resolve_site_in_event<CUDA::DataTransfer>,
+                 boost::cref(data), boost::cref(i->second), _1,
+                 boost::ref(sites), boost::ref(sites_found))
+            );
+        data.visitKernelExecutions(
+            i->first, data.interval(),
+            boost::bind(&resolve_site_in_event<CUDA::KernelExecution>,
+                 boost::cref(data), boost::cref(i->second), _1,
+                 boost::ref(sites), boost::ref(sites_found))
+            );
+    }
+
+    writer.appendRowOffset( ExperimentSnapshot::CALL_SITE_OFFSETS, ExperimentSnapshot::CALL_SITE_FRAME_ADDRESS );
+
+    for ( size_t i = 0; i < sites.size(); ++i ) {
+        if ( sites[i] ) {
+            const StackTrace& trace = *sites[i];
+
+            for ( StackTrace::size_type j = 0; j < trace.size(); ++j ) {
+                quint32 index = ExperimentSnapshot::NO_INDEX;
+
+                std::pair<bool, Function> function = trace.getFunctionAt(j);
+                if ( function.first ) {
+                    std::map<Function, quint32>::const_iterator iter = functionIndex.find( function.second );
+                    if ( iter != functionIndex.end() )
+                        index = iter->second;
+                }
+
+                writer.append( ExperimentSnapshot::CALL_SITE_FRAME_ADDRESS, quint64( trace[j].getValue() ) );
+                writer.append( ExperimentSnapshot::CALL_SITE_FRAME_FUNCTION, index );
+            }
+        }
+        else {
+            const Base::StackTrace& trace = data.sites()[i];
+
+            for ( Base::StackTrace::const_iterator j = trace.begin(); j != trace.end(); ++j ) {
+                writer.append( ExperimentSnapshot::CALL_SITE_FRAME_ADDRESS, quint64( Address(*j).getValue() ) );
+                writer.append( ExperimentSnapshot::CALL_SITE_FRAME_FUNCTION, ExperimentSnapshot::NO_INDEX );
+            }
+        }
+
+        writer.appendRowOffset( ExperimentSnapshot::CALL_SITE_OFFSETS, ExperimentSnapshot::CALL_SITE_FRAME_ADDRESS );
+    }
+}
+
+/**
+ * @brief snapshot_data_transfer
+ * @param time_origin
+ * @param details
+ * @param writer
+ * @return
+ * Add a data transfer to the snapshot.
+ */
+bool snapshot_data_transfer(const Base::Time& time_origin,
+                            const CUDA::DataTransfer& details,
+                            ExperimentSnapshotWriter& writer)
+{
+    writer.append( ExperimentSnapshot::DATA_TRANSFER_TIME_BEGIN, quint64( details.time_begin - time_origin ) );
+    writer.append( ExperimentSnapshot::DATA_TRANSFER_TIME_END, quint64( details.time_end - time_origin ) );
+    writer.append( ExperimentSnapshot::DATA_TRANSFER_SIZE, quint64( details.size ) );
+    writer.append( ExperimentSnapshot::DATA_TRANSFER_KIND, writer.addString( CUDA::stringify( details.kind ) ) );
+    writer.append( ExperimentSnapshot::DATA_TRANSFER_CALL_SITE, quint32( details.call_site ) );
+    writer.append( ExperimentSnapshot::DATA_TRANSFER_DEVICE, quint32( details.device ) );
+
+    return true; // Always continue the visitation
+}
+
+/**
+ * @brief snapshot_kernel_execution
+ * @param time_origin
+ * @param details
+ * @param writer
+ * @return
+ * Add a kernel execution to the snapshot.
+ */
+bool snapshot_kernel_execution(const Base::Time& time_origin,
+                               const CUDA::KernelExecution& details,
+                               ExperimentSnapshotWriter& writer)
+{
+    writer.append( ExperimentSnapshot::KERNEL_EXECUTION_TIME_BEGIN, quint64( details.time_begin - time_origin ) );
+    writer.append( ExperimentSnapshot::KERNEL_EXECUTION_TIME_END, quint64( details.time_end - time_origin ) );
+    writer.append( ExperimentSnapshot::KERNEL_EXECUTION_FUNCTION, writer.addString( demangle_function_name( details.function ) ) );
+    writer.append( ExperimentSnapshot::KERNEL_EXECUTION_CALL_SITE, quint32( details.call_site ) );
+    writer.append( ExperimentSnapshot::KERNEL_EXECUTION_DEVICE, quint32( details.device ) );
+
+    return true; // Always continue the visitation
+}
+
+/**
+ * @brief snapshot_periodic_sample
+ * @param time_origin
+ * @param counterCount
+ * @param time
+ * @param counts
+ * @param writer
+ * @return
+ * Add a periodic sample to the snapshot.  Every sample has exactly one count per counter.
+ */
+bool snapshot_periodic_sample(const Base::Time& time_origin,
+                              std::size_t counterCount,
+                              const Base::Time& time,
+                              const std::vector<uint64_t>& counts,
+                              ExperimentSnapshotWriter& writer)
+{
+    writer.append( ExperimentSnapshot::PERIODIC_SAMPLE_TIME, quint64( time - time_origin ) );
+    for ( std::size_t i = 0; i < counterCount; ++i ) {
+        writer.append( ExperimentSnapshot::PERIODIC_SAMPLE_COUNTS, quint64( i < counts.size() ? counts[i] : 0 ) );
+    }
+
+    return true; // Always continue the visitation
+}
+
+/**
+ * @brief snapshot_cuda
+ * @param collector
+ * @param time_origin
+ * @param all_threads
+ * @param functionIndex
+ * @param writer
+ * Add the CUDA counters, call sites and per-thread events to the snapshot.
+ */
+void snapshot_cuda(const Collector& collector,
+                   const Base::Time& time_origin,
+                   const ThreadGroup& all_threads,
+                   const std::map<Function, quint32>& functionIndex,
+                   ExperimentSnapshotWriter& writer)
+{
+    CUDA::PerformanceData data;
+    std::vector< std::pair<Base::ThreadName, Thread> > threads;
+
+    for ( ThreadGroup::const_iterator i = all_threads.begin(); i != all_threads.end(); ++i ) {
+        GetCUDAPerformanceData( collector, *i, data );
+        threads.push_back( std::make_pair( ConvertToArgoNavis(*i), *i ) );
+    }
+
+    for ( std::vector<std::string>::size_type i = 0; i < data.counters().size(); ++i ) {
+#ifdef HAS_METRIC_TYPES
+        writer.append( ExperimentSnapshot::COUNTER_NAME, writer.addString( data.counters()[i].name ) );
+#else
+        writer.append( ExperimentSnapshot::COUNTER_NAME, writer.addString( data.counters()[i] ) );
+#endif
+    }
+
+    snapshot_call_sites( data, threads, functionIndex, writer );
+
+    // rows are grouped by thread in the same order as the thread columns
+    writer.appendRowOffset( ExperimentSnapshot::DATA_TRANSFER_THREAD_OFFSETS, ExperimentSnapshot::DATA_TRANSFER_TIME_BEGIN );
+    writer.appendRowOffset( ExperimentSnapshot::KERNEL_EXECUTION_THREAD_OFFSETS, ExperimentSnapshot::KERNEL_EXECUTION_TIME_BEGIN );
+    writer.appendRowOffset( ExperimentSnapshot::PERIODIC_SAMPLE_THREAD_OFFSETS, ExperimentSnapshot::PERIODIC_SAMPLE_TIME );
+
+    for ( std::vector< std::pair<Base::ThreadName, Thread> >::const_iterator
+              i = threads.begin(); i != threads.end() && ! AnalysisScheduler::isCanceled(); ++i ) {
+        data.visitDataTransfers(
+            i->first, data.interval(),
+            boost::bind(&snapshot_data_transfer,
+                 boost::cref(time_origin), _1, boost::ref(writer))
+            );
+
+        data.visitKernelExecutions(
+            i->first, data.interval(),
+            boost::bind(&snapshot_kernel_execution,
+                 boost::cref(time_origin), _1, boost::ref(writer))
+            );
+
+        data.visitPeriodicSamples(
+            i->first, data.interval(),
+            boost::bind(&snapshot_periodic_sample,
+                 boost::cref(time_origin), data.counters().size(), _1, _2, boost::ref(writer))
+            );
+
+        writer.appendRowOffset( ExperimentSnapshot::DATA_TRANSFER_THREAD_OFFSETS, ExperimentSnapshot::DATA_TRANSFER_TIME_BEGIN );
+        writer.appendRowOffset( ExperimentSnapshot::KERNEL_EXECUTION_THREAD_OFFSETS, ExperimentSnapshot::KERNEL_EXECUTION_TIME_BEGIN );
+        writer.appendRowOffset( ExperimentSnapshot::PERIODIC_SAMPLE_THREAD_OFFSETS, ExperimentSnapshot::PERIODIC_SAMPLE_TIME );
+    }
+}
+
+/**
+ * @brief The StackTraceTable class
+ * Interns the stack traces of the trace events and stack samples in the stack trace columns of the snapshot.  Stack traces having
+ * the same frames in the same process share one entry.  Each frame is resolved to a function once per process and address.
+ */
+class StackTraceTable
+{
+public:
+
+    StackTraceTable(const std::map<Function, quint32>& functionIndex,
+                    ExperimentSnapshotWriter& writer)
+        : m_functionIndex( functionIndex ), m_writer( writer )
+    {
+        m_writer.appendRowOffset( ExperimentSnapshot::STACK_TRACE_OFFSETS, ExperimentSnapshot::STACK_TRACE_FRAME_ADDRESS );
+    }
+
+    /**
+     * @brief StackTraceTable::process
+     * @param thread
+     * @return
+     * Return the index of the process of the thread.
+     */
+    quint32 process(const Thread& thread)
+    {
+        const std::pair<std::string, pid_t> key( thread.getHost(), thread.getProcessId() );
+
+        std::map< std::pair<std::string, pid_t>, quint32 >::const_iterator iter = m_processes.find( key );
+        if ( iter != m_processes.end() )
+            return iter->second;
+
+        const quint32 index = m_processes.size();
+        m_processes.insert( std::make_pair( key, index ) );
+
+        return index;
+    }
+
+    /**
+     * @brief StackTraceTable::index
+     * @param process
+     * @param trace
+     * @return
+     * Return the index of the stack trace, adding the stack trace to the snapshot if not already present.
+     */
+    quint32 index(quint32 process, const StackTrace& trace)
+    {
+        std::pair< quint32, std::vector<quint64> > key;
+        key.first = process;
+        key.second.reserve( trace.size() );
+        for ( StackTrace::size_type j = 0; j < trace.size(); ++j ) {
+            key.second.push_back( trace[j].getValue() );
+        }
+
+        std::map< std::pair< quint32, std::vector<quint64> >, quint32 >::const_iterator iter = m_traces.find( key );
+        if ( iter != m_traces.end() )
+            return iter->second;
+
+        const quint32 index = m_traces.size();
+        m_traces.insert( std::make_pair( key, index ) );
+
+        for ( StackTrace::size_type j = 0; j < trace.size(); ++j ) {
+            const std::pair<quint32, quint64> frame( process, key.second[j] );
+
+            std::map< std::pair<quint32, quint64>, quint32 >::const_iterator function = m_frameFunctions.find( frame );
+            if ( function == m_frameFunctions.end() ) {
+                quint32 functionIndex = ExperimentSnapshot::NO_INDEX;
+
+                std::pair<bool, Function> resolved = trace.getFunctionAt(j);
+                if ( resolved.first ) {
+                    std::map<Function, quint32>::const_iterator i = m_functionIndex.find( resolved.second );
+                    if ( i != m_functionIndex.end() )
+                        functionIndex = i->second;
+                }
+
+                function = m_frameFunctions.insert( std::make_pair( frame, functionIndex ) ).first;
+            }
+
+            m_writer.append( ExperimentSnapshot::STACK_TRACE_FRAME_ADDRESS, frame.second );
+            m_writer.append( ExperimentSnapshot::STACK_TRACE_FRAME_FUNCTION, function->second );
+        }
+
+        m_writer.appendRowOffset( ExperimentSnapshot::STACK_TRACE_OFFSETS, ExperimentSnapshot::STACK_TRACE_FRAME_ADDRESS );
+
+        return index;
+    }
+
+private:
+
+    const std::map<Function, quint32>& m_functionIndex;
+    ExperimentSnapshotWriter& m_writer;
+    std::map< std::pair<std::string, pid_t>, quint32 > m_processes;
+    std::map< std::pair< quint32, std::vector<quint64> >, quint32 > m_traces;
+    std::map< std::pair<quint32, quint64>, quint32 > m_frameFunctions;
+};
+
+/**
+ * @brief has_metric
+ * @param collector
+ * @param metric
+ * @return
+ * Whether the collector provides the metric.
+ */
+bool has_metric(const Collector& collector, const std::string& metric)
+{
+    const std::set<Metadata> metrics( collector.getMetrics() );
+
+    for ( std::set<Metadata>::const_iterator i = metrics.begin(); i != metrics.end(); ++i ) {
+        if ( i->getUniqueId() == metric )
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief The TraceEvent struct
+ * A trace event of one thread.
+ */
+struct TraceEvent {
+    quint64 begin;
+    quint64 end;
+    quint32 function;
+    quint32 stackTrace;
+    bool operator<(const TraceEvent& other) const { return begin < other.begin; }
+};
+
+/**
+ * @brief snapshot_trace_events
+ * @param collector
+ * @param metric
+ * @param interval
+ * @param threads
+ * @param functionIndex
+ * @param stackTraces
+ * @param writer
+ * @return
+ * Evaluate the details metric of a tracing collector (mpit, iot, mem) one thread at a time and add the trace events of each thread,
+ * ordered by begin time, to the snapshot.  Returns false if the export was canceled.
+ */
+template <typename DETAIL_t>
+bool snapshot_trace_events(const Collector& collector,
+                           const std::string& metric,
+                           const TimeInterval& interval,
+                           const ThreadGroup& threads,
+                           const std::map<Function, quint32>& functionIndex,
+                           StackTraceTable& stackTraces,
+                           ExperimentSnapshotWriter& writer)
+{
+    typedef std::map< Function, std::map< Thread, std::map< StackTrace, DETAIL_t > > > RawItems;
+
+    const Time::value_type time_origin = interval.getBegin().getValue();
+    const std::set<Function> functions( threads.getFunctions() );
+
+    writer.append( ExperimentSnapshot::TRACE_EVENT_METRIC_NAME, writer.addString( metric ) );
+
+    // rows are grouped by thread in the same order as the thread columns
+    writer.appendRowOffset( ExperimentSnapshot::TRACE_EVENT_THREAD_OFFSETS, ExperimentSnapshot::TRACE_EVENT_TIME_BEGIN );
+
+    for ( ThreadGroup::const_iterator t = threads.begin(); t != threads.end(); ++t ) {
+        if ( AnalysisScheduler::isCanceled() )
+            return false;
+
+        ThreadGroup thread;
+        thread.insert( *t );
+
+        SmartPtr< RawItems > raw_items;
+        GetMetricValues( collector, metric, interval, thread, functions, raw_items );
+
+        const quint32 process = stackTraces.process( *t );
+
+        std::vector<TraceEvent> events;
+
+        for ( typename RawItems::const_iterator i = raw_items->begin(); i != raw_items->end(); ++i ) {
+            std::map<Function, quint32>::const_iterator function = functionIndex.find( i->first );
+            typename std::map< Thread, std::map< StackTrace, DETAIL_t > >::const_iterator traces = i->second.find( *t );
+            if ( function == functionIndex.end() || traces == i->second.end() )
+                continue;
+
+            for ( typename std::map< StackTrace, DETAIL_t >::const_iterator j = traces->second.begin(); j != traces->second.end(); ++j ) {
+                const quint32 stackTrace = stackTraces.index( process, j->first );
+
+                for ( typename DETAIL_t::const_iterator k = j->second.begin(); k != j->second.end(); ++k ) {
+                    TraceEvent event;
+                    event.begin = k->dm_interval.getBegin().getValue() - time_origin;
+                    event.end = k->dm_interval.getEnd().getValue() - time_origin;
+                    event.function = function->second;
+                    event.stackTrace = stackTrace;
+                    events.push_back( event );
+                }
+            }
+        }
+
+        std::stable_sort( events.begin(), events.end() );
+
+        for ( std::vector<TraceEvent>::const_iterator i = events.begin(); i != events.end(); ++i ) {
+            writer.append( ExperimentSnapshot::TRACE_EVENT_TIME_BEGIN, i->begin );
+            writer.append( ExperimentSnapshot::TRACE_EVENT_TIME_END, i->end );
+            writer.append( ExperimentSnapshot::TRACE_EVENT_FUNCTION, i->function );
+            writer.append( ExperimentSnapshot::TRACE_EVENT_STACK_TRACE, i->stackTrace );
+        }
+
+        writer.appendRowOffset( ExperimentSnapshot::TRACE_EVENT_THREAD_OFFSETS, ExperimentSnapshot::TRACE_EVENT_TIME_BEGIN );
+    }
+
+    return true;
+}
+
+/**
+ * @brief snapshot_stack_samples
+ * @param collector
+ * @param metric
+ * @param interval
+ * @param threads
+ * @param stackTraces
+ * @param writer
+ * @return
+ * Evaluate the inclusive details metric of a sampling collector (usertime) one thread at a time and add the sample count and time of
+ * each unique stack trace of each thread to the snapshot.  The inclusive details repeat a stack trace for each function of the stack
+ * trace, so each stack trace is added once per thread.  Returns false if the export was canceled.
+ */
+template <typename DETAIL_t>
+bool snapshot_stack_samples(const Collector& collector,
+                            const std::string& metric,
+                            const TimeInterval& interval,
+                            const ThreadGroup& threads,
+                            StackTraceTable& stackTraces,
+                            ExperimentSnapshotWriter& writer)
+{
+    typedef std::map< Function, std::map< Thread, std::map< StackTrace, DETAIL_t > > > RawItems;
+
+    const std::set<Function> functions( threads.getFunctions() );
+
+    writer.append( ExperimentSnapshot::STACK_SAMPLE_METRIC_NAME, writer.addString( metric ) );
+
+    // rows are grouped by thread in the same order as the thread columns
+    writer.appendRowOffset( ExperimentSnapshot::STACK_SAMPLE_THREAD_OFFSETS, ExperimentSnapshot::STACK_SAMPLE_STACK_TRACE );
+
+    for ( ThreadGroup::const_iterator t = threads.begin(); t != threads.end(); ++t ) {
+        if ( AnalysisScheduler::isCanceled() )
+            return false;
+
+        ThreadGroup thread;
+        thread.insert( *t );
+
+        SmartPtr< RawItems > raw_items;
+        GetMetricValues( collector, metric, interval, thread, functions, raw_items );
+
+        const quint32 process = stackTraces.process( *t );
+
+        std::set<quint32> added;
+
+        for ( typename RawItems::const_iterator i = raw_items->begin(); i != raw_items->end(); ++i ) {
+            typename std::map< Thread, std::map< StackTrace, DETAIL_t > >::const_iterator traces = i->second.find( *t );
+            if ( traces == i->second.end() )
+                continue;
+
+            for ( typename std::map< StackTrace, DETAIL_t >::const_iterator j = traces->second.begin(); j != traces->second.end(); ++j ) {
+                const quint32 stackTrace = stackTraces.index( process, j->first );
+
+                if ( ! added.insert( stackTrace ).second )
+                    continue;
+
+                writer.append( ExperimentSnapshot::STACK_SAMPLE_STACK_TRACE, stackTrace );
+                writer.append( ExperimentSnapshot::STACK_SAMPLE_COUNT, quint64( j->second.dm_count ) );
+                writer.append( ExperimentSnapshot::STACK_SAMPLE_TIME, double( j->second.dm_time ) );
+            }
+        }
+
+        writer.appendRowOffset( ExperimentSnapshot::STACK_SAMPLE_THREAD_OFFSETS, ExperimentSnapshot::STACK_SAMPLE_STACK_TRACE );
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+
+/**
+ * Write a columnar binary snapshot of the experiment database.  The export polls the cancellation token of the calling
+ * analysis task (see AnalysisScheduler) between threads and stops without writing the snapshot file once it is canceled.
+ *
+ * @param dbFilename        Filename path to experiment database file (.openss file)
+ * @param snapshotFilename  Filename path of the snapshot file to write
+ * @return                  Exit code. Either 1 if a failure occurred or the export was canceled, or 0 otherwise.
+ */
+int experiment2snapshot(const QString& dbFilename, const QString& snapshotFilename)
+{
+    Experiment experiment( dbFilename.toStdString() );
+
+    ExperimentSnapshotWriter writer( snapshotFilename );
+
+    const TimeInterval interval = experiment.getPerformanceDataExtent().getTimeInterval();
+    const Base::Time time_origin = ConvertToArgoNavis( interval ).begin();
+
+    writer.append( ExperimentSnapshot::TIME_INTERVAL, quint64( interval.getBegin().getValue() ) );
+    writer.append( ExperimentSnapshot::TIME_INTERVAL, quint64( interval.getEnd().getValue() ) );
+
+    const ThreadGroup all_threads = experiment.getThreads();
+
+    snapshot_threads( all_threads, writer );
+
+    std::map<Function, quint32> functionIndex;
+
+    snapshot_symbols( all_threads, functionIndex, writer );
+
+    if ( AnalysisScheduler::isCanceled() )
+        return 1;
+
+    CollectorGroup collectors = experiment.getCollectors();
+
+    boost::optional<Collector> cudaCollector;
+    for ( CollectorGroup::const_iterator i = collectors.begin(); i != collectors.end(); ++i ) {
+        if ( i->getMetadata().getUniqueId() == "cuda" ) {
+            cudaCollector = *i;
+            break;
+        }
+    }
+
+    if ( ! collectors.empty() ) {
+        const Collector& collector = *collectors.begin();
+        const std::string collectorId = collector.getMetadata().getUniqueId();
+
+        snapshot_function_metric( collector, interval, all_threads, functionIndex, writer );
+
+        StackTraceTable stackTraces( functionIndex, writer );
+
+        bool completed( true );
+
+        if ( collectorId == "mpit" && has_metric( collector, "exclusive_details" ) )
+            completed = snapshot_trace_events< std::vector<MPITDetail> >( collector, "exclusive_details", interval, all_threads, functionIndex, stackTraces, writer );
+        else if ( collectorId == "iot" && has_metric( collector, "exclusive_details" ) )
+            completed = snapshot_trace_events< std::vector<IOTDetail> >( collector, "exclusive_details", interval, all_threads, functionIndex, stackTraces, writer );
+        else if ( collectorId == "mem" && has_metric( collector, "exclusive_details" ) )
+            completed = snapshot_trace_events< std::vector<MemDetail> >( collector, "exclusive_details", interval, all_threads, functionIndex, stackTraces, writer );
+        else if ( collectorId == "usertime" && has_metric( collector, "inclusive_detail" ) )
+            completed = snapshot_stack_samples< UserTimeDetail >( collector, "inclusive_detail", interval, all_threads, stackTraces, writer );
+
+        if ( ! completed || AnalysisScheduler::isCanceled() )
+            return 1;
+    }
+
+    if ( cudaCollector ) {
+        snapshot_cuda( *cudaCollector, time_origin, all_threads, functionIndex, writer );
+    }
+
+    if ( AnalysisScheduler::isCanceled() )
+        return 1;
+
+    return writer.write() ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+/*!
+   \file CalltreeGraphItems.cpp
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CalltreeGraphItems.h"
+
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QFontMetricsF>
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+// labels smaller than this on screen (in pixels) are not drawn
+const qreal MIN_READABLE_FONT_SIZE = 6.0;
+
+// nodes are drawn as simple rectangles below this zoom level
+const qreal MIN_DETAILED_NODE_LEVEL_OF_DETAIL = 0.4;
+
+
+/**
+ * @brief CalltreeGraphLabelItem::CalltreeGraphLabelItem
+ * @param text - the label text
+ * @param center - the center of the label in scene coordinates
+ * @param font - the label font
+ * @param parent - the parent graphics item
+ *
+ * Constructs a CalltreeGraphLabelItem instance.
+ */
+CalltreeGraphLabelItem::CalltreeGraphLabelItem(const QString &text, const QPointF &center, const QFont &font, QGraphicsItem *parent)
+    : QGraphicsItem( parent )
+    , m_text( text )
+    , m_font( font )
+{
+    m_text.setPerformanceHint( QStaticText::AggressiveCaching );
+    m_text.prepare( QTransform(), m_font );
+
+    const QSizeF size = m_text.size();
+
+    m_rect = QRectF( center.x() - size.width() / 2.0, center.y() - size.height() / 2.0, size.width(), size.height() );
+}
+
+/**
+ * @brief CalltreeGraphLabelItem::boundingRect
+ * @return - the bounding rectangle of the label
+ */
+QRectF CalltreeGraphLabelItem::boundingRect() const
+{
+    return m_rect;
+}
+
+/**
+ * @brief CalltreeGraphLabelItem::isReadable
+ * @param levelOfDetail - the level of detail of the painter transformation
+ * @param font - the label font
+ * @return - whether text in the font is large enough to read at the level of detail
+ */
+bool CalltreeGraphLabelItem::isReadable(qreal levelOfDetail, const QFont &font)
+{
+    return levelOfDetail * font.pixelSize() >= MIN_READABLE_FONT_SIZE;
+}
+
+/**
+ * @brief CalltreeGraphLabelItem::paint
+ * @param painter - the painter
+ * @param option - the style options of the item
+ * @param widget - the widget being painted on
+ *
+ * Draws the label unless it is too small to read.
+ */
+void CalltreeGraphLabelItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED( option )
+    Q_UNUSED( widget )
+
+    const qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform( painter->worldTransform() );
+
+    if ( ! isReadable( lod, m_font ) )
+        return;
+
+    painter->setFont( m_font );
+    painter->setPen( Qt::black );
+    painter->drawStaticText( m_rect.topLeft(), m_text );
+}
+
+/**
+ * @brief CalltreeGraphNodeItem::CalltreeGraphNodeItem
+ * @param node - the positioned node geometry
+ * @param font - the label font
+ * @param parent - the parent graphics item
+ *
+ * Constructs a CalltreeGraphNodeItem instance.
+ */
+CalltreeGraphNodeItem::CalltreeGraphNodeItem(const CalltreeGraphLayout::Node &node, const QFont &font, QGraphicsItem *parent)
+    : QGraphicsItem( parent )
+    , m_rect( node.rect )
+    , m_label( node.label )
+    , m_font( font )
+    , m_collapsed( node.collapsed )
+{
+    m_label.setPerformanceHint( QStaticText::AggressiveCaching );
+    m_label.prepare( QTransform(), m_font );
+
+    const QSizeF size = m_label.size();
+
+    m_labelPosition = m_rect.center() - QPointF( size.width() / 2.0, size.height() / 2.0 );
+
+    // the label may be wider than the node
+    m_boundingRect = m_rect.united( QRectF( m_labelPosition, size ) ).adjusted( -1.0, -1.0, 1.0, 1.0 );
+
+    setToolTip( QString( "%1\nInclusive time: %2" ).arg( node.label ).arg( node.inclusiveTime ) );
+}
+
+/**
+ * @brief CalltreeGraphNodeItem::boundingRect
+ * @return - the bounding rectangle of the node including its label
+ */
+QRectF CalltreeGraphNodeItem::boundingRect() const
+{
+    return m_boundingRect;
+}
+
+/**
+ * @brief CalltreeGraphNodeItem::paint
+ * @param painter - the painter
+ * @param option - the style options of the item
+ * @param widget - the widget being painted on
+ *
+ * Draws the node using the representation appropriate for the zoom level.
+ */
+void CalltreeGraphNodeItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED( option )
+    Q_UNUSED( widget )
+
+    const qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform( painter->worldTransform() );
+
+    const QColor fillColor = ( m_collapsed ) ? QColor( Qt::lightGray ) : QColor( Qt::white );
+
+    if ( lod < MIN_DETAILED_NODE_LEVEL_OF_DETAIL ) {
+        painter->setRenderHint( QPainter::Antialiasing, false );
+        painter->setPen( QPen( Qt::black, 0 ) );
+        painter->setBrush( fillColor );
+        painter->drawRect( m_rect );
+        return;
+    }
+
+    QPen pen( Qt::black, 0 );
+    if ( m_collapsed )
+        pen.setStyle( Qt::DashLine );
+
+    painter->setPen( pen );
+    painter->setBrush( fillColor );
+    painter->drawEllipse( m_rect );
+
+    if ( CalltreeGraphLabelItem::isReadable( lod, m_font ) ) {
+        painter->setFont( m_font );
+        painter->drawStaticText( m_labelPosition, m_label );
+    }
+}
+
+
+} // GUI
+} // ArgoNavis
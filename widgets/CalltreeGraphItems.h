@@ -0,0 +1,98 @@
+/*!
+   \file CalltreeGraphItems.h
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CALLTREEGRAPHITEMS_H
+#define CALLTREEGRAPHITEMS_H
+
+#include <QGraphicsItem>
+#include <QStaticText>
+#include <QFont>
+
+#include "common/openss-gui-config.h"
+
+#include "managers/CalltreeGraphLayout.h"
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/*!
+ * \brief The CalltreeGraphLabelItem class
+ *
+ * A text label of the calltree graph.  The label is not drawn when the zoom level makes it too small to read.
+ */
+
+class CalltreeGraphLabelItem : public QGraphicsItem
+{
+public:
+
+    CalltreeGraphLabelItem(const QString& text, const QPointF& center, const QFont& font, QGraphicsItem* parent = 0);
+
+    QRectF boundingRect() const Q_DECL_OVERRIDE;
+
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = 0) Q_DECL_OVERRIDE;
+
+    static bool isReadable(qreal levelOfDetail, const QFont& font);
+
+private:
+
+    QStaticText m_text;
+    QFont m_font;
+    QRectF m_rect;
+
+};
+
+
+/*!
+ * \brief The CalltreeGraphNodeItem class
+ *
+ * A function node of the calltree graph.  The representation depends on the zoom level: when zoomed out the node is drawn as a
+ * filled rectangle without antialiasing and its label is hidden; otherwise the node is drawn as an ellipse with its label.
+ */
+
+class CalltreeGraphNodeItem : public QGraphicsItem
+{
+public:
+
+    CalltreeGraphNodeItem(const CalltreeGraphLayout::Node& node, const QFont& font, QGraphicsItem* parent = 0);
+
+    QRectF boundingRect() const Q_DECL_OVERRIDE;
+
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = 0) Q_DECL_OVERRIDE;
+
+private:
+
+    QRectF m_rect;
+    QRectF m_boundingRect;
+    QStaticText m_label;
+    QFont m_font;
+    QPointF m_labelPosition;
+    bool m_collapsed;
+
+};
+
+
+} // GUI
+} // ArgoNavis
+
+#endif // CALLTREEGRAPHITEMS_H
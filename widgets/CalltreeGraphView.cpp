@@ -24,23 +24,39 @@
 #include "CalltreeGraphView.h"
 
 #include <QWheelEvent>
+#include <QContextMenuEvent>
+#include <QMenu>
+#include <QActionGroup>
+#include <QGraphicsScene>
+#include <QGraphicsPathItem>
+#include <QMap>
+#include <QPair>
+#include <QtConcurrentRun>
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
 #include <QtMath>
 #else
 #include <qmath.h>
-#include <QPair>
 #endif
 
-#include "QtGraph/QGraphCanvas.h"
-#include "QtGraph/QGraphNode.h"
-#include "QtGraph/QGraphEdge.h"
-
 #include "managers/PerformanceDataManager.h"
+#include "managers/ApplicationOverrideCursorManager.h"
+
+#include "CalltreeGraphItems.h"
 
 
 namespace ArgoNavis { namespace GUI {
 
 
+// by default only the hot subgraph is shown - functions below 5% of the largest inclusive time are pruned
+const double DEFAULT_PRUNE_THRESHOLD = 0.05;
+
+// the size of the node and edge label font in scene coordinates (points) - matches the Graphviz default font size
+const int LABEL_FONT_SIZE = 14;
+
+// the size of the square scene tiles in which edges are batched into a single path item (scene coordinates)
+const qreal EDGE_TILE_SIZE = 512.0;
+
+
 /**
  * @brief CalltreeGraphView::CalltreeGraphView
  * @param parent - the parent widget
@@ -49,6 +65,8 @@ namespace ArgoNavis { namespace GUI {
  */
 CalltreeGraphView::CalltreeGraphView(QWidget *parent)
     : QGraphicsView( parent )
+    , m_pruneThreshold( DEFAULT_PRUNE_THRESHOLD )
+    , m_layoutPending( false )
 {
     setTransformationAnchor( QGraphicsView::AnchorUnderMouse );
     setRenderHints( QPainter::Antialiasing | QPainter::TextAntialiasing );
@@ -63,6 +81,8 @@ CalltreeGraphView::CalltreeGraphView(QWidget *parent)
         connect( dataMgr, SIGNAL(signalDisplayCalltreeGraph(QString)), this, SLOT(handleDisplayGraphView(QString)) );
 #endif
     }
+
+    connect( &m_layoutWatcher, SIGNAL(finished()), this, SLOT(handleLayoutFinished()) );
 }
 
 /**
@@ -83,35 +103,137 @@ CalltreeGraphView::~CalltreeGraphView()
  * @brief CalltreeGraphView::handleDisplayGraphView
  * @param graph - DOT format data representing calltree graph to create
  *
- * This method takes the DOT format data and creates a calltree graph from it, updates the layout to cause all graph vertex and edge
- * state to be calculated and then attaches the scene to the view.  If am empty string is passed into this method, then a null pointer
- * is set as the scene to clear the graph in view.  The current calltree graph will be removed and destroyed.
+ * This method starts the computation of the calltree graph layout from the DOT format data in a worker thread.  The scene is created
+ * from the positioned geometry when the layout is finished (see handleLayoutFinished).  If am empty string is passed into this method,
+ * then a null pointer is set as the scene to clear the graph in view.  The current calltree graph will be removed and destroyed.
  */
 void CalltreeGraphView::handleDisplayGraphView(const QString& graph)
 {
-    QGraphCanvas* g = NULL;
+    m_graph = graph.toLocal8Bit();
+
+    if ( m_graph.isEmpty() ) {
+        setGraphScene( NULL );
+        return;
+    }
+
+    startLayout();
+}
+
+/**
+ * @brief CalltreeGraphView::startLayout
+ *
+ * Starts the pruning and layout of the current calltree graph in a worker thread.  A layout still being computed for a previous
+ * request is superseded and its result is discarded.
+ */
+void CalltreeGraphView::startLayout()
+{
+    if ( ! m_layoutPending ) {
+        ApplicationOverrideCursorManager* cursorManager = ApplicationOverrideCursorManager::instance();
+        if ( cursorManager ) {
+            cursorManager->startWaitingOperation( QStringLiteral("calltree-layout") );
+        }
+        m_layoutPending = true;
+    }
+
+    m_layoutWatcher.setFuture( QtConcurrent::run( &CalltreeGraphLayout::create, m_graph, m_pruneThreshold ) );
+}
+
+/**
+ * @brief CalltreeGraphView::handleLayoutFinished
+ *
+ * Handler for the QFutureWatcher::finished() signal of the calltree graph layout.  The graphics items for the positioned nodes and
+ * edges are created in a new scene which replaces the current scene.
+ */
+void CalltreeGraphView::handleLayoutFinished()
+{
+    ApplicationOverrideCursorManager* cursorManager = ApplicationOverrideCursorManager::instance();
+    if ( cursorManager ) {
+        cursorManager->finishWaitingOperation( QStringLiteral("calltree-layout") );
+    }
+
+    m_layoutPending = false;
+
+    // the graph was cleared while the layout was computed
+    if ( m_graph.isEmpty() )
+        return;
+
+    const CalltreeGraphLayout layout = m_layoutWatcher.result();
+
+    if ( ! layout.isValid() ) {
+        setGraphScene( NULL );
+        return;
+    }
+
+    QGraphicsScene* graphScene = new QGraphicsScene;
+
+    // the items never move, so the BSP tree index lets the view draw only the items intersecting the exposed area
+    graphScene->setItemIndexMethod( QGraphicsScene::BspTreeIndex );
+
+    QFont font( QStringLiteral("Times") );
+    font.setPixelSize( LABEL_FONT_SIZE );
+
+    // batch the edges (and arrow heads) into one path per scene tile, so the bounding rectangle of a path item stays small and the
+    // BSP tree index still culls the edges outside of the exposed area; edges larger than a tile get a path item of their own
+    typedef QPair< int, int > Tile;
+    QMap< Tile, QPainterPath > edgePaths;
+    QMap< Tile, QPainterPath > arrowPaths;
+
+    // a zero width pen is a cosmetic pen which is drawn one pixel wide regardless of the zoom level
+    const QPen edgePen( Qt::black, 0 );
+
+    foreach ( const CalltreeGraphLayout::Edge& edge, layout.edges() ) {
+        const QRectF bounds = edge.path.boundingRect();
 
-    if ( ! graph.isEmpty() ) {
-        // set graph attributes
-        QGraphCanvas::NameValueList graphAttributeList;
-        graphAttributeList.push_back( qMakePair( QStringLiteral("nodesep"), QStringLiteral("0.5") ) );
+        if ( bounds.width() > EDGE_TILE_SIZE || bounds.height() > EDGE_TILE_SIZE ) {
+            graphScene->addPath( edge.path, edgePen );
 
-        // set default node attributes
-        QGraphCanvas::NameValueList nodeAttributeList;
-        nodeAttributeList.push_back( qMakePair( QStringLiteral("style"), QStringLiteral("filled") ) );
-        nodeAttributeList.push_back( qMakePair( QStringLiteral("fillcolor"), QStringLiteral("white") ) );
+            if ( ! edge.arrowHead.isEmpty() ) {
+                graphScene->addPolygon( edge.arrowHead, QPen( Qt::NoPen ), QBrush( Qt::black ) );
+            }
+        }
+        else {
+            const Tile tile( qFloor( bounds.center().x() / EDGE_TILE_SIZE ), qFloor( bounds.center().y() / EDGE_TILE_SIZE ) );
 
-        // set default edge attributes
-        QGraphCanvas::NameValueList edgeAttributeList;
+            edgePaths[ tile ].addPath( edge.path );
 
-        g = new QGraphCanvas( graph.toLocal8Bit().data(), graphAttributeList, nodeAttributeList, edgeAttributeList );
+            if ( ! edge.arrowHead.isEmpty() ) {
+                arrowPaths[ tile ].addPolygon( edge.arrowHead );
+            }
+        }
 
-        g->updateLayout();
+        if ( ! edge.label.isEmpty() ) {
+            graphScene->addItem( new CalltreeGraphLabelItem( edge.label, edge.labelPosition, font ) );
+        }
     }
 
+    foreach ( const QPainterPath& path, edgePaths ) {
+        graphScene->addPath( path, edgePen );
+    }
+
+    foreach ( const QPainterPath& path, arrowPaths ) {
+        graphScene->addPath( path, QPen( Qt::NoPen ), QBrush( Qt::black ) );
+    }
+
+    foreach ( const CalltreeGraphLayout::Node& node, layout.nodes() ) {
+        graphScene->addItem( new CalltreeGraphNodeItem( node, font ) );
+    }
+
+    graphScene->setSceneRect( layout.boundingRect() );
+
+    setGraphScene( graphScene );
+}
+
+/**
+ * @brief CalltreeGraphView::setGraphScene
+ * @param graphScene - the new scene or a null pointer to clear the view
+ *
+ * Attaches the scene to the view and destroys the current scene.
+ */
+void CalltreeGraphView::setGraphScene(QGraphicsScene *graphScene)
+{
     QGraphicsScene* currentScene = scene();
 
-    setScene( g );
+    setScene( graphScene );
 
     centerOn( sceneRect().center() );
 
@@ -141,6 +263,60 @@ void CalltreeGraphView::wheelEvent(QWheelEvent* event)
     QGraphicsView::wheelEvent( event );
 }
 
+#ifndef QT_NO_CONTEXTMENU
+/**
+ * @brief CalltreeGraphView::contextMenuEvent
+ * @param event - the context-menu event details
+ *
+ * This is the handler to receive context-menu events for the widget.  The context menu allows selection of the inclusive time
+ * threshold below which functions are pruned from the calltree graph.
+ */
+void CalltreeGraphView::contextMenuEvent(QContextMenuEvent *event)
+{
+    QMenu menu( this );
+
+    QMenu* pruneMenu = menu.addMenu( tr("Hide Functions Below Inclusive Time") );
+
+    QActionGroup* actionGroup = new QActionGroup( &menu );
+
+    const double thresholds[] = { 0.0, 0.01, 0.05, 0.10, 0.25 };
+
+    for ( std::size_t i=0; i<sizeof(thresholds)/sizeof(thresholds[0]); ++i ) {
+        const QString text = ( thresholds[i] > 0.0 ) ? tr("%1% of Maximum").arg( thresholds[i] * 100.0 ) : tr("Show All Functions");
+
+        QAction* action = new QAction( text, actionGroup );
+        action->setCheckable( true );
+        action->setChecked( qFuzzyCompare( 1.0 + thresholds[i], 1.0 + m_pruneThreshold ) );
+        action->setData( thresholds[i] );
+
+        pruneMenu->addAction( action );
+    }
+
+    connect( actionGroup, SIGNAL(triggered(QAction*)), this, SLOT(handlePruneThresholdTriggered(QAction*)) );
+
+    menu.exec( event->globalPos() );
+}
+#endif // QT_NO_CONTEXTMENU
+
+/**
+ * @brief CalltreeGraphView::handlePruneThresholdTriggered
+ * @param action - the selected prune threshold action
+ *
+ * Handler for selection of a new prune threshold.  The layout of the current calltree graph is recomputed.
+ */
+void CalltreeGraphView::handlePruneThresholdTriggered(QAction *action)
+{
+    const double pruneThreshold = action->data().toDouble();
+
+    if ( qFuzzyCompare( 1.0 + pruneThreshold, 1.0 + m_pruneThreshold ) )
+        return;
+
+    m_pruneThreshold = pruneThreshold;
+
+    if ( ! m_graph.isEmpty() )
+        startLayout();
+}
+
 
 } // GUI
 } // ArgoNavis
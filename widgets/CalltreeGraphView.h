@@ -25,9 +25,15 @@
 #define CALLTREEGRAPHVIEW_H
 
 #include <QGraphicsView>
+#include <QFutureWatcher>
+#include <QByteArray>
 
 #include "common/openss-gui-config.h"
 
+#include "managers/CalltreeGraphLayout.h"
+
+class QAction;
+
 
 namespace ArgoNavis { namespace GUI {
 
@@ -49,6 +55,26 @@ protected:
 
     virtual void wheelEvent(QWheelEvent* event) Q_DECL_OVERRIDE;
 
+#ifndef QT_NO_CONTEXTMENU
+    virtual void contextMenuEvent(QContextMenuEvent* event) Q_DECL_OVERRIDE;
+#endif
+
+private slots:
+
+    void handleLayoutFinished();
+    void handlePruneThresholdTriggered(QAction* action);
+
+private:
+
+    void startLayout();
+    void setGraphScene(QGraphicsScene* graphScene);
+
+    QByteArray m_graph;                 // DOT format data of the current calltree graph
+    double m_pruneThreshold;            // fraction of the largest inclusive time below which functions are pruned
+    bool m_layoutPending;
+
+    QFutureWatcher< CalltreeGraphLayout > m_layoutWatcher;
+
 };
 
 
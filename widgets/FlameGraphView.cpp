@@ -0,0 +1,374 @@
+/*!
+   \file FlameGraphView.cpp
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "FlameGraphView.h"
+
+#include <QPainter>
+#include <QScrollBar>
+#include <QMouseEvent>
+#include <QHelpEvent>
+#include <QContextMenuEvent>
+#include <QMenu>
+#include <QToolTip>
+#include <QFontMetrics>
+
+#include "managers/PerformanceDataManager.h"
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+// the height of each row of frames in pixels
+const int FRAME_HEIGHT = 18;
+
+// frames narrower than this (in pixels) are not drawn and neither is their subtree
+const double MIN_FRAME_WIDTH = 1.0;
+
+// frames narrower than this (in pixels) are drawn without a label
+const double MIN_LABEL_WIDTH = 24.0;
+
+
+/**
+ * @brief FlameGraphView::FlameGraphView
+ * @param parent - the parent widget
+ *
+ * Constructs a FlameGraphView instance of the given parent.
+ */
+FlameGraphView::FlameGraphView(QWidget *parent)
+    : QAbstractScrollArea( parent )
+    , m_rootFrame( 0 )
+{
+    setHorizontalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
+    setVerticalScrollBarPolicy( Qt::ScrollBarAsNeeded );
+
+    // the whole viewport is repainted so the background need not be erased first
+    viewport()->setAttribute( Qt::WA_OpaquePaintEvent );
+
+    // connect performance data manager signals to flame graph view slots
+    PerformanceDataManager* dataMgr = PerformanceDataManager::instance();
+    if ( dataMgr ) {
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+        connect( dataMgr, &PerformanceDataManager::signalDisplayCalltreeFlameGraph, this, &FlameGraphView::handleDisplayFlameGraph );
+#else
+        connect( dataMgr, SIGNAL(signalDisplayCalltreeFlameGraph(FlameGraphData)), this, SLOT(handleDisplayFlameGraph(FlameGraphData)) );
+#endif
+    }
+}
+
+/**
+ * @brief FlameGraphView::~FlameGraphView
+ *
+ * Destroys the FlameGraphView instance.
+ */
+FlameGraphView::~FlameGraphView()
+{
+
+}
+
+/**
+ * @brief FlameGraphView::handleDisplayFlameGraph
+ * @param flameGraph - the flame graph data to display
+ *
+ * This method replaces the flame graph being displayed.  Passing an empty FlameGraphData instance clears the view.
+ */
+void FlameGraphView::handleDisplayFlameGraph(const FlameGraphData &flameGraph)
+{
+    m_flameGraph = flameGraph;
+    m_rootFrame = 0;
+
+    verticalScrollBar()->setValue( 0 );
+
+    updateScrollBar();
+
+    viewport()->update();
+}
+
+/**
+ * @brief FlameGraphView::handleResetZoom
+ *
+ * Zooms out to the root frame of the flame graph.
+ */
+void FlameGraphView::handleResetZoom()
+{
+    m_rootFrame = 0;
+
+    viewport()->update();
+}
+
+/**
+ * @brief FlameGraphView::paintEvent
+ * @param event - the paint event
+ *
+ * Draws the frames of the zoomed subtree which are at least one pixel wide and inside the viewport.  As the frames are in preorder with
+ * precomputed extents, the subtree of a frame which is too narrow or below the viewport is skipped by jumping to the end of its range.
+ */
+void FlameGraphView::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED( event )
+
+    QPainter painter( viewport() );
+
+    painter.fillRect( viewport()->rect(), palette().base() );
+
+    if ( m_flameGraph.isEmpty() )
+        return;
+
+    const FlameGraphData::Frame& root = m_flameGraph.frame( m_rootFrame );
+
+    if ( root.value <= 0.0 )
+        return;
+
+    const double viewportWidth = viewport()->width();
+    const double scale = viewportWidth / root.value;
+    const int top = verticalScrollBar()->value();
+
+    // the ancestors of the zoomed frame span the full width
+    for ( quint32 index = root.parent; index != FlameGraphData::NO_FRAME; index = m_flameGraph.frame( index ).parent ) {
+        drawFrame( painter, index, 0.0, viewportWidth );
+    }
+
+    int index = m_rootFrame;
+
+    while ( index < (int) root.end ) {
+        const FlameGraphData::Frame& frame = m_flameGraph.frame( index );
+
+        const double width = frame.value * scale;
+        const int y = frame.depth * FRAME_HEIGHT - top;
+
+        // the frames of the subtree are no wider and are all lower than this frame
+        if ( width < MIN_FRAME_WIDTH || y >= viewport()->height() ) {
+            index = frame.end;
+            continue;
+        }
+
+        if ( y + FRAME_HEIGHT > 0 ) {
+            drawFrame( painter, index, ( frame.start - root.start ) * scale, width );
+        }
+
+        ++index;
+    }
+}
+
+/**
+ * @brief FlameGraphView::drawFrame
+ * @param painter - the painter
+ * @param index - the frame index
+ * @param x - the left edge of the frame in viewport coordinates
+ * @param width - the width of the frame in pixels
+ *
+ * Draws a single frame with its label elided to fit in the frame.
+ */
+void FlameGraphView::drawFrame(QPainter &painter, int index, double x, double width) const
+{
+    const FlameGraphData::Frame& frame = m_flameGraph.frame( index );
+
+    const QString name = m_flameGraph.frameName( index );
+
+    const QRectF rect( x, frame.depth * FRAME_HEIGHT - verticalScrollBar()->value(), width, FRAME_HEIGHT - 1 );
+
+    painter.fillRect( rect, frameColor( name ) );
+
+    if ( width >= MIN_LABEL_WIDTH ) {
+        const QString label = painter.fontMetrics().elidedText( name, Qt::ElideRight, width - 4 );
+        painter.setPen( Qt::black );
+        painter.drawText( rect.adjusted( 2, 0, -2, 0 ), Qt::AlignLeft | Qt::AlignVCenter, label );
+    }
+}
+
+/**
+ * @brief FlameGraphView::frameColor
+ * @param name - the function name
+ * @return - the fill color of the frames of the function
+ *
+ * Frames are colored with a warm color derived from the function name so that a function has the same color throughout the graph.
+ */
+QColor FlameGraphView::frameColor(const QString &name)
+{
+    const uint hash = qHash( name );
+
+    return QColor::fromHsv( hash % 55, 130 + ( hash >> 8 ) % 100, 230 + ( hash >> 16 ) % 26 );
+}
+
+/**
+ * @brief FlameGraphView::frameAt
+ * @param pos - a position in viewport coordinates
+ * @return - the index of the frame at the position or -1 if there is none
+ */
+int FlameGraphView::frameAt(const QPoint &pos) const
+{
+    if ( m_flameGraph.isEmpty() || pos.x() < 0 || pos.x() >= viewport()->width() || pos.y() < 0 )
+        return -1;
+
+    const FlameGraphData::Frame& root = m_flameGraph.frame( m_rootFrame );
+
+    if ( root.value <= 0.0 )
+        return -1;
+
+    const quint32 depth = ( pos.y() + verticalScrollBar()->value() ) / FRAME_HEIGHT;
+
+    int index = m_rootFrame;
+
+    // the ancestors of the zoomed frame span the full width
+    if ( depth <= root.depth ) {
+        while ( m_flameGraph.frame( index ).depth > depth )
+            index = m_flameGraph.frame( index ).parent;
+        return index;
+    }
+
+    const double value = root.start + pos.x() * root.value / viewport()->width();
+
+    // descend through the children containing the position
+    while ( m_flameGraph.frame( index ).depth < depth ) {
+        const FlameGraphData::Frame& frame = m_flameGraph.frame( index );
+
+        int child = index + 1;
+        while ( child < (int) frame.end ) {
+            const FlameGraphData::Frame& childFrame = m_flameGraph.frame( child );
+            if ( value >= childFrame.start && value < childFrame.start + childFrame.value )
+                break;
+            child = childFrame.end;
+        }
+
+        if ( child >= (int) frame.end )
+            return -1;
+
+        index = child;
+    }
+
+    return index;
+}
+
+/**
+ * @brief FlameGraphView::updateScrollBar
+ *
+ * Updates the vertical scroll bar range for the depth of the flame graph and the height of the viewport.
+ */
+void FlameGraphView::updateScrollBar()
+{
+    const int height = ( m_flameGraph.isEmpty() ) ? 0 : ( m_flameGraph.maxDepth() + 1 ) * FRAME_HEIGHT;
+
+    verticalScrollBar()->setRange( 0, qMax( 0, height - viewport()->height() ) );
+    verticalScrollBar()->setPageStep( viewport()->height() );
+    verticalScrollBar()->setSingleStep( FRAME_HEIGHT );
+}
+
+/**
+ * @brief FlameGraphView::resizeEvent
+ * @param event - the resize event
+ */
+void FlameGraphView::resizeEvent(QResizeEvent *event)
+{
+    QAbstractScrollArea::resizeEvent( event );
+
+    updateScrollBar();
+}
+
+/**
+ * @brief FlameGraphView::scrollContentsBy
+ * @param dx - the horizontal scroll amount
+ * @param dy - the vertical scroll amount
+ */
+void FlameGraphView::scrollContentsBy(int dx, int dy)
+{
+    Q_UNUSED( dx )
+    Q_UNUSED( dy )
+
+    viewport()->update();
+}
+
+/**
+ * @brief FlameGraphView::mousePressEvent
+ * @param event - the mouse event
+ *
+ * Clicking a frame zooms into the frame.  Clicking an ancestor of the zoomed frame zooms out to it.
+ */
+void FlameGraphView::mousePressEvent(QMouseEvent *event)
+{
+    if ( event->button() == Qt::LeftButton ) {
+        const int index = frameAt( event->pos() );
+
+        if ( index >= 0 && index != m_rootFrame ) {
+            m_rootFrame = index;
+            viewport()->update();
+        }
+    }
+
+    QAbstractScrollArea::mousePressEvent( event );
+}
+
+/**
+ * @brief FlameGraphView::viewportEvent
+ * @param event - the viewport event
+ * @return - whether the event was handled
+ *
+ * Shows the function name, value and percentage of the total of the frame under the mouse as a tooltip.
+ */
+bool FlameGraphView::viewportEvent(QEvent *event)
+{
+    if ( event->type() == QEvent::ToolTip ) {
+        QHelpEvent* helpEvent = static_cast< QHelpEvent* >( event );
+
+        const int index = frameAt( helpEvent->pos() );
+
+        if ( index >= 0 ) {
+            const double value = m_flameGraph.frame( index ).value;
+            const double total = m_flameGraph.frame( 0 ).value;
+
+            QToolTip::showText( helpEvent->globalPos(),
+                                QString( "%1\n%2 (%3%)" ).arg( m_flameGraph.frameName( index ) )
+                                                          .arg( value, 0, 'f', 3 )
+                                                          .arg( ( total > 0.0 ) ? 100.0 * value / total : 0.0, 0, 'f', 2 ),
+                                viewport() );
+        }
+        else {
+            QToolTip::hideText();
+            event->ignore();
+        }
+
+        return true;
+    }
+
+    return QAbstractScrollArea::viewportEvent( event );
+}
+
+#ifndef QT_NO_CONTEXTMENU
+/**
+ * @brief FlameGraphView::contextMenuEvent
+ * @param event - the context-menu event details
+ *
+ * This is the handler to receive context-menu events for the widget.  The context menu allows zooming out to the root frame.
+ */
+void FlameGraphView::contextMenuEvent(QContextMenuEvent *event)
+{
+    QMenu menu( this );
+
+    QAction* resetAction = menu.addAction( tr("Reset Zoom"), this, SLOT(handleResetZoom()) );
+    resetAction->setEnabled( m_rootFrame != 0 );
+
+    menu.exec( event->globalPos() );
+}
+#endif
+
+
+} // GUI
+} // ArgoNavis
@@ -0,0 +1,91 @@
+/*!
+   \file FlameGraphView.h
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef FLAMEGRAPHVIEW_H
+#define FLAMEGRAPHVIEW_H
+
+#include <QAbstractScrollArea>
+
+#include "common/openss-gui-config.h"
+
+#include "managers/FlameGraphData.h"
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/*!
+ * \brief The FlameGraphView class
+ *
+ * Displays the calltree as a flame graph in icicle orientation (the root frame at the top).  Only frames at least one pixel wide inside
+ * the viewport are drawn; the subtree of a narrower or lower frame is skipped as a whole.  Clicking a frame zooms into it by making it
+ * the root of the displayed subtree; the ancestors of the zoomed frame are drawn across the full width above it.
+ */
+
+class FlameGraphView : public QAbstractScrollArea
+{
+    Q_OBJECT
+
+public:
+
+    explicit FlameGraphView(QWidget *parent = 0);
+    virtual ~FlameGraphView();
+
+public slots:
+
+    void handleDisplayFlameGraph(const FlameGraphData& flameGraph);
+
+protected:
+
+    virtual void paintEvent(QPaintEvent* event) Q_DECL_OVERRIDE;
+    virtual void resizeEvent(QResizeEvent* event) Q_DECL_OVERRIDE;
+    virtual void mousePressEvent(QMouseEvent* event) Q_DECL_OVERRIDE;
+    virtual bool viewportEvent(QEvent* event) Q_DECL_OVERRIDE;
+    virtual void scrollContentsBy(int dx, int dy) Q_DECL_OVERRIDE;
+
+#ifndef QT_NO_CONTEXTMENU
+    virtual void contextMenuEvent(QContextMenuEvent* event) Q_DECL_OVERRIDE;
+#endif
+
+private slots:
+
+    void handleResetZoom();
+
+private:
+
+    int frameAt(const QPoint& pos) const;
+    void drawFrame(QPainter& painter, int index, double x, double width) const;
+    void updateScrollBar();
+
+    static QColor frameColor(const QString& name);
+
+    FlameGraphData m_flameGraph;
+    int m_rootFrame;                    // the frame zoomed into
+
+};
+
+
+} // GUI
+} // ArgoNavis
+
+#endif // FLAMEGRAPHVIEW_H
@@ -26,6 +26,7 @@
 #include "ui_MetricViewManager.h"
 
 #include "CBTF-ArgoNavis-Ext/NameValueDefines.h"
+#include "managers/FlameGraphData.h"
 
 #include <QDebug>
 
@@ -88,14 +89,14 @@ void MetricViewManager::handleMetricViewChanged(const QString &metricView)
     const QString modeName = metricView.section( QChar('-'), 0, 0 );
 
     if ( modeName == QStringLiteral("CallTree") ) {
-        setCurrentWidget( ui->widget_CalltreeGraphView );
+        setCurrentWidget( ui->tabWidget_CalltreeViews );
     }
     else {
         // if not calltree mode active then switch to default view
         if ( TIMELINE_VIEW == m_defaultView && currentWidget() != ui->widget_MetricTimelineView )
             setCurrentWidget( ui->widget_MetricTimelineView );
-        else if ( CALLTREE_VIEW == m_defaultView && currentWidget() != ui->widget_CalltreeGraphView )
-            setCurrentWidget( ui->widget_CalltreeGraphView );
+        else if ( CALLTREE_VIEW == m_defaultView && currentWidget() != ui->tabWidget_CalltreeViews )
+            setCurrentWidget( ui->tabWidget_CalltreeViews );
         else if ( GRAPH_VIEW == m_defaultView && currentWidget() != ui->widget_MetricGraphView )
             setCurrentWidget( ui->widget_MetricGraphView );
     }
@@ -114,6 +115,7 @@ void MetricViewManager::unloadExperimentDataFromView(const QString &experimentNa
     ui->widget_MetricTimelineView->unloadExperimentDataFromView( experimentName );
     ui->widget_MetricGraphView->unloadExperimentDataFromView( experimentName );
     ui->widget_CalltreeGraphView->handleDisplayGraphView( QString() );
+    ui->widget_FlameGraphView->handleDisplayFlameGraph( FlameGraphData() );
 
     // switch back to default view
     handleMetricViewChanged( QString() );
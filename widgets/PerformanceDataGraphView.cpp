@@ -30,6 +30,8 @@
 #include <ui_PerformanceDataGraphView.h>
 
 #include <QVector>
+#include <QMenu>
+#include <QInputDialog>
 
 #include <cmath>
 
@@ -100,23 +102,19 @@ PerformanceDataGraphView::PerformanceDataGraphView(QWidget *parent)
                  this, &PerformanceDataGraphView::handleInitGraphView );
         connect( dataMgr, static_cast<void(PerformanceDataManager::*)(const QString &metricName, const QString &viewName, const QString &eventName, int itemIndex, double data)>(&PerformanceDataManager::addGraphItem),
                  this, static_cast<void(PerformanceDataGraphView::*)(const QString &metricName, const QString &viewName, const QString &eventName, int itemIndex, double data)>(&PerformanceDataGraphView::handleAddGraphItem) );
-        connect( dataMgr, static_cast<void(PerformanceDataManager::*)(const QString &clusteringCriteriaName, const QString &metricNameTitle, const QString &metricName, double eventTime, double eventData, int rankOrThread)>(&PerformanceDataManager::addGraphItem),
-                 this, static_cast<void(PerformanceDataGraphView::*)(const QString &clusteringCriteriaName, const QString &metricNameTitle, const QString &metricName, double eventTime, double eventData, int rankOrThread)>(&PerformanceDataGraphView::handleAddGraphItem) );
+        connect( dataMgr, &PerformanceDataManager::signalDisplayGraphEnvelope,
+                 this, &PerformanceDataGraphView::handleDisplayGraphEnvelope, Qt::QueuedConnection );
         connect( dataMgr, &PerformanceDataManager::requestMetricViewComplete,
                  this, &PerformanceDataGraphView::handleRequestMetricViewComplete, Qt::QueuedConnection );
-        connect( dataMgr, &PerformanceDataManager::signalGraphMinAvgMaxRanks,
-                 this, &PerformanceDataGraphView::handleGraphMinAvgMaxRanks, Qt::QueuedConnection );
 #else
         connect( dataMgr, SIGNAL(createGraphItems(QString,QString,QString,QString,QStringList,QStringList)),
                  this, SLOT(handleInitGraphView(QString,QString,QString,QString,QStringList,QStringList)) );
-        connect( dataMgr, SIGNAL(addGraphItem(QString,QString,QString,double,double,int)),
-                 this, SLOT(handleAddGraphItem(QString,QString,QString,double,double,int)) );
+        connect( dataMgr, SIGNAL(signalDisplayGraphEnvelope(QString,QString,QString,RankEnvelopeData)),
+                 this, SLOT(handleDisplayGraphEnvelope(QString,QString,QString,RankEnvelopeData)), Qt::QueuedConnection );
         connect( dataMgr, SIGNAL(addGraphItem(QString,QString,QString,int,double)),
                  this, SLOT(handleAddGraphItem(QString,QString,QString,int,double)) );
         connect( dataMgr, SIGNAL(requestMetricViewComplete(QString,QString,QString,QString,double,double)),
                  this, SLOT(handleRequestMetricViewComplete(QString,QString,QString,QString,double,double)), Qt::QueuedConnection );
-        connect( dataMgr, SIGNAL(signalGraphMinAvgMaxRanks(QString,int,int,int)),
-                 this, SLOT(handleGraphMinAvgMaxRanks(QString,int,int,int)), Qt::QueuedConnection );
 #endif
     }
 }
@@ -191,6 +189,9 @@ CustomPlot *PerformanceDataGraphView::initPlotView(const QString &clusteringCrit
     // connect slot that ties some axis selections together (especially opposite axes):
     connect( graphView, SIGNAL(selectionChangedByUser()), this, SLOT(handleSelectionChanged()) );
 
+    // connect slot that updates the decimated line graph data for the visible range before each replot
+    connect( graphView, SIGNAL(beforeReplot()), this, SLOT(handleBeforeReplot()) );
+
     // get axis rect for this metric
     QCPAxisRect *axisRect = graphView->axisRect();
 
@@ -204,6 +205,10 @@ CustomPlot *PerformanceDataGraphView::initPlotView(const QString &clusteringCrit
     else {
         // legend is located at the top left of axis rect
         axisRect->insetLayout()->setInsetAlignment( 0, Qt::AlignLeft|Qt::AlignTop );
+
+        // the context menu allows showing the graph of any rank
+        graphView->setContextMenuPolicy( Qt::CustomContextMenu );
+        connect( graphView, SIGNAL(customContextMenuRequested(QPoint)), this, SLOT(handleCustomContextMenuRequested(QPoint)) );
     }
 
     // initialize legend
@@ -690,60 +695,232 @@ void PerformanceDataGraphView::handleAxisRangeChange(const QCPRange &requestedRa
 }
 
 /**
- * @brief PerformanceDataGraphView::handleAddGraphItem
+ * @brief PerformanceDataGraphView::handleBeforeReplot
+ *
+ * Before the line graphs are replotted, the data of each graph is replaced by its raw data points decimated to the visible x-axis
+ * range and the width of the axis rect.  The decimated data is only recomputed when the range, the width or the raw data changed.
+ */
+void PerformanceDataGraphView::handleBeforeReplot()
+{
+    // get the sender instance - should be a QCustomPlot instance
+    QCustomPlot* graphView = qobject_cast< QCustomPlot* >( sender() );
+
+    if ( ! graphView )
+        return;
+
+    QCPAxisRect* axisRect = graphView->axisRect();
+
+    if ( ! axisRect )
+        return;
+
+    const QCPRange range = axisRect->axis( QCPAxis::atBottom )->range();
+    const int width = axisRect->width();
+
+    QMutexLocker guard( &m_mutex );
+
+    const QString metricName = graphView->objectName();
+
+    if ( ! m_metricGroup.contains( metricName ) )
+        return;
+
+    MetricGroup& metricGroup = m_metricGroup[ metricName ];
+
+    for ( QMap< int, OSSDecimatedSeries >::iterator iter = metricGroup.series.begin(); iter != metricGroup.series.end(); ++iter ) {
+        iter.value().updateGraph( metricGroup.subgraphs.value( iter.key(), Q_NULLPTR ), range, width );
+    }
+}
+
+/**
+ * @brief PerformanceDataGraphView::handleDisplayGraphEnvelope
  * @param clusteringCriteriaName - the clustering criteria name
  * @param metricNameTitle - the displayed metric name (for graph title on tab widget)
  * @param metricName - the metric name
- * @param eventTime - the time of the event
- * @param eventData - the metric data for the event
- * @param rankOrThread - the rank or thread id in which the trace event occurred
+ * @param envelope - the envelope across all ranks and the raw data points of every rank
+ *
+ * This method handles the display of a per-rank line graph summarized by the PerformanceDataManager.  Rather than a graph for every
+ * rank, the graph shows the band between the minimum and maximum values of all ranks, the mean of the per-rank mean values, the graph
+ * of rank 0 and the graphs of the ranks with the smallest, closest to average and largest peak values.  The graph of any other rank is
+ * only created when the user asks for it (see handleCustomContextMenuRequested).
+ */
+void PerformanceDataGraphView::handleDisplayGraphEnvelope(const QString &clusteringCriteriaName, const QString &metricNameTitle, const QString &metricName, const RankEnvelopeData &envelope)
+{
+    if ( envelope.isEmpty() )
+        return;
+
+    QMutexLocker guard( &m_mutex );
+
+    if ( ! m_metricGroup.contains( metricName ) ) {
+        CustomPlot* graphView = initPlotView( clusteringCriteriaName, metricNameTitle, metricName, false );
+
+        if ( ! graphView )
+            return;
+
+        m_metricGroup.insert( metricName, MetricGroup( graphView ) );
+    }
+
+    MetricGroup& metricGroup = m_metricGroup[ metricName ];
+
+    CustomPlot* graphView = metricGroup.graph;
+
+    metricGroup.envelope = envelope;
+
+    if ( metricGroup.yGraphRange.upper < envelope.maxValue() ) {
+        metricGroup.yGraphRange.upper = envelope.maxValue();
+    }
+
+    // the band between the minimum and maximum values of all ranks and the line of the mean value of all ranks
+    QCPGraph* minGraph = graphView->addGraph();
+    QCPGraph* maxGraph = graphView->addGraph();
+    QCPGraph* meanGraph = graphView->addGraph();
+
+    if ( ! minGraph || ! maxGraph || ! meanGraph )
+        return;
+
+    foreach ( QCPGraph* graph, QList< QCPGraph* >() << minGraph << maxGraph << meanGraph ) {
+#if defined(HAS_QCUSTOMPLOT_V2)
+        graph->setSelectable( QCP::stNone );
+#else
+        graph->setSelectable( false );
+#endif
+    }
+
+    minGraph->setPen( QPen( QColor( 255, 255, 255, 80 ), 1.0 ) );
+    maxGraph->setPen( QPen( QColor( 255, 255, 255, 80 ), 1.0 ) );
+    maxGraph->setBrush( QColor( 255, 255, 255, 40 ) );
+    maxGraph->setChannelFillGraph( minGraph );
+    meanGraph->setPen( QPen( Qt::white, 1.0, Qt::DashLine ) );
+
+#if defined(HAS_QCUSTOMPLOT_V2)
+    minGraph->setData( envelope.envelopeTimes(), envelope.envelopeMin(), true );
+    maxGraph->setData( envelope.envelopeTimes(), envelope.envelopeMax(), true );
+    meanGraph->setData( envelope.envelopeTimes(), envelope.envelopeMean(), true );
+#else
+    minGraph->setData( envelope.envelopeTimes(), envelope.envelopeMin() );
+    maxGraph->setData( envelope.envelopeTimes(), envelope.envelopeMax() );
+    meanGraph->setData( envelope.envelopeTimes(), envelope.envelopeMean() );
+#endif
+
+    maxGraph->setName( QString("Min - Max (%1 Ranks)").arg( envelope.rankCount() ) );
+    meanGraph->setName( QStringLiteral("Mean") );
+
+    maxGraph->addToLegend();
+    meanGraph->addToLegend();
+
+    // the graphs of the representative ranks - a rank may represent more than one - and of rank 0 which is always shown
+    QMap< int, QStringList > representativeRanks;
+    if ( envelope.hasRank( 0 ) )
+        representativeRanks[ 0 ];
+    representativeRanks[ envelope.rankWithMinValue() ] << QStringLiteral("Min");
+    representativeRanks[ envelope.rankClosestToAvgValue() ] << QStringLiteral("Avg");
+    representativeRanks[ envelope.rankWithMaxValue() ] << QStringLiteral("Max");
+
+    for ( QMap< int, QStringList >::iterator iter = representativeRanks.begin(); iter != representativeRanks.end(); ++iter ) {
+        QCPGraph* graph = showRank( metricGroup, iter.key() );
+
+        if ( graph ) {
+            if ( iter.value().isEmpty() )
+                graph->setName( QString("Rank %1").arg( iter.key() ) );
+            else
+                graph->setName( QString("Rank %1 (%2)").arg( iter.key() ).arg( iter.value().join( QStringLiteral("/") ) ) );
+            graph->addToLegend();
+        }
+    }
+}
+
+/**
+ * @brief PerformanceDataGraphView::showRank
+ * @param metricGroup - the metric group
+ * @param rankOrThread - the rank or thread id
+ * @return - the graph instance of the rank (or null if the rank has no data points)
+ *
+ * This method creates the graph of the rank from its raw data points retained in the envelope of the metric group, unless the graph
+ * already exists.
+ */
+QCPGraph *PerformanceDataGraphView::showRank(MetricGroup &metricGroup, int rankOrThread)
+{
+    if ( metricGroup.subgraphs.contains( rankOrThread ) )
+        return metricGroup.subgraphs[ rankOrThread ];
+
+    if ( ! metricGroup.envelope.hasRank( rankOrThread ) )
+        return Q_NULLPTR;
+
+    QCPGraph* graph = initGraph( metricGroup.graph, rankOrThread );
+
+    if ( graph ) {
+        // set plot colors for new graph
+        graph->setPen( QPen( goldenRatioColor( metricGroup.mt ), 2.0 ) );
+
+        metricGroup.subgraphs.insert( rankOrThread, graph );
+
+        // the raw data points are passed to the graph decimated at the next replot
+        metricGroup.series[ rankOrThread ].setData( metricGroup.envelope.times( rankOrThread ), metricGroup.envelope.values( rankOrThread ) );
+    }
+
+    return graph;
+}
+
+/**
+ * @brief PerformanceDataGraphView::handleCustomContextMenuRequested
+ * @param pos - the position of the context menu request in the graph view
  *
- * This method handles adding a graph item to the graph (if it hasn't been created yet) and then adds the data to the graph.
+ * Shows the context menu of a line graph.  The "Show Rank..." action asks for a rank and adds the graph of the rank.
  */
-void PerformanceDataGraphView::handleAddGraphItem(const QString &clusteringCriteriaName, const QString &metricNameTitle, const QString &metricName, double eventTime, double eventData, int rankOrThread)
+void PerformanceDataGraphView::handleCustomContextMenuRequested(const QPoint &pos)
 {
-    Q_UNUSED( rankOrThread );
+    // get the sender instance - should be a QCustomPlot instance
+    QCustomPlot* graphView = qobject_cast< QCustomPlot* >( sender() );
+
+    if ( ! graphView )
+        return;
 
-    CustomPlot* graphView( Q_NULLPTR);
+    const QString metricName = graphView->objectName();
+
+    QList< int > ranks;
 
     {
         QMutexLocker guard( &m_mutex );
 
-        if ( ! m_metricGroup.contains( metricName ) ) {
+        if ( ! m_metricGroup.contains( metricName ) )
+            return;
 
-            graphView = initPlotView( clusteringCriteriaName, metricNameTitle, metricName, false );
+        ranks = m_metricGroup[ metricName ].envelope.ranks();
+    }
 
-            m_metricGroup.insert( metricName, MetricGroup( graphView ) );
-        }
-        else {
-            // get graph index for cluster
-            graphView = m_metricGroup[ metricName ].graph;
-        }
+    if ( ranks.isEmpty() )
+        return;
 
-        MetricGroup& metricGroup = m_metricGroup[ metricName ];
+    QMenu menu( graphView );
 
-        if ( metricGroup.yGraphRange.upper < eventData ) {
-            metricGroup.yGraphRange.upper = eventData;
-        }
+    QAction* showRankAction = menu.addAction( tr("Show Rank...") );
 
-        QCPGraph* graph( Q_NULLPTR );
+    if ( menu.exec( graphView->mapToGlobal( pos ) ) != showRankAction )
+        return;
 
-        if ( metricGroup.subgraphs.contains( rankOrThread ) ) {
-            graph = metricGroup.subgraphs[ rankOrThread ];
-        }
-        else {
-            graph = initGraph( graphView, rankOrThread );
+    bool ok;
+    const int rank = QInputDialog::getInt( this, tr("Show Rank"), tr("Rank:"), ranks.first(), ranks.first(), ranks.last(), 1, &ok );
 
-            // set plot colors for new graph
-            graph->setPen( QPen( goldenRatioColor( metricGroup.mt ), 2.0 ) );
+    if ( ! ok )
+        return;
+
+    {
+        QMutexLocker guard( &m_mutex );
+
+        if ( ! m_metricGroup.contains( metricName ) )
+            return;
+
+        QCPGraph* graph = showRank( m_metricGroup[ metricName ], rank );
 
-            metricGroup.subgraphs.insert( rankOrThread, graph );
-        }
         if ( graph ) {
-            // pass data points to graphs
-            graph->addData( eventTime, eventData );
+            graph->addToLegend();
         }
     }
+
+    // force graph replot
+#if defined(HAS_QCUSTOMPLOT_V2)
+    graphView->replot( QCustomPlot::rpQueuedReplot );
+#else
+    graphView->replot();
+#endif
 }
 
 /**
@@ -783,70 +960,6 @@ void PerformanceDataGraphView::handleAddGraphItem(const QString &metricName, con
     }
 }
 
-/**
- * @brief PerformanceDataGraphView::handleGraphMinAvgMaxRanks
- * @param metricName - the metric name
- * @param rankWithMinValue - rank containing smallest metric value for graph
- * @param rankClosestToAvgValue - rank closest to averagec metric value for graph
- * @param rankWithMaxValue - rank containing largest metric value for graph
- *
- * This slot handles the PerformanceDataManager::signalGraphMinAvgMaxRanks signal.  If this signal is emitted only the unique set of ranks
- * identified by the parameters (rank with minimum value, rank closest to the average value and the rank with maximum value) as well as
- * rank 0 are shown in the graph.  All other graphs that may have been added for other ranks are removed.  The legend will show all these
- * ranks.
- */
-void PerformanceDataGraphView::handleGraphMinAvgMaxRanks(const QString &metricName, int rankWithMinValue, int rankClosestToAvgValue, int rankWithMaxValue)
-{
-    if ( metricName.isEmpty() )
-        return;
-
-    QMutexLocker guard( &m_mutex );
-
-    if ( ! m_metricGroup.contains( metricName ) )
-        return;
-
-    MetricGroup& metricGroup = m_metricGroup[ metricName ];
-
-    QCustomPlot* graphView = metricGroup.graph;
-
-    if ( graphView ) {
-
-        QSet< int > desiredRankSet;
-        desiredRankSet << 0 << rankWithMinValue << rankClosestToAvgValue << rankWithMaxValue;
-
-        for ( int i=graphView->graphCount(); i>=0; --i ) {
-            if ( metricGroup.subgraphs.contains( i ) ) {
-                QCPGraph* graph = metricGroup.subgraphs[ i ];
-                if ( ! desiredRankSet.contains( i ) ) {
-                    graph->removeFromLegend();
-                    graphView->removeGraph( graph );
-                }
-                else {
-                    // change name of graph
-                    if ( i == rankWithMinValue ) {
-                        graph->setName( QString("Rank %1 (Min)").arg( i ) );
-                    }
-                    else if ( i == rankClosestToAvgValue ) {
-                        graph->setName( QString("Rank %1 (Avg)").arg( i ) );
-                    }
-                    else if ( i == rankWithMaxValue ) {
-                        graph->setName( QString("Rank %1 (Max)").arg( i ) );
-                    }
-                    // add legend items only for the desired rank set
-                    graph->addToLegend();
-                }
-            }
-        }
-
-        // force graph replot
-#if defined(HAS_QCUSTOMPLOT_V2)
-        graphView->replot( QCustomPlot::rpQueuedReplot );
-#else
-        graphView->replot();
-#endif
-    }
-}
-
 /**
  * @brief PerformanceDataGraphView::handleRequestMetricViewComplete
  * @param clusteringCriteriaName - the name of the cluster criteria
@@ -34,6 +34,9 @@
 
 #include "common/openss-gui-config.h"
 
+#include "graphitems/OSSDecimatedSeries.h"
+#include "managers/RankEnvelopeData.h"
+
 namespace Ui {
 class PerformanceDataGraphView;
 }
@@ -66,12 +69,10 @@ private slots:
                              const QStringList &eventNames,
                              const QStringList &items);
 
-    void handleAddGraphItem(const QString &clusteringCriteriaName,
-                            const QString &metricNameTitle,
-                            const QString &metricName,
-                            double eventTime,
-                            double eventData,
-                            int rankOrThread);
+    void handleDisplayGraphEnvelope(const QString &clusteringCriteriaName,
+                                    const QString &metricNameTitle,
+                                    const QString &metricName,
+                                    const RankEnvelopeData &envelope);
 
     void handleAddGraphItem(const QString &metricName,
                             const QString &viewName,
@@ -79,13 +80,12 @@ private slots:
                             int itemIndex,
                             double data);
 
-    void handleGraphMinAvgMaxRanks(const QString &metricName,
-                                   int rankWithMinValue,
-                                   int rankClosestToAvgValue,
-                                   int rankWithMaxValue);
-
     void handleAxisRangeChange(const QCPRange &requestedRange);
 
+    void handleBeforeReplot();
+
+    void handleCustomContextMenuRequested(const QPoint &pos);
+
     void handleRequestMetricViewComplete(const QString &clusteringCriteriaName,
                                          const QString &modeName,
                                          const QString &metricName,
@@ -115,6 +115,8 @@ private:
         QCPRange yGraphRange;      // time range for metric group
         CustomPlot* graph;         // the QCustomPlot instance
         QMap< int, QCPGraph* > subgraphs;  // QCPGraph instance for rank/process
+        QMap< int, OSSDecimatedSeries > series;  // raw data points for rank/process fed decimated to the QCPGraph instance
+        RankEnvelopeData envelope;         // the envelope across all ranks and the raw data points of every rank
         QMap< QString, QCPBars* > bars;    // QCPBars instance for each event
         QVector< QPair< QString, QString > > items;    // list of individually graphed items along x-axis: value=[full name, elided name]
         bool legendItemAdded;              // legend item added
@@ -126,6 +128,8 @@ private:
             : graph( Q_NULLPTR ), legendItemAdded( false ), mt( 2560000 ), completed( false ) { }
     } MetricGroup;
 
+    QCPGraph* showRank(MetricGroup& metricGroup, int rankOrThread);
+
     QMap< QString, MetricGroup > m_metricGroup;
 
 };
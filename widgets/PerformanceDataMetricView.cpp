@@ -26,6 +26,8 @@
 #include "common/openss-gui-config.h"
 
 #include "ViewSortFilterProxyModel.h"
+#include "TraceSliceProxyModel.h"
+#include "TraceRowIndex.h"
 #include "MetricViewDelegate.h"
 
 #include "managers/PerformanceDataManager.h"
@@ -139,15 +141,21 @@ PerformanceDataMetricView::PerformanceDataMetricView(QWidget *parent)
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
         connect( dataMgr, &PerformanceDataManager::addMetricView, this, &PerformanceDataMetricView::handleInitModel, Qt::QueuedConnection );
         connect( dataMgr, &PerformanceDataManager::addAssociatedMetricView, this, &PerformanceDataMetricView::handleInitModelView, Qt::QueuedConnection );
+        connect( dataMgr, &PerformanceDataManager::addDeferredMetrics, this, &PerformanceDataMetricView::handleAddDeferredMetrics, Qt::QueuedConnection );
         connect( dataMgr, &PerformanceDataManager::addMetricViewData, this, &PerformanceDataMetricView::handleAddData, Qt::QueuedConnection );
+        connect( dataMgr, &PerformanceDataManager::addTraceViewData, this, &PerformanceDataMetricView::handleAddTraceData, Qt::QueuedConnection );
         connect( dataMgr, &PerformanceDataManager::requestMetricViewComplete, this, &PerformanceDataMetricView::handleRequestMetricViewComplete, Qt::QueuedConnection );
 #else
         connect( dataMgr, SIGNAL(addMetricView(QString,QString,QString,QString,QStringList)),
                  this, SLOT(handleInitModel(QString,QString,QString,QString,QStringList)), Qt::QueuedConnection );
         connect( dataMgr, SIGNAL(addAssociatedMetricView(QString,QString,QString,QString,QString,QStringList)),
                  this, SLOT(handleInitModelView(QString,QString,QString,QString,QString,QStringList)), Qt::QueuedConnection );
+        connect( dataMgr, SIGNAL(addDeferredMetrics(QString,QStringList)),
+                 this, SLOT(handleAddDeferredMetrics(QString,QStringList)), Qt::QueuedConnection );
         connect( dataMgr, SIGNAL(addMetricViewData(QString,QString,QString,QString,QVariantList,QStringList)),
                  this, SLOT(handleAddData(QString,QString,QString,QString,QVariantList,QStringList)), Qt::QueuedConnection );
+        connect( dataMgr, SIGNAL(addTraceViewData(QString,QString,QString,QString,QString,QVector<QVariantList>)),
+                 this, SLOT(handleAddTraceData(QString,QString,QString,QString,QString,QVector<QVariantList>)), Qt::QueuedConnection );
         connect( dataMgr, SIGNAL(requestMetricViewComplete(QString,QString,QString,QString,double,double)),
                  this, SLOT(handleRequestMetricViewComplete(QString,QString,QString,QString,double,double)), Qt::QueuedConnection );
 #endif
@@ -263,6 +271,8 @@ void PerformanceDataMetricView::deleteAllModelsViews()
 
         qDeleteAll( m_proxyModels );
         m_proxyModels.clear();
+
+        m_traceRowIndexes.clear();
     }
 
     PerformanceDataManager* dataMgr = PerformanceDataManager::instance();
@@ -451,6 +461,7 @@ void PerformanceDataMetricView::clearExistingModelsAndViews(const QString& metri
             m_models.remove( metricViewName );
             delete model;
         }
+        m_traceRowIndexes.remove( metricViewName );
     }
 
     if ( deleteView ) {
@@ -493,6 +504,12 @@ void PerformanceDataMetricView::handleInitModel(const QString& clusteringCriteri
 
     m_models[ metricViewName ] = model;
 
+    // the rows of a trace events model are indexed by traced function as they are added
+    if ( s_traceModeName == modeName && metrics.contains( QStringLiteral("Time Begin (ms)") ) ) {
+        QMutexLocker guard( &m_mutex );
+        m_traceRowIndexes[ metricViewName ] = QSharedPointer< TraceRowIndex >( new TraceRowIndex );
+    }
+
     if ( s_detailsModeName == metricName  )
         return;
 
@@ -586,10 +603,44 @@ void PerformanceDataMetricView::handleInitModel(const QString& clusteringCriteri
         m_traceModeMetricModel.appendRow ( new QStandardItem( metricName ) );
     }
 
-    // initialize this as the current view only when the blank view is active
-    if ( m_viewStack->currentWidget() == m_views[ s_noneName ] ) {
+    // initialize this as the current view only when the blank view is active - metric mode views may also be prefetched
+    // in the background, so in that case only when the view matches the current selection
+    if ( m_viewStack->currentWidget() == m_views[ s_noneName ] &&
+         ( modeName != s_metricModeName || metricViewName == getMetricViewName() ) ) {
         m_viewStack->setCurrentWidget( view );
+
+        PerformanceDataManager* dataMgr = PerformanceDataManager::instance();
+        if ( dataMgr ) {
+            dataMgr->setVisibleMetricView( m_clusteringCritieriaName, metricViewName );
+        }
+    }
+}
+
+/**
+ * @brief PerformanceDataMetricView::handleAddDeferredMetrics
+ * @param clusteringCriteriaName - clustering criteria name associated to the metric view
+ * @param metricNames - list of metrics available for metric mode
+ *
+ * Add the metrics available in metric mode to the metric combobox.  The metric views for these metrics are generated
+ * when first selected (if not already prefetched in the background).
+ */
+void PerformanceDataMetricView::handleAddDeferredMetrics(const QString &clusteringCriteriaName, const QStringList &metricNames)
+{
+    if ( m_clusteringCritieriaName.isEmpty() )
+        m_clusteringCritieriaName = clusteringCriteriaName;
+
+    if ( m_clusteringCritieriaName != clusteringCriteriaName )
+        return;
+
+    // the first metric is already being generated, so don't let the combobox request it
+    ui->comboBox_MetricSelection->blockSignals( true );
+
+    foreach ( const QString& metricName, metricNames ) {
+        if ( m_metricModeMetricModel.findItems( metricName ).isEmpty() )
+            m_metricModeMetricModel.appendRow( new QStandardItem( metricName ) );
     }
+
+    ui->comboBox_MetricSelection->blockSignals( false );
 }
 
 /**
@@ -651,15 +702,53 @@ void PerformanceDataMetricView::handleInitModelView(const QString &clusteringCri
         if ( Q_NULLPTR == model )
             return;
 
-        const QString type = ( viewName == s_allEventsDetailsName ) ? "*" : viewName;
+        QSortFilterProxyModel* proxyModel( Q_NULLPTR );
 
-        ViewSortFilterProxyModel* proxyModel = new ViewSortFilterProxyModel( type );
+        if ( s_traceModeName == modeName && m_traceRowIndexes.contains( attachedMetricViewName ) ) {
+            // the trace view of a function presents the rows of the function from the row index of the model;
+            // the sort proxy model on top only sorts and applies user-defined filters
+            QSharedPointer< TraceRowIndex > rowIndex = m_traceRowIndexes.value( attachedMetricViewName );
 
-        if ( Q_NULLPTR == proxyModel )
-            return;
+            DefaultSortFilterProxyModel* sortProxyModel = new DefaultSortFilterProxyModel;
 
-        proxyModel->setSourceModel( model );
-        proxyModel->setColumnHeaders( metrics );
+            if ( Q_NULLPTR == sortProxyModel )
+                return;
+
+            const QString functionName = ( viewName == s_allEventsDetailsName ) ? QString() : viewName;
+
+            TraceSliceProxyModel* sliceProxyModel = new TraceSliceProxyModel( rowIndex, functionName, sortProxyModel );
+
+            sliceProxyModel->setSourceModel( model );
+            sliceProxyModel->setColumnHeaders( metrics );
+
+            sortProxyModel->setSourceModel( sliceProxyModel );
+
+            proxyModel = sortProxyModel;
+        }
+        else if ( s_traceModeName == modeName ) {
+            // trace views not presenting trace events (such as the function summary) are not filtered by time range
+            DefaultSortFilterProxyModel* sortProxyModel = new DefaultSortFilterProxyModel;
+
+            if ( Q_NULLPTR == sortProxyModel )
+                return;
+
+            sortProxyModel->setSourceModel( model );
+
+            proxyModel = sortProxyModel;
+        }
+        else {
+            const QString type = ( viewName == s_allEventsDetailsName ) ? "*" : viewName;
+
+            ViewSortFilterProxyModel* viewProxyModel = new ViewSortFilterProxyModel( type );
+
+            if ( Q_NULLPTR == viewProxyModel )
+                return;
+
+            viewProxyModel->setSourceModel( model );
+            viewProxyModel->setColumnHeaders( metrics );
+
+            proxyModel = viewProxyModel;
+        }
 
         // the model is set to the proxy model
         view->setModel( proxyModel );
@@ -997,6 +1086,64 @@ void PerformanceDataMetricView::handleAddData(const QString& clusteringCriteriaN
     }
 }
 
+/**
+ * @brief PerformanceDataMetricView::handleAddTraceData
+ * @param clusteringCriteriaName - clustering criteria name associated to the metric view
+ * @param modeName - the mode name
+ * @param metricName - name of metric view for which to add data to model
+ * @param viewName - name of the view for which to add data to model
+ * @param functionName - the name of the traced function of the data
+ * @param data - the rows to add to the model
+ *
+ * Appends the rows of a traced function to the model of the specified trace metric view and adds the rows to the row index of the model.
+ * Rows are appended so that the row numbers recorded in the row index remain valid.
+ */
+void PerformanceDataMetricView::handleAddTraceData(const QString &clusteringCriteriaName, const QString &modeName, const QString &metricName, const QString &viewName, const QString &functionName, const QVector<QVariantList> &data)
+{
+    if ( m_clusteringCritieriaName != clusteringCriteriaName || data.isEmpty() )
+        return;
+
+    const QString metricViewName = PerformanceDataMetricView::getMetricViewName( modeName, metricName, viewName );
+
+    QMutexLocker guard( &m_mutex );
+
+    QStandardItemModel* model = m_models.value( metricViewName );
+    QSharedPointer< TraceRowIndex > rowIndex = m_traceRowIndexes.value( metricViewName );
+
+    if ( Q_NULLPTR == model || rowIndex.isNull() )
+        return;
+
+    int timeBeginColumn( -1 );
+    int timeEndColumn( -1 );
+
+    for ( int i=0; i<model->columnCount(); ++i ) {
+        const QString title = model->headerData( i, Qt::Horizontal ).toString();
+        if ( QStringLiteral("Time Begin (ms)") == title )
+            timeBeginColumn = i;
+        else if ( QStringLiteral("Time End (ms)") == title )
+            timeEndColumn = i;
+    }
+
+    if ( -1 == timeBeginColumn || -1 == timeEndColumn )
+        return;
+
+    const int firstRow = model->rowCount();
+
+    model->insertRows( firstRow, data.size() );
+
+    for ( int row=0; row<data.size(); ++row ) {
+        const QVariantList& rowData( data.at( row ) );
+
+        for ( int i=0; i<rowData.size() && i<model->columnCount(); ++i ) {
+            model->setData( model->index( firstRow + row, i ), rowData.at( i ) );
+        }
+
+        if ( rowData.size() > timeBeginColumn && rowData.size() > timeEndColumn ) {
+            rowIndex->addRow( functionName, firstRow + row, rowData.at( timeBeginColumn ).toDouble(), rowData.at( timeEndColumn ).toDouble() );
+        }
+    }
+}
+
 /**
  * @brief PerformanceDataMetricView::handleRangeChanged
  * @param clusteringCriteriaName - clustering criteria name associated to the metric view
@@ -1027,10 +1174,14 @@ void PerformanceDataMetricView::handleRangeChanged(const QString &clusteringCrit
 
     if ( sortFilterProxyModel != Q_NULLPTR ) {
         ViewSortFilterProxyModel* proxyModel = qobject_cast< ViewSortFilterProxyModel* >( sortFilterProxyModel );
+        TraceSliceProxyModel* sliceProxyModel = qobject_cast< TraceSliceProxyModel* >( sortFilterProxyModel->sourceModel() );
 
         if ( proxyModel != Q_NULLPTR ) {
             proxyModel->setFilterRange( lower, upper );
         }
+        else if ( sliceProxyModel != Q_NULLPTR ) {
+            sliceProxyModel->setFilterRange( lower, upper );
+        }
     }
 
     if ( cursorManager ) {
@@ -1241,6 +1392,11 @@ void PerformanceDataMetricView::handleMetricViewChanged(const QString &text)
 
     emit signalMetricViewChanged( metricViewName );
 
+    PerformanceDataManager* dataMgr = PerformanceDataManager::instance();
+    if ( dataMgr ) {
+        dataMgr->setVisibleMetricView( m_clusteringCritieriaName, metricViewName );
+    }
+
     // if the request view has not been generated yet, then show blank view and request view update
     if ( Q_NULLPTR == view ) {
         // show blank view
@@ -1251,6 +1407,10 @@ void PerformanceDataMetricView::handleMetricViewChanged(const QString &text)
     else {
         // display existing metric view
         m_viewStack->setCurrentWidget( view );
+        // if generated for a previous time range, request the view be generated for the current time range
+        if ( dataMgr && dataMgr->isMetricViewStale( m_clusteringCritieriaName, metricViewName ) ) {
+            handleRequestViewUpdate( false );
+        }
     }
 
     ui->pushButton_ApplyClearFilters->setText( s_APPLY_FILTERS_STR );
@@ -1285,6 +1445,14 @@ void PerformanceDataMetricView::handleRequestMetricViewComplete(const QString &c
 
             view = m_views.value( metricViewName, Q_NULLPTR );
 
+            if ( s_traceModeName == modeName ) {
+                // the trace rows are held by the row index of the all events view
+                QSharedPointer< TraceRowIndex > rowIndex = m_traceRowIndexes.value( PerformanceDataMetricView::getMetricViewName( modeName, metricName, s_allEventsDetailsName ) );
+
+                if ( ! rowIndex.isNull() )
+                    rowIndex->finalize();
+            }
+
             if ( view != Q_NULLPTR ) {
                 // now sorting can be enabled
                 if ( s_calltreeModeName == modeName ) {
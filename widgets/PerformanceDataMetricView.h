@@ -28,6 +28,8 @@
 #include <QTreeView>
 #include <QMutex>
 #include <QMap>
+#include <QSharedPointer>
+#include <QVector>
 #include <QStandardItemModel>
 
 #include "CBTF-ArgoNavis-Ext/NameValueDefines.h"
@@ -51,6 +53,7 @@ class ModifyPathSubstitutionsDialog;
 class ShowDeviceDetailsDialog;
 class MetricViewFilterDialog;
 class DerivedMetricInformationDialog;
+class TraceRowIndex;
 
 
 /*!
@@ -117,7 +120,9 @@ public slots:
 
     void handleInitModel(const QString& clusteringCriteriaName, const QString& modeName, const QString& metricName, const QString& viewName, const QStringList& metrics);
     void handleInitModelView(const QString& clusteringCriteriaName, const QString& modeName, const QString& metricName, const QString& viewName, const QString& attachedMetricViewName, const QStringList& metrics);
+    void handleAddDeferredMetrics(const QString& clusteringCriteriaName, const QStringList& metricNames);
     void handleAddData(const QString& clusteringCriteriaName, const QString& modeName, const QString &metricName, const QString& viewName, const QVariantList& data, const QStringList& columnHeaders);
+    void handleAddTraceData(const QString& clusteringCriteriaName, const QString& modeName, const QString &metricName, const QString& viewName, const QString& functionName, const QVector< QVariantList >& data);
     void handleRangeChanged(const QString& clusteringCriteriaName, const QString &modeName, const QString& metricName, const QString& viewName, double lower, double upper);
     void handleRequestViewUpdate(bool clearExistingViews);
 
@@ -181,6 +186,7 @@ private:
     QMap< QString, QStandardItemModel* > m_models;          // map metric to model
     QMap< QString, QSortFilterProxyModel* > m_proxyModels;  // map metric to model
     QMap< QString, QTreeView* > m_views;                    // map metric to view
+    QMap< QString, QSharedPointer< TraceRowIndex > > m_traceRowIndexes;  // map trace metric to row index of model
 
     QList< QPair< QString, QString > > m_currentFilter;     // currently available user-defined metric view filters
 
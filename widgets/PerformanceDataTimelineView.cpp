@@ -29,8 +29,9 @@
 
 #include "graphitems/OSSDataTransferItem.h"
 #include "graphitems/OSSKernelExecutionItem.h"
-#include "graphitems/OSSPeriodicSampleItem.h"
 #include "graphitems/OSSEventsSummaryItem.h"
+#include "graphitems/OSSTraceEventsPlottable.h"
+#include "graphitems/OSSPeriodicSamplesPlottable.h"
 #include "graphitems/OSSTraceItem.h"
 #include "graphitems/OSSHighlightItem.h"
 
@@ -38,11 +39,21 @@
 #include <qmath.h>
 #include <QPen>
 #include <QInputDialog>
+#include <QHelpEvent>
+#include <QToolTip>
+#include <algorithm>
 
 
 namespace ArgoNavis { namespace GUI {
 
 
+// the lane of the event index of an axis rect
+const int CUDA_EVENT_LANE = 0;
+
+// how far (in pixels) the mouse may be from an event and still hit it
+const double HIT_TOLERANCE = 2.0;
+
+
 /**
  * @brief PerformanceDataTimelineView::PerformanceDataTimelineView
  * @param parent - specify parent of the PerformanceDataTimelineView instance
@@ -78,13 +89,16 @@ PerformanceDataTimelineView::PerformanceDataTimelineView(QWidget *parent)
     // connect some interaction slots:
     connect( ui->graphView, SIGNAL(axisDoubleClick(QCPAxis*,QCPAxis::SelectablePart,QMouseEvent*)), this, SLOT(handleAxisLabelDoubleClick(QCPAxis*,QCPAxis::SelectablePart)) );
 
-    // connect slot when an item is clicked
+    // connect slot when the mouse is pressed - events are found by the event index instead of the QCustomPlot item selection mechanism
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-    connect( ui->graphView, &QCustomPlot::itemClick, this, &PerformanceDataTimelineView::handleItemClick );
+    connect( ui->graphView, &QCustomPlot::mousePress, this, &PerformanceDataTimelineView::handleMousePress );
 #else
-    connect( ui->graphView, SIGNAL(itemClick(QCPAbstractItem*,QMouseEvent*)), this, SLOT(handleItemClick(QCPAbstractItem*,QMouseEvent*)) );
+    connect( ui->graphView, SIGNAL(mousePress(QMouseEvent*)), this, SLOT(handleMousePress(QMouseEvent*)) );
 #endif
 
+    // show tooltips for the event under the mouse
+    ui->graphView->installEventFilter( this );
+
     // connect performance data manager signals to performance data view slots
     PerformanceDataManager* dataMgr = PerformanceDataManager::instance();
     if ( dataMgr ) {
@@ -92,7 +106,7 @@ PerformanceDataTimelineView::PerformanceDataTimelineView(QWidget *parent)
         connect( dataMgr, &PerformanceDataManager::addCluster, this, &PerformanceDataTimelineView::handleAddCluster, Qt::QueuedConnection );
         connect( dataMgr, &PerformanceDataManager::addDataTransfer, this, &PerformanceDataTimelineView::handleAddDataTransfer, Qt::QueuedConnection );
         connect( dataMgr, &PerformanceDataManager::addKernelExecution, this, &PerformanceDataTimelineView::handleAddKernelExecution, Qt::QueuedConnection );
-        connect( dataMgr, &PerformanceDataManager::addPeriodicSample, this, &PerformanceDataTimelineView::handleAddPeriodicSample, Qt::QueuedConnection );
+        connect( dataMgr, &PerformanceDataManager::addPeriodicSamples, this, &PerformanceDataTimelineView::handleAddPeriodicSamples, Qt::QueuedConnection );
         connect( dataMgr, &PerformanceDataManager::addTraceItem, this, &PerformanceDataTimelineView::handleAddTraceItem, Qt::QueuedConnection );
         connect( dataMgr, &PerformanceDataManager::addCudaEventSnapshot, this, &PerformanceDataTimelineView::handleCudaEventSnapshot, Qt::QueuedConnection );
         connect( this, &PerformanceDataTimelineView::graphRangeChanged, dataMgr, &PerformanceDataManager::graphRangeChanged );
@@ -103,7 +117,8 @@ PerformanceDataTimelineView::PerformanceDataTimelineView(QWidget *parent)
                  this, SLOT(handleAddCluster(QString,QString,double,double,bool,double,double)), Qt::QueuedConnection );
         connect( dataMgr, SIGNAL(addDataTransfer(QString,QString,Base::Time,CUDA::DataTransfer)), this, SLOT(handleAddDataTransfer(QString,QString,Base::Time,CUDA::DataTransfer)), Qt::QueuedConnection );
         connect( dataMgr, SIGNAL(addKernelExecution(QString,QString,Base::Time,CUDA::KernelExecution)), this, SLOT(handleAddKernelExecution(QString,QString,Base::Time,CUDA::KernelExecution)), Qt::QueuedConnection );
-        connect( dataMgr, SIGNAL(addPeriodicSample(QString,QString,double,double,double)), this, SLOT(handleAddPeriodicSample(QString,QString,double,double,double)), Qt::QueuedConnection );
+        connect( dataMgr, SIGNAL(addPeriodicSamples(QString,QString,int,QVector<double>,QVector<double>,QVector<double>)),
+                 this, SLOT(handleAddPeriodicSamples(QString,QString,int,QVector<double>,QVector<double>,QVector<double>)), Qt::QueuedConnection );
         connect( dataMgr, SIGNAL(addTraceItem(QString,QString,QString,double,double,int)),
                  this, SLOT(handleAddTraceItem(QString,QString,QString,double,double,int)) );
         connect( dataMgr, SIGNAL(addCudaEventSnapshot(const QString&,const QString&,double,double,const QImage&)),
@@ -338,45 +353,222 @@ void PerformanceDataTimelineView::handleSelectionChanged()
 }
 
 /**
- * @brief PerformanceDataTimelineView::handleItemClick
- * @param item - the item that received the click
- * @param event - the mouse event that caused the click
+ * @brief PerformanceDataTimelineView::handleMousePress
+ * @param event - the mouse event
  *
- * Handle the user clicking an item in the graph.  Present overlay popup with more detailed
- * information of the graph item represented by the item that was clicked.
+ * Handle the user clicking an event in the graph.  The event under the mouse is found by the event index of the axis rect.  A clicked
+ * trace event is highlighted.
  */
-void PerformanceDataTimelineView::handleItemClick(QCPAbstractItem *item, QMouseEvent *event)
+void PerformanceDataTimelineView::handleMousePress(QMouseEvent *event)
 {
-    Q_UNUSED( event )
+    if ( event->button() != Qt::LeftButton )
+        return;
+
+    const EventHit hit = findEventAt( event->pos() );
+
 #ifdef HAS_ITEM_CLICK_DEBUG
     QString text;
     QTextStream output( &text );
 #endif
 
-    OSSDataTransferItem* dataXferItem = qobject_cast< OSSDataTransferItem* >( item );
-    if ( dataXferItem ) {
+    switch ( hit.kind ) {
+    case EventHit::TraceEvent:
+        emit signalTraceItemSelected( hit.functionName, hit.timeBegin, hit.timeEnd, hit.rank );
+        break;
+    case EventHit::DataTransfer:
 #ifdef HAS_ITEM_CLICK_DEBUG
-        output << "Data Transfer: " << *dataXferItem;
+        output << "Data Transfer: " << *qobject_cast< OSSDataTransferItem* >( hit.item );
 #endif
+        break;
+    case EventHit::KernelExecution:
+#ifdef HAS_ITEM_CLICK_DEBUG
+        output << "Kernel Execution: " << *qobject_cast< OSSKernelExecutionItem* >( hit.item );
+#endif
+        break;
+    default:
+        break;
     }
-    else {
-        OSSKernelExecutionItem* kernelExecItem = qobject_cast< OSSKernelExecutionItem* >( item );
-        if ( kernelExecItem ) {
+
 #ifdef HAS_ITEM_CLICK_DEBUG
-            output << "Kernel Execution: " << *kernelExecItem;
+    qDebug() << "PerformanceDataTimelineView::handleMousePress: " << text;
 #endif
+}
+
+/**
+ * @brief PerformanceDataTimelineView::eventFilter
+ * @param watched - the watched object
+ * @param event - the event
+ * @return - whether the event was handled
+ *
+ * Shows the details of the event under the mouse in the graph view as a tooltip.
+ */
+bool PerformanceDataTimelineView::eventFilter(QObject *watched, QEvent *event)
+{
+    if ( watched == ui->graphView && event->type() == QEvent::ToolTip ) {
+        QHelpEvent* helpEvent = static_cast< QHelpEvent* >( event );
+
+        const EventHit hit = findEventAt( helpEvent->pos() );
+
+        QString text;
+
+        switch ( hit.kind ) {
+        case EventHit::TraceEvent:
+            text = QString( "%1\nRank: %2\nBegin: %3 ms\nDuration: %4 ms" ).arg( hit.functionName ).arg( hit.rank )
+                                                                           .arg( hit.timeBegin, 0, 'f', 3 )
+                                                                           .arg( hit.timeEnd - hit.timeBegin, 0, 'f', 3 );
+            break;
+        case EventHit::DataTransfer:
+            text = QString( "Data Transfer\nBegin: %1 ms\nDuration: %2 ms" ).arg( hit.timeBegin, 0, 'f', 3 )
+                                                                            .arg( hit.timeEnd - hit.timeBegin, 0, 'f', 3 );
+            break;
+        case EventHit::KernelExecution:
+            text = QString( "Kernel Execution\nBegin: %1 ms\nDuration: %2 ms" ).arg( hit.timeBegin, 0, 'f', 3 )
+                                                                               .arg( hit.timeEnd - hit.timeBegin, 0, 'f', 3 );
+            break;
+        case EventHit::PeriodicSample:
+            text = QString( "Count: %1\nBegin: %2 ms\nEnd: %3 ms" ).arg( hit.value )
+                                                                  .arg( hit.timeBegin, 0, 'f', 3 )
+                                                                  .arg( hit.timeEnd, 0, 'f', 3 );
+            break;
+        default:
+            break;
+        }
+
+        if ( text.isEmpty() ) {
+            QToolTip::hideText();
+            event->ignore();
         }
         else {
-            OSSPeriodicSampleItem* sampleItem = qobject_cast< OSSPeriodicSampleItem* >( item );
-            if ( sampleItem ) {
+            QToolTip::showText( helpEvent->globalPos(), text, ui->graphView );
+        }
+
+        return true;
+    }
+
+    return QWidget::eventFilter( watched, event );
+}
+
+/**
+ * @brief PerformanceDataTimelineView::findEventAt
+ * @param pos - the position in the graph view
+ * @return - the event at the position (of kind EventHit::None if there is none)
+ *
+ * Finds the event at the position by a lookup in the event index (or trace events index) of the axis rect at the position.  The
+ * lookup takes logarithmic time in the number of events of the lane, independent of how many events are displayed.
+ */
+PerformanceDataTimelineView::EventHit PerformanceDataTimelineView::findEventAt(const QPoint &pos)
+{
+    EventHit hit;
+
+    QCPAxisRect* axisRect = ui->graphView->axisRectAt( pos );
+
+    if ( Q_NULLPTR == axisRect || axisRect->height() <= 0 )
+        return hit;
+
+    QCPAxis* xAxis = axisRect->axis( QCPAxis::atBottom );
+    QCPAxis* yAxis = axisRect->axis( QCPAxis::atLeft );
+
+    if ( Q_NULLPTR == xAxis || Q_NULLPTR == yAxis )
+        return hit;
+
+    const double time = xAxis->pixelToCoord( pos.x() );
+    const double tolerance = qAbs( xAxis->pixelToCoord( pos.x() + HIT_TOLERANCE ) - time );
+    const double value = yAxis->pixelToCoord( pos.y() );
+
+    QMutexLocker guard( &m_mutex );
+
+    foreach ( const MetricGroup* group, m_metricGroups ) {
+        const QString clusterName = group->axisRects.key( axisRect );
 
+        if ( clusterName.isEmpty() )
+            continue;
+
+        // trace events are found in the lane of the rank under the mouse
+        OSSTraceEventsPlottable* traceEvents = group->traceEvents.value( clusterName, Q_NULLPTR );
+
+        if ( Q_NULLPTR != traceEvents ) {
+            const int rank = qRound( value );
+
+            if ( qAbs( value - rank ) <= OSSTraceItem::s_halfHeight ) {
+                const OSSIntervalIndex& index = traceEvents->index();
+                const int i = index.find( rank, time - tolerance, time + tolerance );
+
+                if ( i >= 0 ) {
+                    const OSSIntervalIndex::Lane& lane = index.lane( rank );
+                    hit.kind = EventHit::TraceEvent;
+                    hit.timeBegin = lane.begins[ i ];
+                    hit.timeEnd = lane.ends[ i ];
+                    hit.rank = rank;
+                    hit.functionName = traceEvents->functionName( lane.payloads[ i ] );
+                    return hit;
+                }
             }
         }
+
+        QMap< QString, OSSIntervalIndex >::const_iterator indexIter = group->eventIndex.constFind( clusterName );
+
+        // CUDA events occupy the band between the 0.45 and 0.55 axis rect ratios
+        const double ratio = ( pos.y() - axisRect->top() ) / static_cast< double >( axisRect->height() );
+        const double ratioTolerance = HIT_TOLERANCE / axisRect->height();
+
+        if ( indexIter != group->eventIndex.constEnd() && ratio >= 0.45 - ratioTolerance && ratio <= 0.55 + ratioTolerance ) {
+            const OSSIntervalIndex& index = indexIter.value();
+            const QVector< QCPAbstractItem* > items = group->eventItems.value( clusterName );
+
+            const int i = index.find( CUDA_EVENT_LANE, time - tolerance, time + tolerance );
+
+            if ( i >= 0 ) {
+                const OSSIntervalIndex::Lane& lane = index.lane( CUDA_EVENT_LANE );
+                hit.item = items.value( lane.payloads[ i ], Q_NULLPTR );
+                hit.kind = ( Q_NULLPTR != qobject_cast< OSSDataTransferItem* >( hit.item ) ) ? EventHit::DataTransfer : EventHit::KernelExecution;
+                hit.timeBegin = lane.begins[ i ];
+                hit.timeEnd = lane.ends[ i ];
+                return hit;
+            }
+        }
+
+        // periodic samples are hit anywhere between zero and the counter value; the smallest counter value hit is reported
+        foreach ( const OSSPeriodicSamplesPlottable* periodicSamples, group->periodicSamples.value( clusterName ) ) {
+            const int i = periodicSamples->findSample( time - tolerance, time + tolerance );
+
+            if ( i >= 0 && value >= 0.0 && value <= periodicSamples->value( i ) &&
+                 ( EventHit::None == hit.kind || periodicSamples->value( i ) < hit.value ) ) {
+                hit.kind = EventHit::PeriodicSample;
+                hit.timeBegin = periodicSamples->timeBegin( i );
+                hit.timeEnd = periodicSamples->timeEnd( i );
+                hit.value = periodicSamples->value( i );
+            }
+        }
+
+        return hit;
     }
 
-#ifdef HAS_ITEM_CLICK_DEBUG
-    qDebug() << "PerformanceDataTimelineView::handleItemClick: " << text;
-#endif
+    return hit;
+}
+
+/**
+ * @brief PerformanceDataTimelineView::indexEventItem
+ * @param clusteringCriteriaName - the clustering criteria name
+ * @param clusterName - the cluster name
+ * @param lane - the lane of the event index
+ * @param item - the CUDA event item
+ *
+ * Inserts the time interval of the item in the event index of the axis rect, so it can be found by a mouse position.
+ */
+void PerformanceDataTimelineView::indexEventItem(const QString &clusteringCriteriaName, const QString &clusterName, int lane, QCPItemRect *item)
+{
+    QMutexLocker guard( &m_mutex );
+
+    if ( ! m_metricGroups.contains( clusteringCriteriaName ) )
+        return;
+
+    MetricGroup* group = m_metricGroups[ clusteringCriteriaName ];
+
+    QVector< QCPAbstractItem* >& items = group->eventItems[ clusterName ];
+
+    group->eventIndex[ clusterName ].insert( lane, item->topLeft->key(), item->bottomRight->key(), items.size() );
+
+    items.append( item );
 }
 
 /**
@@ -455,7 +647,8 @@ void PerformanceDataTimelineView::handleCudaEventSnapshot(const QString& cluster
  * @param lower - lower value of range to actually view
  * @param upper - upper value of range to actually view
  *
- * Once a signal 'requestMetricViewComplete' is emitted, this handler of the signal will insure the plot is updated.
+ * Once a signal 'requestMetricViewComplete' is emitted, this handler of the signal will insure the event indexes of the metric group
+ * are built and the plot is updated.
  */
 void PerformanceDataTimelineView::handleRequestMetricViewComplete(const QString &clusteringCriteriaName, const QString &modeName, const QString &metricName, const QString &viewName, double lower, double upper)
 {
@@ -467,6 +660,20 @@ void PerformanceDataTimelineView::handleRequestMetricViewComplete(const QString
     if ( clusteringCriteriaName.isEmpty() || modeName.isEmpty() || viewName.isEmpty() )
         return;
 
+    {
+        QMutexLocker guard( &m_mutex );
+
+        if ( m_metricGroups.contains( clusteringCriteriaName ) ) {
+            MetricGroup* group = m_metricGroups[ clusteringCriteriaName ];
+
+            for ( QMap< QString, OSSIntervalIndex >::iterator iter = group->eventIndex.begin(); iter != group->eventIndex.end(); ++iter )
+                iter->finalize();
+
+            foreach ( OSSTraceEventsPlottable* traceEvents, group->traceEvents )
+                traceEvents->finalize();
+        }
+    }
+
     if ( ( QStringLiteral("Trace") == modeName || QStringLiteral("Details") == modeName ) && QStringLiteral("All Events") == viewName ) {
 #if defined(HAS_QCUSTOMPLOT_V2)
     ui->graphView->replot( QCustomPlot::rpQueuedReplot );
@@ -910,6 +1117,8 @@ void PerformanceDataTimelineView::handleAddDataTransfer(const QString &clusterin
 #if !defined(HAS_QCUSTOMPLOT_V2)
     ui->graphView->addItem( dataXferItem );
 #endif
+
+    indexEventItem( clusteringCriteriaName, clusterName, CUDA_EVENT_LANE, dataXferItem );
 }
 
 /**
@@ -921,11 +1130,13 @@ void PerformanceDataTimelineView::handleAddDataTransfer(const QString &clusterin
  * @param endTime - the end time of the trace event
  * @param rankOrThread - the rank or thread id in which the trace event occurred
  *
- * This method handles adding a trace event to the axis rect for the trace graph.
+ * This method handles adding a trace event to the axis rect for the trace graph.  All trace events of the axis rect are held by
+ * a single plottable which is created with the first trace event.
  */
 void PerformanceDataTimelineView::handleAddTraceItem(const QString &clusteringCriteriaName, const QString &clusterName, const QString &functionName, double startTime, double endTime, int rankOrThread)
 {
     QCPAxisRect* axisRect( Q_NULLPTR );
+    OSSTraceEventsPlottable* traceEvents( Q_NULLPTR );
 
     {
         QMutexLocker guard( &m_mutex );
@@ -934,19 +1145,28 @@ void PerformanceDataTimelineView::handleAddTraceItem(const QString &clusteringCr
             QMap< QString, QCPAxisRect* >& axisRects = m_metricGroups[ clusteringCriteriaName ]->axisRects;
             if ( axisRects.contains( clusterName ) )
                 axisRect = axisRects[ clusterName ];
+            traceEvents = m_metricGroups[ clusteringCriteriaName ]->traceEvents.value( clusterName, Q_NULLPTR );
         }
     }
 
     if ( Q_NULLPTR == axisRect )
         return;
 
-    OSSTraceItem* traceItem = new OSSTraceItem( axisRect, ui->graphView );
-
-    traceItem->setData( functionName, startTime, endTime, rankOrThread );
+    if ( Q_NULLPTR == traceEvents ) {
+        traceEvents = new OSSTraceEventsPlottable( axisRect->axis( QCPAxis::atBottom ), axisRect->axis( QCPAxis::atLeft ) );
 
 #if !defined(HAS_QCUSTOMPLOT_V2)
-    ui->graphView->addItem( traceItem );
+        ui->graphView->addPlottable( traceEvents );
 #endif
+
+        QMutexLocker guard( &m_mutex );
+
+        if ( m_metricGroups.contains( clusteringCriteriaName ) ) {
+            m_metricGroups[ clusteringCriteriaName ]->traceEvents.insert( clusterName, traceEvents );
+        }
+    }
+
+    traceEvents->addEvent( functionName, startTime, endTime, rankOrThread );
 }
 
 /**
@@ -983,22 +1203,28 @@ void PerformanceDataTimelineView::handleAddKernelExecution(const QString &cluste
 #if !defined(HAS_QCUSTOMPLOT_V2)
     ui->graphView->addItem( kernelExecItem );
 #endif
+
+    indexEventItem( clusteringCriteriaName, clusterName, CUDA_EVENT_LANE, kernelExecItem );
 }
 
 /**
- * @brief PerformanceDataTimelineView::handleAddPeriodicSample
+ * @brief PerformanceDataTimelineView::handleAddPeriodicSamples
  * @param clusteringCriteriaName - the clustering criteria name
  * @param clusterName - the cluster name
- * @param time_begin - the begin time of the periodic sample (relative to time origin of the experiment)
- * @param time_end - the end time of the periodic sample (relative to time origin of the experiment)
- * @param count - the period sample counter value
+ * @param counterIndex - the index of the sample counter
+ * @param timeBegins - the begin times of the periodic samples (relative to time origin of the experiment)
+ * @param timeEnds - the end times of the periodic samples (relative to time origin of the experiment)
+ * @param counts - the periodic sample counter values
  *
- * Find the axis rect associated with the specified metric group and sample counter index.  Create the periodic sample graph item from the details using the associated axis rect.
- * Add graph item to QCustomPlot instance.  Update y-axis upper range value if counter value is greater than the current y-axis upper range value.
+ * Find the axis rect associated with the specified metric group and cluster.  Append the samples to the periodic samples plottable of the counter in the
+ * axis rect, which is created with the first samples of the counter.  Update y-axis upper range value if the largest counter value is greater than the
+ * current y-axis upper range value.
  */
-void PerformanceDataTimelineView::handleAddPeriodicSample(const QString &clusteringCriteriaName, const QString& clusterName, const double &time_begin, const double &time_end, const double &count)
+void PerformanceDataTimelineView::handleAddPeriodicSamples(const QString &clusteringCriteriaName, const QString& clusterName, int counterIndex,
+                                                           const QVector<double> &timeBegins, const QVector<double> &timeEnds, const QVector<double> &counts)
 {
     QCPAxisRect* axisRect( Q_NULLPTR );
+    OSSPeriodicSamplesPlottable* periodicSamples( Q_NULLPTR );
 
     {
         QMutexLocker guard( &m_mutex );
@@ -1007,24 +1233,35 @@ void PerformanceDataTimelineView::handleAddPeriodicSample(const QString &cluster
             QMap< QString, QCPAxisRect* >& axisRects = m_metricGroups[ clusteringCriteriaName ]->axisRects;
             if ( axisRects.contains( clusterName ) )
                 axisRect = axisRects[ clusterName ];
+            periodicSamples = m_metricGroups[ clusteringCriteriaName ]->periodicSamples.value( clusterName ).value( counterIndex, Q_NULLPTR );
         }
     }
 
-    if ( Q_NULLPTR == axisRect )
+    if ( Q_NULLPTR == axisRect || counts.isEmpty() )
         return;
 
-    OSSPeriodicSampleItem* periodicSampleItem = new OSSPeriodicSampleItem( axisRect, ui->graphView );
-
-    periodicSampleItem->setData( time_begin, time_end, count );
+    if ( Q_NULLPTR == periodicSamples ) {
+        periodicSamples = new OSSPeriodicSamplesPlottable( axisRect->axis( QCPAxis::atBottom ), axisRect->axis( QCPAxis::atLeft ) );
 
 #if !defined(HAS_QCUSTOMPLOT_V2)
-   ui->graphView->addItem( periodicSampleItem );
+        ui->graphView->addPlottable( periodicSamples );
 #endif
 
+        QMutexLocker guard( &m_mutex );
+
+        if ( m_metricGroups.contains( clusteringCriteriaName ) ) {
+            m_metricGroups[ clusteringCriteriaName ]->periodicSamples[ clusterName ].insert( counterIndex, periodicSamples );
+        }
+    }
+
+    periodicSamples->addSamples( timeBegins, timeEnds, counts );
+
+    const double maxCount = *std::max_element( counts.constBegin(), counts.constEnd() );
+
     QCPAxis* yAxis = axisRect->axis( QCPAxis::atLeft );
 
-    if ( count > yAxis->range().upper )
-        yAxis->setRangeUpper( count );
+    if ( maxCount > yAxis->range().upper )
+        yAxis->setRangeUpper( maxCount );
 }
 
 /**
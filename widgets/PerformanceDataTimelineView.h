@@ -31,6 +31,8 @@
 
 #include "common/openss-gui-config.h"
 
+#include "graphitems/OSSIntervalIndex.h"
+
 namespace Ui {
 class PerformanceDataTimelineView;
 }
@@ -51,6 +53,8 @@ namespace GUI {
 
 class OSSEventsSummaryItem;
 class OSSHighlightItem;
+class OSSPeriodicSamplesPlottable;
+class OSSTraceEventsPlottable;
 
 class PerformanceDataTimelineView : public QWidget
 {
@@ -75,13 +79,15 @@ protected:
 
     QSize sizeHint() const Q_DECL_OVERRIDE;
 
+    bool eventFilter(QObject *watched, QEvent *event) Q_DECL_OVERRIDE;
+
 private slots:
 
     void handleAxisRangeChange(const QCPRange &requestedRange);
     void handleAxisRangeChangeForMetricGroup(QCPAxis *senderAxis, const QCPRange &requestedRange);
     void handleAxisLabelDoubleClick(QCPAxis* axis, QCPAxis::SelectablePart part);
     void handleSelectionChanged();
-    void handleItemClick(QCPAbstractItem *item, QMouseEvent *event);
+    void handleMousePress(QMouseEvent *event);
 
     void handleAddCluster(const QString& clusteringCriteriaName, const QString& clusterName, double xAxisLower, double xAxisUpper, bool yAxisVisible, double yAxisLower, double yAxisUpper);
 
@@ -102,11 +108,12 @@ private slots:
                                   const Base::Time& time_origin,
                                   const CUDA::KernelExecution& details);
 
-    void handleAddPeriodicSample(const QString& clusteringCriteriaName,
-                                 const QString& clusterName,
-                                 const double& time_begin,
-                                 const double& time_end,
-                                 const double& count);
+    void handleAddPeriodicSamples(const QString& clusteringCriteriaName,
+                                  const QString& clusterName,
+                                  int counterIndex,
+                                  const QVector< double >& timeBegins,
+                                  const QVector< double >& timeEnds,
+                                  const QVector< double >& counts);
 
     void handleCudaEventSnapshot(const QString& clusteringCriteriaName,
                                  const QString& clusteringName,
@@ -128,6 +135,22 @@ private slots:
 
 private:
 
+    // the event found at a position of the graph view
+    struct EventHit {
+        enum Kind { None, TraceEvent, DataTransfer, KernelExecution, PeriodicSample };
+        EventHit() : kind( None ), timeBegin( 0.0 ), timeEnd( 0.0 ), rank( -1 ), value( 0.0 ), item( Q_NULLPTR ) { }
+        Kind kind;
+        double timeBegin;
+        double timeEnd;
+        int rank;                   // the rank (or thread) of a trace event
+        double value;               // the counter value of a periodic sample
+        QString functionName;       // the function name of a trace event
+        QCPAbstractItem* item;      // the item of a CUDA event
+    };
+
+    EventHit findEventAt(const QPoint& pos);
+    void indexEventItem(const QString& clusteringCriteriaName, const QString& clusterName, int lane, QCPItemRect* item);
+
     void addLegend(QCPAxisRect *axisRect);
     void initPlotView(const QString &clusteringCriteriaName, const QString clusterName, QCPAxisRect* axisRect, double xAxisLower, double xAxisUpper, bool yAxisVisible, double yAxisLower, double yAxisUpper);
     QList< QCPAxis* > getAxesForMetricGroup(const QCPAxis::AxisType axisType, const QString& metricGroupName);
@@ -145,6 +168,10 @@ private:
         QStringList metricList;                   // list of metrics
         QCPMarginGroup* marginGroup;              // one margin group to line up the left and right axes
         QMap< QString, OSSEventsSummaryItem* > eventSummary;
+        QMap< QString, OSSTraceEventsPlottable* > traceEvents;  // the trace events plottable of each trace axis rect
+        QMap< QString, QMap< int, OSSPeriodicSamplesPlottable* > > periodicSamples;  // the periodic samples plottable of each counter of each axis rect
+        QMap< QString, OSSIntervalIndex > eventIndex;           // the CUDA event index of each axis rect
+        QMap< QString, QVector< QCPAbstractItem* > > eventItems; // the items referenced by the payloads of the event index
     } MetricGroup;
 
     QMap< QString, MetricGroup* > m_metricGroups; // defines each metric group
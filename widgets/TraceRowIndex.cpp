@@ -0,0 +1,124 @@
+/*!
+   \file TraceRowIndex.cpp
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "TraceRowIndex.h"
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/**
+ * @brief TraceRowIndex::TraceRowIndex
+ *
+ * Constructs an empty TraceRowIndex instance.
+ */
+TraceRowIndex::TraceRowIndex()
+{
+
+}
+
+/**
+ * @brief TraceRowIndex::addRow
+ * @param functionName - the name of the traced function of the row
+ * @param row - the row in the trace metric view model
+ * @param timeBegin - the time the trace event began
+ * @param timeEnd - the time the trace event ended
+ *
+ * Adds the row to the rows of the function and to all rows.
+ */
+void TraceRowIndex::addRow(const QString &functionName, int row, double timeBegin, double timeEnd)
+{
+    QHash< QString, int >::const_iterator iter = m_functionLanes.constFind( functionName );
+
+    if ( iter == m_functionLanes.constEnd() )
+        iter = m_functionLanes.insert( functionName, m_functionLanes.size() + 1 );
+
+    m_index.insert( ALL_EVENTS_LANE, timeBegin, timeEnd, row );
+    m_index.insert( iter.value(), timeBegin, timeEnd, row );
+}
+
+/**
+ * @brief TraceRowIndex::finalize
+ *
+ * Indexes the rows added since the last call, so they are found by rows().
+ */
+void TraceRowIndex::finalize()
+{
+    m_index.finalize();
+}
+
+/**
+ * @brief TraceRowIndex::clear
+ *
+ * Removes all rows.
+ */
+void TraceRowIndex::clear()
+{
+    m_index.clear();
+    m_functionLanes.clear();
+}
+
+/**
+ * @brief TraceRowIndex::rows
+ * @param functionName - the name of the traced function (or an empty string for all rows)
+ * @param lower - the lower value of the time range
+ * @param upper - the upper value of the time range
+ * @return - the rows in order of the time the trace event began
+ *
+ * Finds the rows of the function whose trace event either began within the time range or began before it and ended at or after the
+ * lower value of the time range.
+ */
+QVector< int > TraceRowIndex::rows(const QString &functionName, double lower, double upper) const
+{
+    QVector< int > result;
+
+    int lane( ALL_EVENTS_LANE );
+
+    if ( ! functionName.isEmpty() ) {
+        QHash< QString, int >::const_iterator iter = m_functionLanes.constFind( functionName );
+
+        if ( iter == m_functionLanes.constEnd() )
+            return result;
+
+        lane = iter.value();
+    }
+
+    int first, last;
+    m_index.findRange( lane, lower, upper, first, last );
+
+    const OSSIntervalIndex::Lane& intervals = m_index.lane( lane );
+
+    result.reserve( qMax( 0, last - first ) );
+
+    for ( int i=first; i<last; ++i ) {
+        if ( intervals.ends[ i ] >= lower )
+            result.append( intervals.payloads[ i ] );
+    }
+
+    return result;
+}
+
+
+} // GUI
+} // ArgoNavis
@@ -0,0 +1,75 @@
+/*!
+   \file TraceRowIndex.h
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef TRACEROWINDEX_H
+#define TRACEROWINDEX_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "common/openss-gui-config.h"
+
+#include "graphitems/OSSIntervalIndex.h"
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/*!
+ * \brief The TraceRowIndex class
+ *
+ * The index of the rows of a trace metric view model built while the rows are added.  The rows of each traced function, and separately
+ * all rows, are kept sorted by the time the trace event began, so the rows of a function whose trace events intersect a time range are
+ * found by binary search rather than by evaluating a filter over every row of the model.  Added rows are found once finalize() is called
+ * after the rows of a function have been loaded.
+ */
+
+class TraceRowIndex
+{
+public:
+
+    TraceRowIndex();
+
+    void addRow(const QString& functionName, int row, double timeBegin, double timeEnd);
+    void finalize();
+    void clear();
+
+    QVector< int > rows(const QString& functionName, double lower, double upper) const;
+
+private:
+
+    // lane of the interval index holding all rows; the lanes of the functions follow
+    static const int ALL_EVENTS_LANE = 0;
+
+    OSSIntervalIndex m_index;
+    QHash< QString, int > m_functionLanes;
+
+};
+
+
+} // GUI
+} // ArgoNavis
+
+#endif // TRACEROWINDEX_H
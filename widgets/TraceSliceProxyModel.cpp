@@ -0,0 +1,284 @@
+/*!
+   \file TraceSliceProxyModel.cpp
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "TraceSliceProxyModel.h"
+
+#include "TraceRowIndex.h"
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+/**
+ * @brief TraceSliceProxyModel::TraceSliceProxyModel
+ * @param rowIndex - the row index of the source model
+ * @param functionName - the name of the traced function whose rows are presented (or an empty string for all rows)
+ * @param parent - the parent object
+ *
+ * Constructs a TraceSliceProxyModel instance with the given parent.  No rows are presented until a time range is set.
+ */
+TraceSliceProxyModel::TraceSliceProxyModel(const QSharedPointer<TraceRowIndex> &rowIndex, const QString &functionName, QObject *parent)
+    : QAbstractProxyModel( parent )
+    , m_rowIndex( rowIndex )
+    , m_functionName( functionName )
+{
+
+}
+
+/**
+ * @brief TraceSliceProxyModel::~TraceSliceProxyModel
+ *
+ * Destroys this TraceSliceProxyModel instance.
+ */
+TraceSliceProxyModel::~TraceSliceProxyModel()
+{
+
+}
+
+/**
+ * @brief TraceSliceProxyModel::setSourceModel
+ * @param sourceModel - the trace metric view model
+ *
+ * The method reimplements QAbstractProxyModel::setSourceModel.  The presented rows are discarded whenever rows of the source model are
+ * removed or the source model is reset, as the row index no longer describes the source model.  Rows appended to the source model are
+ * presented once the time range is next set.
+ */
+void TraceSliceProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+    beginResetModel();
+
+    if ( QAbstractProxyModel::sourceModel() ) {
+        disconnect( QAbstractProxyModel::sourceModel(), Q_NULLPTR, this, Q_NULLPTR );
+    }
+
+    QAbstractProxyModel::setSourceModel( sourceModel );
+
+    if ( sourceModel ) {
+        connect( sourceModel, SIGNAL(modelReset()), this, SLOT(handleSourceModelReset()) );
+        connect( sourceModel, SIGNAL(rowsRemoved(QModelIndex,int,int)), this, SLOT(handleSourceModelReset()) );
+        connect( sourceModel, SIGNAL(destroyed()), this, SLOT(handleSourceModelReset()) );
+    }
+
+    m_columns.clear();
+    m_rows.clear();
+    m_sourceRows.clear();
+
+    endResetModel();
+}
+
+/**
+ * @brief TraceSliceProxyModel::setColumnHeaders
+ * @param columnHeaders - the subset of columns to be included in the proxy model
+ *
+ * This method defines a subset of columns from the source model to use in the proxy model.  The function column is only presented when
+ * all rows are presented.
+ */
+void TraceSliceProxyModel::setColumnHeaders(const QStringList &columnHeaders)
+{
+    QAbstractItemModel* model = sourceModel();
+
+    if ( Q_NULLPTR == model )
+        return;
+
+    beginResetModel();
+
+    m_columns.clear();
+
+    for ( int i=0; i<model->columnCount(); ++i ) {
+        if ( i == 0 && ! m_functionName.isEmpty() )
+            continue;
+        if ( columnHeaders.contains( model->headerData( i, Qt::Horizontal ).toString() ) )
+            m_columns << i;
+    }
+
+    endResetModel();
+}
+
+/**
+ * @brief TraceSliceProxyModel::setFilterRange
+ * @param lower - the lower value of the filter range
+ * @param upper - the upper value of the filter range
+ *
+ * This method presents the rows whose trace event either began within the range defined by ['lower' .. 'upper'] or began before 'lower'
+ * but ended at or after 'lower'.
+ */
+void TraceSliceProxyModel::setFilterRange(double lower, double upper)
+{
+    beginResetModel();
+
+    m_sourceRows.clear();
+
+    if ( sourceModel() && ! m_rowIndex.isNull() )
+        m_rows = m_rowIndex->rows( m_functionName, lower, upper );
+    else
+        m_rows.clear();
+
+    m_sourceRows.reserve( m_rows.size() );
+
+    for ( int i=0; i<m_rows.size(); ++i ) {
+        m_sourceRows.insert( m_rows[ i ], i );
+    }
+
+    endResetModel();
+}
+
+/**
+ * @brief TraceSliceProxyModel::index
+ * @param row - the presented row
+ * @param column - the presented column
+ * @param parent - the parent of the item (the rows of the model are not nested)
+ * @return - the model index of the item
+ *
+ * The method reimplements QAbstractItemModel::index.
+ */
+QModelIndex TraceSliceProxyModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if ( parent.isValid() || row < 0 || row >= m_rows.size() || column < 0 || column >= m_columns.size() )
+        return QModelIndex();
+
+    return createIndex( row, column );
+}
+
+/**
+ * @brief TraceSliceProxyModel::parent
+ * @param child - the model index of an item
+ * @return - the model index of the parent (the rows of the model are not nested)
+ *
+ * The method reimplements QAbstractItemModel::parent.
+ */
+QModelIndex TraceSliceProxyModel::parent(const QModelIndex &child) const
+{
+    Q_UNUSED( child )
+
+    return QModelIndex();
+}
+
+/**
+ * @brief TraceSliceProxyModel::rowCount
+ * @param parent - the parent of the items (the rows of the model are not nested)
+ * @return - the number of rows presented
+ *
+ * The method reimplements QAbstractItemModel::rowCount.
+ */
+int TraceSliceProxyModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+/**
+ * @brief TraceSliceProxyModel::columnCount
+ * @param parent - the parent of the items (the rows of the model are not nested)
+ * @return - the number of columns presented
+ *
+ * The method reimplements QAbstractItemModel::columnCount.
+ */
+int TraceSliceProxyModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_columns.size();
+}
+
+/**
+ * @brief TraceSliceProxyModel::mapToSource
+ * @param proxyIndex - the model index of a presented item
+ * @return - the model index of the item in the source model
+ *
+ * The method reimplements QAbstractProxyModel::mapToSource.
+ */
+QModelIndex TraceSliceProxyModel::mapToSource(const QModelIndex &proxyIndex) const
+{
+    QAbstractItemModel* model = sourceModel();
+
+    if ( Q_NULLPTR == model || ! proxyIndex.isValid() || proxyIndex.row() >= m_rows.size() || proxyIndex.column() >= m_columns.size() )
+        return QModelIndex();
+
+    return model->index( m_rows[ proxyIndex.row() ], m_columns[ proxyIndex.column() ] );
+}
+
+/**
+ * @brief TraceSliceProxyModel::mapFromSource
+ * @param sourceIndex - the model index of an item in the source model
+ * @return - the model index of the presented item (invalid if the item is not presented)
+ *
+ * The method reimplements QAbstractProxyModel::mapFromSource.
+ */
+QModelIndex TraceSliceProxyModel::mapFromSource(const QModelIndex &sourceIndex) const
+{
+    if ( ! sourceIndex.isValid() )
+        return QModelIndex();
+
+    QHash< int, int >::const_iterator iter = m_sourceRows.constFind( sourceIndex.row() );
+    const int column = m_columns.indexOf( sourceIndex.column() );
+
+    if ( iter == m_sourceRows.constEnd() || -1 == column )
+        return QModelIndex();
+
+    return createIndex( iter.value(), column );
+}
+
+/**
+ * @brief TraceSliceProxyModel::headerData
+ * @param section - the presented column (or row)
+ * @param orientation - the header orientation
+ * @param role - the data role
+ * @return - the header data of the corresponding source column (or row)
+ *
+ * The method reimplements QAbstractProxyModel::headerData.
+ */
+QVariant TraceSliceProxyModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    QAbstractItemModel* model = sourceModel();
+
+    if ( Q_NULLPTR == model )
+        return QVariant();
+
+    if ( Qt::Horizontal == orientation ) {
+        if ( section < 0 || section >= m_columns.size() )
+            return QVariant();
+        return model->headerData( m_columns[ section ], orientation, role );
+    }
+
+    if ( section < 0 || section >= m_rows.size() )
+        return QVariant();
+
+    return model->headerData( m_rows[ section ], orientation, role );
+}
+
+/**
+ * @brief TraceSliceProxyModel::handleSourceModelReset
+ *
+ * Discards the presented rows when the rows of the source model no longer correspond to the row index.
+ */
+void TraceSliceProxyModel::handleSourceModelReset()
+{
+    beginResetModel();
+
+    m_rows.clear();
+    m_sourceRows.clear();
+
+    endResetModel();
+}
+
+
+} // GUI
+} // ArgoNavis
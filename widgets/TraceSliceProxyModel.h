@@ -0,0 +1,97 @@
+/*!
+   \file TraceSliceProxyModel.h
+   \author Gregory Schultz <gregory.schultz@embarqmail.com>
+
+   \section LICENSE
+   This file is part of the Open|SpeedShop Graphical User Interface
+   Copyright (C) 2010-2018 Schultz Software Solutions, LLC
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+   for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef TRACESLICEPROXYMODEL_H
+#define TRACESLICEPROXYMODEL_H
+
+#include <QAbstractProxyModel>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QList>
+
+#include "common/openss-gui-config.h"
+
+
+namespace ArgoNavis { namespace GUI {
+
+
+class TraceRowIndex;
+
+
+/*!
+ * \brief The TraceSliceProxyModel class
+ *
+ * A proxy model presenting the rows of one traced function (or all rows) of a trace metric view model whose trace events intersect
+ * the current time range.  The rows are taken from the TraceRowIndex of the model instead of evaluating a filter for every row of the
+ * model, so changing the time range costs a binary search plus the number of rows presented.  Sorting and user-defined filters are
+ * left to a DefaultSortFilterProxyModel stacked on top of this model.
+ */
+
+class TraceSliceProxyModel : public QAbstractProxyModel
+{
+    Q_OBJECT
+
+public:
+
+    explicit TraceSliceProxyModel(const QSharedPointer< TraceRowIndex >& rowIndex, const QString& functionName = QString(), QObject* parent = Q_NULLPTR);
+    virtual ~TraceSliceProxyModel();
+
+    void setSourceModel(QAbstractItemModel* sourceModel) Q_DECL_OVERRIDE;
+
+    void setColumnHeaders(const QStringList& columnHeaders);
+
+    void setFilterRange(double lower, double upper);
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const Q_DECL_OVERRIDE;
+    QModelIndex parent(const QModelIndex& child) const Q_DECL_OVERRIDE;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const Q_DECL_OVERRIDE;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const Q_DECL_OVERRIDE;
+
+    QModelIndex mapToSource(const QModelIndex& proxyIndex) const Q_DECL_OVERRIDE;
+    QModelIndex mapFromSource(const QModelIndex& sourceIndex) const Q_DECL_OVERRIDE;
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const Q_DECL_OVERRIDE;
+
+private slots:
+
+    void handleSourceModelReset();
+
+private:
+
+    QSharedPointer< TraceRowIndex > m_rowIndex;
+    QString m_functionName;
+
+    QList< int > m_columns;             // the source columns presented
+    QVector< int > m_rows;              // the source rows presented
+    QHash< int, int > m_sourceRows;     // map source row to presented row
+
+};
+
+
+} // GUI
+} // ArgoNavis
+
+#endif // TRACESLICEPROXYMODEL_H